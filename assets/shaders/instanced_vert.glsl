@@ -0,0 +1,36 @@
+#version 330 core
+
+// Vertex attributes
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec3 a_normals;
+layout(location = 2) in vec3 a_uv;  // xy = texture coords, z = layer index
+layout(location = 3) in vec3 a_tint;
+layout(location = 4) in mat4 a_model;  // per instance, locations 4-7
+
+// Vertex outputs
+out vec3 v_normal;
+out vec3 v_worldPos;
+out vec3 v_uv;
+out vec3 v_tint;
+
+// Per-frame data shared by every draw, uploaded once a frame (std140; matches FrameUniforms in RenderSystem.cpp)
+layout(std140) uniform FrameData
+{
+    mat4 u_viewProjection;
+    vec4 u_sunDirection;  // xyz, points *from fragment toward light*
+    vec4 u_sunColor;      // rgb
+    vec4 u_ambientColor;  // rgb
+    vec4 u_viewPos;       // xyz
+};
+
+void main()
+{
+    vec4 worldPos = a_model * vec4(a_position, 1.0);
+
+    v_worldPos = worldPos.xyz;
+    v_normal   = normalize(mat3(a_model) * a_normals);  // instances are only rotated and moved
+    v_uv       = a_uv;
+    v_tint     = a_tint;
+
+    gl_Position = u_viewProjection * worldPos;
+}
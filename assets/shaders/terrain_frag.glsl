@@ -9,36 +9,40 @@ in vec3 v_worldPos;
 in vec3 v_uv;  // xy = texture coords, z = layer index
 in vec3 v_tint;
 
-uniform vec3           u_viewPos;
-uniform sampler2DArray u_blockTextures;
+// Per-frame data shared by every draw, uploaded once a frame (std140; matches FrameUniforms in RenderSystem.cpp)
+layout(std140) uniform FrameData
+{
+    mat4 u_viewProjection;
+    vec4 u_sunDirection;  // xyz, points *from fragment toward light*
+    vec4 u_sunColor;      // rgb
+    vec4 u_ambientColor;  // rgb
+    vec4 u_viewPos;       // xyz
+};
 
-// Sun (directional light). Direction points *from fragment toward light*.
-uniform vec3 u_sunDirection;
-uniform vec3 u_sunColor;
-uniform vec3 u_ambientColor;
+uniform sampler2DArray u_blockTextures;
 
 void main()
 {
     vec3 albedo = texture(u_blockTextures, v_uv).rgb * v_tint;
 
     vec3 N = normalize(v_normal);
-    vec3 V = normalize(u_viewPos - v_worldPos);
-    vec3 L = normalize(u_sunDirection);
+    vec3 V = normalize(u_viewPos.xyz - v_worldPos);
+    vec3 L = normalize(u_sunDirection.xyz);
 
-    vec3 ambient = u_ambientColor * albedo;
+    vec3 ambient = u_ambientColor.rgb * albedo;
 
     float NdotL = max(dot(N, L), 0.0);
 
     float wrap = 0.25;
     float wrapped = clamp((NdotL + wrap) / (1.0 + wrap), 0.0, 1.0);
-    vec3 diffuse = wrapped * u_sunColor * albedo;
+    vec3 diffuse = wrapped * u_sunColor.rgb * albedo;
 
     vec3  H = normalize(L + V);
     float specPower = 64.0;
     float specStrength = 0.18;
     float spec = pow(max(dot(N, H), 0.0), specPower) * specStrength;
 
-    vec3 specular = spec * mix(u_sunColor, vec3(0.65, 0.75, 1.0), 0.35);
+    vec3 specular = spec * mix(u_sunColor.rgb, vec3(0.65, 0.75, 1.0), 0.35);
 
     vec3 color = ambient + diffuse + specular;
     color = color / (color + vec3(1.0));
@@ -5,6 +5,7 @@ layout(location = 0) in vec3 a_position;
 layout(location = 1) in vec3 a_normals;
 layout(location = 2) in vec3 a_uv;  // xy = texture coords, z = layer index
 layout(location = 3) in vec3 a_tint;
+layout(location = 4) in vec3 a_chunkOrigin;  // per draw for batched terrain; unset (zero) for single meshes
 
 // Vertex outputs
 out vec3 v_normal;
@@ -12,18 +13,28 @@ out vec3 v_worldPos;
 out vec3 v_uv;
 out vec3 v_tint;
 
-// Uniforms
-uniform mat4 u_mvp;
+// Per-frame data shared by every draw, uploaded once a frame (std140; matches FrameUniforms in RenderSystem.cpp)
+layout(std140) uniform FrameData
+{
+    mat4 u_viewProjection;
+    vec4 u_sunDirection;  // xyz, points *from fragment toward light*
+    vec4 u_sunColor;      // rgb
+    vec4 u_ambientColor;  // rgb
+    vec4 u_viewPos;       // xyz
+};
+
+// Per-object data
 uniform mat4 u_model;
 
 void main()
 {
-    vec4 worldPos = u_model * vec4(a_position, 1.0);
+    vec3 position = a_position + a_chunkOrigin;
+    vec4 worldPos = u_model * vec4(position, 1.0);
 
     v_worldPos = worldPos.xyz;
     v_normal   = normalize(mat3(transpose(inverse(u_model))) * a_normals);
     v_uv       = a_uv;
     v_tint     = a_tint;
 
-    gl_Position = u_mvp * vec4(a_position, 1.0);
+    gl_Position = u_viewProjection * worldPos;
 }
@@ -4,5 +4,7 @@
 #include "pch_shared.h"
 
 // Server headers here...
+#include <charconv>
+#include <csignal>
 
 #endif // PCH_SERVER_H
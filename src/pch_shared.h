@@ -12,12 +12,15 @@
 #include <array>
 #include <cassert>
 #include <atomic>
+#include <bit>
+#include <bitset>
 #include <chrono>
 #include <cmath>
 #include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <exception>
 #include <expected>
 #include <filesystem>
@@ -33,6 +36,7 @@
 #include <memory>
 #include <mutex>
 #include <new>
+#include <optional>
 #include <print>
 #include <queue>
 #include <random>
@@ -45,6 +49,7 @@
 #include <stack>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <typeindex>
 #include <type_traits>
@@ -54,7 +59,14 @@
 #include <vector>
 
 // Additional Libraries
+#ifdef _WIN32
 #include <sal.h>
+#endif
+
+// SSE2 is part of every x64 target; code using it keeps a scalar path for the rest
+#if defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
 
 // GLM (Math Library)
 #include <glm/glm.hpp>
@@ -66,6 +78,7 @@
 #include <glm/gtx/hash.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/norm.hpp>
+#include <glm/gtx/euler_angles.hpp>
 
 #ifndef OPENGL_COMMON_PCH_UTILS
 #define OPENGL_COMMON_PCH_UTILS
@@ -2,12 +2,126 @@
 
 #include "ServerApp.h"
 
+#include <Engine/World/Level.h>
+
 namespace Server
 {
 
-void ServerApp::Run()
+namespace
+{
+
+volatile std::sig_atomic_t s_fInterrupted = 0;
+
+void PrintUsage()
+{
+   std::println( "Usage: OpenGL_Server [--world <name>] [--pregen <radius> [--center <x> <z>] [--threads <n>]]" );
+   std::println( "  --world <name>     world under saves/ (default: world)" );
+   std::println( "  --pregen <radius>  generate and save every chunk within <radius> chunks, then exit." );
+   std::println( "                     Interrupt with Ctrl+C at any time; rerunning resumes." );
+   std::println( "  --center <x> <z>   pre-generation center in chunk coordinates (default: 0 0)" );
+   std::println( "  --threads <n>      pre-generation worker threads (default: all hardware threads)" );
+}
+
+bool FParseInt( const char* psz, int& out )
+{
+   const std::string_view str( psz );
+   const auto [ ptr, ec ] = std::from_chars( str.data(), str.data() + str.size(), out );
+   return ec == std::errc() && ptr == str.data() + str.size();
+}
+
+} // namespace
+
+
+// ----------------------------------------------------------------
+// ServerOptions
+// ----------------------------------------------------------------
+/*static*/ std::optional< ServerOptions > ServerOptions::Parse( std::span< char* const > args )
+{
+   ServerOptions options;
+   PreGenOptions preGen;
+   bool          fPreGen = false;
+   bool          fOk     = true;
+   for( size_t i = 0; i < args.size() && fOk; ++i )
+   {
+      const std::string_view arg       = args[ i ];
+      const size_t           remaining = args.size() - i - 1;
+      if( arg == "--world" && remaining >= 1 )
+         options.worldName = args[ ++i ];
+      else if( arg == "--pregen" && remaining >= 1 )
+         fOk = fPreGen = FParseInt( args[ ++i ], preGen.radius ) && preGen.radius >= 0;
+      else if( arg == "--center" && remaining >= 2 )
+      {
+         fOk = FParseInt( args[ i + 1 ], preGen.centerX ) && FParseInt( args[ i + 2 ], preGen.centerZ );
+         i += 2;
+      }
+      else if( arg == "--threads" && remaining >= 1 )
+      {
+         int threads        = 0;
+         fOk                = FParseInt( args[ ++i ], threads ) && threads >= 0;
+         preGen.threadCount = static_cast< unsigned >( threads );
+      }
+      else
+         fOk = false;
+   }
+
+   if( !fOk )
+   {
+      PrintUsage();
+      return std::nullopt;
+   }
+
+   if( fPreGen )
+      options.optPreGen = preGen;
+
+   return options;
+}
+
+
+// ----------------------------------------------------------------
+// ServerApp
+// ----------------------------------------------------------------
+ServerApp::ServerApp( ServerOptions options ) :
+   m_options( std::move( options ) )
+{}
+
+
+int ServerApp::Run()
 {
+   if( m_options.optPreGen )
+      return RunPreGen( *m_options.optPreGen );
+
    std::println( "ServerApp::Run not yet implemented." );
+   return 0;
+}
+
+
+int ServerApp::RunPreGen( const PreGenOptions& options )
+{
+   // Level resolves the world directory and seed exactly as a later play session will, and saves the meta
+   Level level( m_options.worldName );
+
+   // Ctrl+C stops the workers after their current chunk; everything already written stays valid
+   s_fInterrupted = 0;
+   auto prevHandler = std::signal( SIGINT, []( int ) { s_fInterrupted = 1; } );
+
+   std::stop_source stopSource;
+   std::jthread     interruptWatcher( [ &stopSource ]( std::stop_token stopToken )
+   {
+      while( !stopToken.stop_requested() && !s_fInterrupted )
+         std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+
+      if( s_fInterrupted )
+         stopSource.request_stop();
+   } );
+
+   WorldPreGenerator preGenerator( level, options );
+   const bool        fOk = preGenerator.Run( stopSource.get_token() );
+
+   interruptWatcher.request_stop();
+   interruptWatcher.join();
+   std::signal( SIGINT, prevHandler );
+
+   return fOk ? 0 : 1;
 }
 
 } // namespace Server
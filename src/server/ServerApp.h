@@ -1,12 +1,30 @@
 #pragma once
 
+#include <Server/WorldPreGenerator.h>
+
 namespace Server
 {
 
+struct ServerOptions
+{
+   std::string                    worldName { "world" };
+   std::optional< PreGenOptions > optPreGen; // pre-generate the world and exit instead of serving it
+
+   // Parses command-line arguments (without the program name). Prints usage and returns nullopt on error.
+   static std::optional< ServerOptions > Parse( std::span< char* const > args );
+};
+
 class ServerApp
 {
 public:
-   void Run();
+   explicit ServerApp( ServerOptions options );
+
+   int Run();
+
+private:
+   int RunPreGen( const PreGenOptions& options );
+
+   ServerOptions m_options;
 };
 
 } // namespace Server
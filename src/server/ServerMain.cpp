@@ -2,18 +2,20 @@
 
 #include <Server/ServerApp.h>
 
-int main( int /*argc*/, char* /*argv*/[] )
+int main( int argc, char* argv[] )
 {
    try
    {
-      Server::ServerApp app;
-      app.Run();
+      const std::optional< Server::ServerOptions > optOptions = Server::ServerOptions::Parse( std::span< char* const >( argv + 1, argc > 1 ? argc - 1 : 0 ) );
+      if( !optOptions )
+         return 1;
+
+      Server::ServerApp app( *optOptions );
+      return app.Run();
    }
    catch( const std::exception& e )
    {
       std::println( std::cerr, "Server terminated unexpectedly: {}", e.what() );
       return -1;
    }
-
-   return 0;
 }
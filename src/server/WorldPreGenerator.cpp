@@ -0,0 +1,118 @@
+#include "pch_server.h"
+
+#include "WorldPreGenerator.h"
+
+#include <Engine/World/Level.h>
+
+namespace Server
+{
+
+// ----------------------------------------------------------------
+// WorldPreGenerator
+// ----------------------------------------------------------------
+WorldPreGenerator::WorldPreGenerator( const Level& level, const PreGenOptions& options ) :
+   m_level( level ),
+   m_options( options ),
+   m_total( static_cast< uint64_t >( 2 * options.radius + 1 ) * static_cast< uint64_t >( 2 * options.radius + 1 ) )
+{}
+
+
+bool WorldPreGenerator::Run( std::stop_token stopToken )
+{
+   const unsigned threadCount = m_options.threadCount ? m_options.threadCount : ( std::max )( 1u, std::thread::hardware_concurrency() );
+   std::println( "Pre-generating {} chunks (radius {}) around chunk ({}, {}) on {} threads",
+                 m_total,
+                 m_options.radius,
+                 m_options.centerX,
+                 m_options.centerZ,
+                 threadCount );
+
+   m_start = std::chrono::steady_clock::now();
+   {
+      std::vector< std::jthread > workers;
+      for( unsigned i = 0; i < threadCount; ++i )
+         workers.emplace_back( [ this, stopToken ]() { WorkerLoop( stopToken ); } );
+
+      // Report from the calling thread until the workers run out of chunks
+      while( m_next.load( std::memory_order_relaxed ) < m_total && !stopToken.stop_requested() )
+      {
+         std::this_thread::sleep_for( std::chrono::seconds( 1 ) );
+         ReportProgress( false /*fFinal*/ );
+      }
+   } // join
+
+   ReportProgress( true /*fFinal*/ );
+   if( stopToken.stop_requested() && m_generated + m_skipped + m_failed < m_total )
+      std::println( "Pre-generation interrupted; run it again to resume" );
+
+   return m_failed == 0;
+}
+
+
+void WorldPreGenerator::WorkerLoop( std::stop_token stopToken )
+{
+   for( uint64_t i = m_next++; i < m_total && !stopToken.stop_requested(); i = m_next++ )
+   {
+      const auto [ dx, dz ] = RingOffset( i );
+      switch( m_level.PreGenerateChunk( ChunkPos { m_options.centerX + dx, m_options.centerZ + dz } ) )
+      {
+         case Level::PreGenResult::Generated:    ++m_generated; break;
+         case Level::PreGenResult::AlreadySaved: ++m_skipped; break;
+         case Level::PreGenResult::Failed:       ++m_failed; break;
+      }
+   }
+}
+
+
+void WorldPreGenerator::ReportProgress( bool fFinal ) const
+{
+   const uint64_t generated = m_generated;
+   const uint64_t done      = generated + m_skipped + m_failed;
+   const double   seconds   = std::chrono::duration< double >( std::chrono::steady_clock::now() - m_start ).count();
+
+   // Rate counts generated chunks only; skipped ones cost a file check and would inflate it on resume
+   const double rate = seconds > 0.0 ? static_cast< double >( generated ) / seconds : 0.0;
+   const double pct  = m_total ? 100.0 * static_cast< double >( done ) / static_cast< double >( m_total ) : 100.0;
+   if( fFinal )
+   {
+      std::println( "Pre-generation finished {}/{} chunks in {:.1f}s ({} generated, {} already saved, {} failed, {:.1f} chunks/s)",
+                    done,
+                    m_total,
+                    seconds,
+                    generated,
+                    m_skipped.load(),
+                    m_failed.load(),
+                    rate );
+      return;
+   }
+
+   const uint64_t eta = rate > 0.0 ? static_cast< uint64_t >( static_cast< double >( m_total - done ) / rate ) : 0;
+   std::println( "  {}/{} ({:.1f}%)  {:.1f} chunks/s  ETA {}:{:02}:{:02}", done, m_total, pct, rate, eta / 3600, ( eta / 60 ) % 60, eta % 60 );
+}
+
+
+/*static*/ std::pair< int, int > WorldPreGenerator::RingOffset( uint64_t index ) noexcept
+{
+   if( index == 0 )
+      return { 0, 0 };
+
+   // Ring r covers indices [(2r-1)^2, (2r+1)^2)
+   int64_t r = static_cast< int64_t >( ( std::sqrt( static_cast< double >( index ) ) + 1.0 ) / 2.0 );
+   while( r > 1 && static_cast< uint64_t >( ( 2 * r - 1 ) * ( 2 * r - 1 ) ) > index )
+      --r;
+   while( static_cast< uint64_t >( ( 2 * r + 1 ) * ( 2 * r + 1 ) ) <= index )
+      ++r;
+
+   const int64_t k    = static_cast< int64_t >( index ) - ( 2 * r - 1 ) * ( 2 * r - 1 ); // [0, 8r)
+   const int64_t side = k / ( 2 * r );
+   const int64_t t    = k % ( 2 * r );
+   switch( side )
+   {
+      case 0:  return { static_cast< int >( r ), static_cast< int >( -r + 1 + t ) };
+      case 1:  return { static_cast< int >( r - 1 - t ), static_cast< int >( r ) };
+      case 2:  return { static_cast< int >( -r ), static_cast< int >( r - 1 - t ) };
+      default: return { static_cast< int >( -r + 1 + t ), static_cast< int >( -r ) };
+   }
+}
+
+} // namespace Server
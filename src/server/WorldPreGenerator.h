@@ -0,0 +1,51 @@
+#pragma once
+
+class Level;
+
+namespace Server
+{
+
+struct PreGenOptions
+{
+   int      radius { 0 };      // chunks around the center, square
+   int      centerX { 0 };     // chunk coordinates
+   int      centerZ { 0 };
+   unsigned threadCount { 0 }; // 0 = one per hardware thread
+};
+
+// ----------------------------------------------------------------
+// WorldPreGenerator - generates and saves every chunk in a radius ahead of play
+// ----------------------------------------------------------------
+// Chunks are visited in rings outward from the center, so an interrupted run still leaves a solid
+// area around spawn. Positions are computed from a shared counter rather than listed up front, and
+// each worker holds a single chunk at a time, so memory does not grow with the radius. Chunks that
+// already have a file are skipped, which is what makes a rerun resume where the last one stopped.
+class WorldPreGenerator
+{
+public:
+   WorldPreGenerator( const Level& level, const PreGenOptions& options );
+
+   // Blocks until every chunk is done or `stopToken` is signalled. Returns false if any chunk failed to save.
+   bool Run( std::stop_token stopToken );
+
+private:
+   NO_COPY_MOVE( WorldPreGenerator )
+
+   void WorkerLoop( std::stop_token stopToken );
+   void ReportProgress( bool fFinal ) const;
+
+   // Position of the `index`th chunk in ring order: the center, then each ring of 8r chunks at distance r
+   static std::pair< int, int > RingOffset( uint64_t index ) noexcept;
+
+   const Level&        m_level;
+   const PreGenOptions m_options;
+   const uint64_t      m_total;
+
+   std::chrono::steady_clock::time_point m_start;
+   std::atomic< uint64_t >               m_next { 0 };
+   std::atomic< uint64_t >               m_generated { 0 };
+   std::atomic< uint64_t >               m_skipped { 0 };
+   std::atomic< uint64_t >               m_failed { 0 };
+};
+
+} // namespace Server
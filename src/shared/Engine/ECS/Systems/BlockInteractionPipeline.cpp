@@ -153,6 +153,21 @@ void BlockHitSystem::FixedTick( FixedTickContext& ctx )
    }
 }
 
+// Drops of one block share a mesh, so the renderer draws them as instances of a single batch
+static std::shared_ptr< BlockItemMesh > GetItemDropMesh( BlockId id )
+{
+   static std::array< std::weak_ptr< BlockItemMesh >, static_cast< size_t >( BlockId::Count ) > s_meshes;
+
+   std::weak_ptr< BlockItemMesh >&  slot   = s_meshes[ static_cast< size_t >( id ) ];
+   std::shared_ptr< BlockItemMesh > psMesh = slot.lock();
+   if( !psMesh )
+   {
+      psMesh = std::make_shared< BlockItemMesh >( id );
+      slot   = psMesh;
+   }
+   return psMesh;
+}
+
 static void SpawnItemDrop( Entity::Registry& registry, const glm::ivec3& pos, BlockId id )
 {
    auto randomFloatFn = [ & ]( float min, float max ) -> float
@@ -166,7 +181,7 @@ static void SpawnItemDrop( Entity::Registry& registry, const glm::ivec3& pos, Bl
    registry.Add< CTransform >( drop, glm::vec3( pos ) + 0.5f );
    registry.Add< CItemDrop >( drop, CItemDrop { .blockId = id } );
    registry.Add< CPhysics >( drop, CPhysics { .bbMin = glm::vec3( -0.125f ), .bbMax = glm::vec3( 0.125f ) } );
-   registry.Add< CMesh >( drop, std::make_shared< BlockItemMesh >( id ) );
+   registry.Add< CMesh >( drop, GetItemDropMesh( id ) );
 
    // Randomized "shoot out" velocity
    float     angle  = randomFloatFn( 0.0f, 2.0f * glm::pi< float >() );
@@ -1,5 +1,8 @@
 #include "RenderContext.h"
 
+// Project dependencies
+#include <Engine/Renderer/RenderDevice.h>
+
 
 // ----------------------------------------------------------------
 // RenderContext
@@ -57,9 +60,22 @@ void RenderContext::SetVSync( bool fState )
 }
 
 
+void RenderContext::MakeCurrent()
+{
+   glfwMakeContextCurrent( &m_window );
+}
+
+
+void RenderContext::ReleaseCurrent()
+{
+   glfwMakeContextCurrent( nullptr );
+}
+
+
+// Through the device, so the change lands in order with the frame's other calls on whichever thread draws it
 void RenderContext::UpdateViewport( int x, int y, int width, int height )
 {
-   glViewport( x, y, width, height );
+   RenderDevice::Get().Viewport( x, y, width, height );
 }
 
 
@@ -12,6 +12,10 @@ public:
    void Present();
    void SetVSync( bool fState );
 
+   // The context is current on one thread at a time: release it on one before making it current on another
+   void MakeCurrent();
+   void ReleaseCurrent();
+
    void UpdateViewport( int x, int y, int width, int height );
 
 private:
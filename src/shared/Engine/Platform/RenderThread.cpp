@@ -0,0 +1,142 @@
+#include "RenderThread.h"
+
+// Local dependencies
+#include "RenderContext.h"
+
+// Project dependencies
+#include <Engine/Renderer/NullRenderDevice.h>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+float Milliseconds( Clock::duration duration ) noexcept
+{
+   return std::chrono::duration< float, std::milli >( duration ).count();
+}
+
+
+// Exponential moving average, about the last twenty samples
+void Average( float& average, float sample ) noexcept
+{
+   constexpr float WEIGHT = 0.05f;
+   average += ( sample - average ) * WEIGHT;
+}
+
+} // namespace
+
+
+// ----------------------------------------------------------------
+// RenderThread
+// ----------------------------------------------------------------
+RenderThread::RenderThread( RenderContext& context ) :
+   m_context( context ),
+   m_device( RenderDevice::GetOpenGL().GetViewport() ),
+   m_player( RenderDevice::GetOpenGL() )
+{
+   m_device.SetPacket( m_frames[ m_recording ].packet );
+   RenderDevice::Set( &m_device );
+
+   m_context.ReleaseCurrent();
+   m_thread = std::thread( [ this ] { Run(); } );
+}
+
+
+RenderThread::~RenderThread()
+{
+   // Whatever was recorded since the last frame, releases mostly, still has to reach the GPU
+   SubmitFrame( false );
+   {
+      std::lock_guard lock( m_mutex );
+      m_fStopping = true;
+   }
+   m_cv.notify_all();
+   m_thread.join();
+
+   m_context.MakeCurrent();
+
+   // Objects that outlive the window (the registry's meshes, say) were created here, so their ids mean nothing to
+   // OpenGL; their releases are dropped
+   static NullRenderDevice s_released;
+   RenderDevice::Set( &s_released );
+}
+
+
+void RenderThread::SubmitFrame( bool fPresent )
+{
+   const Clock::time_point start = Clock::now();
+
+   Frame& frame   = m_frames[ m_recording ];
+   frame.fPresent = fPresent;
+   {
+      std::unique_lock lock( m_mutex );
+      const float      inFlight = static_cast< float >( ( m_pSubmitted ? 1 : 0 ) + ( m_pPlaying ? 1 : 0 ) );
+
+      // The other frame is ours to record into once the render thread is done with it
+      m_cv.wait( lock, [ this ] { return !m_pSubmitted && !m_pPlaying; } );
+
+      frame.submitTime = Clock::now();
+      m_pSubmitted     = &frame;
+
+      Average( m_stats.waitMs, Milliseconds( frame.submitTime - start ) );
+      Average( m_stats.queueDepth, inFlight );
+      m_stats.packetBytes    = frame.packet.stream.size();
+      m_stats.packetCommands = frame.packet.commands;
+   }
+   m_cv.notify_all();
+
+   m_recording ^= 1;
+   Frame& next = m_frames[ m_recording ];
+   next.packet.Clear();
+   next.ui.Clear();
+   m_device.SetPacket( next.packet );
+}
+
+
+RenderThreadStats RenderThread::GetStats() const
+{
+   std::lock_guard lock( m_mutex );
+   return m_stats;
+}
+
+
+void RenderThread::Run()
+{
+   m_context.MakeCurrent();
+
+   std::unique_lock lock( m_mutex );
+   while( true )
+   {
+      m_cv.wait( lock, [ this ] { return m_pSubmitted || m_fStopping; } );
+      if( !m_pSubmitted )
+         break;
+
+      Frame& frame = *std::exchange( m_pSubmitted, nullptr );
+      m_pPlaying   = &frame;
+
+      const Clock::time_point start = Clock::now();
+      Average( m_stats.handoffMs, Milliseconds( start - frame.submitTime ) );
+      lock.unlock();
+
+      m_player.Play( frame.packet );
+      frame.ui.Render();
+
+      if( const int swapInterval = m_pendingSwapInterval.exchange( -1 ); swapInterval >= 0 )
+         m_context.SetVSync( swapInterval != 0 );
+
+      // Measured before the swap, which waits for vsync
+      const float playMs = Milliseconds( Clock::now() - start );
+      if( frame.fPresent )
+         m_context.Present();
+
+      lock.lock();
+      m_pPlaying = nullptr;
+      Average( m_stats.playMs, playMs );
+      ++m_stats.frames;
+      m_cv.notify_all();
+   }
+
+   lock.unlock();
+   m_context.ReleaseCurrent();
+}
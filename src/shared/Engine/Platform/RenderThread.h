@@ -0,0 +1,72 @@
+#pragma once
+
+// Project dependencies
+#include <Engine/Renderer/DeferredRenderDevice.h>
+#include <Engine/UI/UI.h>
+
+// Forward Declarations
+class RenderContext;
+
+// Timings are moving averages over recent frames
+struct RenderThreadStats
+{
+   uint64_t frames { 0 };
+   float    handoffMs { 0.0f };  // from a frame's submit until the render thread starts on it
+   float    playMs { 0.0f };     // playing the packet and drawing the UI, up to the buffer swap
+   float    waitMs { 0.0f };     // the main thread blocked in SubmitFrame, waiting for the render thread
+   float    queueDepth { 0.0f }; // frames still in flight at each submit: near 0 the main thread sets the pace, near 1 the render thread does
+   size_t   packetBytes { 0 };   // of the last frame submitted
+   size_t   packetCommands { 0 };
+};
+
+// ----------------------------------------------------------------
+// RenderThread - owns the GL context and draws the frames the main thread records
+// ----------------------------------------------------------------
+// While it runs, the current RenderDevice records into one of two frames. SubmitFrame seals that frame, holding the
+// packet and the UI's draw lists, and hands it over; the render thread plays it, draws the UI and swaps buffers
+// while the main thread simulates and records the next one. Submitting waits only while the render thread is still
+// on the previous frame, so at most one frame is in flight.
+class RenderThread
+{
+public:
+   // Takes the context from the calling thread, which must hold it
+   explicit RenderThread( RenderContext& context );
+   ~RenderThread(); // draws what was recorded since the last frame, then hands the context back
+
+   // The UI's draw lists for the frame being recorded
+   UI::DrawDataSnapshot& GetFrameUI() noexcept { return m_frames[ m_recording ].ui; }
+
+   void SubmitFrame( bool fPresent = true );
+   void SetVSync( bool fState ) noexcept { m_pendingSwapInterval = fState ? 1 : 0; }
+
+   RenderThreadStats GetStats() const;
+
+private:
+   NO_COPY_MOVE( RenderThread )
+
+   struct Frame
+   {
+      RenderPacket                          packet;
+      UI::DrawDataSnapshot                  ui;
+      bool                                  fPresent { true };
+      std::chrono::steady_clock::time_point submitTime;
+   };
+
+   void Run();
+
+   RenderContext&         m_context;
+   DeferredRenderDevice   m_device; // current on the main thread while this runs
+   RenderPacketPlayer     m_player; // render thread only
+   std::array< Frame, 2 > m_frames;
+   size_t                 m_recording { 0 }; // main thread only
+
+   mutable std::mutex      m_mutex;
+   std::condition_variable m_cv;
+   Frame*                  m_pSubmitted { nullptr }; // handed over, not yet picked up
+   Frame*                  m_pPlaying { nullptr };
+   bool                    m_fStopping { false };
+   RenderThreadStats       m_stats;
+   std::atomic< int >      m_pendingSwapInterval { -1 };
+
+   std::thread m_thread; // started last, once everything it uses exists
+};
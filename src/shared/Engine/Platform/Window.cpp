@@ -2,12 +2,14 @@
 
 // Local dependencies
 #include "RenderContext.h"
+#include "RenderThread.h"
 
 // Project dependencies
 #include <Engine/Events/ApplicationEvent.h>
 #include <Engine/Events/KeyEvent.h>
 #include <Engine/Events/MouseEvent.h>
 #include <Engine/Input/Input.h>
+#include <Engine/Renderer/RenderDevice.h>
 
 
 // --------------------------------------------------------------------
@@ -20,7 +22,8 @@ Window::Window( std::string_view title ) noexcept :
 
 Window::~Window()
 {
-   m_ui.Shutdown(); // UI context depends on GLFW window and GL context, so shut it down first
+   m_pRenderThread.reset(); // finishes the last frame and hands the GL context back to this thread
+   m_ui.Shutdown();         // UI context depends on GLFW window and GL context, so shut it down first
    m_pRenderContext.reset();
 
    glfwDestroyWindow( m_pWindow );
@@ -68,6 +71,9 @@ void Window::Init()
    m_pRenderContext->Init( m_state.fVSync );
 
    m_ui.Init( m_pWindow );
+
+   // From here on this thread records frames and the render thread draws them
+   m_pRenderThread = std::make_unique< RenderThread >( *m_pRenderContext );
 }
 
 
@@ -115,11 +121,9 @@ bool Window::FBeginFrame()
 
 void Window::EndFrame()
 {
-   // UI renders just before present.
-   m_ui.EndFrame();
-
-   if( m_pRenderContext )
-      m_pRenderContext->Present();
+   // UI renders just before present, both on the render thread
+   m_ui.EndFrame( m_pRenderThread->GetFrameUI() );
+   m_pRenderThread->SubmitFrame();
 }
 
 
@@ -129,8 +133,14 @@ void Window::SetVSync( bool fState )
       return;
 
    m_state.fVSync = fState;
-   if( m_pRenderContext )
-      m_pRenderContext->SetVSync( fState );
+   if( m_pRenderThread )
+      m_pRenderThread->SetVSync( fState );
+}
+
+
+RenderThreadStats Window::GetRenderStats() const
+{
+   return m_pRenderThread ? m_pRenderThread->GetStats() : RenderThreadStats {};
 }
 
 
@@ -153,7 +163,7 @@ void Window::SetCallbacks()
          {
             static int polygonModeFlip = GL_FILL;
             polygonModeFlip            = ( polygonModeFlip == GL_FILL ) ? GL_LINE : GL_FILL;
-            glPolygonMode( GL_FRONT_AND_BACK, polygonModeFlip );
+            RenderDevice::Get().PolygonMode( GL_FRONT_AND_BACK, polygonModeFlip );
             break;
          }
 
@@ -6,6 +6,8 @@
 // Forward Declarations
 struct GLFWwindow;
 class RenderContext;
+class RenderThread;
+struct RenderThreadStats;
 
 namespace Events { class EventSubscriber; }
 
@@ -50,6 +52,8 @@ public:
    bool FMinimized() const noexcept { return m_state.fMinimized; }
    void SetVSync( bool fState );
 
+   RenderThreadStats GetRenderStats() const;
+
 private:
    Window( std::string_view title ) noexcept; // private ctor for singleton
    ~Window();
@@ -63,6 +67,7 @@ private:
 
    UI::UIContext                    m_ui { *this };
    std::unique_ptr< RenderContext > m_pRenderContext;
+   std::unique_ptr< RenderThread >  m_pRenderThread; // draws and presents frames once Init is done
 
    // Events
    std::unique_ptr< Events::EventSubscriber > m_pEventSubscriber;
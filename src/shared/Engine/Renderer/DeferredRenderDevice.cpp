@@ -0,0 +1,896 @@
+#include "DeferredRenderDevice.h"
+
+namespace
+{
+
+// One per RenderDevice call, plus the two name lookups that stand in for GetUniformLocation/GetUniformBlockIndex
+enum class Op : uint8_t
+{
+   CreateBuffer,
+   DeleteBuffer,
+   BindBuffer,
+   BindBufferBase,
+   BufferData,
+   BufferSubData,
+   CopyBufferSubData,
+   CreateVertexArray,
+   DeleteVertexArray,
+   BindVertexArray,
+   EnableVertexAttribArray,
+   DisableVertexAttribArray,
+   VertexAttribPointer,
+   VertexAttribDivisor,
+   CreateTexture,
+   DeleteTexture,
+   ActiveTexture,
+   BindTexture,
+   TexImage2D,
+   TexImage3D,
+   TexSubImage3D,
+   TexParameteri,
+   GenerateMipmap,
+   CreateProgram,
+   DeleteProgram,
+   UseProgram,
+   ResolveUniform,
+   ResolveUniformBlock,
+   UniformBlockBinding,
+   Uniform1i,
+   Uniform1ui,
+   Uniform1f,
+   Uniform2f,
+   Uniform3f,
+   Uniform4f,
+   UniformMatrix3fv,
+   UniformMatrix4fv,
+   DrawArrays,
+   DrawElements,
+   DrawElementsInstanced,
+   MultiDrawElementsIndirect,
+   Clear,
+   Enable,
+   Disable,
+   DepthFunc,
+   DepthMask,
+   PolygonMode,
+   Viewport,
+};
+
+void PutBytes( RenderPacket& packet, const void* pData, size_t size )
+{
+   const std::byte* pBytes = static_cast< const std::byte* >( pData );
+   packet.stream.insert( packet.stream.end(), pBytes, pBytes + size );
+}
+
+
+template< typename T >
+void Put( RenderPacket& packet, const T& value )
+{
+   static_assert( std::is_trivially_copyable_v< T > );
+   PutBytes( packet, &value, sizeof( T ) );
+}
+
+
+// Client memory a call may be given none of: a flag, then the bytes if there are any
+void PutData( RenderPacket& packet, const void* pData, size_t size )
+{
+   Put< uint8_t >( packet, pData != nullptr );
+   if( pData )
+      PutBytes( packet, pData, size );
+}
+
+
+// Its length, then the characters with a terminator so they play back as a C string
+void PutString( RenderPacket& packet, std::string_view text )
+{
+   Put( packet, static_cast< uint32_t >( text.size() + 1 ) );
+   PutBytes( packet, text.data(), text.size() );
+   Put( packet, '\0' );
+}
+
+
+template< typename... Args >
+void Record( RenderPacket& packet, Op op, const Args&... args )
+{
+   Put( packet, op );
+   ( Put( packet, args ), ... );
+   ++packet.commands;
+}
+
+
+// Reads back what Record and the Put functions wrote, in the same order and types
+class PacketReader
+{
+public:
+   explicit PacketReader( std::span< const std::byte > stream ) noexcept :
+      m_stream( stream )
+   {}
+
+   bool FDone() const noexcept { return m_at >= m_stream.size(); }
+
+   template< typename T >
+   T Read() noexcept
+   {
+      T value;
+      std::memcpy( &value, m_stream.data() + m_at, sizeof( T ) );
+      m_at += sizeof( T );
+      return value;
+   }
+
+   const void* ReadData( size_t size ) noexcept
+   {
+      if( !Read< uint8_t >() )
+         return nullptr;
+
+      const std::byte* pData = m_stream.data() + m_at;
+      m_at += size;
+      return pData;
+   }
+
+   const char* ReadString() noexcept
+   {
+      const uint32_t size  = Read< uint32_t >();
+      const char*    pText = reinterpret_cast< const char* >( m_stream.data() + m_at );
+      m_at += size;
+      return pText;
+   }
+
+private:
+   std::span< const std::byte > m_stream;
+   size_t                       m_at { 0 };
+};
+
+} // namespace
+
+
+// ----------------------------------------------------------------
+// DeferredRenderDevice
+// ----------------------------------------------------------------
+DeferredRenderDevice::DeferredRenderDevice( glm::ivec4 viewport ) noexcept :
+   m_viewport( viewport )
+{}
+
+
+GLuint DeferredRenderDevice::CreateObject()
+{
+   if( m_freeIds.empty() )
+      return m_nextId++;
+
+   const GLuint id = m_freeIds.back();
+   m_freeIds.pop_back();
+   return id;
+}
+
+
+// Ids are handed out again once freed; the player sees the delete before any reuse, since both are in order
+void DeferredRenderDevice::DeleteObject( GLuint id )
+{
+   if( id != 0 )
+      m_freeIds.push_back( id );
+}
+
+
+// Names are looked up once per program; the player resolves them against the real program when it gets there
+GLint DeferredRenderDevice::ResolveName( NameMap& names, GLuint program, const char* pName, bool fBlock )
+{
+   if( const auto it = names.find( std::string_view( pName ) ); it != names.end() )
+      return it->second;
+
+   const GLint name = m_nextName++;
+   names.emplace( pName, name );
+
+   Record( *m_pPacket, fBlock ? Op::ResolveUniformBlock : Op::ResolveUniform, program, name );
+   PutString( *m_pPacket, pName );
+   return name;
+}
+
+
+// Buffers
+GLuint DeferredRenderDevice::CreateBuffer()
+{
+   const GLuint buffer = CreateObject();
+   Record( *m_pPacket, Op::CreateBuffer, buffer );
+   return buffer;
+}
+
+
+void DeferredRenderDevice::DeleteBuffer( GLuint buffer )
+{
+   Record( *m_pPacket, Op::DeleteBuffer, buffer );
+   DeleteObject( buffer );
+}
+
+
+void DeferredRenderDevice::BindBuffer( GLenum target, GLuint buffer )
+{
+   Record( *m_pPacket, Op::BindBuffer, target, buffer );
+}
+
+
+void DeferredRenderDevice::BindBufferBase( GLenum target, GLuint index, GLuint buffer )
+{
+   Record( *m_pPacket, Op::BindBufferBase, target, index, buffer );
+}
+
+
+void DeferredRenderDevice::BufferData( GLenum target, GLsizeiptr size, const void* pData, GLenum usage )
+{
+   Record( *m_pPacket, Op::BufferData, target, size, usage );
+   PutData( *m_pPacket, pData, static_cast< size_t >( size ) );
+}
+
+
+void DeferredRenderDevice::BufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const void* pData )
+{
+   Record( *m_pPacket, Op::BufferSubData, target, offset, size );
+   PutData( *m_pPacket, pData, static_cast< size_t >( size ) );
+}
+
+
+void DeferredRenderDevice::CopyBufferSubData( GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size )
+{
+   Record( *m_pPacket, Op::CopyBufferSubData, readTarget, writeTarget, readOffset, writeOffset, size );
+}
+
+
+// Vertex arrays
+GLuint DeferredRenderDevice::CreateVertexArray()
+{
+   const GLuint vertexArray = CreateObject();
+   Record( *m_pPacket, Op::CreateVertexArray, vertexArray );
+   return vertexArray;
+}
+
+
+void DeferredRenderDevice::DeleteVertexArray( GLuint vertexArray )
+{
+   Record( *m_pPacket, Op::DeleteVertexArray, vertexArray );
+   DeleteObject( vertexArray );
+}
+
+
+void DeferredRenderDevice::BindVertexArray( GLuint vertexArray )
+{
+   Record( *m_pPacket, Op::BindVertexArray, vertexArray );
+}
+
+
+void DeferredRenderDevice::EnableVertexAttribArray( GLuint index )
+{
+   Record( *m_pPacket, Op::EnableVertexAttribArray, index );
+}
+
+
+void DeferredRenderDevice::DisableVertexAttribArray( GLuint index )
+{
+   Record( *m_pPacket, Op::DisableVertexAttribArray, index );
+}
+
+
+void DeferredRenderDevice::VertexAttribPointer( GLuint index, GLint size, GLenum type, GLboolean fNormalized, GLsizei stride, size_t offset )
+{
+   Record( *m_pPacket, Op::VertexAttribPointer, index, size, type, fNormalized, stride, offset );
+}
+
+
+void DeferredRenderDevice::VertexAttribDivisor( GLuint index, GLuint divisor )
+{
+   Record( *m_pPacket, Op::VertexAttribDivisor, index, divisor );
+}
+
+
+// Textures
+GLuint DeferredRenderDevice::CreateTexture()
+{
+   const GLuint texture = CreateObject();
+   Record( *m_pPacket, Op::CreateTexture, texture );
+   return texture;
+}
+
+
+void DeferredRenderDevice::DeleteTexture( GLuint texture )
+{
+   Record( *m_pPacket, Op::DeleteTexture, texture );
+   DeleteObject( texture );
+}
+
+
+void DeferredRenderDevice::ActiveTexture( GLenum unit )
+{
+   Record( *m_pPacket, Op::ActiveTexture, unit );
+}
+
+
+void DeferredRenderDevice::BindTexture( GLenum target, GLuint texture )
+{
+   Record( *m_pPacket, Op::BindTexture, target, texture );
+}
+
+
+void DeferredRenderDevice::TexImage2D( GLenum target, GLenum internalFormat, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pPixels )
+{
+   Record( *m_pPacket, Op::TexImage2D, target, internalFormat, width, height, format, type );
+   PutData( *m_pPacket, pPixels, static_cast< size_t >( width ) * height * TexelSize( format, type ) );
+}
+
+
+void DeferredRenderDevice::TexImage3D( GLenum target, GLenum internalFormat, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels )
+{
+   Record( *m_pPacket, Op::TexImage3D, target, internalFormat, width, height, depth, format, type );
+   PutData( *m_pPacket, pPixels, static_cast< size_t >( width ) * height * depth * TexelSize( format, type ) );
+}
+
+
+void DeferredRenderDevice::TexSubImage3D( GLenum target, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels )
+{
+   Record( *m_pPacket, Op::TexSubImage3D, target, x, y, z, width, height, depth, format, type );
+   PutData( *m_pPacket, pPixels, static_cast< size_t >( width ) * height * depth * TexelSize( format, type ) );
+}
+
+
+void DeferredRenderDevice::TexParameteri( GLenum target, GLenum name, GLint value )
+{
+   Record( *m_pPacket, Op::TexParameteri, target, name, value );
+}
+
+
+void DeferredRenderDevice::GenerateMipmap( GLenum target )
+{
+   Record( *m_pPacket, Op::GenerateMipmap, target );
+}
+
+
+// Programs
+GLuint DeferredRenderDevice::CreateProgram( std::string_view vertexSource, std::string_view fragmentSource )
+{
+   const GLuint program = CreateObject();
+   Record( *m_pPacket, Op::CreateProgram, program );
+   PutString( *m_pPacket, vertexSource );
+   PutString( *m_pPacket, fragmentSource );
+   return program;
+}
+
+
+void DeferredRenderDevice::DeleteProgram( GLuint program )
+{
+   Record( *m_pPacket, Op::DeleteProgram, program );
+   DeleteObject( program );
+   m_uniforms.erase( program );
+   m_uniformBlocks.erase( program );
+}
+
+
+void DeferredRenderDevice::UseProgram( GLuint program )
+{
+   Record( *m_pPacket, Op::UseProgram, program );
+}
+
+
+GLint DeferredRenderDevice::GetUniformLocation( GLuint program, const char* pName )
+{
+   return ResolveName( m_uniforms[ program ], program, pName, false );
+}
+
+
+GLuint DeferredRenderDevice::GetUniformBlockIndex( GLuint program, const char* pName )
+{
+   return static_cast< GLuint >( ResolveName( m_uniformBlocks[ program ], program, pName, true ) );
+}
+
+
+void DeferredRenderDevice::UniformBlockBinding( GLuint program, GLuint blockIndex, GLuint binding )
+{
+   Record( *m_pPacket, Op::UniformBlockBinding, program, blockIndex, binding );
+}
+
+
+// Uniforms
+void DeferredRenderDevice::Uniform1i( GLint location, GLint value )
+{
+   Record( *m_pPacket, Op::Uniform1i, location, value );
+}
+
+
+void DeferredRenderDevice::Uniform1ui( GLint location, GLuint value )
+{
+   Record( *m_pPacket, Op::Uniform1ui, location, value );
+}
+
+
+void DeferredRenderDevice::Uniform1f( GLint location, GLfloat value )
+{
+   Record( *m_pPacket, Op::Uniform1f, location, value );
+}
+
+
+void DeferredRenderDevice::Uniform2f( GLint location, GLfloat x, GLfloat y )
+{
+   Record( *m_pPacket, Op::Uniform2f, location, x, y );
+}
+
+
+void DeferredRenderDevice::Uniform3f( GLint location, GLfloat x, GLfloat y, GLfloat z )
+{
+   Record( *m_pPacket, Op::Uniform3f, location, x, y, z );
+}
+
+
+void DeferredRenderDevice::Uniform4f( GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w )
+{
+   Record( *m_pPacket, Op::Uniform4f, location, x, y, z, w );
+}
+
+
+void DeferredRenderDevice::UniformMatrix3fv( GLint location, const GLfloat* pValue )
+{
+   Record( *m_pPacket, Op::UniformMatrix3fv, location );
+   PutBytes( *m_pPacket, pValue, 9 * sizeof( GLfloat ) );
+}
+
+
+void DeferredRenderDevice::UniformMatrix4fv( GLint location, const GLfloat* pValue )
+{
+   Record( *m_pPacket, Op::UniformMatrix4fv, location );
+   PutBytes( *m_pPacket, pValue, 16 * sizeof( GLfloat ) );
+}
+
+
+// Draws
+void DeferredRenderDevice::DrawArrays( GLenum mode, GLint first, GLsizei count )
+{
+   Record( *m_pPacket, Op::DrawArrays, mode, first, count );
+}
+
+
+void DeferredRenderDevice::DrawElements( GLenum mode, GLsizei count, GLenum type, size_t offset )
+{
+   Record( *m_pPacket, Op::DrawElements, mode, count, type, offset );
+}
+
+
+void DeferredRenderDevice::DrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, size_t offset, GLsizei instances )
+{
+   Record( *m_pPacket, Op::DrawElementsInstanced, mode, count, type, offset, instances );
+}
+
+
+void DeferredRenderDevice::MultiDrawElementsIndirect( GLenum mode, GLenum type, size_t offset, GLsizei drawCount, GLsizei stride )
+{
+   Record( *m_pPacket, Op::MultiDrawElementsIndirect, mode, type, offset, drawCount, stride );
+}
+
+
+// Fixed-function state
+void DeferredRenderDevice::Clear( GLbitfield mask )
+{
+   Record( *m_pPacket, Op::Clear, mask );
+}
+
+
+void DeferredRenderDevice::Enable( GLenum capability )
+{
+   Record( *m_pPacket, Op::Enable, capability );
+}
+
+
+void DeferredRenderDevice::Disable( GLenum capability )
+{
+   Record( *m_pPacket, Op::Disable, capability );
+}
+
+
+void DeferredRenderDevice::DepthFunc( GLenum func )
+{
+   Record( *m_pPacket, Op::DepthFunc, func );
+}
+
+
+void DeferredRenderDevice::DepthMask( GLboolean fWrite )
+{
+   Record( *m_pPacket, Op::DepthMask, fWrite );
+}
+
+
+void DeferredRenderDevice::PolygonMode( GLenum face, GLenum mode )
+{
+   Record( *m_pPacket, Op::PolygonMode, face, mode );
+}
+
+
+void DeferredRenderDevice::Viewport( GLint x, GLint y, GLsizei width, GLsizei height )
+{
+   m_viewport = glm::ivec4( x, y, width, height );
+   Record( *m_pPacket, Op::Viewport, x, y, width, height );
+}
+
+
+// ----------------------------------------------------------------
+// RenderPacketPlayer
+// ----------------------------------------------------------------
+RenderPacketPlayer::RenderPacketPlayer( RenderDevice& device ) noexcept :
+   m_device( device )
+{}
+
+
+GLuint& RenderPacketPlayer::Object( GLuint id )
+{
+   if( id >= m_objects.size() )
+      m_objects.resize( id + 1, 0 );
+
+   return m_objects[ id ];
+}
+
+
+GLint& RenderPacketPlayer::Name( GLint name )
+{
+   const size_t index = static_cast< size_t >( name );
+   if( index >= m_names.size() )
+      m_names.resize( index + 1, -1 );
+
+   return m_names[ index ];
+}
+
+
+// -1 passes through, as it does in GL, where setting it is ignored
+GLint RenderPacketPlayer::Location( GLint name ) const noexcept
+{
+   return name >= 0 && static_cast< size_t >( name ) < m_names.size() ? m_names[ static_cast< size_t >( name ) ] : -1;
+}
+
+
+// Arguments are read into locals first: the order a call's arguments are evaluated in is unspecified
+void RenderPacketPlayer::Play( const RenderPacket& packet )
+{
+   PacketReader reader( packet.stream );
+   while( !reader.FDone() )
+   {
+      switch( reader.Read< Op >() )
+      {
+         // Buffers
+         case Op::CreateBuffer:
+         {
+            const GLuint buffer = reader.Read< GLuint >();
+            Object( buffer )    = m_device.CreateBuffer();
+            break;
+         }
+         case Op::DeleteBuffer:
+         {
+            const GLuint buffer = reader.Read< GLuint >();
+            m_device.DeleteBuffer( std::exchange( Object( buffer ), 0 ) );
+            break;
+         }
+         case Op::BindBuffer:
+         {
+            const GLenum target = reader.Read< GLenum >();
+            const GLuint buffer = reader.Read< GLuint >();
+            m_device.BindBuffer( target, Object( buffer ) );
+            break;
+         }
+         case Op::BindBufferBase:
+         {
+            const GLenum target = reader.Read< GLenum >();
+            const GLuint index  = reader.Read< GLuint >();
+            const GLuint buffer = reader.Read< GLuint >();
+            m_device.BindBufferBase( target, index, Object( buffer ) );
+            break;
+         }
+         case Op::BufferData:
+         {
+            const GLenum     target = reader.Read< GLenum >();
+            const GLsizeiptr size   = reader.Read< GLsizeiptr >();
+            const GLenum     usage  = reader.Read< GLenum >();
+            const void*      pData  = reader.ReadData( static_cast< size_t >( size ) );
+            m_device.BufferData( target, size, pData, usage );
+            break;
+         }
+         case Op::BufferSubData:
+         {
+            const GLenum     target = reader.Read< GLenum >();
+            const GLintptr   offset = reader.Read< GLintptr >();
+            const GLsizeiptr size   = reader.Read< GLsizeiptr >();
+            const void*      pData  = reader.ReadData( static_cast< size_t >( size ) );
+            m_device.BufferSubData( target, offset, size, pData );
+            break;
+         }
+         case Op::CopyBufferSubData:
+         {
+            const GLenum     readTarget  = reader.Read< GLenum >();
+            const GLenum     writeTarget = reader.Read< GLenum >();
+            const GLintptr   readOffset  = reader.Read< GLintptr >();
+            const GLintptr   writeOffset = reader.Read< GLintptr >();
+            const GLsizeiptr size        = reader.Read< GLsizeiptr >();
+            m_device.CopyBufferSubData( readTarget, writeTarget, readOffset, writeOffset, size );
+            break;
+         }
+
+         // Vertex arrays
+         case Op::CreateVertexArray:
+         {
+            const GLuint vertexArray = reader.Read< GLuint >();
+            Object( vertexArray )    = m_device.CreateVertexArray();
+            break;
+         }
+         case Op::DeleteVertexArray:
+         {
+            const GLuint vertexArray = reader.Read< GLuint >();
+            m_device.DeleteVertexArray( std::exchange( Object( vertexArray ), 0 ) );
+            break;
+         }
+         case Op::BindVertexArray:
+         {
+            const GLuint vertexArray = reader.Read< GLuint >();
+            m_device.BindVertexArray( Object( vertexArray ) );
+            break;
+         }
+         case Op::EnableVertexAttribArray:  m_device.EnableVertexAttribArray( reader.Read< GLuint >() ); break;
+         case Op::DisableVertexAttribArray: m_device.DisableVertexAttribArray( reader.Read< GLuint >() ); break;
+         case Op::VertexAttribPointer:
+         {
+            const GLuint    index       = reader.Read< GLuint >();
+            const GLint     size        = reader.Read< GLint >();
+            const GLenum    type        = reader.Read< GLenum >();
+            const GLboolean fNormalized = reader.Read< GLboolean >();
+            const GLsizei   stride      = reader.Read< GLsizei >();
+            const size_t    offset      = reader.Read< size_t >();
+            m_device.VertexAttribPointer( index, size, type, fNormalized, stride, offset );
+            break;
+         }
+         case Op::VertexAttribDivisor:
+         {
+            const GLuint index   = reader.Read< GLuint >();
+            const GLuint divisor = reader.Read< GLuint >();
+            m_device.VertexAttribDivisor( index, divisor );
+            break;
+         }
+
+         // Textures
+         case Op::CreateTexture:
+         {
+            const GLuint texture = reader.Read< GLuint >();
+            Object( texture )    = m_device.CreateTexture();
+            break;
+         }
+         case Op::DeleteTexture:
+         {
+            const GLuint texture = reader.Read< GLuint >();
+            m_device.DeleteTexture( std::exchange( Object( texture ), 0 ) );
+            break;
+         }
+         case Op::ActiveTexture: m_device.ActiveTexture( reader.Read< GLenum >() ); break;
+         case Op::BindTexture:
+         {
+            const GLenum target  = reader.Read< GLenum >();
+            const GLuint texture = reader.Read< GLuint >();
+            m_device.BindTexture( target, Object( texture ) );
+            break;
+         }
+         case Op::TexImage2D:
+         {
+            const GLenum  target         = reader.Read< GLenum >();
+            const GLenum  internalFormat = reader.Read< GLenum >();
+            const GLsizei width          = reader.Read< GLsizei >();
+            const GLsizei height         = reader.Read< GLsizei >();
+            const GLenum  format         = reader.Read< GLenum >();
+            const GLenum  type           = reader.Read< GLenum >();
+            const void*   pPixels        = reader.ReadData( static_cast< size_t >( width ) * height * RenderDevice::TexelSize( format, type ) );
+            m_device.TexImage2D( target, internalFormat, width, height, format, type, pPixels );
+            break;
+         }
+         case Op::TexImage3D:
+         {
+            const GLenum  target         = reader.Read< GLenum >();
+            const GLenum  internalFormat = reader.Read< GLenum >();
+            const GLsizei width          = reader.Read< GLsizei >();
+            const GLsizei height         = reader.Read< GLsizei >();
+            const GLsizei depth          = reader.Read< GLsizei >();
+            const GLenum  format         = reader.Read< GLenum >();
+            const GLenum  type           = reader.Read< GLenum >();
+            const void*   pPixels        = reader.ReadData( static_cast< size_t >( width ) * height * depth * RenderDevice::TexelSize( format, type ) );
+            m_device.TexImage3D( target, internalFormat, width, height, depth, format, type, pPixels );
+            break;
+         }
+         case Op::TexSubImage3D:
+         {
+            const GLenum  target  = reader.Read< GLenum >();
+            const GLint   x       = reader.Read< GLint >();
+            const GLint   y       = reader.Read< GLint >();
+            const GLint   z       = reader.Read< GLint >();
+            const GLsizei width   = reader.Read< GLsizei >();
+            const GLsizei height  = reader.Read< GLsizei >();
+            const GLsizei depth   = reader.Read< GLsizei >();
+            const GLenum  format  = reader.Read< GLenum >();
+            const GLenum  type    = reader.Read< GLenum >();
+            const void*   pPixels = reader.ReadData( static_cast< size_t >( width ) * height * depth * RenderDevice::TexelSize( format, type ) );
+            m_device.TexSubImage3D( target, x, y, z, width, height, depth, format, type, pPixels );
+            break;
+         }
+         case Op::TexParameteri:
+         {
+            const GLenum target = reader.Read< GLenum >();
+            const GLenum name   = reader.Read< GLenum >();
+            const GLint  value  = reader.Read< GLint >();
+            m_device.TexParameteri( target, name, value );
+            break;
+         }
+         case Op::GenerateMipmap: m_device.GenerateMipmap( reader.Read< GLenum >() ); break;
+
+         // Programs
+         case Op::CreateProgram:
+         {
+            const GLuint program         = reader.Read< GLuint >();
+            const char*  pVertexSource   = reader.ReadString();
+            const char*  pFragmentSource = reader.ReadString();
+            Object( program )            = m_device.CreateProgram( pVertexSource, pFragmentSource );
+            break;
+         }
+         case Op::DeleteProgram:
+         {
+            const GLuint program = reader.Read< GLuint >();
+            m_device.DeleteProgram( std::exchange( Object( program ), 0 ) );
+            break;
+         }
+         case Op::UseProgram:
+         {
+            const GLuint program = reader.Read< GLuint >();
+            m_device.UseProgram( Object( program ) );
+            break;
+         }
+         case Op::ResolveUniform:
+         {
+            const GLuint program = reader.Read< GLuint >();
+            const GLint  name    = reader.Read< GLint >();
+            const char*  pName   = reader.ReadString();
+            Name( name )         = m_device.GetUniformLocation( Object( program ), pName );
+            if( Name( name ) == -1 )
+               std::println( "Warning: uniform '{}' doesn't exist!", pName );
+            break;
+         }
+         case Op::ResolveUniformBlock:
+         {
+            const GLuint program = reader.Read< GLuint >();
+            const GLint  name    = reader.Read< GLint >();
+            const char*  pName   = reader.ReadString();
+            const GLuint index   = m_device.GetUniformBlockIndex( Object( program ), pName );
+            Name( name )         = index == GL_INVALID_INDEX ? -1 : static_cast< GLint >( index );
+            if( index == GL_INVALID_INDEX )
+               std::println( "Warning: uniform block '{}' doesn't exist!", pName );
+            break;
+         }
+         case Op::UniformBlockBinding:
+         {
+            const GLuint program    = reader.Read< GLuint >();
+            const GLuint blockIndex = reader.Read< GLuint >();
+            const GLuint binding    = reader.Read< GLuint >();
+            if( const GLint index = Location( static_cast< GLint >( blockIndex ) ); index != -1 )
+               m_device.UniformBlockBinding( Object( program ), static_cast< GLuint >( index ), binding );
+            break;
+         }
+
+         // Uniforms
+         case Op::Uniform1i:
+         {
+            const GLint location = reader.Read< GLint >();
+            const GLint value    = reader.Read< GLint >();
+            m_device.Uniform1i( Location( location ), value );
+            break;
+         }
+         case Op::Uniform1ui:
+         {
+            const GLint  location = reader.Read< GLint >();
+            const GLuint value    = reader.Read< GLuint >();
+            m_device.Uniform1ui( Location( location ), value );
+            break;
+         }
+         case Op::Uniform1f:
+         {
+            const GLint   location = reader.Read< GLint >();
+            const GLfloat value    = reader.Read< GLfloat >();
+            m_device.Uniform1f( Location( location ), value );
+            break;
+         }
+         case Op::Uniform2f:
+         {
+            const GLint   location = reader.Read< GLint >();
+            const GLfloat x        = reader.Read< GLfloat >();
+            const GLfloat y        = reader.Read< GLfloat >();
+            m_device.Uniform2f( Location( location ), x, y );
+            break;
+         }
+         case Op::Uniform3f:
+         {
+            const GLint   location = reader.Read< GLint >();
+            const GLfloat x        = reader.Read< GLfloat >();
+            const GLfloat y        = reader.Read< GLfloat >();
+            const GLfloat z        = reader.Read< GLfloat >();
+            m_device.Uniform3f( Location( location ), x, y, z );
+            break;
+         }
+         case Op::Uniform4f:
+         {
+            const GLint   location = reader.Read< GLint >();
+            const GLfloat x        = reader.Read< GLfloat >();
+            const GLfloat y        = reader.Read< GLfloat >();
+            const GLfloat z        = reader.Read< GLfloat >();
+            const GLfloat w        = reader.Read< GLfloat >();
+            m_device.Uniform4f( Location( location ), x, y, z, w );
+            break;
+         }
+         case Op::UniformMatrix3fv:
+         {
+            const GLint                    location = reader.Read< GLint >();
+            const std::array< GLfloat, 9 > value    = reader.Read< std::array< GLfloat, 9 > >();
+            m_device.UniformMatrix3fv( Location( location ), value.data() );
+            break;
+         }
+         case Op::UniformMatrix4fv:
+         {
+            const GLint                     location = reader.Read< GLint >();
+            const std::array< GLfloat, 16 > value    = reader.Read< std::array< GLfloat, 16 > >();
+            m_device.UniformMatrix4fv( Location( location ), value.data() );
+            break;
+         }
+
+         // Draws
+         case Op::DrawArrays:
+         {
+            const GLenum  mode  = reader.Read< GLenum >();
+            const GLint   first = reader.Read< GLint >();
+            const GLsizei count = reader.Read< GLsizei >();
+            m_device.DrawArrays( mode, first, count );
+            break;
+         }
+         case Op::DrawElements:
+         {
+            const GLenum  mode   = reader.Read< GLenum >();
+            const GLsizei count  = reader.Read< GLsizei >();
+            const GLenum  type   = reader.Read< GLenum >();
+            const size_t  offset = reader.Read< size_t >();
+            m_device.DrawElements( mode, count, type, offset );
+            break;
+         }
+         case Op::DrawElementsInstanced:
+         {
+            const GLenum  mode      = reader.Read< GLenum >();
+            const GLsizei count     = reader.Read< GLsizei >();
+            const GLenum  type      = reader.Read< GLenum >();
+            const size_t  offset    = reader.Read< size_t >();
+            const GLsizei instances = reader.Read< GLsizei >();
+            m_device.DrawElementsInstanced( mode, count, type, offset, instances );
+            break;
+         }
+         case Op::MultiDrawElementsIndirect:
+         {
+            const GLenum  mode      = reader.Read< GLenum >();
+            const GLenum  type      = reader.Read< GLenum >();
+            const size_t  offset    = reader.Read< size_t >();
+            const GLsizei drawCount = reader.Read< GLsizei >();
+            const GLsizei stride    = reader.Read< GLsizei >();
+            m_device.MultiDrawElementsIndirect( mode, type, offset, drawCount, stride );
+            break;
+         }
+
+         // Fixed-function state
+         case Op::Clear:     m_device.Clear( reader.Read< GLbitfield >() ); break;
+         case Op::Enable:    m_device.Enable( reader.Read< GLenum >() ); break;
+         case Op::Disable:   m_device.Disable( reader.Read< GLenum >() ); break;
+         case Op::DepthFunc: m_device.DepthFunc( reader.Read< GLenum >() ); break;
+         case Op::DepthMask: m_device.DepthMask( reader.Read< GLboolean >() ); break;
+         case Op::PolygonMode:
+         {
+            const GLenum face = reader.Read< GLenum >();
+            const GLenum mode = reader.Read< GLenum >();
+            m_device.PolygonMode( face, mode );
+            break;
+         }
+         case Op::Viewport:
+         {
+            const GLint   x      = reader.Read< GLint >();
+            const GLint   y      = reader.Read< GLint >();
+            const GLsizei width  = reader.Read< GLsizei >();
+            const GLsizei height = reader.Read< GLsizei >();
+            m_device.Viewport( x, y, width, height );
+            break;
+         }
+      }
+   }
+}
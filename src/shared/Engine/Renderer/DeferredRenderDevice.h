@@ -0,0 +1,137 @@
+#pragma once
+
+#include <Engine/Renderer/RenderDevice.h>
+
+// A stretch of device calls recorded in order, each with the data it uploads, ready to be played on another thread
+struct RenderPacket
+{
+   std::vector< std::byte > stream;
+   size_t                   commands { 0 };
+
+   void Clear() noexcept
+   {
+      stream.clear();
+      commands = 0;
+   }
+};
+
+// ----------------------------------------------------------------
+// DeferredRenderDevice - records the renderer's calls into a packet for later
+// ----------------------------------------------------------------
+// Every call is encoded into the current packet with a copy of the memory it reads, so callers may free or reuse
+// that memory as soon as the call returns. Object ids, uniform locations and block indices are handed out here
+// and translated when the packet is played, which keeps every call non-blocking; the one query, GetViewport,
+// answers from the last viewport recorded. A program that fails to compile still gets an id; it plays as 0.
+class DeferredRenderDevice final : public RenderDevice
+{
+public:
+   explicit DeferredRenderDevice( glm::ivec4 viewport ) noexcept;
+
+   // Calls record into packet from here on
+   void SetPacket( RenderPacket& packet ) noexcept { m_pPacket = &packet; }
+
+   // Buffers
+   GLuint CreateBuffer() override;
+   void   DeleteBuffer( GLuint buffer ) override;
+   void   BindBuffer( GLenum target, GLuint buffer ) override;
+   void   BindBufferBase( GLenum target, GLuint index, GLuint buffer ) override;
+   void   BufferData( GLenum target, GLsizeiptr size, const void* pData, GLenum usage ) override;
+   void   BufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const void* pData ) override;
+   void   CopyBufferSubData( GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size ) override;
+
+   // Vertex arrays
+   GLuint CreateVertexArray() override;
+   void   DeleteVertexArray( GLuint vertexArray ) override;
+   void   BindVertexArray( GLuint vertexArray ) override;
+   void   EnableVertexAttribArray( GLuint index ) override;
+   void   DisableVertexAttribArray( GLuint index ) override;
+   void   VertexAttribPointer( GLuint index, GLint size, GLenum type, GLboolean fNormalized, GLsizei stride, size_t offset ) override;
+   void   VertexAttribDivisor( GLuint index, GLuint divisor ) override;
+
+   // Textures
+   GLuint CreateTexture() override;
+   void   DeleteTexture( GLuint texture ) override;
+   void   ActiveTexture( GLenum unit ) override;
+   void   BindTexture( GLenum target, GLuint texture ) override;
+   void   TexImage2D( GLenum target, GLenum internalFormat, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pPixels ) override;
+   void   TexImage3D( GLenum target, GLenum internalFormat, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels ) override;
+   void   TexSubImage3D( GLenum target, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels ) override;
+   void   TexParameteri( GLenum target, GLenum name, GLint value ) override;
+   void   GenerateMipmap( GLenum target ) override;
+
+   // Programs
+   GLuint CreateProgram( std::string_view vertexSource, std::string_view fragmentSource ) override;
+   void   DeleteProgram( GLuint program ) override;
+   void   UseProgram( GLuint program ) override;
+   GLint  GetUniformLocation( GLuint program, const char* pName ) override;
+   GLuint GetUniformBlockIndex( GLuint program, const char* pName ) override;
+   void   UniformBlockBinding( GLuint program, GLuint blockIndex, GLuint binding ) override;
+
+   // Uniforms
+   void Uniform1i( GLint location, GLint value ) override;
+   void Uniform1ui( GLint location, GLuint value ) override;
+   void Uniform1f( GLint location, GLfloat value ) override;
+   void Uniform2f( GLint location, GLfloat x, GLfloat y ) override;
+   void Uniform3f( GLint location, GLfloat x, GLfloat y, GLfloat z ) override;
+   void Uniform4f( GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w ) override;
+   void UniformMatrix3fv( GLint location, const GLfloat* pValue ) override;
+   void UniformMatrix4fv( GLint location, const GLfloat* pValue ) override;
+
+   // Draws
+   void DrawArrays( GLenum mode, GLint first, GLsizei count ) override;
+   void DrawElements( GLenum mode, GLsizei count, GLenum type, size_t offset ) override;
+   void DrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, size_t offset, GLsizei instances ) override;
+   void MultiDrawElementsIndirect( GLenum mode, GLenum type, size_t offset, GLsizei drawCount, GLsizei stride ) override;
+
+   // Fixed-function state
+   void       Clear( GLbitfield mask ) override;
+   void       Enable( GLenum capability ) override;
+   void       Disable( GLenum capability ) override;
+   void       DepthFunc( GLenum func ) override;
+   void       DepthMask( GLboolean fWrite ) override;
+   void       PolygonMode( GLenum face, GLenum mode ) override;
+   void       Viewport( GLint x, GLint y, GLsizei width, GLsizei height ) override;
+   glm::ivec4 GetViewport() override { return m_viewport; }
+
+private:
+   NO_COPY_MOVE( DeferredRenderDevice )
+
+   using NameMap = std::map< std::string, GLint, std::less<> >;
+
+   GLuint CreateObject();
+   void   DeleteObject( GLuint id );
+   GLint  ResolveName( NameMap& names, GLuint program, const char* pName, bool fBlock );
+
+   RenderPacket* m_pPacket { nullptr };
+   glm::ivec4    m_viewport;
+
+   GLuint                                m_nextId { 1 };
+   std::vector< GLuint >                 m_freeIds; // deleted, to be handed out again
+   GLint                                 m_nextName { 0 };
+   std::unordered_map< GLuint, NameMap > m_uniforms;      // locations by program and name
+   std::unordered_map< GLuint, NameMap > m_uniformBlocks; // block indices by program and name
+};
+
+// ----------------------------------------------------------------
+// RenderPacketPlayer - replays recorded packets against a device
+// ----------------------------------------------------------------
+// Keeps the translation from recorded ids to the device's across packets, so a packet may use objects created in
+// an earlier one. Packets must be played in the order they were recorded.
+class RenderPacketPlayer
+{
+public:
+   explicit RenderPacketPlayer( RenderDevice& device ) noexcept;
+
+   void Play( const RenderPacket& packet );
+
+private:
+   NO_COPY_MOVE( RenderPacketPlayer )
+
+   GLuint& Object( GLuint id );
+   GLint&  Name( GLint name );
+   GLint   Location( GLint name ) const noexcept;
+
+   RenderDevice&         m_device;
+   std::vector< GLuint > m_objects; // device ids by recorded id
+   std::vector< GLint >  m_names;   // device uniform locations and block indices by recorded name
+};
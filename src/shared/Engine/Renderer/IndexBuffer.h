@@ -1,5 +1,7 @@
 #pragma once
 
+#include "RenderDevice.h"
+
 class IndexBuffer
 {
 public:
@@ -7,7 +9,7 @@ public:
    ~IndexBuffer()
    {
       if( m_bufferID )
-         glDeleteBuffers( 1, &m_bufferID );
+         RenderDevice::Get().DeleteBuffer( m_bufferID );
    }
 
    // Initialize method to create and populate the index buffer
@@ -17,17 +19,18 @@ public:
       m_size = indexData.size();
 
       // Delete previous buffer if exists
+      RenderDevice& device = RenderDevice::Get();
       if( m_bufferID )
-         glDeleteBuffers( 1, &m_bufferID );
+         device.DeleteBuffer( m_bufferID );
 
-      glGenBuffers( 1, &m_bufferID );
-      glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_bufferID );
-      glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_size * sizeof( unsigned int ), indexData.data(), GL_STATIC_DRAW );
-      glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 ); // Unbind after setup
+      m_bufferID = device.CreateBuffer();
+      device.BindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_bufferID );
+      device.BufferData( GL_ELEMENT_ARRAY_BUFFER, m_size * sizeof( unsigned int ), indexData.data(), GL_STATIC_DRAW );
+      device.BindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 ); // Unbind after setup
    }
 
-   void Bind() const { glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_bufferID ); }
-   void Unbind() const { glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 ); }
+   void Bind() const { RenderDevice::Get().BindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_bufferID ); }
+   void Unbind() const { RenderDevice::Get().BindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 ); }
 
    inline unsigned int GetSize() const { return m_size; }
 
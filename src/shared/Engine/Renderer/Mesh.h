@@ -1,6 +1,7 @@
 #pragma once
 
 // Project dependencies
+#include <Engine/Renderer/RenderDevice.h>
 #include <Engine/Renderer/VertexBufferLayout.h>
 #include <Engine/Renderer/Texture.h>
 
@@ -14,34 +15,36 @@ public:
    {
       Cleanup(); // Ensure previous buffers are deleted before reinitialization
 
-      glGenVertexArrays( 1, &m_vertexArrayID );
-      glGenBuffers( 1, &m_vertexBufferID );
-      glGenBuffers( 1, &m_indexBufferID );
+      RenderDevice& device = RenderDevice::Get();
+      m_vertexArrayID      = device.CreateVertexArray();
+      m_vertexBufferID     = device.CreateBuffer();
+      m_indexBufferID      = device.CreateBuffer();
    }
 
-   void Bind() const { glBindVertexArray( m_vertexArrayID ); }
-   void Unbind() const { glBindVertexArray( 0 ); }
+   void Bind() const { RenderDevice::Get().BindVertexArray( m_vertexArrayID ); }
+   void Unbind() const { RenderDevice::Get().BindVertexArray( 0 ); }
 
    // VertexBuffer Functions
    template< typename T >
    void SetVertexData( const T* verticesData, size_t verticesCount, VertexBufferLayout&& layout )
    {
       m_vertexBufferLayout = std::move( layout );
-      glBindVertexArray( m_vertexArrayID );
-      glBindBuffer( GL_ARRAY_BUFFER, m_vertexBufferID );
-      glBufferData( GL_ARRAY_BUFFER, verticesCount * sizeof( T ), verticesData, GL_STATIC_DRAW );
+      RenderDevice& device = RenderDevice::Get();
+      device.BindVertexArray( m_vertexArrayID );
+      device.BindBuffer( GL_ARRAY_BUFFER, m_vertexBufferID );
+      device.BufferData( GL_ARRAY_BUFFER, verticesCount * sizeof( T ), verticesData, GL_STATIC_DRAW );
 
       // Apply layout
       const std::vector< VertexBufferElement >& elements = m_vertexBufferLayout.GetElements();
       for( unsigned int i = 0; i < elements.size(); i++ )
       {
          const VertexBufferElement& element = elements[ i ];
-         glEnableVertexAttribArray( i );
-         glVertexAttribPointer( i, element.m_count, element.m_type, element.m_normalized, m_vertexBufferLayout.GetStride(), ( const void* )element.m_offset );
+         device.EnableVertexAttribArray( i );
+         device.VertexAttribPointer( i, element.m_count, element.m_type, element.m_normalized, m_vertexBufferLayout.GetStride(), element.m_offset );
       }
 
-      glBindBuffer( GL_ARRAY_BUFFER, 0 );
-      glBindVertexArray( 0 );
+      device.BindBuffer( GL_ARRAY_BUFFER, 0 );
+      device.BindVertexArray( 0 );
    }
 
    template< typename T, size_t N >
@@ -59,11 +62,12 @@ public:
    // IndexBuffer Functions
    void SetIndexData( const unsigned int* indicesData, size_t indicesCount )
    {
-      m_indexCount = static_cast< unsigned int >( indicesCount );
-      glBindVertexArray( m_vertexArrayID );
-      glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_indexBufferID );
-      glBufferData( GL_ELEMENT_ARRAY_BUFFER, indicesCount * sizeof( unsigned int ), indicesData, GL_STATIC_DRAW );
-      glBindVertexArray( 0 );
+      m_indexCount         = static_cast< unsigned int >( indicesCount );
+      RenderDevice& device = RenderDevice::Get();
+      device.BindVertexArray( m_vertexArrayID );
+      device.BindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_indexBufferID );
+      device.BufferData( GL_ELEMENT_ARRAY_BUFFER, indicesCount * sizeof( unsigned int ), indicesData, GL_STATIC_DRAW );
+      device.BindVertexArray( 0 );
    }
 
    template< size_t N >
@@ -81,12 +85,13 @@ public:
 private:
    void Cleanup()
    {
+      RenderDevice& device = RenderDevice::Get();
       if( m_vertexArrayID )
-         glDeleteVertexArrays( 1, &m_vertexArrayID );
+         device.DeleteVertexArray( m_vertexArrayID );
       if( m_vertexBufferID )
-         glDeleteBuffers( 1, &m_vertexBufferID );
+         device.DeleteBuffer( m_vertexBufferID );
       if( m_indexBufferID )
-         glDeleteBuffers( 1, &m_indexBufferID );
+         device.DeleteBuffer( m_indexBufferID );
 
       m_vertexArrayID  = 0;
       m_vertexBufferID = 0;
@@ -110,7 +115,7 @@ public:
    void Render() const
    {
       m_meshBuffer.Bind();
-      glDrawElements( GL_TRIANGLES, m_meshBuffer.GetIndexCount(), GL_UNSIGNED_INT, nullptr );
+      RenderDevice::Get().DrawElements( GL_TRIANGLES, m_meshBuffer.GetIndexCount(), GL_UNSIGNED_INT, 0 );
       m_meshBuffer.Unbind();
    }
 
@@ -0,0 +1,360 @@
+#include "NullRenderDevice.h"
+
+NullRenderDevice::NullRenderDevice( glm::ivec2 viewportSize ) noexcept :
+   m_viewportSize( viewportSize )
+{}
+
+
+void NullRenderDevice::Reset()
+{
+   m_commands.clear();
+   m_counters = {};
+}
+
+
+uint64_t NullRenderDevice::GetBufferMemory() const noexcept
+{
+   uint64_t total = 0;
+   for( const auto& [ _, buffer ] : m_buffers )
+      total += buffer.size;
+
+   return total;
+}
+
+
+std::span< const std::byte > NullRenderDevice::GetBufferContents( GLuint buffer ) const
+{
+   const auto it = m_buffers.find( buffer );
+   return it != m_buffers.end() ? std::span< const std::byte >( it->second.contents ) : std::span< const std::byte >();
+}
+
+
+void NullRenderDevice::Record( const RenderCommand& command )
+{
+   m_commands.push_back( command );
+   ++m_counters.commands;
+
+   switch( command.type )
+   {
+      case RenderCommand::Type::UseProgram:      ++m_counters.programBinds; break;
+      case RenderCommand::Type::BindVertexArray: ++m_counters.vertexArrayBinds; break;
+      case RenderCommand::Type::BindBuffer:      ++m_counters.bufferBinds; break;
+      case RenderCommand::Type::BindTexture:     ++m_counters.textureBinds; break;
+      case RenderCommand::Type::SetUniform:      ++m_counters.uniforms; break;
+      case RenderCommand::Type::UploadBuffer:
+      case RenderCommand::Type::CopyBuffer:      m_counters.bufferBytes += command.bytes; break;
+      case RenderCommand::Type::UploadTexture:   m_counters.textureBytes += command.bytes; break;
+      case RenderCommand::Type::Draw:
+      case RenderCommand::Type::DrawInstanced:
+      case RenderCommand::Type::MultiDrawIndirect:
+         ++m_counters.drawCalls;
+         m_counters.draws += command.draws;
+         m_counters.instances += command.instances;
+         m_counters.elements += command.elements;
+         break;
+      default: break;
+   }
+}
+
+
+void NullRenderDevice::RecordUniform( GLint location )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::SetUniform, .target = static_cast< uint32_t >( location ) } );
+}
+
+
+GLuint& NullRenderDevice::Binding( GLenum target )
+{
+   return target == GL_ELEMENT_ARRAY_BUFFER ? m_elementBindings[ m_vertexArray ] : m_bindings[ target ];
+}
+
+
+NullRenderDevice::Buffer* NullRenderDevice::GetBound( GLenum target )
+{
+   const auto it = m_buffers.find( Binding( target ) );
+   return it != m_buffers.end() ? &it->second : nullptr;
+}
+
+
+// ----------------------------------------------------------------
+// Buffers
+// ----------------------------------------------------------------
+GLuint NullRenderDevice::CreateBuffer()
+{
+   const GLuint buffer = m_nextId++;
+   m_buffers.emplace( buffer, Buffer {} );
+   return buffer;
+}
+
+
+void NullRenderDevice::DeleteBuffer( GLuint buffer )
+{
+   m_buffers.erase( buffer );
+}
+
+
+void NullRenderDevice::BindBuffer( GLenum target, GLuint buffer )
+{
+   Binding( target ) = buffer;
+   Record( RenderCommand { .type = RenderCommand::Type::BindBuffer, .target = target, .object = buffer } );
+}
+
+
+void NullRenderDevice::BindBufferBase( GLenum target, GLuint /*index*/, GLuint buffer )
+{
+   BindBuffer( target, buffer );
+}
+
+
+void NullRenderDevice::BufferData( GLenum target, GLsizeiptr size, const void* pData, GLenum /*usage*/ )
+{
+   Buffer* pBuffer = GetBound( target );
+   if( !pBuffer )
+      return;
+
+   pBuffer->size = static_cast< uint64_t >( size );
+   pBuffer->contents.clear();
+   const bool fKeep = target == GL_DRAW_INDIRECT_BUFFER || m_fKeepContents;
+   if( fKeep )
+      pBuffer->contents.resize( static_cast< size_t >( size ) );
+   if( fKeep && pData )
+      std::memcpy( pBuffer->contents.data(), pData, static_cast< size_t >( size ) );
+
+   Record( RenderCommand { .type = RenderCommand::Type::UploadBuffer, .target = target, .object = Binding( target ), .bytes = pData ? static_cast< uint64_t >( size ) : 0 } );
+}
+
+
+void NullRenderDevice::BufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const void* pData )
+{
+   Buffer* pBuffer = GetBound( target );
+   if( !pBuffer )
+      return;
+
+   if( !pBuffer->contents.empty() && static_cast< size_t >( offset + size ) <= pBuffer->contents.size() )
+      std::memcpy( pBuffer->contents.data() + offset, pData, static_cast< size_t >( size ) );
+
+   Record( RenderCommand { .type = RenderCommand::Type::UploadBuffer, .target = target, .object = Binding( target ), .bytes = static_cast< uint64_t >( size ) } );
+}
+
+
+void NullRenderDevice::CopyBufferSubData( GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size )
+{
+   // Source and destination may be the same buffer; GL leaves overlapping ranges undefined, memmove does not mind
+   const Buffer* pRead  = GetBound( readTarget );
+   Buffer*       pWrite = GetBound( writeTarget );
+   if( pRead && pWrite && static_cast< size_t >( readOffset + size ) <= pRead->contents.size() &&
+       static_cast< size_t >( writeOffset + size ) <= pWrite->contents.size() )
+      std::memmove( pWrite->contents.data() + writeOffset, pRead->contents.data() + readOffset, static_cast< size_t >( size ) );
+
+   Record( RenderCommand { .type = RenderCommand::Type::CopyBuffer, .target = writeTarget, .object = Binding( writeTarget ), .bytes = static_cast< uint64_t >( size ) } );
+}
+
+
+// ----------------------------------------------------------------
+// Vertex arrays
+// ----------------------------------------------------------------
+GLuint NullRenderDevice::CreateVertexArray()
+{
+   ++m_vertexArrays;
+   return m_nextId++;
+}
+
+
+void NullRenderDevice::DeleteVertexArray( GLuint vertexArray )
+{
+   if( vertexArray == 0 )
+      return;
+
+   m_elementBindings.erase( vertexArray );
+   --m_vertexArrays;
+}
+
+
+void NullRenderDevice::BindVertexArray( GLuint vertexArray )
+{
+   m_vertexArray = vertexArray;
+   Record( RenderCommand { .type = RenderCommand::Type::BindVertexArray, .object = vertexArray } );
+}
+
+
+// ----------------------------------------------------------------
+// Textures
+// ----------------------------------------------------------------
+GLuint NullRenderDevice::CreateTexture()
+{
+   ++m_textures;
+   return m_nextId++;
+}
+
+
+void NullRenderDevice::DeleteTexture( GLuint texture )
+{
+   if( texture != 0 )
+      --m_textures;
+}
+
+
+void NullRenderDevice::BindTexture( GLenum target, GLuint texture )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::BindTexture, .target = target, .object = texture } );
+}
+
+
+void NullRenderDevice::TexImage2D( GLenum target, GLenum /*internalFormat*/, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pPixels )
+{
+   const uint64_t bytes = pPixels ? static_cast< uint64_t >( width ) * height * TexelSize( format, type ) : 0;
+   Record( RenderCommand { .type = RenderCommand::Type::UploadTexture, .target = target, .bytes = bytes } );
+}
+
+
+void NullRenderDevice::TexImage3D( GLenum target, GLenum /*internalFormat*/, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels )
+{
+   const uint64_t bytes = pPixels ? static_cast< uint64_t >( width ) * height * depth * TexelSize( format, type ) : 0;
+   Record( RenderCommand { .type = RenderCommand::Type::UploadTexture, .target = target, .bytes = bytes } );
+}
+
+
+void NullRenderDevice::TexSubImage3D( GLenum target, GLint /*x*/, GLint /*y*/, GLint /*z*/, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* /*pPixels*/ )
+{
+   const uint64_t bytes = static_cast< uint64_t >( width ) * height * depth * TexelSize( format, type );
+   Record( RenderCommand { .type = RenderCommand::Type::UploadTexture, .target = target, .bytes = bytes } );
+}
+
+
+// ----------------------------------------------------------------
+// Programs
+// ----------------------------------------------------------------
+GLuint NullRenderDevice::CreateProgram( std::string_view vertexSource, std::string_view fragmentSource )
+{
+   const GLuint program = m_nextId++;
+   m_programs.emplace( program, Program { .source = std::format( "{}\n{}", vertexSource, fragmentSource ) } );
+   return program;
+}
+
+
+void NullRenderDevice::DeleteProgram( GLuint program )
+{
+   m_programs.erase( program );
+}
+
+
+void NullRenderDevice::UseProgram( GLuint program )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::UseProgram, .object = program } );
+}
+
+
+// A name found as a whole word in the program's source gets its own location within the program; any other is -1,
+// as GL gives for a uniform that does not exist
+GLint NullRenderDevice::GetUniformLocation( GLuint program, const char* pName )
+{
+   Program&               entry = m_programs[ program ];
+   const std::string_view name( pName );
+   auto                   fIdentifier = []( char c ) { return std::isalnum( static_cast< unsigned char >( c ) ) || c == '_'; };
+
+   bool fDeclared = false;
+   for( size_t at = entry.source.find( name ); at != std::string::npos && !fDeclared; at = entry.source.find( name, at + 1 ) )
+   {
+      const size_t end = at + name.size();
+      fDeclared        = !name.empty() && ( at == 0 || !fIdentifier( entry.source[ at - 1 ] ) ) && ( end == entry.source.size() || !fIdentifier( entry.source[ end ] ) );
+   }
+   if( !fDeclared )
+      return -1;
+
+   return entry.locations.try_emplace( pName, static_cast< GLint >( entry.locations.size() ) ).first->second;
+}
+
+
+// ----------------------------------------------------------------
+// Draws
+// ----------------------------------------------------------------
+void NullRenderDevice::DrawArrays( GLenum mode, GLint /*first*/, GLsizei count )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::Draw, .target = mode, .object = m_vertexArray, .draws = 1, .instances = 1, .elements = static_cast< uint64_t >( count ) } );
+}
+
+
+void NullRenderDevice::DrawElements( GLenum mode, GLsizei count, GLenum /*type*/, size_t /*offset*/ )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::Draw, .target = mode, .object = m_vertexArray, .draws = 1, .instances = 1, .elements = static_cast< uint64_t >( count ) } );
+}
+
+
+void NullRenderDevice::DrawElementsInstanced( GLenum mode, GLsizei count, GLenum /*type*/, size_t /*offset*/, GLsizei instances )
+{
+   Record( RenderCommand { .type      = RenderCommand::Type::DrawInstanced,
+                           .target    = mode,
+                           .object    = m_vertexArray,
+                           .draws     = 1,
+                           .instances = static_cast< uint32_t >( instances ),
+                           .elements  = static_cast< uint64_t >( count ) * static_cast< uint64_t >( instances ) } );
+}
+
+
+void NullRenderDevice::MultiDrawElementsIndirect( GLenum mode, GLenum /*type*/, size_t offset, GLsizei drawCount, GLsizei stride )
+{
+   // Each command starts with its index count and instance count, as in DrawElementsIndirectCommand
+   RenderCommand command { .type = RenderCommand::Type::MultiDrawIndirect, .target = mode, .object = m_vertexArray, .draws = static_cast< uint32_t >( drawCount ) };
+
+   const size_t  step    = stride ? static_cast< size_t >( stride ) : 5 * sizeof( uint32_t );
+   const Buffer* pBuffer = GetBound( GL_DRAW_INDIRECT_BUFFER );
+   for( GLsizei i = 0; pBuffer && i < drawCount; ++i )
+   {
+      const size_t at = offset + static_cast< size_t >( i ) * step;
+      if( at + 2 * sizeof( uint32_t ) > pBuffer->contents.size() )
+         break;
+
+      uint32_t counts[ 2 ];
+      std::memcpy( counts, pBuffer->contents.data() + at, sizeof( counts ) );
+      command.instances += counts[ 1 ];
+      command.elements += static_cast< uint64_t >( counts[ 0 ] ) * counts[ 1 ];
+   }
+
+   Record( command );
+}
+
+
+// ----------------------------------------------------------------
+// Fixed-function state
+// ----------------------------------------------------------------
+void NullRenderDevice::Clear( GLbitfield mask )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::Clear, .target = mask } );
+}
+
+
+void NullRenderDevice::Enable( GLenum capability )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::SetState, .target = capability, .object = 1 } );
+}
+
+
+void NullRenderDevice::Disable( GLenum capability )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::SetState, .target = capability, .object = 0 } );
+}
+
+
+void NullRenderDevice::DepthFunc( GLenum func )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::SetState, .target = GL_DEPTH_FUNC, .object = func } );
+}
+
+
+void NullRenderDevice::DepthMask( GLboolean fWrite )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::SetState, .target = GL_DEPTH_WRITEMASK, .object = fWrite } );
+}
+
+
+void NullRenderDevice::PolygonMode( GLenum /*face*/, GLenum mode )
+{
+   Record( RenderCommand { .type = RenderCommand::Type::SetState, .target = GL_POLYGON_MODE, .object = mode } );
+}
+
+
+void NullRenderDevice::Viewport( GLint /*x*/, GLint /*y*/, GLsizei width, GLsizei height )
+{
+   m_viewportSize = glm::ivec2( width, height );
+   Record( RenderCommand { .type = RenderCommand::Type::SetState, .target = GL_VIEWPORT } );
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <Engine/Renderer/RenderDevice.h>
+
+// One recorded device call that matters for cost: binds, uploads, uniforms, draws and state changes. Object
+// creation and deletion only show up in the live resource counts.
+struct RenderCommand
+{
+   enum class Type : uint8_t
+   {
+      Clear,
+      SetState,
+      UseProgram,
+      BindVertexArray,
+      BindBuffer,
+      BindTexture,
+      SetUniform,
+      UploadBuffer,
+      CopyBuffer,
+      UploadTexture,
+      Draw,
+      DrawInstanced,
+      MultiDrawIndirect,
+   };
+
+   Type     type;
+   uint32_t target { 0 };    // GL target, capability, uniform location or primitive mode
+   uint32_t object { 0 };    // buffer, vertex array, texture or program
+   uint64_t bytes { 0 };     // uploaded or copied
+   uint32_t draws { 0 };     // draws issued; an indirect call counts each of its commands
+   uint32_t instances { 0 }; // summed over the call's draws
+   uint64_t elements { 0 };  // vertices or indices read, summed over every instance
+};
+
+// Totals over the commands recorded since the last Reset
+struct RenderCounters
+{
+   size_t   commands { 0 };
+   size_t   drawCalls { 0 }; // API calls
+   size_t   draws { 0 };     // what the GPU would process: one per indirect command
+   size_t   instances { 0 };
+   uint64_t elements { 0 };
+   size_t   programBinds { 0 };
+   size_t   vertexArrayBinds { 0 };
+   size_t   bufferBinds { 0 };
+   size_t   textureBinds { 0 };
+   size_t   uniforms { 0 };
+   uint64_t bufferBytes { 0 };  // uploaded and copied
+   uint64_t textureBytes { 0 }; // uploaded
+};
+
+// ----------------------------------------------------------------
+// NullRenderDevice - records the renderer's calls instead of making them
+// ----------------------------------------------------------------
+// Object ids are handed out from a counter and never reused, and buffer sizes are tracked, so callers behave as they
+// would against OpenGL. Uniforms not named in a program's source have no location. Indirect command buffers keep
+// their contents, letting an indirect draw report the draws and indices it stands for; other buffers keep theirs
+// only when asked, for callers that read back what was uploaded. Nothing is rendered.
+class NullRenderDevice final : public RenderDevice
+{
+public:
+   explicit NullRenderDevice( glm::ivec2 viewportSize = glm::ivec2( 1920, 1080 ) ) noexcept;
+
+   // Commands and counters start over; resources and bindings stay
+   void Reset();
+
+   std::span< const RenderCommand > GetCommands() const noexcept { return m_commands; }
+   const RenderCounters&            GetCounters() const noexcept { return m_counters; }
+
+   size_t   GetLiveBuffers() const noexcept { return m_buffers.size(); }
+   size_t   GetLiveVertexArrays() const noexcept { return m_vertexArrays; }
+   size_t   GetLiveTextures() const noexcept { return m_textures; }
+   size_t   GetLivePrograms() const noexcept { return m_programs.size(); }
+   uint64_t GetBufferMemory() const noexcept; // bytes allocated by BufferData across live buffers
+
+   // Every buffer sized by BufferData from here on keeps what is uploaded and copied into it
+   void                         SetKeepBufferContents( bool fKeep ) noexcept { m_fKeepContents = fKeep; }
+   std::span< const std::byte > GetBufferContents( GLuint buffer ) const; // empty for buffers that keep nothing
+
+   // Buffers
+   GLuint CreateBuffer() override;
+   void   DeleteBuffer( GLuint buffer ) override;
+   void   BindBuffer( GLenum target, GLuint buffer ) override;
+   void   BindBufferBase( GLenum target, GLuint index, GLuint buffer ) override;
+   void   BufferData( GLenum target, GLsizeiptr size, const void* pData, GLenum usage ) override;
+   void   BufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const void* pData ) override;
+   void   CopyBufferSubData( GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size ) override;
+
+   // Vertex arrays
+   GLuint CreateVertexArray() override;
+   void   DeleteVertexArray( GLuint vertexArray ) override;
+   void   BindVertexArray( GLuint vertexArray ) override;
+   void   EnableVertexAttribArray( GLuint /*index*/ ) override {}
+   void   DisableVertexAttribArray( GLuint /*index*/ ) override {}
+   void   VertexAttribPointer( GLuint /*index*/, GLint /*size*/, GLenum /*type*/, GLboolean /*fNormalized*/, GLsizei /*stride*/, size_t /*offset*/ ) override {}
+   void   VertexAttribDivisor( GLuint /*index*/, GLuint /*divisor*/ ) override {}
+
+   // Textures
+   GLuint CreateTexture() override;
+   void   DeleteTexture( GLuint texture ) override;
+   void   ActiveTexture( GLenum /*unit*/ ) override {}
+   void   BindTexture( GLenum target, GLuint texture ) override;
+   void   TexImage2D( GLenum target, GLenum internalFormat, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pPixels ) override;
+   void   TexImage3D( GLenum target, GLenum internalFormat, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels ) override;
+   void   TexSubImage3D( GLenum target, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels ) override;
+   void   TexParameteri( GLenum /*target*/, GLenum /*name*/, GLint /*value*/ ) override {}
+   void   GenerateMipmap( GLenum /*target*/ ) override {}
+
+   // Programs
+   GLuint CreateProgram( std::string_view vertexSource, std::string_view fragmentSource ) override;
+   void   DeleteProgram( GLuint program ) override;
+   void   UseProgram( GLuint program ) override;
+   GLint  GetUniformLocation( GLuint program, const char* pName ) override;
+   GLuint GetUniformBlockIndex( GLuint /*program*/, const char* /*pName*/ ) override { return 0; }
+   void   UniformBlockBinding( GLuint /*program*/, GLuint /*blockIndex*/, GLuint /*binding*/ ) override {}
+
+   // Uniforms
+   void Uniform1i( GLint location, GLint /*value*/ ) override { RecordUniform( location ); }
+   void Uniform1ui( GLint location, GLuint /*value*/ ) override { RecordUniform( location ); }
+   void Uniform1f( GLint location, GLfloat /*value*/ ) override { RecordUniform( location ); }
+   void Uniform2f( GLint location, GLfloat /*x*/, GLfloat /*y*/ ) override { RecordUniform( location ); }
+   void Uniform3f( GLint location, GLfloat /*x*/, GLfloat /*y*/, GLfloat /*z*/ ) override { RecordUniform( location ); }
+   void Uniform4f( GLint location, GLfloat /*x*/, GLfloat /*y*/, GLfloat /*z*/, GLfloat /*w*/ ) override { RecordUniform( location ); }
+   void UniformMatrix3fv( GLint location, const GLfloat* /*pValue*/ ) override { RecordUniform( location ); }
+   void UniformMatrix4fv( GLint location, const GLfloat* /*pValue*/ ) override { RecordUniform( location ); }
+
+   // Draws
+   void DrawArrays( GLenum mode, GLint first, GLsizei count ) override;
+   void DrawElements( GLenum mode, GLsizei count, GLenum type, size_t offset ) override;
+   void DrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, size_t offset, GLsizei instances ) override;
+   void MultiDrawElementsIndirect( GLenum mode, GLenum type, size_t offset, GLsizei drawCount, GLsizei stride ) override;
+
+   // Fixed-function state
+   void       Clear( GLbitfield mask ) override;
+   void       Enable( GLenum capability ) override;
+   void       Disable( GLenum capability ) override;
+   void       DepthFunc( GLenum func ) override;
+   void       DepthMask( GLboolean fWrite ) override;
+   void       PolygonMode( GLenum face, GLenum mode ) override;
+   void       Viewport( GLint x, GLint y, GLsizei width, GLsizei height ) override;
+   glm::ivec4 GetViewport() override { return glm::ivec4( 0, 0, m_viewportSize ); }
+
+private:
+   NO_COPY_MOVE( NullRenderDevice )
+
+   struct Buffer
+   {
+      uint64_t                 size { 0 };
+      std::vector< std::byte > contents; // indirect command buffers, and any buffer while contents are kept
+   };
+
+   struct Program
+   {
+      std::string                    source; // both stages, searched for uniform names
+      std::map< std::string, GLint > locations;
+   };
+
+   void    Record( const RenderCommand& command );
+   void    RecordUniform( GLint location );
+   GLuint& Binding( GLenum target );
+   Buffer* GetBound( GLenum target );
+
+   glm::ivec2                                                   m_viewportSize;
+   GLuint                                                       m_nextId { 1 };
+   std::vector< RenderCommand >                                 m_commands;
+   RenderCounters                                               m_counters;
+   std::unordered_map< GLuint, Buffer >                         m_buffers;
+   std::unordered_map< GLenum, GLuint >                         m_bindings;        // by target, element array excluded
+   std::unordered_map< GLuint, GLuint >                         m_elementBindings; // by vertex array, as GL keeps it
+   GLuint                                                       m_vertexArray { 0 };
+   std::unordered_map< GLuint, Program >                        m_programs;
+   size_t                                                       m_vertexArrays { 0 };
+   size_t                                                       m_textures { 0 };
+   bool                                                         m_fKeepContents { false };
+};
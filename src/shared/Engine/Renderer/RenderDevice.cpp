@@ -0,0 +1,257 @@
+#include "RenderDevice.h"
+
+namespace
+{
+
+// ----------------------------------------------------------------
+// GLRenderDevice - forwards every call to OpenGL
+// ----------------------------------------------------------------
+class GLRenderDevice final : public RenderDevice
+{
+public:
+   // Buffers
+   GLuint CreateBuffer() override
+   {
+      GLuint buffer = 0;
+      glGenBuffers( 1, &buffer );
+      return buffer;
+   }
+   void DeleteBuffer( GLuint buffer ) override { glDeleteBuffers( 1, &buffer ); }
+   void BindBuffer( GLenum target, GLuint buffer ) override { glBindBuffer( target, buffer ); }
+   void BindBufferBase( GLenum target, GLuint index, GLuint buffer ) override { glBindBufferBase( target, index, buffer ); }
+   void BufferData( GLenum target, GLsizeiptr size, const void* pData, GLenum usage ) override { glBufferData( target, size, pData, usage ); }
+   void BufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const void* pData ) override { glBufferSubData( target, offset, size, pData ); }
+   void CopyBufferSubData( GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size ) override
+   {
+      glCopyBufferSubData( readTarget, writeTarget, readOffset, writeOffset, size );
+   }
+
+   // Vertex arrays
+   GLuint CreateVertexArray() override
+   {
+      GLuint vertexArray = 0;
+      glGenVertexArrays( 1, &vertexArray );
+      return vertexArray;
+   }
+   void DeleteVertexArray( GLuint vertexArray ) override { glDeleteVertexArrays( 1, &vertexArray ); }
+   void BindVertexArray( GLuint vertexArray ) override { glBindVertexArray( vertexArray ); }
+   void EnableVertexAttribArray( GLuint index ) override { glEnableVertexAttribArray( index ); }
+   void DisableVertexAttribArray( GLuint index ) override { glDisableVertexAttribArray( index ); }
+   void VertexAttribPointer( GLuint index, GLint size, GLenum type, GLboolean fNormalized, GLsizei stride, size_t offset ) override
+   {
+      glVertexAttribPointer( index, size, type, fNormalized, stride, reinterpret_cast< const void* >( offset ) );
+   }
+   void VertexAttribDivisor( GLuint index, GLuint divisor ) override { glVertexAttribDivisor( index, divisor ); }
+
+   // Textures
+   GLuint CreateTexture() override
+   {
+      GLuint texture = 0;
+      glGenTextures( 1, &texture );
+      return texture;
+   }
+   void DeleteTexture( GLuint texture ) override { glDeleteTextures( 1, &texture ); }
+   void ActiveTexture( GLenum unit ) override { glActiveTexture( unit ); }
+   void BindTexture( GLenum target, GLuint texture ) override { glBindTexture( target, texture ); }
+   void TexImage2D( GLenum target, GLenum internalFormat, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pPixels ) override
+   {
+      glTexImage2D( target, 0, static_cast< GLint >( internalFormat ), width, height, 0, format, type, pPixels );
+   }
+   void TexImage3D( GLenum target, GLenum internalFormat, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels ) override
+   {
+      glTexImage3D( target, 0, static_cast< GLint >( internalFormat ), width, height, depth, 0, format, type, pPixels );
+   }
+   void TexSubImage3D( GLenum target, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels ) override
+   {
+      glTexSubImage3D( target, 0, x, y, z, width, height, depth, format, type, pPixels );
+   }
+   void TexParameteri( GLenum target, GLenum name, GLint value ) override { glTexParameteri( target, name, value ); }
+   void GenerateMipmap( GLenum target ) override { glGenerateMipmap( target ); }
+
+   // Programs
+   GLuint CreateProgram( std::string_view vertexSource, std::string_view fragmentSource ) override;
+   void   DeleteProgram( GLuint program ) override { glDeleteProgram( program ); }
+   void   UseProgram( GLuint program ) override { glUseProgram( program ); }
+   GLint  GetUniformLocation( GLuint program, const char* pName ) override { return glGetUniformLocation( program, pName ); }
+   GLuint GetUniformBlockIndex( GLuint program, const char* pName ) override { return glGetUniformBlockIndex( program, pName ); }
+   void   UniformBlockBinding( GLuint program, GLuint blockIndex, GLuint binding ) override { glUniformBlockBinding( program, blockIndex, binding ); }
+
+   // Uniforms
+   void Uniform1i( GLint location, GLint value ) override { glUniform1i( location, value ); }
+   void Uniform1ui( GLint location, GLuint value ) override { glUniform1ui( location, value ); }
+   void Uniform1f( GLint location, GLfloat value ) override { glUniform1f( location, value ); }
+   void Uniform2f( GLint location, GLfloat x, GLfloat y ) override { glUniform2f( location, x, y ); }
+   void Uniform3f( GLint location, GLfloat x, GLfloat y, GLfloat z ) override { glUniform3f( location, x, y, z ); }
+   void Uniform4f( GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w ) override { glUniform4f( location, x, y, z, w ); }
+   void UniformMatrix3fv( GLint location, const GLfloat* pValue ) override { glUniformMatrix3fv( location, 1, GL_FALSE, pValue ); }
+   void UniformMatrix4fv( GLint location, const GLfloat* pValue ) override { glUniformMatrix4fv( location, 1, GL_FALSE, pValue ); }
+
+   // Draws
+   void DrawArrays( GLenum mode, GLint first, GLsizei count ) override { glDrawArrays( mode, first, count ); }
+   void DrawElements( GLenum mode, GLsizei count, GLenum type, size_t offset ) override
+   {
+      glDrawElements( mode, count, type, reinterpret_cast< const void* >( offset ) );
+   }
+   void DrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, size_t offset, GLsizei instances ) override
+   {
+      glDrawElementsInstanced( mode, count, type, reinterpret_cast< const void* >( offset ), instances );
+   }
+   void MultiDrawElementsIndirect( GLenum mode, GLenum type, size_t offset, GLsizei drawCount, GLsizei stride ) override
+   {
+      glMultiDrawElementsIndirect( mode, type, reinterpret_cast< const void* >( offset ), drawCount, stride );
+   }
+
+   // Fixed-function state
+   void Clear( GLbitfield mask ) override { glClear( mask ); }
+   void Enable( GLenum capability ) override { glEnable( capability ); }
+   void Disable( GLenum capability ) override { glDisable( capability ); }
+   void DepthFunc( GLenum func ) override { glDepthFunc( func ); }
+   void DepthMask( GLboolean fWrite ) override { glDepthMask( fWrite ); }
+   void PolygonMode( GLenum face, GLenum mode ) override { glPolygonMode( face, mode ); }
+   void Viewport( GLint x, GLint y, GLsizei width, GLsizei height ) override { glViewport( x, y, width, height ); }
+
+   glm::ivec4 GetViewport() override
+   {
+      GLint viewport[ 4 ] {};
+      glGetIntegerv( GL_VIEWPORT, viewport );
+      return glm::ivec4( viewport[ 0 ], viewport[ 1 ], viewport[ 2 ], viewport[ 3 ] );
+   }
+
+private:
+   static GLuint CompileShader( GLenum type, std::string_view source );
+};
+
+
+// Creates a program, attaches a vertex and fragment shader, then links and validates it
+GLuint GLRenderDevice::CreateProgram( std::string_view vertexSource, std::string_view fragmentSource )
+{
+   // Creates an empty program object for which shader objects can be attached
+   GLuint programID = glCreateProgram();
+
+   // Creates shader objects for the Vertex and Fragment shaders
+   GLuint vs = CompileShader( GL_VERTEX_SHADER, vertexSource );
+   GLuint fs = CompileShader( GL_FRAGMENT_SHADER, fragmentSource );
+
+   // Attaches the shader objects to the program object
+   glAttachShader( programID, vs );
+   glAttachShader( programID, fs );
+
+   // Links the program object and creates executables for each of the shaders
+   glLinkProgram( programID );
+
+   int success;
+   glGetProgramiv( programID, GL_LINK_STATUS, &success );
+   if( success == GL_FALSE )
+   {
+      int length;
+      glGetProgramiv( programID, GL_INFO_LOG_LENGTH, &length );
+
+      std::vector< char > message( length );
+      glGetProgramInfoLog( programID, length, &length, message.data() );
+      std::println( "Failed to link shader program id {}!", programID );
+      std::println( "{}", message.data() );
+      glDeleteProgram( programID );
+      return 0;
+   }
+
+   // Checks/validates whether the executables contained in 'program' can execute
+   glValidateProgram( programID );
+
+   glGetProgramiv( programID, GL_VALIDATE_STATUS, &success );
+   if( success == GL_FALSE )
+   {
+      int length;
+      glGetProgramiv( programID, GL_INFO_LOG_LENGTH, &length );
+      std::vector< char > message( length );
+      glGetProgramInfoLog( programID, length, &length, message.data() );
+      std::println( "Failed to validate shader program id {}!", programID );
+      std::println( "{}", message.data() );
+      glDeleteProgram( programID );
+      return 0;
+   }
+
+   // Flags the shaders for deletion, but will not be deleted until it is no
+   // longer attached to any program object.  This will happen when
+   // glDeleteProgram() is called on 'program'
+   glDeleteShader( vs );
+   glDeleteShader( fs );
+
+   // Returns the id for which the program object can be referenced
+   return programID;
+}
+
+
+// Compiles one stage; returns the shader's id for attaching to a program
+/*static*/ GLuint GLRenderDevice::CompileShader( GLenum type, std::string_view source )
+{
+   std::string_view typeName = ( type == GL_VERTEX_SHADER ? "vertex" : ( type == GL_FRAGMENT_SHADER ? "fragment" : "unknown" ) );
+   if( source.empty() )
+   {
+      std::println( "Shader source is empty for {} shader", typeName );
+      return 0;
+   }
+
+   // Set the shader's (id) source code and compile it
+   const char* src      = source.data();
+   const GLint length   = static_cast< GLint >( source.size() );
+   GLuint      shaderID = glCreateShader( type );
+   glShaderSource( shaderID, 1, &src, &length );
+   glCompileShader( shaderID );
+
+   // Error Handling
+   int success;
+   glGetShaderiv( shaderID, GL_COMPILE_STATUS, &success );
+   if( success == GL_FALSE )
+   {
+      int logLength;
+      glGetShaderiv( shaderID, GL_INFO_LOG_LENGTH, &logLength );
+      std::vector< char > message( logLength );
+      glGetShaderInfoLog( shaderID, logLength, &logLength, message.data() );
+
+      std::println( "Failed to compile {} shader id {}!", typeName, shaderID );
+      std::println( "{}", message.data() );
+
+      std::println( "---- {} shader source begin ----", typeName );
+      std::println( "{}", source );
+      std::println( "---- {} shader source end ----", typeName );
+
+      glDeleteShader( shaderID );
+      return 0;
+   }
+
+   return shaderID;
+}
+
+
+GLRenderDevice s_glDevice;
+RenderDevice*  s_pCurrentDevice = &s_glDevice;
+
+} // namespace
+
+
+// ----------------------------------------------------------------
+// RenderDevice
+// ----------------------------------------------------------------
+/*static*/ RenderDevice& RenderDevice::Get() noexcept
+{
+   return *s_pCurrentDevice;
+}
+
+
+/*static*/ RenderDevice* RenderDevice::Set( RenderDevice* pDevice ) noexcept
+{
+   return std::exchange( s_pCurrentDevice, pDevice ? pDevice : &s_glDevice );
+}
+
+
+/*static*/ RenderDevice& RenderDevice::GetOpenGL() noexcept
+{
+   return s_glDevice;
+}
+
+
+/*static*/ uint64_t RenderDevice::TexelSize( GLenum format, GLenum type ) noexcept
+{
+   const uint64_t components = format == GL_RED ? 1 : format == GL_RG ? 2 : format == GL_RGB ? 3 : 4;
+   return components * ( type == GL_FLOAT ? 4 : 1 );
+}
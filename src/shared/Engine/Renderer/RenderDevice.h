@@ -0,0 +1,93 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// ----------------------------------------------------------------
+// RenderDevice - every GPU call the renderer makes, behind one interface
+// ----------------------------------------------------------------
+// The interface keeps OpenGL's shape: the same names without the gl prefix, GL enums and object ids, so a call site
+// reads like the GL it replaced. The OpenGL device forwards each call as-is; NullRenderDevice records them instead,
+// which lets RenderSystem and ChunkRenderer run without a context.
+//
+// Calls go to the process-wide current device, the OpenGL one unless another was installed. Resources belong to
+// the device that created them, so switch devices only while none are alive (e.g. in a tool, before building
+// anything, or when the window hands rendering to its render thread).
+class RenderDevice
+{
+public:
+   virtual ~RenderDevice() = default;
+
+   static RenderDevice& Get() noexcept;
+
+   // Makes pDevice current, or the OpenGL device for nullptr; returns the device that was current before
+   static RenderDevice* Set( RenderDevice* pDevice ) noexcept;
+
+   // The device that calls OpenGL, whichever is current; only valid on the thread holding the context
+   static RenderDevice& GetOpenGL() noexcept;
+
+   // Bytes per texel of tightly packed client pixels in the formats the renderer uploads
+   static uint64_t TexelSize( GLenum format, GLenum type ) noexcept;
+
+   // Buffers
+   virtual GLuint CreateBuffer() = 0;
+   virtual void   DeleteBuffer( GLuint buffer ) = 0;
+   virtual void   BindBuffer( GLenum target, GLuint buffer ) = 0;
+   virtual void   BindBufferBase( GLenum target, GLuint index, GLuint buffer ) = 0;
+   virtual void   BufferData( GLenum target, GLsizeiptr size, const void* pData, GLenum usage ) = 0;
+   virtual void   BufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const void* pData ) = 0;
+   virtual void   CopyBufferSubData( GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size ) = 0;
+
+   // Vertex arrays; attribute offsets are bytes into the buffer bound to GL_ARRAY_BUFFER
+   virtual GLuint CreateVertexArray() = 0;
+   virtual void   DeleteVertexArray( GLuint vertexArray ) = 0;
+   virtual void   BindVertexArray( GLuint vertexArray ) = 0;
+   virtual void   EnableVertexAttribArray( GLuint index ) = 0;
+   virtual void   DisableVertexAttribArray( GLuint index ) = 0;
+   virtual void   VertexAttribPointer( GLuint index, GLint size, GLenum type, GLboolean fNormalized, GLsizei stride, size_t offset ) = 0;
+   virtual void   VertexAttribDivisor( GLuint index, GLuint divisor ) = 0;
+
+   // Textures
+   virtual GLuint CreateTexture() = 0;
+   virtual void   DeleteTexture( GLuint texture ) = 0;
+   virtual void   ActiveTexture( GLenum unit ) = 0;
+   virtual void   BindTexture( GLenum target, GLuint texture ) = 0;
+   virtual void   TexImage2D( GLenum target, GLenum internalFormat, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pPixels ) = 0;
+   virtual void   TexImage3D( GLenum target, GLenum internalFormat, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels ) = 0;
+   virtual void   TexSubImage3D( GLenum target, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pPixels ) = 0;
+   virtual void   TexParameteri( GLenum target, GLenum name, GLint value ) = 0;
+   virtual void   GenerateMipmap( GLenum target ) = 0;
+
+   // Programs. CreateProgram compiles, links and validates, printing the log and returning 0 on failure.
+   virtual GLuint CreateProgram( std::string_view vertexSource, std::string_view fragmentSource ) = 0;
+   virtual void   DeleteProgram( GLuint program ) = 0;
+   virtual void   UseProgram( GLuint program ) = 0;
+   virtual GLint  GetUniformLocation( GLuint program, const char* pName ) = 0;
+   virtual GLuint GetUniformBlockIndex( GLuint program, const char* pName ) = 0;
+   virtual void   UniformBlockBinding( GLuint program, GLuint blockIndex, GLuint binding ) = 0;
+
+   // Uniforms of the program in use; matrices are column-major
+   virtual void Uniform1i( GLint location, GLint value ) = 0;
+   virtual void Uniform1ui( GLint location, GLuint value ) = 0;
+   virtual void Uniform1f( GLint location, GLfloat value ) = 0;
+   virtual void Uniform2f( GLint location, GLfloat x, GLfloat y ) = 0;
+   virtual void Uniform3f( GLint location, GLfloat x, GLfloat y, GLfloat z ) = 0;
+   virtual void Uniform4f( GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w ) = 0;
+   virtual void UniformMatrix3fv( GLint location, const GLfloat* pValue ) = 0;
+   virtual void UniformMatrix4fv( GLint location, const GLfloat* pValue ) = 0;
+
+   // Draws; index offsets are bytes into the element buffer, indirect offsets bytes into GL_DRAW_INDIRECT_BUFFER
+   virtual void DrawArrays( GLenum mode, GLint first, GLsizei count ) = 0;
+   virtual void DrawElements( GLenum mode, GLsizei count, GLenum type, size_t offset ) = 0;
+   virtual void DrawElementsInstanced( GLenum mode, GLsizei count, GLenum type, size_t offset, GLsizei instances ) = 0;
+   virtual void MultiDrawElementsIndirect( GLenum mode, GLenum type, size_t offset, GLsizei drawCount, GLsizei stride ) = 0;
+
+   // Fixed-function state
+   virtual void       Clear( GLbitfield mask ) = 0;
+   virtual void       Enable( GLenum capability ) = 0;
+   virtual void       Disable( GLenum capability ) = 0;
+   virtual void       DepthFunc( GLenum func ) = 0;
+   virtual void       DepthMask( GLboolean fWrite ) = 0;
+   virtual void       PolygonMode( GLenum face, GLenum mode ) = 0;
+   virtual void       Viewport( GLint x, GLint y, GLsizei width, GLsizei height ) = 0;
+   virtual glm::ivec4 GetViewport() = 0; // x, y, width, height
+};
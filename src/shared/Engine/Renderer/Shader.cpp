@@ -7,25 +7,25 @@
 Shader::Shader( InitType type, std::string_view vertex, std::string_view fragment )
 {
    m_source     = GetShaderProgramSource( type, vertex, fragment );
-   m_rendererId = CreateShader();
+   m_rendererId = RenderDevice::Get().CreateProgram( m_source.vertex, m_source.fragment );
 }
 
 // Frees memory and restores the name taken by m_RendererID
 Shader::~Shader()
 {
-   glDeleteProgram( m_rendererId );
+   RenderDevice::Get().DeleteProgram( m_rendererId );
 }
 
 
 void Shader::Bind() const
 {
-   glUseProgram( m_rendererId ); // Set the current active shader program
+   RenderDevice::Get().UseProgram( m_rendererId ); // Set the current active shader program
 }
 
 
 void Shader::Unbind() const
 {
-   glUseProgram( 0 ); // Unbinds the shader program currently active
+   RenderDevice::Get().UseProgram( 0 ); // Unbinds the shader program currently active
 }
 
 
@@ -58,117 +58,15 @@ Shader::ShaderProgramSource Shader::GetShaderProgramSource( InitType type, std::
 }
 
 
-// Creates a Shader program, attaches a vertex and fragment shader, then links
-// and validates the shader. Returns the Shader program's id
-unsigned int Shader::CreateShader()
-{
-   // Creates an empty program object for which shader objects can be attached
-   unsigned int programID = glCreateProgram();
-
-   // Creates shader objects for the Vertex and Fragment shaders
-   unsigned int vs = CompileShader( GL_VERTEX_SHADER, m_source.vertex );
-   unsigned int fs = CompileShader( GL_FRAGMENT_SHADER, m_source.fragment );
-
-   // Attaches the shader objects to the program object
-   glAttachShader( programID, vs );
-   glAttachShader( programID, fs );
-
-   // Links the program object and creates executables for each of the shaders
-   glLinkProgram( programID );
-
-   int success;
-   glGetProgramiv( programID, GL_LINK_STATUS, &success );
-   if( success == GL_FALSE )
-   {
-      int length;
-      glGetProgramiv( programID, GL_INFO_LOG_LENGTH, &length );
-
-      std::vector< char > message( length );
-      glGetProgramInfoLog( programID, length, &length, message.data() );
-      std::println( "Failed to link shader program id {}!", programID );
-      std::println( "{}", message.data() );
-      glDeleteProgram( programID );
-      return 0;
-   }
-
-   // Checks/validates whether the executables contained in 'program' can execute
-   glValidateProgram( programID );
-
-   glGetProgramiv( programID, GL_VALIDATE_STATUS, &success );
-   if( success == GL_FALSE )
-   {
-      int length;
-      glGetProgramiv( programID, GL_INFO_LOG_LENGTH, &length );
-      std::vector< char > message( length );
-      glGetProgramInfoLog( programID, length, &length, message.data() );
-      std::println( "Failed to validate shader program id {}!", programID );
-      std::println( "{}", message.data() );
-      glDeleteProgram( programID );
-      return 0;
-   }
-
-   // Flags the shaders for deletion, but will not be deleted until it is no
-   // longer attached to any program object.  This will happen when
-   // glDeleteProgram() is called on 'program'
-   glDeleteShader( vs );
-   glDeleteShader( fs );
-
-   // Returns the id for which the program object can be referenced
-   return programID;
-}
-
-
-// Compiles the Shader's source code
-// Returns a Shader's id for attaching to a Shader program
-unsigned int Shader::CompileShader( unsigned int type, std::string_view source )
-{
-   std::string_view typeName = ( type == GL_VERTEX_SHADER ? "vertex" : ( type == GL_FRAGMENT_SHADER ? "fragment" : "unknown" ) );
-   if( source.empty() )
-   {
-      std::println( "Shader source is empty for {} shader", typeName );
-      return 0;
-   }
-
-   // Set the shader's (id) source code and compile it
-   const char*  src      = source.data();
-   unsigned int shaderID = glCreateShader( type );
-   glShaderSource( shaderID, 1, &src, nullptr );
-   glCompileShader( shaderID );
-
-   // Error Handling
-   int success;
-   glGetShaderiv( shaderID, GL_COMPILE_STATUS, &success );
-   if( success == GL_FALSE )
-   {
-      int length;
-      glGetShaderiv( shaderID, GL_INFO_LOG_LENGTH, &length );
-      std::vector< char > message( length );
-      glGetShaderInfoLog( shaderID, length, &length, message.data() );
-
-      std::println( "Failed to compile {} shader id {}!", typeName, shaderID );
-      std::println( "{}", message.data() );
-
-      std::println( "---- {} shader source begin ----", typeName );
-      std::println( "{}", source );
-      std::println( "---- {} shader source end ----", typeName );
-
-      glDeleteShader( shaderID );
-      return 0;
-   }
-
-   return shaderID;
-}
-
-
 // Returns the location of a uniform value within the Shader
-int Shader::GetUniformLocation( const std::string_view& name )
+int Shader::GetUniformLocation( std::string_view name )
 {
    // Search the cache to check if the uniform variable has been hit before
-   if( auto it = m_uniformLocationCache.find( std::string { name } ); it != m_uniformLocationCache.end() )
+   if( auto it = m_uniformLocationCache.find( name ); it != m_uniformLocationCache.end() )
       return it->second;
 
    // Find the location of the uniform variable
-   int location = glGetUniformLocation( m_rendererId, name.data() );
+   int location = RenderDevice::Get().GetUniformLocation( m_rendererId, std::string( name ).c_str() );
    if( location == -1 )
       std::println( "Warning: uniform '{}' doesn't exist!", name );
 
@@ -176,3 +74,18 @@ int Shader::GetUniformLocation( const std::string_view& name )
    m_uniformLocationCache.emplace( name, location );
    return location;
 }
+
+
+// Assigns a uniform block to a binding index, so every program using the block reads the same buffer
+void Shader::BindUniformBlock( std::string_view name, unsigned int binding )
+{
+   RenderDevice&      device = RenderDevice::Get();
+   const unsigned int index  = device.GetUniformBlockIndex( m_rendererId, std::string( name ).c_str() );
+   if( index == GL_INVALID_INDEX )
+   {
+      std::println( "Warning: uniform block '{}' doesn't exist!", name );
+      return;
+   }
+
+   device.UniformBlockBinding( m_rendererId, index, binding );
+}
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <glad/glad.h>
+#include <Engine/Renderer/RenderDevice.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -25,78 +25,100 @@ public:
    void Bind() const;
    void Unbind() const;
 
+   // A uniform's location, looked up once so per-draw calls go straight to the device
+   struct UniformHandle
+   {
+      int location { -1 };
+   };
+
+   UniformHandle GetUniformHandle( std::string_view name ) { return UniformHandle { GetUniformLocation( name ) }; }
+
+   // Points the named uniform block at a GL_UNIFORM_BUFFER binding index
+   void BindUniformBlock( std::string_view name, unsigned int binding );
+
    template< typename T >
-   void SetUniform( const std::string_view& name, const T& value );
+   void SetUniform( UniformHandle handle, const T& value );
+
+   template< typename T >
+   void SetUniform( const std::string_view& name, const T& value )
+   {
+      SetUniform( GetUniformHandle( name ), value );
+   }
 
    template< typename... Args >
    void SetUniform( const std::string_view& name, Args... args );
 
 private:
    ShaderProgramSource GetShaderProgramSource( InitType type, std::string_view vertex, std::string_view fragment );
-   unsigned int        CreateShader();
-   unsigned int        CompileShader( unsigned int type, std::string_view source );
-   int                 GetUniformLocation( const std::string_view& name );
+   int                 GetUniformLocation( std::string_view name );
+
+   // Lets the cache be searched with a string_view, without building a std::string per lookup
+   struct NameHash
+   {
+      using is_transparent = void;
+      size_t operator()( std::string_view name ) const noexcept { return std::hash< std::string_view > {}( name ); }
+   };
 
-   ShaderProgramSource                    m_source {};
-   unsigned int                           m_rendererId {};
-   std::unordered_map< std::string, int > m_uniformLocationCache;
+   ShaderProgramSource                                               m_source {};
+   unsigned int                                                      m_rendererId {};
+   std::unordered_map< std::string, int, NameHash, std::equal_to<> > m_uniformLocationCache;
 };
 
 template<>
-inline void Shader::SetUniform< int >( const std::string_view& name, const int& value )
+inline void Shader::SetUniform< int >( UniformHandle handle, const int& value )
 {
-   glUniform1i( GetUniformLocation( name ), value );
+   RenderDevice::Get().Uniform1i( handle.location, value );
 }
 
 template<>
-inline void Shader::SetUniform< unsigned int >( const std::string_view& name, const unsigned int& value )
+inline void Shader::SetUniform< unsigned int >( UniformHandle handle, const unsigned int& value )
 {
-   glUniform1ui( GetUniformLocation( name ), value );
+   RenderDevice::Get().Uniform1ui( handle.location, value );
 }
 
 template<>
-inline void Shader::SetUniform< float >( const std::string_view& name, const float& value )
+inline void Shader::SetUniform< float >( UniformHandle handle, const float& value )
 {
-   glUniform1f( GetUniformLocation( name ), value );
+   RenderDevice::Get().Uniform1f( handle.location, value );
 }
 
 template<>
-inline void Shader::SetUniform< glm::vec2 >( const std::string_view& name, const glm::vec2& value )
+inline void Shader::SetUniform< glm::vec2 >( UniformHandle handle, const glm::vec2& value )
 {
-   glUniform2f( GetUniformLocation( name ), value.x, value.y );
+   RenderDevice::Get().Uniform2f( handle.location, value.x, value.y );
 }
 
 template<>
-inline void Shader::SetUniform< glm::vec3 >( const std::string_view& name, const glm::vec3& value )
+inline void Shader::SetUniform< glm::vec3 >( UniformHandle handle, const glm::vec3& value )
 {
-   glUniform3f( GetUniformLocation( name ), value.x, value.y, value.z );
+   RenderDevice::Get().Uniform3f( handle.location, value.x, value.y, value.z );
 }
 
 template<>
-inline void Shader::SetUniform< glm::vec4 >( const std::string_view& name, const glm::vec4& value )
+inline void Shader::SetUniform< glm::vec4 >( UniformHandle handle, const glm::vec4& value )
 {
-   glUniform4f( GetUniformLocation( name ), value.x, value.y, value.z, value.w );
+   RenderDevice::Get().Uniform4f( handle.location, value.x, value.y, value.z, value.w );
 }
 
 template<>
-inline void Shader::SetUniform< glm::mat3 >( const std::string_view& name, const glm::mat3& value )
+inline void Shader::SetUniform< glm::mat3 >( UniformHandle handle, const glm::mat3& value )
 {
-   glUniformMatrix3fv( GetUniformLocation( name ), 1, GL_FALSE, glm::value_ptr( value ) );
+   RenderDevice::Get().UniformMatrix3fv( handle.location, glm::value_ptr( value ) );
 }
 
 template<>
-inline void Shader::SetUniform< glm::mat4 >( const std::string_view& name, const glm::mat4& value )
+inline void Shader::SetUniform< glm::mat4 >( UniformHandle handle, const glm::mat4& value )
 {
-   glUniformMatrix4fv( GetUniformLocation( name ), 1, GL_FALSE, glm::value_ptr( value ) );
+   RenderDevice::Get().UniformMatrix4fv( handle.location, glm::value_ptr( value ) );
 }
 
 template< typename... Args >
 inline void Shader::SetUniform( const std::string_view& name, Args... args )
 {
    if constexpr( sizeof...( Args ) == 2 )
-      glUniform2f( GetUniformLocation( name ), args... );
+      RenderDevice::Get().Uniform2f( GetUniformLocation( name ), args... );
    else if constexpr( sizeof...( Args ) == 3 )
-      glUniform3f( GetUniformLocation( name ), args... );
+      RenderDevice::Get().Uniform3f( GetUniformLocation( name ), args... );
    else if constexpr( sizeof...( Args ) == 4 )
-      glUniform4f( GetUniformLocation( name ), args... );
+      RenderDevice::Get().Uniform4f( GetUniformLocation( name ), args... );
 }
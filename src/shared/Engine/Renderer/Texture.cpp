@@ -71,9 +71,10 @@ SkyboxTexture::SkyboxTexture( std::span< const std::string_view > faces ) :
 
 SkyboxTexture::~SkyboxTexture()
 {
-   glDeleteVertexArrays( 1, &m_vao );
-   glDeleteBuffers( 1, &m_vbo );
-   glDeleteTextures( 1, &m_textureID );
+   RenderDevice& device = RenderDevice::Get();
+   device.DeleteVertexArray( m_vao );
+   device.DeleteBuffer( m_vbo );
+   device.DeleteTexture( m_textureID );
 }
 
 
@@ -81,27 +82,28 @@ void SkyboxTexture::LoadCubemap( std::span< const std::string_view > faces )
 {
    STBFlipVerticallyOnLoad flipGuard( false );
 
-   glGenTextures( 1, &m_textureID );
-   glBindTexture( GL_TEXTURE_CUBE_MAP, m_textureID );
+   RenderDevice& device = RenderDevice::Get();
+   m_textureID          = device.CreateTexture();
+   device.BindTexture( GL_TEXTURE_CUBE_MAP, m_textureID );
 
    int width, height, bpp;
    for( unsigned int i = 0; i < faces.size(); i++ )
    {
       unsigned char* pData = stbi_load( faces[ i ].data(), &width, &height, &bpp, 4 );
       if( pData )
-         glTexImage2D( GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pData );
+         device.TexImage2D( GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, GL_RGBA8, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pData );
       else
          std::cerr << "SkyboxTexture::LoadCubemap - failed to load texture at " << faces[ i ] << "\n";
 
       stbi_image_free( pData );
    }
 
-   glTexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
-   glTexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
-   glTexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
-   glTexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
-   glTexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE );
-   glBindTexture( GL_TEXTURE_CUBE_MAP, 0 );
+   device.TexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+   device.TexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+   device.TexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+   device.TexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+   device.TexParameteri( GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE );
+   device.BindTexture( GL_TEXTURE_CUBE_MAP, 0 );
 }
 
 
@@ -115,24 +117,26 @@ void SkyboxTexture::InitGeometry()
       1.0f,  -1.0f, 1.0f,  -1.0f, -1.0f, 1.0f,  -1.0f, 1.0f,  -1.0f, 1.0f,  1.0f,  -1.0f, 1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  -1.0f, 1.0f,  1.0f, -1.0f,
       1.0f,  -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, 1.0f,  1.0f,  -1.0f, -1.0f, 1.0f,  -1.0f, -1.0f, -1.0f, -1.0f, 1.0f,  1.0f,  -1.0f, 1.0f
    };
-   glGenVertexArrays( 1, &m_vao );
-   glGenBuffers( 1, &m_vbo );
+   RenderDevice& device = RenderDevice::Get();
+   m_vao                = device.CreateVertexArray();
+   m_vbo                = device.CreateBuffer();
 
-   glBindVertexArray( m_vao );
-   glBindBuffer( GL_ARRAY_BUFFER, m_vbo );
-   glBufferData( GL_ARRAY_BUFFER, sizeof( skyboxVertices ), skyboxVertices.data(), GL_STATIC_DRAW );
+   device.BindVertexArray( m_vao );
+   device.BindBuffer( GL_ARRAY_BUFFER, m_vbo );
+   device.BufferData( GL_ARRAY_BUFFER, sizeof( skyboxVertices ), skyboxVertices.data(), GL_STATIC_DRAW );
 
-   glEnableVertexAttribArray( 0 );
-   glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof( float ), ( void* )0 );
+   device.EnableVertexAttribArray( 0 );
+   device.VertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof( float ), 0 );
 
-   glBindVertexArray( 0 );
+   device.BindVertexArray( 0 );
 }
 
 
 void SkyboxTexture::Draw( const glm::mat4& view, const glm::mat4& projection )
 {
-   glDepthFunc( GL_LEQUAL ); // skybox depth trick
-   glDepthMask( GL_FALSE );
+   RenderDevice& device = RenderDevice::Get();
+   device.DepthFunc( GL_LEQUAL ); // skybox depth trick
+   device.DepthMask( GL_FALSE );
 
    m_shader.Bind();
 
@@ -140,18 +144,18 @@ void SkyboxTexture::Draw( const glm::mat4& view, const glm::mat4& projection )
    const glm::mat4 skyboxViewProjection = projection * glm::mat4( glm::mat3( view ) );
    m_shader.SetUniform( "u_viewProjection", skyboxViewProjection );
 
-   glActiveTexture( GL_TEXTURE0 );
-   glBindTexture( GL_TEXTURE_CUBE_MAP, m_textureID );
+   device.ActiveTexture( GL_TEXTURE0 );
+   device.BindTexture( GL_TEXTURE_CUBE_MAP, m_textureID );
    m_shader.SetUniform( "u_skybox", 0 );
 
-   glBindVertexArray( m_vao );
-   glDrawArrays( GL_TRIANGLES, 0, 36 );
-   glBindVertexArray( 0 );
+   device.BindVertexArray( m_vao );
+   device.DrawArrays( GL_TRIANGLES, 0, 36 );
+   device.BindVertexArray( 0 );
 
    m_shader.Unbind();
 
-   glDepthMask( GL_TRUE );
-   glDepthFunc( GL_LESS );
+   device.DepthMask( GL_TRUE );
+   device.DepthFunc( GL_LESS );
 }
 
 
@@ -161,7 +165,7 @@ void SkyboxTexture::Draw( const glm::mat4& view, const glm::mat4& projection )
 TextureAtlas::~TextureAtlas()
 {
    if( m_rendererID )
-      glDeleteTextures( 1, &m_rendererID );
+      RenderDevice::Get().DeleteTexture( m_rendererID );
 }
 
 
@@ -267,9 +271,10 @@ void TextureAtlas::PrepareTexture( BlockId blockId )
 
 void TextureAtlas::Compile()
 {
+   RenderDevice& device = RenderDevice::Get();
    if( m_rendererID )
    {
-      glDeleteTextures( 1, &m_rendererID );
+      device.DeleteTexture( m_rendererID );
       m_rendererID = 0;
    }
 
@@ -289,9 +294,9 @@ void TextureAtlas::Compile()
    m_layerCount = static_cast< int >( m_pending.size() );
 
    // Create texture array
-   glGenTextures( 1, &m_rendererID );
-   glBindTexture( GL_TEXTURE_2D_ARRAY, m_rendererID );
-   glTexImage3D( GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, m_width, m_height, m_layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr );
+   m_rendererID = device.CreateTexture();
+   device.BindTexture( GL_TEXTURE_2D_ARRAY, m_rendererID );
+   device.TexImage3D( GL_TEXTURE_2D_ARRAY, GL_RGBA8, m_width, m_height, m_layerCount, GL_RGBA, GL_UNSIGNED_BYTE, nullptr );
 
    // Upload each texture as a layer
    uint32_t layerIndex = 0;
@@ -300,7 +305,7 @@ void TextureAtlas::Compile()
       // If texture is smaller than max dimensions, we need to pad it
       if( texture.width == m_width && texture.height == m_height )
       {
-         glTexSubImage3D( GL_TEXTURE_2D_ARRAY, 0, 0, 0, layerIndex, m_width, m_height, 1, GL_RGBA, GL_UNSIGNED_BYTE, texture.pixels.data() );
+         device.TexSubImage3D( GL_TEXTURE_2D_ARRAY, 0, 0, layerIndex, m_width, m_height, 1, GL_RGBA, GL_UNSIGNED_BYTE, texture.pixels.data() );
       }
       else
       {
@@ -321,7 +326,7 @@ void TextureAtlas::Compile()
                dst[ 3 ]                 = src[ 3 ];
             }
          }
-         glTexSubImage3D( GL_TEXTURE_2D_ARRAY, 0, 0, 0, layerIndex, m_width, m_height, 1, GL_RGBA, GL_UNSIGNED_BYTE, padded.data() );
+         device.TexSubImage3D( GL_TEXTURE_2D_ARRAY, 0, 0, layerIndex, m_width, m_height, 1, GL_RGBA, GL_UNSIGNED_BYTE, padded.data() );
       }
 
       m_regions[ key ] = Region { .layer = layerIndex };
@@ -329,27 +334,28 @@ void TextureAtlas::Compile()
    }
    m_pending.clear();
 
-   glGenerateMipmap( GL_TEXTURE_2D_ARRAY );
+   device.GenerateMipmap( GL_TEXTURE_2D_ARRAY );
 
-   glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
-   glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
-   glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR );
-   glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+   device.TexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+   device.TexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+   device.TexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR );
+   device.TexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
 
-   glBindTexture( GL_TEXTURE_2D_ARRAY, 0 );
+   device.BindTexture( GL_TEXTURE_2D_ARRAY, 0 );
 }
 
 
 void TextureAtlas::Bind( unsigned int slot ) const
 {
-   glActiveTexture( GL_TEXTURE0 + slot );
-   glBindTexture( GL_TEXTURE_2D_ARRAY, m_rendererID );
+   RenderDevice& device = RenderDevice::Get();
+   device.ActiveTexture( GL_TEXTURE0 + slot );
+   device.BindTexture( GL_TEXTURE_2D_ARRAY, m_rendererID );
 }
 
 
 void TextureAtlas::Unbind() const
 {
-   glBindTexture( GL_TEXTURE_2D_ARRAY, 0 );
+   RenderDevice::Get().BindTexture( GL_TEXTURE_2D_ARRAY, 0 );
 }
 
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "RenderDevice.h"
+
 class VertexArray
 {
 public:
@@ -7,12 +9,12 @@ public:
    ~VertexArray()
    {
       if( m_vertexArrayID )
-         glDeleteVertexArrays( 1, &m_vertexArrayID );
+         RenderDevice::Get().DeleteVertexArray( m_vertexArrayID );
    }
 
-   void Initialize() { glCreateVertexArrays( 1, &m_vertexArrayID ); }
-   void Bind() const { glBindVertexArray( m_vertexArrayID ); }
-   void Unbind() const { glBindVertexArray( 0 ); }
+   void Initialize() { m_vertexArrayID = RenderDevice::Get().CreateVertexArray(); }
+   void Bind() const { RenderDevice::Get().BindVertexArray( m_vertexArrayID ); }
+   void Unbind() const { RenderDevice::Get().BindVertexArray( 0 ); }
 
    // Delete Copy and Move Constructors
    VertexArray( const VertexArray& )            = delete;
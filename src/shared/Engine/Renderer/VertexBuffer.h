@@ -1,6 +1,7 @@
 #pragma once
 
 // Local dependencies
+#include "RenderDevice.h"
 #include "VertexBufferLayout.h"
 
 class VertexBuffer
@@ -10,14 +11,14 @@ public:
    ~VertexBuffer()
    {
       if( m_bufferID )
-         glDeleteBuffers( 1, &m_bufferID );
+         RenderDevice::Get().DeleteBuffer( m_bufferID );
    }
 
    // Initialize method to set up buffer
    template< typename TContainer >
    void SetBufferData( const TContainer& vertexData, VertexBufferLayout&& layout );
-   void Bind() const { glBindBuffer( GL_ARRAY_BUFFER, m_bufferID ); }
-   void Unbind() const { glBindBuffer( GL_ARRAY_BUFFER, 0 ); }
+   void Bind() const { RenderDevice::Get().BindBuffer( GL_ARRAY_BUFFER, m_bufferID ); }
+   void Unbind() const { RenderDevice::Get().BindBuffer( GL_ARRAY_BUFFER, 0 ); }
 
    const std::vector< float >& GetVertices() const { return m_vertexData; }
 
@@ -38,22 +39,23 @@ void VertexBuffer::SetBufferData( const TContainer& vertexData, VertexBufferLayo
    m_vertexData.assign( vertexData.begin(), vertexData.end() ); // Store data for ray casting
 
    // Delete previous buffer if exists
+   RenderDevice& device = RenderDevice::Get();
    if( m_bufferID )
-      glDeleteBuffers( 1, &m_bufferID );
+      device.DeleteBuffer( m_bufferID );
 
    // Generate and bind buffer
-   glGenBuffers( 1, &m_bufferID );
-   glBindBuffer( GL_ARRAY_BUFFER, m_bufferID );
-   glBufferData( GL_ARRAY_BUFFER, vertexData.size() * sizeof( TContainer::value_type ), vertexData.data(), GL_STATIC_DRAW );
+   m_bufferID = device.CreateBuffer();
+   device.BindBuffer( GL_ARRAY_BUFFER, m_bufferID );
+   device.BufferData( GL_ARRAY_BUFFER, vertexData.size() * sizeof( TContainer::value_type ), vertexData.data(), GL_STATIC_DRAW );
 
    // Apply layout
    const std::vector< VertexBufferElement >& elements = m_layout.GetElements();
    for( unsigned int i = 0; i < elements.size(); i++ )
    {
-      glEnableVertexAttribArray( i );
+      device.EnableVertexAttribArray( i );
       const VertexBufferElement& element = elements[ i ];
-      glVertexAttribPointer( i, element.m_count, element.m_type, element.m_normalized, m_layout.GetStride(), ( const void* )element.m_offset );
+      device.VertexAttribPointer( i, element.m_count, element.m_type, element.m_normalized, m_layout.GetStride(), element.m_offset );
    }
 
-   glBindBuffer( GL_ARRAY_BUFFER, 0 ); // Unbind after setup
+   device.BindBuffer( GL_ARRAY_BUFFER, 0 ); // Unbind after setup
 }
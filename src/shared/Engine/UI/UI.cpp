@@ -2,6 +2,7 @@
 
 // Project dependencies
 #include <Engine/Platform/Window.h>
+#include <Engine/Platform/RenderThread.h>
 
 #include <Engine/Core/Time.h>
 #include <Engine/ECS/Registry.h>
@@ -11,6 +12,35 @@
 namespace UI
 {
 
+// ----------------------------------------------------------------
+// DrawDataSnapshot
+// ----------------------------------------------------------------
+void DrawDataSnapshot::Capture( const ImDrawData& drawData )
+{
+   Clear();
+
+   m_drawData = drawData;
+   for( ImDrawList*& pList : m_drawData.CmdLists )
+      pList = pList->CloneOutput();
+}
+
+
+void DrawDataSnapshot::Clear()
+{
+   for( ImDrawList* pList : m_drawData.CmdLists )
+      IM_DELETE( pList );
+
+   m_drawData.Clear();
+}
+
+
+void DrawDataSnapshot::Render()
+{
+   if( m_drawData.Valid )
+      ImGui_ImplOpenGL3_RenderDrawData( &m_drawData );
+}
+
+
 // ----------------------------------------------------------------
 // UIContext
 // ----------------------------------------------------------------
@@ -44,6 +74,10 @@ void UIContext::Init( GLFWwindow* pGlfwWindowHandle )
    if( !ImGui_ImplOpenGL3_Init( "#version 330" ) )
       throw std::runtime_error( "Failed to initialize ImGui OpenGL backend" );
 
+   // Created now, while this thread still holds the GL context; NewFrame would otherwise create them lazily, and
+   // frames are drawn on the render thread
+   ImGui_ImplOpenGL3_CreateDeviceObjects();
+
    m_uiElements.reserve( kInitialUIElementCapacity );
    m_fInitialized = true;
 }
@@ -94,7 +128,7 @@ void UIContext::Register( std::shared_ptr< IDrawable > element )
 }
 
 
-void UIContext::EndFrame()
+void UIContext::EndFrame( DrawDataSnapshot& outDrawData )
 {
    if( !m_fInitialized )
       throw std::runtime_error( "UIContext::EndFrame - UIContext not initialized" );
@@ -108,7 +142,7 @@ void UIContext::EndFrame()
    m_uiElements.clear();
 
    ImGui::Render();
-   ImGui_ImplOpenGL3_RenderDrawData( ImGui::GetDrawData() );
+   outDrawData.Capture( *ImGui::GetDrawData() );
 
    m_fFrameActive = false;
 }
@@ -188,6 +222,10 @@ void DebugUI::Draw()
             if( ImGui::Checkbox( "VSync", &fVSync ) )
                Window::Get().SetVSync( fVSync );
 
+            const RenderThreadStats render = Window::Get().GetRenderStats();
+            ImGui::Text( "Render Thread: %.2fms play, %.3fms handoff, %.2fms main wait", render.playMs, render.handoffMs, render.waitMs );
+            ImGui::Text( "Frames In Flight: %.2f, Packet: %zu commands, %zu KB", render.queueDepth, render.packetCommands, render.packetBytes / 1024 );
+
             ImGui::Text( "Tick: %d", m_timestep.GetTickCount() );
             ImGui::Text( "Entity Count: %d", ( int )m_registry.GetEntityCount() );
 
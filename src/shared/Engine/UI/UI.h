@@ -30,6 +30,29 @@ struct IDrawable
 };
 
 
+// ----------------------------------------------------------------
+// DrawDataSnapshot - a frame's ImGui draw lists, owned, to be drawn later
+// ----------------------------------------------------------------
+// ImGui reuses its draw lists on the next NewFrame, so a frame drawn on another thread draws from a copy
+class DrawDataSnapshot
+{
+public:
+   DrawDataSnapshot() noexcept = default;
+   ~DrawDataSnapshot() { Clear(); }
+
+   void Capture( const ImDrawData& drawData );
+   void Clear();
+
+   // Needs the GL context, so runs on whichever thread holds it
+   void Render();
+
+private:
+   NO_COPY_MOVE( DrawDataSnapshot )
+
+   ImDrawData m_drawData;
+};
+
+
 // ----------------------------------------------------------------
 // UIContext - Manages the UI system and provides access to display info
 // ----------------------------------------------------------------
@@ -46,7 +69,7 @@ public:
 
    void BeginFrame();
    void Register( std::shared_ptr< IDrawable > element );
-   void EndFrame();
+   void EndFrame( DrawDataSnapshot& outDrawData ); // builds the frame's draw lists; drawing them is the caller's
 
    // Display info for UI layout
    [[nodiscard]] const Window& GetWindow() const noexcept { return m_window; }
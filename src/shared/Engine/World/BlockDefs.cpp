@@ -3,13 +3,44 @@
 namespace World
 {
 
+// Grass needs this much skylight above it to spread
+static constexpr uint8_t GRASS_SPREAD_LIGHT = 9;
+
+static void GrassRandomTick( Level& level, WorldBlockPos pos, TickRng& rng )
+{
+   // Smothered grass dies back to dirt
+   const WorldBlockPos above { pos.x, pos.y + 1, pos.z };
+   if( FOpaque( level.GetBlock( above ) ) )
+   {
+      level.SetBlock( pos, BlockState( BlockId::Dirt ) );
+      return;
+   }
+
+   if( level.GetSkyLight( above ) < GRASS_SPREAD_LIGHT )
+      return;
+
+   // Spread onto one random dirt block within 3x4x3 (two below to one above) that is open to the sky.
+   // GetBlock reads unloaded chunks as air, so this never loads a neighbor.
+   const WorldBlockPos target { pos.x + static_cast< int >( rng.NextBelow( 3 ) ) - 1,
+                                pos.y + static_cast< int >( rng.NextBelow( 4 ) ) - 2,
+                                pos.z + static_cast< int >( rng.NextBelow( 3 ) ) - 1 };
+   const WorldBlockPos targetAbove { target.x, target.y + 1, target.z };
+   if( level.GetBlock( target ).GetId() == BlockId::Dirt && !FOpaque( level.GetBlock( targetAbove ) ) && level.GetSkyLight( targetAbove ) >= GRASS_SPREAD_LIGHT )
+      level.SetBlock( target, BlockState( BlockId::Grass ) );
+}
+
+
 constexpr std::array BlockDefs = {
    BlockDef { .id = BlockId::Air, .breakTicks = 0, .hasBlockEntity = false, .openable = false, .OnBroken = nullptr },
    BlockDef { .id = BlockId::Dirt, .breakTicks = 10 },
    BlockDef { .id = BlockId::Stone, .breakTicks = 60 },
-   BlockDef { .id = BlockId::Grass, .breakTicks = 12 },
+   BlockDef { .id = BlockId::Grass, .breakTicks = 12, .OnRandomTick = GrassRandomTick },
    BlockDef { .id = BlockId::Bedrock, .breakTicks = 0xFFFFFFFFu },
    BlockDef { .id = BlockId::Furnace, .breakTicks = 80, .hasBlockEntity = true, .openable = true },
+   BlockDef { .id = BlockId::Water, .breakTicks = 0xFFFFFFFFu },
+   BlockDef { .id = BlockId::Lava, .breakTicks = 0xFFFFFFFFu },
+   BlockDef { .id = BlockId::Log, .breakTicks = 30 },
+   BlockDef { .id = BlockId::Leaves, .breakTicks = 4 },
 };
 constexpr auto _blockDefsValidation = []() // compile-time validation of BlockDefs
 {
@@ -18,6 +49,10 @@ constexpr auto _blockDefsValidation = []() // compile-time validation of BlockDe
                               BlockDefs.end(),
                               []( const BlockDef& def ) { return def.id != static_cast< BlockId >( &def - BlockDefs.data() ); } ) )
       throw "BlockDef ID mismatch";
+   if constexpr( std::any_of( BlockDefs.begin(),
+                              BlockDefs.end(),
+                              []( const BlockDef& def ) { return ( def.OnRandomTick != nullptr ) != FRandomTicks( BlockState( def.id ) ); } ) )
+      throw "BlockDef OnRandomTick does not match BlockFlag::RandomTick";
 
    return true;
 }();
@@ -19,6 +19,12 @@ struct BlockDef
    bool openable { false };
 
    void ( *OnBroken )( Level& level, WorldBlockPos pos ) { nullptr };
+
+   // Random tick behavior; set exactly for blocks with BlockFlag::RandomTick
+   void ( *OnRandomTick )( Level& level, WorldBlockPos pos, TickRng& rng ) { nullptr };
+
+   // Runs when a tick scheduled with Level::FScheduleTick comes due and this block is still there
+   void ( *OnScheduledTick )( Level& level, WorldBlockPos pos ) { nullptr };
 };
 
 class BlockDefRegistry
@@ -0,0 +1,167 @@
+#include "BlockTickScheduler.h"
+
+// ----------------------------------------------------------------
+// BlockTickScheduler
+// ----------------------------------------------------------------
+BlockTickScheduler::BlockTickScheduler( uint64_t now ) :
+   m_now( now )
+{
+   m_slots.fill( NIL );
+}
+
+
+bool BlockTickScheduler::FSchedule( const ChunkPos& cpos, const WorldBlockPos& pos, BlockId block, uint64_t dueTick )
+{
+   const Key key { pos, block };
+   if( m_byKey.contains( key ) )
+      return false;
+
+   const Node fresh { .tick = { pos, block, ( std::max )( dueTick, m_now + 1 ) }, .cpos = cpos };
+   uint32_t   index;
+   if( !m_free.empty() )
+   {
+      index = m_free.back();
+      m_free.pop_back();
+      m_nodes[ index ] = fresh;
+   }
+   else
+   {
+      index = static_cast< uint32_t >( m_nodes.size() );
+      m_nodes.push_back( fresh );
+   }
+
+   Node& node = m_nodes[ index ];
+
+   // Push onto the front of the chunk's list
+   auto [ it, fInserted ] = m_byChunk.try_emplace( cpos, NIL );
+   node.chunkNext         = it->second;
+   if( it->second != NIL )
+      m_nodes[ it->second ].chunkPrev = index;
+   it->second = index;
+
+   m_byKey.emplace( key, index );
+   Link( index );
+   return true;
+}
+
+
+void BlockTickScheduler::Advance( uint64_t now, std::vector< ScheduledBlockTick >& outDue )
+{
+   while( m_now < now )
+   {
+      ++m_now;
+
+      // Every level whose lower digits just rolled over to zero hands its current slot down, top level first
+      int top = 0;
+      while( top + 1 < LEVELS && ( m_now & ( ( uint64_t { 1 } << ( SLOT_BITS * ( top + 1 ) ) ) - 1 ) ) == 0 )
+         ++top;
+
+      for( int level = top; level >= 1; --level )
+      {
+         uint32_t& head = m_slots[ level * SLOT_COUNT + ( ( m_now >> ( SLOT_BITS * level ) ) & ( SLOT_COUNT - 1 ) ) ];
+         for( uint32_t index = std::exchange( head, NIL ); index != NIL; )
+         {
+            const uint32_t next = m_nodes[ index ].slotNext;
+            m_nodes[ index ].slot = NIL;
+            Link( index );
+            index = next;
+         }
+      }
+
+      // Everything left in the current level 0 slot is due now
+      uint32_t& head = m_slots[ m_now & ( SLOT_COUNT - 1 ) ];
+      for( uint32_t index = std::exchange( head, NIL ); index != NIL; )
+      {
+         const uint32_t next = m_nodes[ index ].slotNext;
+         m_nodes[ index ].slot = NIL;
+         outDue.push_back( m_nodes[ index ].tick );
+         Release( index );
+         index = next;
+      }
+   }
+}
+
+
+std::vector< ScheduledBlockTick > BlockTickScheduler::ChunkTicks( const ChunkPos& cpos ) const
+{
+   std::vector< ScheduledBlockTick > ticks;
+   if( auto it = m_byChunk.find( cpos ); it != m_byChunk.end() )
+   {
+      for( uint32_t index = it->second; index != NIL; index = m_nodes[ index ].chunkNext )
+         ticks.push_back( m_nodes[ index ].tick );
+   }
+
+   return ticks;
+}
+
+
+void BlockTickScheduler::DropChunk( const ChunkPos& cpos )
+{
+   auto it = m_byChunk.find( cpos );
+   if( it == m_byChunk.end() )
+      return;
+
+   for( uint32_t index = it->second; index != NIL; )
+   {
+      Node&          node = m_nodes[ index ];
+      const uint32_t next = node.chunkNext;
+      Unlink( index );
+      m_byKey.erase( Key { node.tick.pos, node.tick.block } );
+      m_free.push_back( index );
+      index = next;
+   }
+
+   m_byChunk.erase( it );
+}
+
+
+void BlockTickScheduler::Link( uint32_t index )
+{
+   Node& node = m_nodes[ index ];
+
+   // The highest digit in which the due tick differs from now picks the level; that digit of the due tick picks the slot
+   const uint64_t diff  = node.tick.dueTick ^ m_now;
+   const int      level = diff ? static_cast< int >( ( std::bit_width( diff ) - 1 ) / SLOT_BITS ) : 0;
+   node.slot            = static_cast< uint32_t >( level * SLOT_COUNT + ( ( node.tick.dueTick >> ( SLOT_BITS * level ) ) & ( SLOT_COUNT - 1 ) ) );
+
+   node.slotPrev = NIL;
+   node.slotNext = m_slots[ node.slot ];
+   if( node.slotNext != NIL )
+      m_nodes[ node.slotNext ].slotPrev = index;
+   m_slots[ node.slot ] = index;
+}
+
+
+void BlockTickScheduler::Unlink( uint32_t index )
+{
+   Node& node = m_nodes[ index ];
+   if( node.slot == NIL )
+      return;
+
+   if( node.slotPrev != NIL )
+      m_nodes[ node.slotPrev ].slotNext = node.slotNext;
+   else
+      m_slots[ node.slot ] = node.slotNext;
+   if( node.slotNext != NIL )
+      m_nodes[ node.slotNext ].slotPrev = node.slotPrev;
+
+   node.slot = NIL;
+}
+
+
+void BlockTickScheduler::Release( uint32_t index )
+{
+   Node& node = m_nodes[ index ];
+
+   if( node.chunkPrev != NIL )
+      m_nodes[ node.chunkPrev ].chunkNext = node.chunkNext;
+   else if( node.chunkNext != NIL )
+      m_byChunk[ node.cpos ] = node.chunkNext;
+   else
+      m_byChunk.erase( node.cpos );
+   if( node.chunkNext != NIL )
+      m_nodes[ node.chunkNext ].chunkPrev = node.chunkPrev;
+
+   m_byKey.erase( Key { node.tick.pos, node.tick.block } );
+   m_free.push_back( index );
+}
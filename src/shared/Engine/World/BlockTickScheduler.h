@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Engine/World/Level.h>
+
+struct ScheduledBlockTick
+{
+   WorldBlockPos pos;
+   BlockId       block;
+   uint64_t      dueTick;
+};
+
+// ----------------------------------------------------------------
+// BlockTickScheduler - delayed block ticks on a hierarchical timing wheel
+// ----------------------------------------------------------------
+// Level l holds ticks due within 64^(l+1) ticks of now in 64 slots; every 64^l ticks one slot of level l
+// is cascaded down a level. Scheduling, cancelling and expiring are O(1), and an idle tick touches one
+// slot, however many ticks are pending. Enough levels cover the full 64-bit tick range.
+//
+// Ticks are deduplicated by (position, block) and also linked per chunk, so a chunk's ticks can be
+// saved with it and dropped when it unloads.
+class BlockTickScheduler
+{
+public:
+   explicit BlockTickScheduler( uint64_t now );
+
+   // Schedules `block` at `pos` (inside chunk `cpos`) for `dueTick` (> now). Returns false if that
+   // block is already scheduled at that position; the earlier tick is kept.
+   bool FSchedule( const ChunkPos& cpos, const WorldBlockPos& pos, BlockId block, uint64_t dueTick );
+
+   // Moves time forward to `now`, appending every tick that came due in order of expiry
+   void Advance( uint64_t now, std::vector< ScheduledBlockTick >& outDue );
+
+   // Pending ticks of one chunk, in no particular order
+   std::vector< ScheduledBlockTick > ChunkTicks( const ChunkPos& cpos ) const;
+   void                              DropChunk( const ChunkPos& cpos );
+
+   uint64_t Now() const noexcept { return m_now; }
+   size_t   PendingCount() const noexcept { return m_byKey.size(); }
+
+private:
+   NO_COPY_MOVE( BlockTickScheduler )
+
+   static constexpr int      SLOT_BITS  = 6;
+   static constexpr int      SLOT_COUNT = 1 << SLOT_BITS;
+   static constexpr int      LEVELS     = ( 64 + SLOT_BITS - 1 ) / SLOT_BITS;
+   static constexpr uint32_t NIL        = UINT32_MAX;
+
+   // Pooled entry, linked into one wheel slot and into its chunk's list
+   struct Node
+   {
+      ScheduledBlockTick tick;
+      ChunkPos           cpos;
+      uint32_t           slot { NIL }; // level * SLOT_COUNT + index
+      uint32_t           slotPrev { NIL }, slotNext { NIL };
+      uint32_t           chunkPrev { NIL }, chunkNext { NIL };
+   };
+
+   struct Key
+   {
+      WorldBlockPos pos;
+      BlockId       block;
+      bool          operator==( const Key& ) const = default;
+   };
+
+   struct KeyHash
+   {
+      std::size_t operator()( const Key& key ) const noexcept { return BlockPosHash {}( key.pos ) ^ ( static_cast< std::size_t >( key.block ) * 0x9E3779B97F4A7C15ull ); }
+   };
+
+   void Link( uint32_t node );   // into the wheel slot for its due tick
+   void Unlink( uint32_t node ); // from its wheel slot
+   void Release( uint32_t node ); // from the chunk list, the key index and the pool
+
+   std::vector< Node >     m_nodes;
+   std::vector< uint32_t > m_free;
+
+   std::array< uint32_t, LEVELS * SLOT_COUNT >            m_slots;
+   std::unordered_map< Key, uint32_t, KeyHash >           m_byKey;
+   std::unordered_map< ChunkPos, uint32_t, ChunkPosHash > m_byChunk; // head of each chunk's list
+
+   uint64_t m_now;
+};
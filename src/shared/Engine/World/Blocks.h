@@ -11,6 +11,10 @@ enum class BlockId : uint16_t
    Grass   = 3,
    Bedrock = 4,
    Furnace = 5,
+   Water   = 6,
+   Lava    = 7,
+   Log     = 8,
+   Leaves  = 9,
    Count // Keep as last, new entries should be inserted before this
 };
 
@@ -36,10 +40,15 @@ struct BlockProperties
 {
    BlockId          id { BlockId::Air };
    BlockOrientation orientation { BlockOrientation::North };
+   uint8_t          fluidLevel { 0 }; // fluids only: 0 = source, higher = further from it (max FLUID_LEVEL_MAX)
    // add more fields as needed
 };
 
 
+// Fluids spread up to this many blocks from a source (lava covers the range in steps of two)
+inline constexpr uint8_t FLUID_LEVEL_MAX = 7;
+
+
 // ------------------------------------------------------------
 // Block State - packed per-block instance data
 // ------------------------------------------------------------
@@ -52,30 +61,33 @@ public:
    {}
    constexpr explicit BlockState( const BlockProperties& props )
    {
-      uint16_t bits = 0;
-      bits          = IdField::Insert( bits, static_cast< uint16_t >( props.id ) );
-      bits          = OrientationField::Insert( bits, static_cast< uint16_t >( props.orientation ) );
+      uint32_t bits = 0;
+      bits          = IdField::Insert( bits, static_cast< uint32_t >( props.id ) );
+      bits          = OrientationField::Insert( bits, static_cast< uint32_t >( props.orientation ) );
+      bits          = FluidLevelField::Insert( bits, props.fluidLevel );
       data          = bits;
    }
 
    constexpr bool             operator==( const BlockState& other ) const = default;
-   constexpr BlockProperties  GetProperties() const { return BlockProperties { .id = GetId(), .orientation = GetOrientation() }; }
+   constexpr BlockProperties  GetProperties() const { return BlockProperties { .id = GetId(), .orientation = GetOrientation(), .fluidLevel = GetFluidLevel() }; }
    constexpr BlockId          GetId() const { return static_cast< BlockId >( IdField::Extract( data ) ); }
    constexpr BlockOrientation GetOrientation() const { return static_cast< BlockOrientation >( OrientationField::Extract( data ) ); }
+   constexpr uint8_t          GetFluidLevel() const { return static_cast< uint8_t >( FluidLevelField::Extract( data ) ); }
 
 private:
    // Bit helper
-   template< uint16_t StartBit, uint16_t BitCount >
+   template< uint32_t StartBit, uint32_t BitCount >
    struct Field
    {
-      static constexpr uint16_t mask = ( ( 1u << BitCount ) - 1 ) << StartBit;
-      static constexpr uint16_t Extract( uint16_t v ) { return ( v & mask ) >> StartBit; }
-      static constexpr uint16_t Insert( uint16_t v, uint16_t f ) { return ( v & ~mask ) | ( ( f << StartBit ) & mask ); }
+      static constexpr uint32_t mask = ( ( 1u << BitCount ) - 1 ) << StartBit;
+      static constexpr uint32_t Extract( uint32_t v ) { return ( v & mask ) >> StartBit; }
+      static constexpr uint32_t Insert( uint32_t v, uint32_t f ) { return ( v & ~mask ) | ( ( f << StartBit ) & mask ); }
    };
 
    // Layout of BlockState
    using IdField          = Field< 0, 12 >; // 12 bits for BlockId
    using OrientationField = Field< 12, 3 >; // 3 bits for orientation
+   using FluidLevelField  = Field< 15, 3 >; // 3 bits for fluid level
 
    // Stored data
    uint32_t data { 0 };
@@ -87,9 +99,11 @@ private:
 // ------------------------------------------------------------
 enum class BlockFlag : uint32_t
 {
-   None   = 0,
-   Solid  = 1 << 0, // Blocks that are solid (collidable)
-   Opaque = 1 << 1, // Blocks that are opaque (not see-through)
+   None       = 0,
+   Solid      = 1 << 0, // Blocks that are solid (collidable)
+   Opaque     = 1 << 1, // Blocks that are opaque (not see-through)
+   RandomTick = 1 << 2, // Blocks that react to random ticks (World::BlockDef::OnRandomTick)
+   Fluid      = 1 << 3, // Blocks simulated by the FluidSimulator
 };
 
 
@@ -108,6 +122,7 @@ struct BlockInfo
    BlockId          id;
    std::string_view json;
    BlockFlag        flags;
+   uint8_t          lightEmission { 0 }; // block light level emitted, 0-15
 };
 
 
@@ -115,12 +130,16 @@ struct BlockInfo
 // BlockData - definition of all block types and their properties
 // ------------------------------------------------------------
 inline constexpr std::array BlockData = {
-   BlockInfo { BlockId::Air,     "",                           BlockFlag::None                      },
-   BlockInfo { BlockId::Dirt,    "assets/models/dirt.json",    BlockFlag::Solid | BlockFlag::Opaque },
-   BlockInfo { BlockId::Stone,   "assets/models/stone.json",   BlockFlag::Solid | BlockFlag::Opaque },
-   BlockInfo { BlockId::Grass,   "assets/models/grass.json",   BlockFlag::Solid | BlockFlag::Opaque },
-   BlockInfo { BlockId::Bedrock, "assets/models/bedrock.json", BlockFlag::Solid | BlockFlag::Opaque },
-   BlockInfo { BlockId::Furnace, "assets/models/furnace.json", BlockFlag::Solid | BlockFlag::Opaque },
+   BlockInfo { BlockId::Air,     "",                           BlockFlag::None,                                              0  },
+   BlockInfo { BlockId::Dirt,    "assets/models/dirt.json",    BlockFlag::Solid | BlockFlag::Opaque,                         0  },
+   BlockInfo { BlockId::Stone,   "assets/models/stone.json",   BlockFlag::Solid | BlockFlag::Opaque,                         0  },
+   BlockInfo { BlockId::Grass,   "assets/models/grass.json",   BlockFlag::Solid | BlockFlag::Opaque | BlockFlag::RandomTick, 0  },
+   BlockInfo { BlockId::Bedrock, "assets/models/bedrock.json", BlockFlag::Solid | BlockFlag::Opaque,                         0  },
+   BlockInfo { BlockId::Furnace, "assets/models/furnace.json", BlockFlag::Solid | BlockFlag::Opaque,                         13 },
+   BlockInfo { BlockId::Water,   "assets/models/water.json",   BlockFlag::Fluid,                                             0  },
+   BlockInfo { BlockId::Lava,    "assets/models/lava.json",    BlockFlag::Fluid,                                             15 },
+   BlockInfo { BlockId::Log,     "assets/models/log.json",     BlockFlag::Solid | BlockFlag::Opaque,                         0  },
+   BlockInfo { BlockId::Leaves,  "assets/models/leaves.json",  BlockFlag::Solid,                                             0  },
 };
 constexpr auto _blockDataValidation = []() // compile-time validation of BlockData
 {
@@ -166,3 +185,27 @@ constexpr bool FSolid( BlockState state ) noexcept
 {
    return FSolid( state.GetId() );
 }
+
+
+constexpr bool FOpaque( BlockState state ) noexcept
+{
+   return FHasFlag( GetBlockInfo( state ).flags, BlockFlag::Opaque );
+}
+
+
+constexpr bool FRandomTicks( BlockState state ) noexcept
+{
+   return FHasFlag( GetBlockInfo( state ).flags, BlockFlag::RandomTick );
+}
+
+
+constexpr bool FFluid( BlockState state ) noexcept
+{
+   return FHasFlag( GetBlockInfo( state ).flags, BlockFlag::Fluid );
+}
+
+
+constexpr uint8_t LightEmission( BlockState state ) noexcept
+{
+   return GetBlockInfo( state ).lightEmission;
+}
@@ -0,0 +1,145 @@
+#include "ChunkMeshArena.h"
+
+#include <Engine/Renderer/RenderDevice.h>
+
+ChunkMeshArena::ChunkMeshArena( uint32_t vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity ) :
+   m_vertexStride( vertexStride ),
+   m_vertices( vertexCapacity ),
+   m_indices( indexCapacity )
+{}
+
+
+ChunkMeshArena::~ChunkMeshArena()
+{
+   if( m_vbo )
+      RenderDevice::Get().DeleteBuffer( m_vbo );
+   if( m_ebo )
+      RenderDevice::Get().DeleteBuffer( m_ebo );
+}
+
+
+ChunkMeshArena::Handle ChunkMeshArena::Allocate( const void* pVertices, uint32_t vertexCount, std::span< const uint32_t > indices )
+{
+   assert( vertexCount > 0 && !indices.empty() );
+   const uint32_t indexCount = static_cast< uint32_t >( indices.size() );
+
+   if( !m_vbo )
+      Rebuild( m_vertices.GetCapacity(), m_indices.GetCapacity() );
+
+   std::optional< uint32_t > firstVertex = m_vertices.Allocate( vertexCount );
+   std::optional< uint32_t > firstIndex  = m_indices.Allocate( indexCount );
+   if( !firstVertex || !firstIndex )
+   {
+      if( firstVertex )
+         m_vertices.Free( *firstVertex );
+      if( firstIndex )
+         m_indices.Free( *firstIndex );
+
+      Rebuild( NextCapacity( m_vertices, vertexCount ), NextCapacity( m_indices, indexCount ) );
+      firstVertex = m_vertices.Allocate( vertexCount );
+      firstIndex  = m_indices.Allocate( indexCount );
+   }
+
+   // Copy targets leave the element binding of whatever vertex array is bound alone
+   RenderDevice& device = RenderDevice::Get();
+   device.BindBuffer( GL_COPY_WRITE_BUFFER, m_vbo );
+   device.BufferSubData( GL_COPY_WRITE_BUFFER, static_cast< GLintptr >( *firstVertex ) * m_vertexStride, static_cast< GLsizeiptr >( vertexCount ) * m_vertexStride, pVertices );
+   device.BindBuffer( GL_COPY_WRITE_BUFFER, m_ebo );
+   device.BufferSubData( GL_COPY_WRITE_BUFFER, static_cast< GLintptr >( *firstIndex ) * sizeof( uint32_t ), indices.size_bytes(), indices.data() );
+   device.BindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+
+   const Range range { .firstVertex = *firstVertex, .vertexCount = vertexCount, .firstIndex = *firstIndex, .indexCount = indexCount };
+   if( m_freeHandles.empty() )
+   {
+      m_ranges.push_back( range );
+      return static_cast< Handle >( m_ranges.size() - 1 );
+   }
+
+   const Handle handle = m_freeHandles.back();
+   m_freeHandles.pop_back();
+   m_ranges[ handle ] = range;
+   return handle;
+}
+
+
+void ChunkMeshArena::Free( Handle handle )
+{
+   Range& range = m_ranges[ handle ];
+   assert( range.vertexCount > 0 );
+
+   m_vertices.Free( range.firstVertex );
+   m_indices.Free( range.firstIndex );
+   range = {};
+   m_freeHandles.push_back( handle );
+}
+
+
+/*static*/ uint32_t ChunkMeshArena::NextCapacity( const RangeAllocator& allocator, uint32_t size ) noexcept
+{
+   uint32_t capacity = ( std::max )( allocator.GetCapacity(), 1u );
+   while( static_cast< uint64_t >( allocator.GetUsed() ) + size > capacity / 2 )
+      capacity *= 2;
+
+   return capacity;
+}
+
+
+void ChunkMeshArena::Rebuild( uint32_t vertexCapacity, uint32_t indexCapacity )
+{
+   RenderDevice& device = RenderDevice::Get();
+   const GLuint  vbo    = device.CreateBuffer();
+   const GLuint  ebo    = device.CreateBuffer();
+   device.BindBuffer( GL_COPY_WRITE_BUFFER, vbo );
+   device.BufferData( GL_COPY_WRITE_BUFFER, static_cast< GLsizeiptr >( vertexCapacity ) * m_vertexStride, nullptr, GL_DYNAMIC_DRAW );
+   device.BindBuffer( GL_COPY_WRITE_BUFFER, ebo );
+   device.BufferData( GL_COPY_WRITE_BUFFER, static_cast< GLsizeiptr >( indexCapacity ) * sizeof( uint32_t ), nullptr, GL_DYNAMIC_DRAW );
+
+   // Packing keeps the order of live ranges, so each moved range is found by its old offset
+   auto pack = []( RangeAllocator& allocator, uint32_t capacity )
+   {
+      std::unordered_map< uint32_t, uint32_t > moved;
+      for( const RangeAllocator::Move& move : allocator.Compact() )
+         moved.emplace( move.from, move.to );
+
+      allocator.Grow( capacity );
+      return moved;
+   };
+   const auto movedVertices = pack( m_vertices, vertexCapacity );
+   const auto movedIndices  = pack( m_indices, indexCapacity );
+
+   auto copy = [ & ]( GLuint from, GLuint to, uint32_t src, uint32_t dst, uint32_t count, uint32_t stride )
+   {
+      device.BindBuffer( GL_COPY_READ_BUFFER, from );
+      device.BindBuffer( GL_COPY_WRITE_BUFFER, to );
+      device.CopyBufferSubData( GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast< GLintptr >( src ) * stride, static_cast< GLintptr >( dst ) * stride, static_cast< GLsizeiptr >( count ) * stride );
+   };
+
+   for( Range& range : m_ranges )
+   {
+      if( range.vertexCount == 0 )
+         continue;
+
+      const auto vertexIt = movedVertices.find( range.firstVertex );
+      const auto indexIt  = movedIndices.find( range.firstIndex );
+      const Range packed { .firstVertex = vertexIt != movedVertices.end() ? vertexIt->second : range.firstVertex,
+                           .vertexCount = range.vertexCount,
+                           .firstIndex  = indexIt != movedIndices.end() ? indexIt->second : range.firstIndex,
+                           .indexCount  = range.indexCount };
+
+      copy( m_vbo, vbo, range.firstVertex, packed.firstVertex, range.vertexCount, m_vertexStride );
+      copy( m_ebo, ebo, range.firstIndex, packed.firstIndex, range.indexCount, sizeof( uint32_t ) );
+      range = packed;
+   }
+
+   device.BindBuffer( GL_COPY_READ_BUFFER, 0 );
+   device.BindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+
+   if( m_vbo )
+      device.DeleteBuffer( m_vbo );
+   if( m_ebo )
+      device.DeleteBuffer( m_ebo );
+
+   m_vbo = vbo;
+   m_ebo = ebo;
+   ++m_generation;
+}
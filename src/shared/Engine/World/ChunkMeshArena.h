@@ -0,0 +1,62 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <Engine/World/RangeAllocator.h>
+
+// ----------------------------------------------------------------
+// ChunkMeshArena - every chunk mesh in one vertex buffer and one index buffer
+// ----------------------------------------------------------------
+// Meshes are copied into ranges handed out by a RangeAllocator per buffer, so the terrain draws from a single
+// vertex array with indirect commands instead of binding a vertex array per section. Indices stay relative to the
+// mesh's first vertex; draws add it back as the base vertex.
+//
+// When a mesh does not fit, live meshes are copied into fresh buffers packed from the front, doubling their size
+// if they would be more than half full. Handles stay valid across that; buffer names do not.
+class ChunkMeshArena
+{
+public:
+   using Handle                           = uint32_t;
+   static constexpr Handle INVALID_HANDLE = ~0u;
+
+   struct Range
+   {
+      uint32_t firstVertex { 0 };
+      uint32_t vertexCount { 0 };
+      uint32_t firstIndex { 0 };
+      uint32_t indexCount { 0 };
+   };
+
+   // Capacities are in vertices and indices; GL buffers are created with the first mesh
+   ChunkMeshArena( uint32_t vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity );
+   ~ChunkMeshArena();
+
+   Handle Allocate( const void* pVertices, uint32_t vertexCount, std::span< const uint32_t > indices );
+   void   Free( Handle handle );
+
+   const Range& GetRange( Handle handle ) const noexcept { return m_ranges[ handle ]; }
+
+   GLuint   GetVertexBuffer() const noexcept { return m_vbo; }
+   GLuint   GetIndexBuffer() const noexcept { return m_ebo; }
+   uint32_t GetGeneration() const noexcept { return m_generation; } // changes whenever the buffers are replaced
+
+   const RangeAllocator& GetVertexAllocator() const noexcept { return m_vertices; }
+   const RangeAllocator& GetIndexAllocator() const noexcept { return m_indices; }
+
+private:
+   NO_COPY_MOVE( ChunkMeshArena )
+
+   void Rebuild( uint32_t vertexCapacity, uint32_t indexCapacity );
+
+   // Capacity that leaves `size` more units at most half of it once packed
+   static uint32_t NextCapacity( const RangeAllocator& allocator, uint32_t size ) noexcept;
+
+   uint32_t              m_vertexStride;
+   RangeAllocator        m_vertices;
+   RangeAllocator        m_indices;
+   GLuint                m_vbo { 0 };
+   GLuint                m_ebo { 0 };
+   uint32_t              m_generation { 0 };
+   std::vector< Range >  m_ranges; // by handle; freed ones have no vertices
+   std::vector< Handle > m_freeHandles;
+};
@@ -1,5 +1,6 @@
 #include "ChunkRenderer.h"
 
+#include <Engine/Renderer/RenderDevice.h>
 #include <Engine/Renderer/Texture.h>
 
 namespace
@@ -49,32 +50,120 @@ constexpr glm::vec2 kQuadUVs[ 4 ] = {
    { 0.0f, 1.0f }
 };
 
+// Light level -> brightness; each level is 20% darker so caves fall off quickly but never go fully black
+constexpr auto kLightBrightness = []()
+{
+   std::array< float, MAX_LIGHT_LEVEL + 1 > brightness {};
+   float                                    falloff = 1.0f;
+   for( int level = MAX_LIGHT_LEVEL; level >= 0; --level, falloff *= 0.8f )
+      brightness[ level ] = 0.05f + 0.95f * falloff;
+
+   return brightness;
+}();
+
+// Faces are lit by the block they face; block light is slightly warm
+glm::vec3 LightTint( uint8_t skyLight, uint8_t blockLight )
+{
+   return glm::max( glm::vec3( kLightBrightness[ skyLight ] ), kLightBrightness[ blockLight ] * glm::vec3( 1.0f, 0.9f, 0.75f ) );
+}
+
+// The face looking back at a block from the neighbor in each direction
+constexpr std::array< size_t, 6 > kOppositeFaces = { 2, 3, 0, 1, 5, 4 };
+
+// The quad on one side of a full-detail block, or false when a solid neighbor covers it. A quad depends only on
+// the block, the neighbor it faces and that neighbor's light.
+bool FSectionFace( const Level& level, const Chunk& chunk, LocalBlockPos pos, BlockState state, const Direction& dir, std::array< ChunkRenderer::Vertex, 4 >& out )
+{
+   const LocalBlockPos nlocal { pos.x + dir.dx, pos.y + dir.dy, pos.z + dir.dz };
+   const WorldBlockPos nworld { chunk.GetChunkPos().x * CHUNK_SIZE_X + nlocal.x, nlocal.y, chunk.GetChunkPos().z * CHUNK_SIZE_Z + nlocal.z };
+   const BlockState    neighborState = chunk.FInBounds( nlocal ) ? chunk.GetBlock( nlocal ) : level.GetBlock( nworld );
+   if( neighborState.GetId() != BlockId::Air )
+      return false;
+
+   const bool      fSameColumn = nlocal.x >= 0 && nlocal.x < CHUNK_SIZE_X && nlocal.z >= 0 && nlocal.z < CHUNK_SIZE_Z;
+   const uint8_t   skyLight    = fSameColumn ? chunk.GetSkyLight( nlocal ) : level.GetSkyLight( nworld );
+   const uint8_t   blockLight  = fSameColumn ? chunk.GetBlockLight( nlocal ) : level.GetBlockLight( nworld );
+   const glm::vec3 tint        = LightTint( skyLight, blockLight );
+
+   const TextureAtlas::Region& region  = TextureAtlasManager::Get().GetRegion( state, dir.face );
+   const float                 layerF  = static_cast< float >( region.layer );
+   const glm::vec3             basePos = glm::vec3( static_cast< float >( pos.x ), static_cast< float >( pos.y ), static_cast< float >( pos.z ) );
+   for( int i = 0; i < 4; ++i )
+   {
+      ChunkRenderer::Vertex& v      = out[ i ];
+      const int              uvIdx  = kFaceUVs[ static_cast< size_t >( dir.face ) ][ i ];
+      const glm::vec2&       quadUV = kQuadUVs[ uvIdx ];
+      v.position = basePos + kFaceVerts[ static_cast< size_t >( dir.face ) ][ i ];
+      v.normal   = dir.normal;
+      v.uv       = glm::vec3( quadUV.x, quadUV.y, layerF );
+      v.tint     = tint;
+   }
+
+   return true;
 }
 
-void ChunkRenderer::DestroySectionGL( SectionEntry& e )
+}
+
+void ChunkRenderer::MeshData::AddQuad( size_t face, uint32_t firstVertex )
 {
-   if( e.vao )
-      glDeleteVertexArrays( 1, &e.vao );
-   if( e.vbo )
-      glDeleteBuffers( 1, &e.vbo );
-   if( e.ebo )
-      glDeleteBuffers( 1, &e.ebo );
+   std::vector< uint32_t >& group = m_faceIndices[ face ];
+   group.insert( group.end(), { firstVertex + 0, firstVertex + 1, firstVertex + 2, firstVertex + 0, firstVertex + 2, firstVertex + 3 } );
+}
 
-   e.vao           = 0;
-   e.vbo           = 0;
-   e.ebo           = 0;
-   e.indexCount    = 0;
+void ChunkRenderer::MeshData::JoinFaces()
+{
+   indices.clear();
+   for( size_t face = 0; face < FACE_COUNT; ++face )
+   {
+      indices.insert( indices.end(), m_faceIndices[ face ].begin(), m_faceIndices[ face ].end() );
+      faceIndexCounts[ face ] = static_cast< uint32_t >( m_faceIndices[ face ].size() );
+   }
+}
+
+ChunkRenderer::ChunkRenderer() :
+   m_arena( sizeof( Vertex ), ARENA_VERTICES, ARENA_INDICES )
+{}
+
+ChunkRenderer::~ChunkRenderer()
+{
+   Clear();
+
+   RenderDevice& device = RenderDevice::Get();
+   if( m_vao )
+      device.DeleteVertexArray( m_vao );
+   if( m_commandBuffer )
+      device.DeleteBuffer( m_commandBuffer );
+   if( m_originBuffer )
+      device.DeleteBuffer( m_originBuffer );
+}
+
+void ChunkRenderer::Release( SectionEntry& e )
+{
+   DropFaces( e );
+   if( e.mesh != ChunkMeshArena::INVALID_HANDLE )
+      m_arena.Free( e.mesh );
+
+   e.mesh          = ChunkMeshArena::INVALID_HANDLE;
    e.builtRevision = 0;
+   e.visibility    = SectionVisibility::All();
    e.fEmpty        = true;
+   e.faceFirstIndex.fill( 0 );
+   e.faceIndexCounts.fill( 0 );
 }
 
 void ChunkRenderer::Clear()
 {
    for( auto& [ _, ce ] : m_entries )
+   {
       for( auto& sec : ce.sections )
-         DestroySectionGL( sec );
+         Release( sec );
+
+      Release( ce.coarse );
+   }
 
    m_entries.clear();
+   m_culler.Clear();
+   m_boundsOwners.clear();
 }
 
 std::tuple< ChunkPos, LocalBlockPos > ChunkRenderer::WorldToChunkPos( WorldBlockPos wpos )
@@ -99,16 +188,29 @@ bool ChunkRenderer::InView( const ChunkPos& cc, const ChunkPos& center, uint8_t
    return std::abs( cc.x - center.x ) <= viewRadius && std::abs( cc.z - center.z ) <= viewRadius;
 }
 
+int ChunkRenderer::ChooseLod( int distance, int current ) noexcept
+{
+   const int lod = static_cast< int >( std::ranges::count_if( LOD_RING_DISTANCES, [ distance ]( int ring ) { return distance >= ring; } ) );
+   if( current < 0 || current == lod )
+      return lod;
+
+   // Hold the current level until the chunk is a full step past the ring it would cross, so walking along a
+   // ring boundary does not rebuild the same chunks back and forth
+   if( lod > current )
+      return distance >= LOD_RING_DISTANCES[ current ] + LOD_HYSTERESIS ? lod : current;
+
+   return distance < LOD_RING_DISTANCES[ current - 1 ] - LOD_HYSTERESIS ? lod : current;
+}
+
 void ChunkRenderer::BuildSectionMesh( const Level& level, const Chunk& chunk, int sectionIndex, MeshData& out )
 {
    out.Clear();
    out.vertices.reserve( CHUNK_SECTION_VOLUME * 4 );
    out.indices.reserve( CHUNK_SECTION_VOLUME * 6 );
 
-   const int baseWX = chunk.GetChunkPos().x * CHUNK_SIZE_X;
-   const int baseWZ = chunk.GetChunkPos().z * CHUNK_SIZE_Z;
-   const int baseY  = sectionIndex * CHUNK_SECTION_SIZE;
+   const int baseY = sectionIndex * CHUNK_SECTION_SIZE;
 
+   std::array< Vertex, 4 > quad;
    for( int x = 0; x < CHUNK_SIZE_X; ++x )
    {
       for( int ly = 0; ly < CHUNK_SECTION_SIZE; ++ly )
@@ -117,130 +219,584 @@ void ChunkRenderer::BuildSectionMesh( const Level& level, const Chunk& chunk, in
          for( int z = 0; z < CHUNK_SIZE_Z; ++z )
          {
             const BlockState state = chunk.GetBlock( LocalBlockPos { x, y, z } );
-            const BlockId    id    = state.GetId();
-            if( id == BlockId::Air )
+            if( state.GetId() == BlockId::Air )
                continue;
 
-            const WorldBlockPos wpos { baseWX + x, y, baseWZ + z };
-            const glm::vec3     basePos( static_cast< float >( x ), static_cast< float >( y ), static_cast< float >( z ) );
+            const size_t block = ChunkSection::ToIndex( LocalBlockPos { x, ly, z } );
             for( const Direction& dir : directions )
             {
-               const LocalBlockPos nlocal { x + dir.dx, y + dir.dy, z + dir.dz };
-               const WorldBlockPos nworld { wpos.x + dir.dx, wpos.y + dir.dy, wpos.z + dir.dz };
-               BlockState          neighborState = chunk.FInBounds( nlocal ) ? chunk.GetBlock( nlocal ) : level.GetBlock( nworld );
-               if( neighborState.GetId() != BlockId::Air )
+               if( !FSectionFace( level, chunk, LocalBlockPos { x, y, z }, state, dir, quad ) )
                   continue;
 
-               const TextureAtlas::Region& region      = TextureAtlasManager::Get().GetRegion( state, dir.face );
+               const size_t face = static_cast< size_t >( dir.face );
+               out.AddQuad( face, static_cast< uint32_t >( out.vertices.size() ) );
+               out.vertices.insert( out.vertices.end(), quad.begin(), quad.end() );
+               out.quadFaces.push_back( static_cast< uint16_t >( block * FACE_COUNT + face ) );
+            }
+         }
+      }
+   }
+
+   out.JoinFaces();
+}
+
+void ChunkRenderer::BuildCoarseMesh( const Level& level, const Chunk& chunk, int lod, MeshData& out )
+{
+   out.Clear();
+
+   const int size    = 1 << lod;
+   const int cellsXZ = CHUNK_SIZE_X / size;
+   const int cellsY  = CHUNK_SIZE_Y / size;
+
+   std::vector< BlockId > cells( static_cast< size_t >( cellsXZ * cellsXZ * cellsY ), BlockId::Air );
+   auto                   cellAt = [ & ]( int x, int y, int z ) -> BlockId&
+   {
+      return cells[ static_cast< size_t >( x + z * cellsXZ + y * cellsXZ * cellsXZ ) ];
+   };
+
+   // Majority vote: a cell is solid when at least half its blocks are, and takes its most common solid block.
+   // Blocks are counted top down and ties keep the first, so grass wins over the dirt beneath it.
+   std::array< uint16_t, static_cast< size_t >( BlockId::Count ) > counts;
+   for( int cy = 0; cy < cellsY; ++cy )
+   {
+      for( int cz = 0; cz < cellsXZ; ++cz )
+      {
+         for( int cx = 0; cx < cellsXZ; ++cx )
+         {
+            counts.fill( 0 );
+            int     solid = 0;
+            BlockId best  = BlockId::Air;
+            for( int by = size - 1; by >= 0; --by )
+            {
+               for( int bz = 0; bz < size; ++bz )
+               {
+                  for( int bx = 0; bx < size; ++bx )
+                  {
+                     const BlockId id = chunk.GetBlock( LocalBlockPos { cx * size + bx, cy * size + by, cz * size + bz } ).GetId();
+                     if( id == BlockId::Air )
+                        continue;
+
+                     ++solid;
+                     if( ++counts[ static_cast< size_t >( id ) ] > counts[ static_cast< size_t >( best ) ] )
+                        best = id;
+                  }
+               }
+            }
+
+            if( solid * 2 >= size * size * size )
+               cellAt( cx, cy, cz ) = best;
+         }
+      }
+   }
+
+   auto fOpen = [ & ]( int x, int y, int z ) { return y >= cellsY || ( y >= 0 && cellAt( x, y, z ) == BlockId::Air ); };
+
+   const int baseWX = chunk.GetChunkPos().x * CHUNK_SIZE_X;
+   const int baseWZ = chunk.GetChunkPos().z * CHUNK_SIZE_Z;
+   for( int cy = 0; cy < cellsY; ++cy )
+   {
+      for( int cz = 0; cz < cellsXZ; ++cz )
+      {
+         for( int cx = 0; cx < cellsXZ; ++cx )
+         {
+            const BlockId material = cellAt( cx, cy, cz );
+            if( material == BlockId::Air )
+               continue;
+
+            // Neighbors may be meshed at another level, so the top two cells of every column always get their
+            // walls on the chunk border. They hang down past any step between the levels and hide the seam.
+            const bool fSkirt = fOpen( cx, cy + 1, cz ) || fOpen( cx, cy + 2, cz );
+
+            const glm::ivec3 cellMin( cx * size, cy * size, cz * size );
+            for( const Direction& dir : directions )
+            {
+               const int  nx      = cx + dir.dx;
+               const int  nz      = cz + dir.dz;
+               const bool fBorder = nx < 0 || nx >= cellsXZ || nz < 0 || nz >= cellsXZ;
+               if( fBorder ? !fSkirt : !fOpen( nx, cy + dir.dy, nz ) )
+                  continue;
+
+               // Faces are lit by the block just outside their center
+               const glm::ivec3    outside = cellMin + glm::ivec3( dir.dx < 0 ? -1 : dir.dx > 0 ? size : size / 2,
+                                                                dir.dy < 0 ? -1 : dir.dy > 0 ? size : size / 2,
+                                                                dir.dz < 0 ? -1 : dir.dz > 0 ? size : size / 2 );
+               const LocalBlockPos nlocal { outside.x, outside.y, outside.z };
+               const WorldBlockPos nworld { baseWX + outside.x, outside.y, baseWZ + outside.z };
+               const uint8_t       skyLight   = fBorder ? level.GetSkyLight( nworld ) : chunk.GetSkyLight( nlocal );
+               const uint8_t       blockLight = fBorder ? level.GetBlockLight( nworld ) : chunk.GetBlockLight( nlocal );
+               const glm::vec3     tint       = LightTint( skyLight, blockLight );
+
+               const TextureAtlas::Region& region      = TextureAtlasManager::Get().GetRegion( BlockState( material ), dir.face );
                const float                 layerF      = static_cast< float >( region.layer );
                const uint32_t              indexOffset = static_cast< uint32_t >( out.vertices.size() );
                for( int i = 0; i < 4; ++i )
                {
-                  Vertex            v {};
-                  const int         uvIdx = kFaceUVs[ static_cast< size_t >( dir.face ) ][ i ];
-                  const glm::vec2&  quadUV = kQuadUVs[ uvIdx ];
-                  v.position = basePos + kFaceVerts[ static_cast< size_t >( dir.face ) ][ i ];
+                  Vertex           v {};
+                  const int        uvIdx  = kFaceUVs[ static_cast< size_t >( dir.face ) ][ i ];
+                  const glm::vec2& quadUV = kQuadUVs[ uvIdx ];
+                  v.position = glm::vec3( cellMin ) + kFaceVerts[ static_cast< size_t >( dir.face ) ][ i ] * static_cast< float >( size );
                   v.normal   = dir.normal;
                   v.uv       = glm::vec3( quadUV.x, quadUV.y, layerF );
-                  v.tint     = glm::vec3( 1.0f );
+                  v.tint     = tint;
                   out.vertices.push_back( v );
                }
 
-               out.indices.push_back( indexOffset + 0 );
-               out.indices.push_back( indexOffset + 1 );
-               out.indices.push_back( indexOffset + 2 );
-
-               out.indices.push_back( indexOffset + 0 );
-               out.indices.push_back( indexOffset + 2 );
-               out.indices.push_back( indexOffset + 3 );
+               out.AddQuad( static_cast< size_t >( dir.face ), indexOffset );
             }
          }
       }
    }
+
+   out.JoinFaces();
 }
 
 void ChunkRenderer::Update( Level& level, const glm::vec3& playerPos, uint8_t viewRadius )
 {
    level.UpdateStreaming( playerPos, viewRadius );
+   m_viewRadius = viewRadius;
 
    auto [ playerChunk, _ ] = WorldToChunkPos( WorldBlockPos { playerPos } );
+
    for( auto it = m_entries.begin(); it != m_entries.end(); )
    {
       if( !InView( it->first, playerChunk, viewRadius ) )
       {
          for( auto& sec : it->second.sections )
-            DestroySectionGL( sec );
+            Release( sec );
+
+         Release( it->second.coarse );
 
-         it = m_entries.erase( it );
+         it             = m_entries.erase( it );
+         m_fBoundsDirty = true;
       }
       else
          ++it;
    }
 
    MeshData mesh;
-   for( const auto& [ cc, chunk ] : level.GetChunks() )
+   int      coarseBudget = COARSE_BUILDS_PER_UPDATE;
+   level.GetChunks().ForEach( [ & ]( const Chunk& chunk )
    {
-      if( !InView( cc, playerChunk, viewRadius ) )
-         continue;
+      // Wait for the chunk's light rather than flashing it dark for a tick
+      const ChunkPos cc = chunk.GetChunkPos();
+      if( !InView( cc, playerChunk, viewRadius ) || !chunk.FLit() )
+         return;
+
+      auto [ it, fInserted ] = m_entries.try_emplace( cc );
+      m_fBoundsDirty |= fInserted;
 
-      Entry&         ce  = m_entries[ cc ];
+      Entry&         ce  = it->second;
+      const int      lod = ChooseLod( ( std::max )( std::abs( cc.x - playerChunk.x ), std::abs( cc.z - playerChunk.z ) ), ce.lod );
       const uint64_t rev = chunk.MeshRevision();
-      if( ce.lastSeenRevision == rev && !Any( chunk.Dirty() & ChunkDirty::Mesh ) )
-         continue;
+      if( ce.lastSeenRevision == rev && !Any( chunk.Dirty() & ChunkDirty::Mesh ) && ce.lod == lod )
+         return;
 
-      for( const auto& [ i, sec ] : ce.sections | std::views::enumerate )
+      if( lod > 0 )
       {
-         if( sec.builtRevision == rev && !Any( chunk.Dirty() & ChunkDirty::Mesh ) )
-            continue;
+         // Whatever the chunk showed before stays up until its turn comes
+         if( coarseBudget == 0 )
+            return;
+
+         --coarseBudget;
+         BuildCoarseMesh( level, chunk, lod, mesh );
+         Upload( ce.coarse, mesh );
+         ce.coarse.builtRevision = rev;
+         for( auto& sec : ce.sections )
+            Release( sec );
+      }
+      else
+      {
+         // When the chunk lists every edit since its sections were built, only the sections around the edits
+         // change. A section is rebuilt on its first edit and keeps a face map, so later ones patch it in place.
+         const bool fPatch = !chunk.FMeshRebuild() && ce.lod == 0;
+         if( fPatch )
+            GatherFaceEdits( chunk.MeshEdits() );
+
+         for( const auto& [ i, sec ] : ce.sections | std::views::enumerate )
+         {
+            if( sec.builtRevision == rev && !Any( chunk.Dirty() & ChunkDirty::Mesh ) )
+               continue;
+
+            const std::vector< uint16_t >& faceEdits = m_faceEdits[ static_cast< size_t >( i ) ];
+            if( fPatch && sec.builtRevision != 0 )
+            {
+               if( faceEdits.empty() )
+               {
+                  sec.builtRevision = rev;
+                  continue;
+               }
+
+               if( sec.pFaces && FPatchSection( level, chunk, static_cast< int >( i ), sec, faceEdits ) )
+               {
+                  sec.builtRevision = rev;
+                  sec.visibility    = SectionVisibility::Compute( chunk.GetSections()[ i ].Snapshot() );
+                  continue;
+               }
+            }
+
+            BuildSectionMesh( level, chunk, i, mesh );
+            if( fPatch && !faceEdits.empty() && !mesh.FEmpty() )
+               UploadPatchable( sec, mesh );
+            else
+               Upload( sec, mesh );
 
-         BuildSectionMesh( level, chunk, i, mesh );
-         Upload( sec, mesh );
-         sec.builtRevision = rev;
+            sec.builtRevision = rev;
+            sec.visibility    = SectionVisibility::Compute( chunk.GetSections()[ i ].Snapshot() );
+         }
+
+         Release( ce.coarse );
       }
 
+      m_fBoundsDirty |= ce.lod != lod;
+
       ce.lastSeenRevision = rev;
+      ce.lod              = lod;
       const_cast< Chunk& >( chunk ).ClearDirty( ChunkDirty::Mesh );
+   } );
+
+   if( m_fBoundsDirty )
+      RebuildBounds();
+}
+
+void ChunkRenderer::RebuildBounds()
+{
+   m_culler.Clear();
+   m_boundsOwners.clear();
+   for( auto& [ cc, ce ] : m_entries )
+   {
+      const glm::vec3 columnMin( static_cast< float >( cc.x * CHUNK_SIZE_X ), 0.0f, static_cast< float >( cc.z * CHUNK_SIZE_Z ) );
+      const glm::vec3 columnMax = columnMin + glm::vec3( CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z );
+      m_culler.AddColumn( columnMin, columnMax );
+
+      if( ce.lod == 0 )
+      {
+         for( int i = 0; i < SECTIONS_PER_CHUNK; ++i )
+         {
+            const glm::vec3 secMin( columnMin.x, static_cast< float >( i * CHUNK_SECTION_SIZE ), columnMin.z );
+            const uint32_t  index = m_culler.Add( secMin, secMin + glm::vec3( CHUNK_SIZE_X, CHUNK_SECTION_SIZE, CHUNK_SIZE_Z ) );
+            if( i == 0 )
+               ce.firstBounds = index;
+
+            m_boundsOwners.push_back( BoundsOwner { .cc = cc, .pEntry = &ce, .section = i } );
+         }
+      }
+      else
+      {
+         ce.firstBounds = m_culler.Add( columnMin, columnMax );
+         m_boundsOwners.push_back( BoundsOwner { .cc = cc, .pEntry = &ce, .section = -1 } );
+      }
    }
+
+   m_fBoundsDirty = false;
+}
+
+SectionVisibility ChunkRenderer::GetVisibility( const SectionPos& pos ) const
+{
+   const auto it = m_entries.find( ChunkPos { pos.x, pos.z } );
+   if( it == m_entries.end() || it->second.lod != 0 || pos.y < 0 || pos.y >= SECTIONS_PER_CHUNK )
+      return SectionVisibility::All();
+
+   return it->second.sections[ static_cast< size_t >( pos.y ) ].visibility;
 }
 
 void ChunkRenderer::Upload( SectionEntry& e, const MeshData& mesh )
 {
-   if( mesh.FEmpty() )
+   DropFaces( e );
+   if( e.mesh != ChunkMeshArena::INVALID_HANDLE )
+      m_arena.Free( e.mesh );
+
+   e.mesh            = mesh.FEmpty() ? ChunkMeshArena::INVALID_HANDLE : m_arena.Allocate( mesh.vertices.data(), static_cast< uint32_t >( mesh.vertices.size() ), mesh.indices );
+   e.fEmpty          = mesh.FEmpty();
+   e.faceIndexCounts = mesh.faceIndexCounts;
+
+   uint32_t firstIndex = 0;
+   for( size_t face = 0; face < FACE_COUNT; ++face )
+   {
+      e.faceFirstIndex[ face ] = firstIndex;
+      firstIndex += mesh.faceIndexCounts[ face ];
+   }
+}
+
+// ----------------------------------------------------------------
+// Patching single-block edits
+// ----------------------------------------------------------------
+void ChunkRenderer::GatherFaceEdits( std::span< const LocalBlockPos > edits )
+{
+   for( std::vector< uint16_t >& keys : m_faceEdits )
+      keys.clear();
+
+   auto add = [ this ]( int x, int y, int z, size_t face )
+   {
+      if( x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z )
+         return;
+
+      const size_t block = ChunkSection::ToIndex( LocalBlockPos { x, y % CHUNK_SECTION_SIZE, z } );
+      m_faceEdits[ static_cast< size_t >( y / CHUNK_SECTION_SIZE ) ].push_back( static_cast< uint16_t >( block * FACE_COUNT + face ) );
+   };
+
+   // Every face of an edited block, and the face of each neighbor that looks at it: up to 12 quads over 7 blocks
+   for( const LocalBlockPos& pos : edits )
+   {
+      for( const Direction& dir : directions )
+      {
+         const size_t face = static_cast< size_t >( dir.face );
+         add( pos.x, pos.y, pos.z, face );
+         add( pos.x + dir.dx, pos.y + dir.dy, pos.z + dir.dz, kOppositeFaces[ face ] );
+      }
+   }
+
+   // Light edits list the same block once per channel and pass
+   for( std::vector< uint16_t >& keys : m_faceEdits )
+   {
+      std::ranges::sort( keys );
+      keys.erase( std::ranges::unique( keys ).begin(), keys.end() );
+   }
+}
+
+void ChunkRenderer::UploadPatchable( SectionEntry& e, const MeshData& mesh )
+{
+   if( !e.pFaces )
    {
-      e.indexCount = 0;
-      e.fEmpty     = true;
+      if( m_patchable.size() == MAX_PATCHABLE_SECTIONS )
+         DropFaces( **std::ranges::min_element( m_patchable, {}, []( const SectionEntry* p ) { return p->pFaces->lastUsed; } ) );
+
+      e.pFaces = std::make_unique< SectionFaces >();
+      m_patchable.push_back( &e );
+   }
+
+   // Each group gets a quarter again as many slots, so a run of edits rarely outgrows it
+   constexpr uint32_t MIN_SPARE_QUADS = 8;
+
+   SectionFaces& faces = *e.pFaces;
+   uint32_t      slots = 0;
+   for( size_t face = 0; face < FACE_COUNT; ++face )
+   {
+      faces.quads[ face ]     = mesh.faceIndexCounts[ face ] / 6;
+      faces.capacity[ face ]  = faces.quads[ face ] + ( std::max )( faces.quads[ face ] / 4, MIN_SPARE_QUADS );
+      faces.firstSlot[ face ] = slots;
+      slots += faces.capacity[ face ];
+   }
+   faces.slotFaces.assign( slots, 0 );
+   faces.faceSlots.assign( CHUNK_SECTION_VOLUME * FACE_COUNT, SectionFaces::NO_SLOT );
+   faces.patches  = 0;
+   faces.lastUsed = ++m_patchClock;
+
+   // Quads move from the order they were meshed in to their group's slots; spare slots are never drawn. The index
+   // pattern is the same for every slot, whatever group it is in.
+   m_patchMesh.Clear();
+   m_patchMesh.vertices.resize( static_cast< size_t >( slots ) * 4 );
+   for( uint32_t slot = 0; slot < slots; ++slot )
+      m_patchMesh.AddQuad( 0, slot * 4 );
+   m_patchMesh.JoinFaces();
+
+   size_t joined = 0; // into mesh.indices, a quad at a time
+   for( size_t face = 0; face < FACE_COUNT; ++face )
+   {
+      for( uint32_t slot = faces.firstSlot[ face ]; slot < faces.firstSlot[ face ] + faces.quads[ face ]; ++slot, joined += 6 )
+      {
+         const size_t   quad = mesh.indices[ joined ] / 4;
+         const uint16_t key  = mesh.quadFaces[ quad ];
+         std::copy_n( mesh.vertices.begin() + static_cast< ptrdiff_t >( quad * 4 ), 4, m_patchMesh.vertices.begin() + static_cast< ptrdiff_t >( slot ) * 4 );
+         faces.slotFaces[ slot ] = key;
+         faces.faceSlots[ key ]  = static_cast< uint16_t >( slot );
+      }
+   }
+
+   if( e.mesh != ChunkMeshArena::INVALID_HANDLE )
+      m_arena.Free( e.mesh );
+
+   e.mesh   = m_arena.Allocate( m_patchMesh.vertices.data(), static_cast< uint32_t >( m_patchMesh.vertices.size() ), m_patchMesh.indices );
+   e.fEmpty = mesh.FEmpty();
+   for( size_t face = 0; face < FACE_COUNT; ++face )
+   {
+      e.faceFirstIndex[ face ]  = faces.firstSlot[ face ] * 6;
+      e.faceIndexCounts[ face ] = faces.quads[ face ] * 6;
+   }
+}
+
+bool ChunkRenderer::FPatchSection( const Level& level, const Chunk& chunk, int sectionIndex, SectionEntry& e, std::span< const uint16_t > faceKeys )
+{
+   SectionFaces& faces = *e.pFaces;
+   if( ++faces.patches > PATCHES_PER_BUILD )
+      return false;
+
+   faces.lastUsed = ++m_patchClock;
+
+   const uint32_t firstVertex = m_arena.GetRange( e.mesh ).firstVertex;
+   auto           slotOffset  = [ firstVertex ]( uint32_t slot ) { return static_cast< GLintptr >( firstVertex + slot * 4 ) * static_cast< GLintptr >( sizeof( Vertex ) ); };
+
+   RenderDevice& device = RenderDevice::Get();
+   device.BindBuffer( GL_COPY_READ_BUFFER, m_arena.GetVertexBuffer() );
+   device.BindBuffer( GL_COPY_WRITE_BUFFER, m_arena.GetVertexBuffer() );
+
+   bool                    fFits = true;
+   std::array< Vertex, 4 > quad;
+   for( const uint16_t key : faceKeys )
+   {
+      const size_t        face  = key % FACE_COUNT;
+      const int           block = static_cast< int >( key / FACE_COUNT );
+      const LocalBlockPos pos { block % CHUNK_SIZE_X, sectionIndex * CHUNK_SECTION_SIZE + block / ( CHUNK_SIZE_X * CHUNK_SIZE_Z ), block / CHUNK_SIZE_X % CHUNK_SIZE_Z };
+      const BlockState    state = chunk.GetBlock( pos );
+
+      uint16_t& slot = faces.faceSlots[ key ];
+      if( state.GetId() != BlockId::Air && FSectionFace( level, chunk, pos, state, directions[ face ], quad ) )
+      {
+         if( slot == SectionFaces::NO_SLOT )
+         {
+            if( faces.quads[ face ] == faces.capacity[ face ] )
+            {
+               fFits = false;
+               break;
+            }
+
+            slot                    = static_cast< uint16_t >( faces.firstSlot[ face ] + faces.quads[ face ]++ );
+            faces.slotFaces[ slot ] = key;
+         }
+
+         device.BufferSubData( GL_COPY_WRITE_BUFFER, slotOffset( slot ), sizeof( quad ), quad.data() );
+      }
+      else if( slot != SectionFaces::NO_SLOT )
+      {
+         const uint32_t last = faces.firstSlot[ face ] + --faces.quads[ face ];
+         if( slot != last )
+         {
+            device.CopyBufferSubData( GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, slotOffset( last ), slotOffset( slot ), sizeof( quad ) );
+            faces.slotFaces[ slot ]                    = faces.slotFaces[ last ];
+            faces.faceSlots[ faces.slotFaces[ slot ] ] = slot;
+         }
+
+         slot = SectionFaces::NO_SLOT;
+      }
+   }
+
+   device.BindBuffer( GL_COPY_READ_BUFFER, 0 );
+   device.BindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+   if( !fFits )
+      return false;
+
+   uint32_t quads = 0;
+   for( size_t face = 0; face < FACE_COUNT; ++face )
+   {
+      e.faceIndexCounts[ face ] = faces.quads[ face ] * 6;
+      quads += faces.quads[ face ];
+   }
+   e.fEmpty = quads == 0;
+   return true;
+}
+
+void ChunkRenderer::DropFaces( SectionEntry& e )
+{
+   if( !e.pFaces )
       return;
+
+   // The mesh keeps its slot layout and draws as it is
+   e.pFaces.reset();
+   m_patchable.erase( std::ranges::find( m_patchable, &e ) );
+}
+
+static_assert( sizeof( ChunkRenderer::DrawCommand ) == 5 * sizeof( uint32_t ), "DrawCommand must match DrawElementsIndirectCommand" );
+
+uint8_t ChunkRenderer::FacingFaces( const glm::vec3& viewPos, const glm::vec3& boxMin, const glm::vec3& boxMax ) noexcept
+{
+   uint8_t mask = 0;
+   for( const Direction& dir : directions )
+   {
+      // The plane farthest back that a face of this direction can lie on
+      const glm::vec3 back( dir.dx > 0 ? boxMin.x : boxMax.x, dir.dy > 0 ? boxMin.y : boxMax.y, dir.dz > 0 ? boxMin.z : boxMax.z );
+      if( glm::dot( dir.normal, viewPos - back ) > 0.0f )
+         mask |= static_cast< uint8_t >( 1u << static_cast< size_t >( dir.face ) );
+   }
+   return mask;
+}
+
+void ChunkRenderer::Queue( DrawList& list, const SectionEntry& mesh, const glm::vec3& origin, uint8_t faceMask ) const
+{
+   if( mesh.fEmpty )
+      return;
+
+   // Groups that follow on from the last command extend it; every command of the mesh picks the same origin
+   const ChunkMeshArena::Range& range      = m_arena.GetRange( mesh.mesh );
+   const uint32_t               originSlot = static_cast< uint32_t >( list.origins.size() );
+   const size_t                 first      = list.commands.size();
+   for( size_t face = 0; face < FACE_COUNT; ++face )
+   {
+      const uint32_t count      = mesh.faceIndexCounts[ face ];
+      const uint32_t firstIndex = range.firstIndex + mesh.faceFirstIndex[ face ];
+      if( count == 0 || !( ( faceMask >> face ) & 1u ) )
+         continue;
+
+      if( list.commands.size() > first && list.commands.back().firstIndex + list.commands.back().count == firstIndex )
+         list.commands.back().count += count;
+      else
+         list.commands.push_back( DrawCommand { .count        = count,
+                                                .firstIndex   = firstIndex,
+                                                .baseVertex   = static_cast< int32_t >( range.firstVertex ),
+                                                .baseInstance = originSlot } );
    }
 
-   if( !e.vao )
+   if( list.commands.size() > first )
+      list.origins.push_back( origin );
+}
+
+void ChunkRenderer::BindArena()
+{
+   RenderDevice& device = RenderDevice::Get();
+   if( !m_vao )
    {
-      glGenVertexArrays( 1, &e.vao );
-      glGenBuffers( 1, &e.vbo );
-      glGenBuffers( 1, &e.ebo );
+      m_vao           = device.CreateVertexArray();
+      m_commandBuffer = device.CreateBuffer();
+      m_originBuffer  = device.CreateBuffer();
    }
 
-   glBindVertexArray( e.vao );
+   device.BindVertexArray( m_vao );
+
+   device.BindBuffer( GL_ARRAY_BUFFER, m_arena.GetVertexBuffer() );
+   device.BindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_arena.GetIndexBuffer() );
+
+   device.EnableVertexAttribArray( 0 );
+   device.VertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ), offsetof( Vertex, position ) );
+
+   device.EnableVertexAttribArray( 1 );
+   device.VertexAttribPointer( 1, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ), offsetof( Vertex, normal ) );
 
-   glBindBuffer( GL_ARRAY_BUFFER, e.vbo );
-   glBufferData( GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof( Vertex ), mesh.vertices.data(), GL_STATIC_DRAW );
+   device.EnableVertexAttribArray( 2 );
+   device.VertexAttribPointer( 2, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ), offsetof( Vertex, uv ) );
 
-   glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, e.ebo );
-   glBufferData( GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof( uint32_t ), mesh.indices.data(), GL_STATIC_DRAW );
+   device.EnableVertexAttribArray( 3 );
+   device.VertexAttribPointer( 3, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ), offsetof( Vertex, tint ) );
 
-   glEnableVertexAttribArray( 0 );
-   glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ), ( void* )offsetof( Vertex, position ) );
+   // One origin per draw: the command's base instance selects it
+   device.BindBuffer( GL_ARRAY_BUFFER, m_originBuffer );
+   device.EnableVertexAttribArray( 4 );
+   device.VertexAttribPointer( 4, 3, GL_FLOAT, GL_FALSE, sizeof( glm::vec3 ), 0 );
+   device.VertexAttribDivisor( 4, 1 );
+
+   device.BindVertexArray( 0 );
+   device.BindBuffer( GL_ARRAY_BUFFER, 0 );
+
+   m_vaoGeneration = m_arena.GetGeneration();
+}
+
+void ChunkRenderer::Submit( const DrawList& list )
+{
+   if( list.commands.empty() )
+      return;
 
-   glEnableVertexAttribArray( 1 );
-   glVertexAttribPointer( 1, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ), ( void* )offsetof( Vertex, normal ) );
+   // The arena replaces its buffers when it grows or packs, and the vertex array has to follow
+   if( !m_vao || m_vaoGeneration != m_arena.GetGeneration() )
+      BindArena();
 
-   glEnableVertexAttribArray( 2 );
-   glVertexAttribPointer( 2, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ), ( void* )offsetof( Vertex, uv ) );
+   RenderDevice& device = RenderDevice::Get();
+   device.BindBuffer( GL_ARRAY_BUFFER, m_originBuffer );
+   device.BufferData( GL_ARRAY_BUFFER, list.origins.size() * sizeof( glm::vec3 ), list.origins.data(), GL_STREAM_DRAW );
+   device.BindBuffer( GL_ARRAY_BUFFER, 0 );
 
-   glEnableVertexAttribArray( 3 );
-   glVertexAttribPointer( 3, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ), ( void* )offsetof( Vertex, tint ) );
+   device.BindBuffer( GL_DRAW_INDIRECT_BUFFER, m_commandBuffer );
+   device.BufferData( GL_DRAW_INDIRECT_BUFFER, list.commands.size() * sizeof( DrawCommand ), list.commands.data(), GL_STREAM_DRAW );
 
-   glBindVertexArray( 0 );
+   device.BindVertexArray( m_vao );
+   device.MultiDrawElementsIndirect( GL_TRIANGLES, GL_UNSIGNED_INT, 0, static_cast< GLsizei >( list.commands.size() ), 0 );
+   device.BindVertexArray( 0 );
 
-   e.indexCount = static_cast< uint32_t >( mesh.indices.size() );
-   e.fEmpty     = false;
+   device.BindBuffer( GL_DRAW_INDIRECT_BUFFER, 0 );
 }
@@ -2,13 +2,30 @@
 
 #include <glad/glad.h>
 
+#include <Engine/World/ChunkMeshArena.h>
+#include <Engine/World/FrustumCuller.h>
 #include <Engine/World/Level.h>
+#include <Engine/World/SectionVisibility.h>
 
 class ChunkRenderer
 {
 public:
-   ChunkRenderer() noexcept = default;
-   ~ChunkRenderer() { Clear(); }
+   // Chunks past each ring are meshed from cells of 2, 4 and 8 blocks. Surface quads fall with the square of the
+   // cell size, so a 32 chunk view draws about as many as a 12 chunk view at full detail.
+   static constexpr std::array< int, 3 > LOD_RING_DISTANCES { 8, 16, 24 }; // chunks
+   static constexpr int                  LOD_HYSTERESIS           = 1;  // chunks past a ring before switching back
+   static constexpr int                  COARSE_BUILDS_PER_UPDATE = 32; // each reads the whole column
+
+   // Starting size of the shared mesh buffers; a full-detail section averages a few thousand vertices
+   static constexpr uint32_t ARENA_VERTICES = 1u << 20;
+   static constexpr uint32_t ARENA_INDICES  = ARENA_VERTICES / 4 * 6;
+
+   // Sections edited recently keep their face maps so the next edits patch them; see SectionFaces
+   static constexpr size_t MAX_PATCHABLE_SECTIONS = 32;
+   static constexpr int    PATCHES_PER_BUILD      = 64; // edits patched in before the section is rebuilt and packed again
+
+   ChunkRenderer();
+   ~ChunkRenderer();
 
    struct Vertex
    {
@@ -18,51 +35,173 @@ public:
       glm::vec3 tint {};
    };
 
+   // Quads are grouped by the direction they face: north, east, south, west, top, bottom. A mask holds one bit per
+   // group in that order.
+   static constexpr size_t  FACE_COUNT = 6;
+   static constexpr uint8_t ALL_FACES  = ( 1u << FACE_COUNT ) - 1;
+
    struct MeshData
    {
-      std::vector< Vertex >   vertices {};
-      std::vector< uint32_t > indices {};
+      std::vector< Vertex >              vertices {};
+      std::vector< uint32_t >            indices {}; // one run per face group, in mask order
+      std::array< uint32_t, FACE_COUNT > faceIndexCounts {};
+      std::vector< uint16_t >            quadFaces {}; // section meshes: block index * FACE_COUNT + face, by quad
 
       void Clear()
       {
          vertices.clear();
          indices.clear();
+         faceIndexCounts.fill( 0 );
+         quadFaces.clear();
+         for( auto& face : m_faceIndices )
+            face.clear();
       }
 
+      // Two triangles over the four vertices from `firstVertex` on
+      void AddQuad( size_t face, uint32_t firstVertex );
+
+      // Joins the groups into `indices`; call once the last quad is in
+      void JoinFaces();
+
       bool FEmpty() const noexcept { return vertices.empty() || indices.empty(); }
+
+   private:
+      std::array< std::vector< uint32_t >, FACE_COUNT > m_faceIndices {};
    };
 
-   struct SectionEntry
+   // Where each face of a section's blocks sits in its uploaded mesh, so an edit re-meshes the few faces around it
+   // in place. Each face group owns a run of quad slots with room to grow; slot s is vertices 4s to 4s + 3 and
+   // indices 6s to 6s + 5, which never change, so a patch only rewrites the vertices of the slots it touches.
+   // A face that goes away hands its slot to the group's last quad, keeping the group one run.
+   struct SectionFaces
    {
-      GLuint   vao { 0 };
-      GLuint   vbo { 0 };
-      GLuint   ebo { 0 };
-      uint32_t indexCount { 0 };
+      static constexpr uint16_t NO_SLOT = UINT16_MAX;
+
+      std::array< uint32_t, FACE_COUNT > firstSlot {}; // by face group
+      std::array< uint32_t, FACE_COUNT > capacity {};
+      std::array< uint32_t, FACE_COUNT > quads {};
+      std::vector< uint16_t >            slotFaces {}; // block index * FACE_COUNT + face, by slot
+      std::vector< uint16_t >            faceSlots {}; // slot by block index * FACE_COUNT + face, NO_SLOT if none
+      int                                patches { 0 };
+      uint64_t                           lastUsed { 0 };
+   };
 
-      uint64_t builtRevision { 0 };
-      bool     fEmpty { true };
+   struct SectionEntry
+   {
+      ChunkMeshArena::Handle mesh { ChunkMeshArena::INVALID_HANDLE };
+
+      uint64_t                           builtRevision { 0 };
+      SectionVisibility                  visibility { SectionVisibility::All() }; // faces that see each other, from the last build
+      std::array< uint32_t, FACE_COUNT > faceFirstIndex {};                       // of the uploaded mesh, by face group, from its first index
+      std::array< uint32_t, FACE_COUNT > faceIndexCounts {};
+      std::unique_ptr< SectionFaces >    pFaces {}; // while the section is patchable
+      bool                               fEmpty { true };
    };
 
    struct Entry
    {
       std::array< SectionEntry, SECTIONS_PER_CHUNK > sections {};
+      SectionEntry                                   coarse {}; // the whole column in one mesh while lod > 0
       uint64_t                                       lastSeenRevision { 0 };
+      int                                            lod { -1 }; // cells of 2^lod blocks; -1 until first built
+      uint32_t                                       firstBounds { 0 }; // culler index of section 0 at lod 0, else of the coarse mesh
+   };
+
+   // What a culler box stands for
+   struct BoundsOwner
+   {
+      ChunkPos     cc {};
+      const Entry* pEntry { nullptr };
+      int          section { -1 }; // -1 for the coarse mesh
    };
 
    void        Update( Level& level, const glm::vec3& playerPos, uint8_t viewRadius );
    const auto& GetEntries() const noexcept { return m_entries; }
+   uint8_t     GetViewRadius() const noexcept { return m_viewRadius; }
+
+   // Connectivity of a full-detail section; All() for anything else, which never hides what lies behind it
+   SectionVisibility GetVisibility( const SectionPos& pos ) const;
+
+   // One column per chunk, holding all 16 section boxes at lod 0 or the coarse mesh's box past it. Rebuilt in
+   // Update only when entries come, go or change shape.
+   const FrustumCuller& GetCuller() const noexcept { return m_culler; }
+   const BoundsOwner&   GetBoundsOwner( uint32_t index ) const noexcept { return m_boundsOwners[ index ]; }
+
+   // Same layout as GL's DrawElementsIndirectCommand
+   struct DrawCommand
+   {
+      uint32_t count { 0 };
+      uint32_t instanceCount { 1 };
+      uint32_t firstIndex { 0 };
+      int32_t  baseVertex { 0 };
+      uint32_t baseInstance { 0 }; // picks the draw's chunk origin
+   };
+
+   // Section meshes gathered over a frame and drawn together
+   struct DrawList
+   {
+      std::vector< DrawCommand > commands; // one per run of adjacent face groups drawn from a mesh
+      std::vector< glm::vec3 >   origins;  // world position of each mesh's chunk corner, shared by its commands
+
+      void Clear()
+      {
+         commands.clear();
+         origins.clear();
+      }
+   };
+
+   // Face groups of a mesh within the box that can face a camera at `viewPos`. Every face of a group lies on a plane
+   // inside the box, so a group is out only when the camera is behind all of those planes; the GPU still culls the
+   // back faces of the groups that are drawn.
+   static uint8_t FacingFaces( const glm::vec3& viewPos, const glm::vec3& boxMin, const glm::vec3& boxMax ) noexcept;
+
+   // Empty meshes are skipped, as are groups outside `faceMask`; `origin` is added to every vertex of the mesh
+   void Queue( DrawList& list, const SectionEntry& mesh, const glm::vec3& origin, uint8_t faceMask = ALL_FACES ) const;
+
+   // One glMultiDrawElementsIndirect for the whole list, with the terrain shader already bound
+   void Submit( const DrawList& list );
+
+   const ChunkMeshArena& GetArena() const noexcept { return m_arena; }
+
+   // Full-detail mesh of one section, as Update builds it; chunk-relative positions with world-space Y
+   static void BuildSectionMesh( const Level& level, const Chunk& chunk, int sectionIndex, MeshData& out );
 
 private:
    NO_COPY_MOVE( ChunkRenderer )
 
-   void        Clear();
-   static void DestroySectionGL( SectionEntry& e );
+   void Clear();
+   void Release( SectionEntry& e );
 
    static bool                                  InView( const ChunkPos& cc, const ChunkPos& center, uint8_t viewRadius );
+   static int                                   ChooseLod( int distance, int current ) noexcept;
    static std::tuple< ChunkPos, LocalBlockPos > WorldToChunkPos( WorldBlockPos wpos );
 
-   static void BuildSectionMesh( const Level& level, const Chunk& chunk, int sectionIndex, MeshData& out );
-   static void Upload( SectionEntry& e, const MeshData& mesh );
+   static void BuildCoarseMesh( const Level& level, const Chunk& chunk, int lod, MeshData& out );
+
+   void Upload( SectionEntry& e, const MeshData& mesh );
+   void RebuildBounds();
+   void BindArena();
+
+   // Patching single-block edits; see SectionFaces
+   void GatherFaceEdits( std::span< const LocalBlockPos > edits );
+   void UploadPatchable( SectionEntry& e, const MeshData& mesh );
+   bool FPatchSection( const Level& level, const Chunk& chunk, int sectionIndex, SectionEntry& e, std::span< const uint16_t > faceKeys );
+   void DropFaces( SectionEntry& e );
 
    std::unordered_map< ChunkPos, Entry, ChunkPosHash > m_entries;
+   uint8_t                                             m_viewRadius { 0 };
+   FrustumCuller                                       m_culler;
+   std::vector< BoundsOwner >                          m_boundsOwners; // by culler index
+   bool                                                m_fBoundsDirty { false };
+
+   ChunkMeshArena m_arena;
+   GLuint         m_vao { 0 };
+   GLuint         m_commandBuffer { 0 };
+   GLuint         m_originBuffer { 0 };
+   uint32_t       m_vaoGeneration { 0 }; // arena generation the vertex array points into
+
+   std::vector< SectionEntry* >                              m_patchable; // sections holding face maps
+   uint64_t                                                  m_patchClock { 0 };
+   std::array< std::vector< uint16_t >, SECTIONS_PER_CHUNK > m_faceEdits; // faces to patch by section, for one chunk
+   MeshData                                                  m_patchMesh; // upload scratch
 }; // class ChunkRenderer
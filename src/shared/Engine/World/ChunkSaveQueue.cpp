@@ -0,0 +1,135 @@
+#include "ChunkSaveQueue.h"
+
+// ----------------------------------------------------------------
+// ChunkSaveQueue
+// ----------------------------------------------------------------
+ChunkSaveQueue::ChunkSaveQueue( std::filesystem::path worldDir ) :
+   m_worldDir( std::move( worldDir ) ),
+   m_worker( [ this ]( std::stop_token stopToken ) { WorkerLoop( stopToken ); } )
+{}
+
+
+ChunkSaveQueue::~ChunkSaveQueue()
+{
+   Flush();
+   m_worker.request_stop();
+}
+
+
+void ChunkSaveQueue::Enqueue( ChunkSnapshot snapshot )
+{
+   {
+      std::lock_guard lock( m_mutex );
+
+      PendingEntry& entry = m_pending[ snapshot.cpos ];
+      entry.snapshot      = std::move( snapshot );
+      entry.sequence      = ++m_nextSequence;
+      if( !entry.fQueued )
+      {
+         entry.fQueued = true;
+         m_queue.push_back( entry.snapshot.cpos );
+      }
+   }
+
+   m_workCv.notify_one();
+}
+
+
+std::optional< ChunkSnapshot > ChunkSaveQueue::FindPending( const ChunkPos& cpos ) const
+{
+   std::lock_guard lock( m_mutex );
+   if( auto it = m_pending.find( cpos ); it != m_pending.end() )
+      return it->second.snapshot;
+
+   return std::nullopt;
+}
+
+
+std::vector< ChunkSnapshot > ChunkSaveQueue::PendingSnapshots() const
+{
+   std::lock_guard              lock( m_mutex );
+   std::vector< ChunkSnapshot > snapshots;
+   snapshots.reserve( m_pending.size() );
+   for( const auto& [ _, entry ] : m_pending )
+      snapshots.push_back( entry.snapshot );
+
+   return snapshots;
+}
+
+
+void ChunkSaveQueue::RetryFailed()
+{
+   {
+      std::lock_guard lock( m_mutex );
+      for( const ChunkPos& cpos : m_failed )
+      {
+         auto it = m_pending.find( cpos );
+         if( it == m_pending.end() || it->second.fQueued )
+            continue;
+
+         it->second.fQueued = true;
+         m_queue.push_back( cpos );
+      }
+
+      m_failed.clear();
+   }
+
+   m_workCv.notify_one();
+}
+
+
+void ChunkSaveQueue::Flush()
+{
+   std::unique_lock lock( m_mutex );
+   m_idleCv.wait( lock, [ this ]() { return m_queue.empty() && !m_fWriting; } );
+}
+
+
+size_t ChunkSaveQueue::PendingCount() const
+{
+   std::lock_guard lock( m_mutex );
+   return m_pending.size();
+}
+
+
+void ChunkSaveQueue::WorkerLoop( std::stop_token stopToken )
+{
+   while( true )
+   {
+      ChunkSnapshot snapshot;
+      uint64_t      sequence = 0;
+      {
+         std::unique_lock lock( m_mutex );
+         if( !m_workCv.wait( lock, stopToken, [ this ]() { return !m_queue.empty(); } ) )
+            return;
+
+         PendingEntry& entry = m_pending.at( m_queue.front() );
+         m_queue.pop_front();
+
+         entry.fQueued = false;
+         snapshot      = entry.snapshot; // shares section storage, no block copy
+         sequence      = entry.sequence;
+         m_fWriting    = true;
+      }
+
+      const std::vector< std::byte > bytes    = snapshot.Encode();
+      const bool                     fWritten = World::WorldSave::FSaveChunkBytes( m_worldDir, snapshot.Coord3(), bytes );
+
+      {
+         std::lock_guard lock( m_mutex );
+         m_fWriting = false;
+
+         // Keep the entry if a newer snapshot arrived while writing; it is already queued again.
+         auto it = m_pending.find( snapshot.cpos );
+         if( fWritten && it != m_pending.end() && it->second.sequence == sequence )
+            m_pending.erase( it );
+         else if( !fWritten )
+         {
+            std::println( std::cerr, "Failed to save chunk ({}, {})", snapshot.cpos.x, snapshot.cpos.z );
+            m_failed.push_back( snapshot.cpos );
+         }
+      }
+
+      m_idleCv.notify_all();
+   }
+}
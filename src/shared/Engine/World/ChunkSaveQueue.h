@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Engine/World/Level.h>
+
+// ----------------------------------------------------------------
+// ChunkSaveQueue - serializes and writes chunk snapshots on a background thread
+// ----------------------------------------------------------------
+class ChunkSaveQueue
+{
+public:
+   explicit ChunkSaveQueue( std::filesystem::path worldDir );
+   ~ChunkSaveQueue();
+
+   // Queues a snapshot for writing. A newer snapshot of the same chunk replaces one that has not started writing yet.
+   void Enqueue( ChunkSnapshot snapshot );
+
+   // Newest snapshot of the chunk that has not reached disk yet, if any
+   std::optional< ChunkSnapshot > FindPending( const ChunkPos& cpos ) const;
+   std::vector< ChunkSnapshot >   PendingSnapshots() const;
+
+   // Re-queues snapshots whose write failed
+   void RetryFailed();
+
+   // Blocks until every queued snapshot has been written (or has failed)
+   void Flush();
+
+   size_t PendingCount() const;
+
+private:
+   NO_COPY_MOVE( ChunkSaveQueue )
+
+   void WorkerLoop( std::stop_token stopToken );
+
+   struct PendingEntry
+   {
+      ChunkSnapshot snapshot;
+      uint64_t      sequence { 0 };
+      bool          fQueued { false };
+   };
+
+   const std::filesystem::path m_worldDir;
+
+   mutable std::mutex                                         m_mutex;
+   std::condition_variable_any                                m_workCv;
+   std::condition_variable                                    m_idleCv;
+   std::unordered_map< ChunkPos, PendingEntry, ChunkPosHash > m_pending; // latest unwritten snapshot per chunk
+   std::deque< ChunkPos >                                     m_queue;   // write order
+   std::vector< ChunkPos >                                    m_failed;
+   uint64_t                                                   m_nextSequence { 0 };
+   bool                                                       m_fWriting { false };
+
+   std::jthread m_worker; // declared last so it stops before the state it uses is destroyed
+};
@@ -0,0 +1,388 @@
+#include "FarField.h"
+
+#include <Engine/World/RunLengthCodec.h>
+
+// Ray parameters for axes the ray does not move along; large enough to never win, small enough that 0 * it is 0
+constexpr float kNoCrossing = 1e30f;
+
+// ----------------------------------------------------------------
+// FarField
+// ----------------------------------------------------------------
+void FarField::Summarize( const ChunkSnapshot& snapshot )
+{
+   Column column;
+   for( const auto& [ i, pBlocks ] : snapshot.sections | std::views::enumerate )
+      column[ i ] = pBlocks ? Build( *pBlocks, 0, 0, 0, CHUNK_SECTION_SIZE ) : Leaf( BlockId::Air );
+
+   m_columns[ snapshot.cpos ] = column;
+
+   if( m_nodes.size() >= m_compactAt )
+      Compact();
+}
+
+
+void FarField::Queue( const ChunkPos& cpos, std::vector< std::byte > compressed )
+{
+   m_queue.push_back( QueuedColumn { .cpos = cpos, .compressed = std::move( compressed ) } );
+}
+
+
+void FarField::BuildQueued( size_t maxColumns )
+{
+   for( ; maxColumns > 0 && !m_queue.empty(); --maxColumns )
+   {
+      const QueuedColumn& queued = m_queue.front();
+
+      // A column that fails to decode is left out, as if it had never been queued
+      std::optional< ChunkSnapshot >                   optSnapshot;
+      const std::optional< std::vector< std::byte > > optBytes = RunLengthCodec::Decode( queued.compressed );
+      if( optBytes )
+         optSnapshot = ChunkSnapshot::Decode( queued.cpos, *optBytes );
+
+      if( optSnapshot )
+         Summarize( *optSnapshot );
+
+      m_queue.pop_front();
+   }
+}
+
+
+void FarField::Remove( const ChunkPos& cpos )
+{
+   m_columns.erase( cpos );
+   std::erase_if( m_queue, [ & ]( const QueuedColumn& queued ) { return queued.cpos == cpos; } );
+}
+
+
+void FarField::EvictBeyond( const ChunkPos& center, int radius )
+{
+   // Nodes only the evicted columns used are reclaimed by the next compaction
+   auto fBeyond = [ & ]( const ChunkPos& cpos ) { return ( std::max )( std::abs( cpos.x - center.x ), std::abs( cpos.z - center.z ) ) > radius; };
+   std::erase_if( m_columns, [ & ]( const auto& entry ) { return fBeyond( entry.first ); } );
+   std::erase_if( m_queue, [ & ]( const QueuedColumn& queued ) { return fBeyond( queued.cpos ); } );
+}
+
+
+FarField::NodeRef FarField::Build( const SectionBlocks& blocks, int x, int y, int z, int size )
+{
+   if( size == 1 )
+      return Leaf( blocks[ ChunkSection::ToIndex( LocalBlockPos { x, y, z } ) ].GetId() );
+
+   const int half = size / 2;
+   Children  children;
+   for( int i = 0; i < 8; ++i )
+      children[ i ] = Build( blocks, x + ( i & 1 ) * half, y + ( ( i >> 1 ) & 1 ) * half, z + ( ( i >> 2 ) & 1 ) * half, half );
+
+   return Intern( children );
+}
+
+
+FarField::NodeRef FarField::Intern( const Children& children )
+{
+   // Eight copies of one leaf are that leaf
+   if( FLeaf( children[ 0 ] ) && std::ranges::all_of( children, [ & ]( NodeRef ref ) { return ref == children[ 0 ]; } ) )
+      return children[ 0 ];
+
+   auto [ it, fNew ] = m_index.try_emplace( children, static_cast< NodeRef >( m_nodes.size() ) );
+   if( !fNew )
+      return it->second;
+
+   // Coarse material: the most common non-air material among the children
+   std::array< int, static_cast< size_t >( BlockId::Count ) > votes {};
+   for( NodeRef ref : children )
+      ++votes[ static_cast< size_t >( Material( ref ) ) ];
+   votes[ static_cast< size_t >( BlockId::Air ) ] = 0;
+
+   m_nodes.push_back( Node { .children = children, .material = static_cast< BlockId >( std::ranges::max_element( votes ) - votes.begin() ) } );
+   return it->second;
+}
+
+
+BlockId FarField::SampleCell( NodeRef root, int x, int y, int z, int lod ) const noexcept
+{
+   // Walk down until the node covers exactly one cell, or a leaf covers several
+   NodeRef ref = root;
+   for( int level = LEVELS - 1; level >= lod && !FLeaf( ref ); --level )
+   {
+      const int bit = level - lod;
+      ref           = m_nodes[ ref ].children[ ( ( x >> bit ) & 1 ) | ( ( ( y >> bit ) & 1 ) << 1 ) | ( ( ( z >> bit ) & 1 ) << 2 ) ];
+   }
+
+   return Material( ref );
+}
+
+
+BlockId FarField::SampleColumn( const ChunkPos& cpos, int x, int y, int z, int lod ) const noexcept
+{
+   const int cells = CHUNK_SECTION_SIZE >> lod;
+   auto      it    = m_columns.find( cpos );
+   if( it == m_columns.end() || y < 0 || y >= cells * SECTIONS_PER_CHUNK )
+      return BlockId::Air;
+
+   return SampleCell( it->second[ y / cells ], x, y % cells, z, lod );
+}
+
+
+void FarField::ExtractCoarseMesh( const ChunkPos& cpos, int lod, std::vector< CoarseQuad >& out ) const
+{
+   auto it = m_columns.find( cpos );
+   if( it == m_columns.end() )
+      return;
+
+   lod              = std::clamp( lod, 0, LEVELS );
+   const int cells  = CHUNK_SECTION_SIZE >> lod;
+   const int cellsY = cells * SECTIONS_PER_CHUNK;
+   const int size   = 1 << lod;
+
+   // One column of cells, sampled once; neighbors across the column edge come from the adjacent summary
+   std::vector< BlockId > grid( static_cast< size_t >( cells * cellsY * cells ), BlockId::Air );
+   auto                   at = [ & ]( int x, int y, int z ) -> BlockId& { return grid[ static_cast< size_t >( x + z * cells + y * cells * cells ) ]; };
+   for( int sy = 0; sy < SECTIONS_PER_CHUNK; ++sy )
+   {
+      const NodeRef root = it->second[ sy ];
+      if( root == Leaf( BlockId::Air ) )
+         continue;
+
+      for( int y = 0; y < cells; ++y )
+      {
+         for( int z = 0; z < cells; ++z )
+         {
+            for( int x = 0; x < cells; ++x )
+               at( x, sy * cells + y, z ) = SampleCell( root, x, y, z, lod );
+         }
+      }
+   }
+
+   constexpr std::array< glm::ivec3, 6 > kFaceDirs = {
+      glm::ivec3 { -1, 0, 0 },
+      glm::ivec3 { 1, 0, 0 },
+      glm::ivec3 { 0, -1, 0 },
+      glm::ivec3 { 0, 1, 0 },
+      glm::ivec3 { 0, 0, -1 },
+      glm::ivec3 { 0, 0, 1 },
+   };
+
+   auto neighbor = [ & ]( int x, int y, int z )
+   {
+      if( y < 0 )
+         return BlockId::Bedrock; // nothing to see below the world
+      if( x >= 0 && x < cells && z >= 0 && z < cells )
+         return y < cellsY ? at( x, y, z ) : BlockId::Air;
+
+      const ChunkPos ncpos { cpos.x + ( x < 0 ? -1 : x >= cells ? 1 : 0 ), cpos.z + ( z < 0 ? -1 : z >= cells ? 1 : 0 ) };
+      if( !m_columns.contains( ncpos ) )
+         return BlockId::Air;
+
+      return SampleColumn( ncpos, ( x + cells ) % cells, y, ( z + cells ) % cells, lod );
+   };
+
+   for( int y = 0; y < cellsY; ++y )
+   {
+      for( int z = 0; z < cells; ++z )
+      {
+         for( int x = 0; x < cells; ++x )
+         {
+            const BlockId material = at( x, y, z );
+            if( material == BlockId::Air )
+               continue;
+
+            for( const auto& [ face, d ] : kFaceDirs | std::views::enumerate )
+            {
+               if( neighbor( x + d.x, y + d.y, z + d.z ) != BlockId::Air )
+                  continue;
+
+               out.push_back( CoarseQuad { .cell     = glm::ivec3( cpos.x * CHUNK_SIZE_X + x * size, y * size, cpos.z * CHUNK_SIZE_Z + z * size ),
+                                           .face     = static_cast< uint8_t >( face ),
+                                           .size     = static_cast< uint8_t >( size ),
+                                           .material = material } );
+            }
+         }
+      }
+   }
+}
+
+
+std::optional< RaycastResult > FarField::Raycast( const Ray& ray ) const
+{
+   const glm::vec3 dir = glm::normalize( ray.direction );
+   const glm::vec3 invDir( dir.x != 0.0f ? 1.0f / dir.x : kNoCrossing, dir.y != 0.0f ? 1.0f / dir.y : kNoCrossing, dir.z != 0.0f ? 1.0f / dir.z : kNoCrossing );
+
+   // Columns in the order the ray crosses them (2D DDA over x/z), then sections bottom-up or top-down
+   glm::ivec2       column( static_cast< int >( std::floor( ray.origin.x / CHUNK_SIZE_X ) ), static_cast< int >( std::floor( ray.origin.z / CHUNK_SIZE_Z ) ) );
+   const glm::ivec2 step( dir.x >= 0.0f ? 1 : -1, dir.z >= 0.0f ? 1 : -1 );
+   auto             boundary = [ & ]( int c, int s, int edge, float o, float inv ) { return ( static_cast< float >( ( c + ( s > 0 ? 1 : 0 ) ) * edge ) - o ) * inv; };
+   glm::vec2        tNext( dir.x != 0.0f ? boundary( column.x, step.x, CHUNK_SIZE_X, ray.origin.x, invDir.x ) : kNoCrossing,
+                           dir.z != 0.0f ? boundary( column.y, step.y, CHUNK_SIZE_Z, ray.origin.z, invDir.z ) : kNoCrossing );
+   const glm::vec2  tDelta( dir.x != 0.0f ? CHUNK_SIZE_X * std::abs( invDir.x ) : kNoCrossing, dir.z != 0.0f ? CHUNK_SIZE_Z * std::abs( invDir.z ) : kNoCrossing );
+
+   for( float tColumn = 0.0f; tColumn <= ray.maxDistance; )
+   {
+      if( auto it = m_columns.find( ChunkPos { column.x, column.y } ); it != m_columns.end() )
+      {
+         for( int n = 0; n < SECTIONS_PER_CHUNK; ++n )
+         {
+            const int     sy   = dir.y >= 0.0f ? n : SECTIONS_PER_CHUNK - 1 - n;
+            const NodeRef root = it->second[ sy ];
+            if( root == Leaf( BlockId::Air ) )
+               continue;
+
+            const glm::vec3 boxMin( column.x * CHUNK_SIZE_X, sy * CHUNK_SECTION_SIZE, column.y * CHUNK_SIZE_Z );
+            float           tHit = 0.0f;
+            int             axis = 0;
+            if( !FTraverse( root, boxMin, CHUNK_SECTION_SIZE, ray.origin, invDir, ray.maxDistance, tHit, axis ) )
+               continue;
+
+            RaycastResult result;
+            result.distance           = tHit;
+            result.point              = ray.origin + dir * tHit;
+            result.faceNormal         = glm::ivec3( 0 );
+            result.faceNormal[ axis ] = dir[ axis ] > 0.0f ? -1 : 1;
+            result.block              = glm::ivec3( glm::floor( result.point - glm::vec3( result.faceNormal ) * 0.5f ) );
+            return result;
+         }
+      }
+
+      // Sections of one column are visited in ray order, and columns are too
+      if( tNext.x < tNext.y )
+      {
+         tColumn = tNext.x;
+         tNext.x += tDelta.x;
+         column.x += step.x;
+      }
+      else
+      {
+         tColumn = tNext.y;
+         tNext.y += tDelta.y;
+         column.y += step.y;
+      }
+   }
+
+   return std::nullopt;
+}
+
+
+bool FarField::FTraverse( NodeRef ref, const glm::vec3& boxMin, float size, const glm::vec3& origin, const glm::vec3& invDir, float tMax, float& tHit, int& axis ) const
+{
+   const glm::vec3 t0     = ( boxMin - origin ) * invDir;
+   const glm::vec3 t1     = ( boxMin + glm::vec3( size ) - origin ) * invDir;
+   const glm::vec3 tNear  = glm::min( t0, t1 );
+   const glm::vec3 tFar   = glm::max( t0, t1 );
+   const float     tEnter = ( std::max )( { tNear.x, tNear.y, tNear.z } );
+   const float     tExit  = ( std::min )( { tFar.x, tFar.y, tFar.z } );
+   if( tEnter > tExit || tExit < 0.0f || tEnter > tMax )
+      return false;
+
+   if( FLeaf( ref ) )
+   {
+      if( LeafId( ref ) == BlockId::Air )
+         return false;
+
+      tHit = ( std::max )( tEnter, 0.0f );
+      axis = tEnter == tNear.x ? 0 : tEnter == tNear.y ? 1 : 2;
+      return true;
+   }
+
+   // Children nearest along the ray first, so the first hit is the closest
+   const float                              half = size * 0.5f;
+   std::array< std::pair< float, int >, 8 > order;
+   for( int i = 0; i < 8; ++i )
+   {
+      const glm::vec3 childMin = boxMin + glm::vec3( i & 1, ( i >> 1 ) & 1, ( i >> 2 ) & 1 ) * half;
+      const glm::vec3 c0       = ( childMin - origin ) * invDir;
+      const glm::vec3 c1       = ( childMin + glm::vec3( half ) - origin ) * invDir;
+      const glm::vec3 cNear    = glm::min( c0, c1 );
+      order[ i ]               = { ( std::max )( { cNear.x, cNear.y, cNear.z } ), i };
+   }
+   std::ranges::sort( order );
+
+   const Node& node = m_nodes[ ref ];
+   for( const auto& [ _, i ] : order )
+   {
+      const glm::vec3 childMin = boxMin + glm::vec3( i & 1, ( i >> 1 ) & 1, ( i >> 2 ) & 1 ) * half;
+      if( FTraverse( node.children[ i ], childMin, half, origin, invDir, tMax, tHit, axis ) )
+         return true;
+   }
+
+   return false;
+}
+
+
+void FarField::Compact()
+{
+   // Children are always interned before their parent, so copying in index order keeps that invariant
+   std::vector< NodeRef > remap( m_nodes.size(), UINT32_MAX );
+   std::vector< NodeRef > stack;
+   for( const auto& [ _, column ] : m_columns )
+   {
+      for( NodeRef root : column )
+      {
+         if( !FLeaf( root ) )
+            stack.push_back( root );
+      }
+   }
+
+   while( !stack.empty() )
+   {
+      const NodeRef ref = stack.back();
+      stack.pop_back();
+      if( remap[ ref ] != UINT32_MAX )
+         continue;
+
+      remap[ ref ] = 0; // live
+      for( NodeRef child : m_nodes[ ref ].children )
+      {
+         if( !FLeaf( child ) && remap[ child ] == UINT32_MAX )
+            stack.push_back( child );
+      }
+   }
+
+   std::vector< Node > nodes;
+   m_index.clear();
+   for( size_t ref = 0; ref < m_nodes.size(); ++ref )
+   {
+      if( remap[ ref ] == UINT32_MAX )
+         continue;
+
+      Node node = m_nodes[ ref ];
+      for( NodeRef& child : node.children )
+      {
+         if( !FLeaf( child ) )
+            child = remap[ child ];
+      }
+
+      remap[ ref ] = static_cast< NodeRef >( nodes.size() );
+      m_index.emplace( node.children, remap[ ref ] );
+      nodes.push_back( node );
+   }
+
+   for( auto& [ _, column ] : m_columns )
+   {
+      for( NodeRef& root : column )
+      {
+         if( !FLeaf( root ) )
+            root = remap[ root ];
+      }
+   }
+
+   m_nodes     = std::move( nodes );
+   m_compactAt = ( std::max )( m_compactAt, 2 * m_nodes.size() );
+}
+
+
+FarField::Stats FarField::GetStats() const noexcept
+{
+   // Node-based containers: roughly one allocation of key, value and next pointer per entry, plus the buckets
+   constexpr size_t ENTRY_OVERHEAD = 2 * sizeof( void* );
+
+   Stats stats;
+   stats.columns     = m_columns.size();
+   stats.nodes       = m_nodes.size();
+   stats.nodeBytes   = m_nodes.capacity() * sizeof( Node );
+   stats.columnBytes = m_columns.size() * ( sizeof( ChunkPos ) + sizeof( Column ) + ENTRY_OVERHEAD ) + m_columns.bucket_count() * sizeof( void* );
+   stats.indexBytes  = m_index.size() * ( sizeof( Children ) + sizeof( NodeRef ) + ENTRY_OVERHEAD ) + m_index.bucket_count() * sizeof( void* );
+   stats.queued      = m_queue.size();
+   for( const QueuedColumn& queued : m_queue )
+      stats.queuedBytes += sizeof( QueuedColumn ) + queued.compressed.capacity();
+
+   return stats;
+}
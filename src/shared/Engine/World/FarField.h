@@ -0,0 +1,120 @@
+#pragma once
+
+#include <Engine/World/Level.h>
+#include <Engine/World/Raycast.h>
+
+// ----------------------------------------------------------------
+// FarField - read-only sparse voxel DAG summary of distant chunks
+// ----------------------------------------------------------------
+// Each section of a summarized chunk becomes an octree over its 16^3 blocks. Regions of one block id collapse
+// into a leaf, and every interior node is interned in one pool shared by all chunks, so identical subtrees
+// (solid stone, open air, the same strip of grass over dirt) are stored once however often they occur. A
+// typical column costs its 16 root references plus the few nodes nobody else had yet.
+//
+// Only block ids are kept; orientation and fluid level are dropped. Interior nodes carry the most common
+// material beneath them, which is what coarse meshes are colored by. Main thread only.
+//
+// Columns waiting to be summarized are held run-length coded, a few KiB each, and the owner evicts columns
+// past the far radius as the player moves, so neither grows with the distance travelled.
+class FarField
+{
+public:
+   static constexpr size_t BUILDS_PER_UPDATE = 4; // queued columns summarized per BuildQueued call
+
+   // Per-column quad at a level of detail. Cells are 2^lod blocks on a side, lod 0 to 4.
+   struct CoarseQuad
+   {
+      glm::ivec3 cell;       // world position of the cell's minimum corner
+      uint8_t    face { 0 }; // 0 -X, 1 +X, 2 -Y, 3 +Y, 4 -Z, 5 +Z
+      uint8_t    size { 1 }; // cell edge in blocks
+      BlockId    material { BlockId::Air };
+   };
+
+   struct Stats
+   {
+      size_t columns { 0 };
+      size_t nodes { 0 };
+      size_t nodeBytes { 0 };   // interned nodes
+      size_t columnBytes { 0 }; // root references and their map entries
+      size_t indexBytes { 0 };  // intern table, only needed while building
+      size_t queued { 0 };
+      size_t queuedBytes { 0 }; // compressed encodings waiting in the queue
+   };
+
+   FarField() = default;
+
+   // Replaces the column's summary now, or from BuildQueued a few columns at a time. Queue takes the chunk file
+   // encoding run-length coded (RunLengthCodec::Encode of ChunkSnapshot::Encode), as cold chunks keep it.
+   void Summarize( const ChunkSnapshot& snapshot );
+   void Queue( const ChunkPos& cpos, std::vector< std::byte > compressed );
+   void BuildQueued( size_t maxColumns = BUILDS_PER_UPDATE );
+
+   void Remove( const ChunkPos& cpos );
+   void EvictBeyond( const ChunkPos& center, int radius ); // summarized and queued columns, in chunks on either axis
+   bool FContains( const ChunkPos& cpos ) const noexcept { return m_columns.contains( cpos ); }
+
+   // First non-air block along the ray through summarized columns. Hits on collapsed regions report the
+   // block just inside the face the ray entered through.
+   std::optional< RaycastResult > Raycast( const Ray& ray ) const;
+
+   // Faces between solid and open cells of one column; faces toward columns that are not summarized are kept
+   void ExtractCoarseMesh( const ChunkPos& cpos, int lod, std::vector< CoarseQuad >& out ) const;
+
+   Stats GetStats() const noexcept;
+
+private:
+   NO_COPY_MOVE( FarField )
+
+   // Leaf references have LEAF_BIT set and the block id in the low bits; others index m_nodes
+   using NodeRef                     = uint32_t;
+   static constexpr NodeRef LEAF_BIT = 0x80000000u;
+   static constexpr int     LEVELS   = 4; // 16 = 2^4
+
+   static constexpr NodeRef Leaf( BlockId id ) noexcept { return LEAF_BIT | static_cast< NodeRef >( id ); }
+   static constexpr bool    FLeaf( NodeRef ref ) noexcept { return ( ref & LEAF_BIT ) != 0; }
+   static constexpr BlockId LeafId( NodeRef ref ) noexcept { return static_cast< BlockId >( ref & ~LEAF_BIT ); }
+
+   using Children = std::array< NodeRef, 8 >; // child i covers offset ( i & 1, ( i >> 1 ) & 1, ( i >> 2 ) & 1 ) * half
+
+   struct Node
+   {
+      Children children;
+      BlockId  material { BlockId::Air };
+   };
+
+   struct ChildrenHash
+   {
+      std::size_t operator()( const Children& children ) const noexcept
+      {
+         std::size_t h = 1469598103934665603ull;
+         for( NodeRef ref : children )
+            h = ( h ^ ref ) * 0x100000001B3ull;
+         return h;
+      }
+   };
+
+   using Column = std::array< NodeRef, SECTIONS_PER_CHUNK >;
+
+   NodeRef Build( const SectionBlocks& blocks, int x, int y, int z, int size );
+   NodeRef Intern( const Children& children );
+   BlockId Material( NodeRef ref ) const noexcept { return FLeaf( ref ) ? LeafId( ref ) : m_nodes[ ref ].material; }
+   BlockId SampleCell( NodeRef root, int x, int y, int z, int lod ) const noexcept; // x, y, z in cells of the section
+   BlockId SampleColumn( const ChunkPos& cpos, int x, int y, int z, int lod ) const noexcept; // Air when not summarized
+
+   bool FTraverse( NodeRef ref, const glm::vec3& boxMin, float size, const glm::vec3& origin, const glm::vec3& invDir, float tMax, float& tHit, int& axis ) const;
+
+   // Drops nodes no column references any more; runs when the pool has doubled since the last compaction
+   void Compact();
+
+   std::vector< Node >                                   m_nodes;
+   std::unordered_map< Children, NodeRef, ChildrenHash > m_index;
+   std::unordered_map< ChunkPos, Column, ChunkPosHash >  m_columns;
+   struct QueuedColumn
+   {
+      ChunkPos                 cpos;
+      std::vector< std::byte > compressed;
+   };
+
+   std::deque< QueuedColumn >                            m_queue;
+   size_t                                                m_compactAt { 1u << 16 };
+};
@@ -0,0 +1,262 @@
+#include "FluidSimulator.h"
+
+constexpr std::array< glm::ivec3, 4 > kHorizontal = {
+   glm::ivec3 { 1, 0, 0 },
+   glm::ivec3 { -1, 0, 0 },
+   glm::ivec3 { 0, 0, 1 },
+   glm::ivec3 { 0, 0, -1 },
+};
+
+// ----------------------------------------------------------------
+// FluidSimulator
+// ----------------------------------------------------------------
+FluidSimulator::FluidSimulator( Level& level ) :
+   m_level( level )
+{}
+
+
+void FluidSimulator::OnBlocksChanged( std::span< const WorldBlockPos > positions )
+{
+   for( const WorldBlockPos& pos : positions )
+   {
+      Activate( pos );
+      Activate( WorldBlockPos { pos.x, pos.y + 1, pos.z } );
+      Activate( WorldBlockPos { pos.x, pos.y - 1, pos.z } );
+      for( const glm::ivec3& d : kHorizontal )
+         Activate( WorldBlockPos { pos.x + d.x, pos.y, pos.z + d.z } );
+   }
+}
+
+
+void FluidSimulator::Tick( uint64_t tick )
+{
+   m_stats = {};
+
+   size_t budget = UPDATE_BUDGET;
+   if( tick % WATER_STEP_TICKS == 0 )
+      Step( Water, budget );
+   if( tick % LAVA_STEP_TICKS == 0 )
+      Step( Lava, budget );
+
+   for( const FrontierMap& frontiers : m_frontiers )
+   {
+      m_stats.activeSections += frontiers.size();
+      for( const auto& [ _, frontier ] : frontiers )
+         m_stats.activeCells += frontier.cells.size();
+   }
+}
+
+
+void FluidSimulator::DropChunk( const ChunkPos& cpos )
+{
+   for( int kind = 0; kind < KindCount; ++kind )
+   {
+      for( int section = 0; section < SECTIONS_PER_CHUNK; ++section )
+         m_frontiers[ kind ].erase( SectionKey { cpos, section } );
+
+      std::erase_if( m_order[ kind ], [ & ]( const SectionKey& key ) { return key.cpos == cpos; } );
+   }
+}
+
+
+void FluidSimulator::Activate( const WorldBlockPos& pos )
+{
+   const std::optional< BlockState > optState = Read( pos );
+   if( !optState || !FFluid( *optState ) )
+      return;
+
+   auto [ cpos, local ] = m_level.WorldToChunk( pos );
+   const SectionKey key { cpos, local.y / CHUNK_SECTION_SIZE };
+   const Kind       kind = KindOf( optState->GetId() );
+
+   auto [ it, fNew ] = m_frontiers[ kind ].try_emplace( key );
+   if( fNew )
+      m_order[ kind ].push_back( key );
+
+   Frontier&      frontier = it->second;
+   const uint16_t index    = static_cast< uint16_t >( ChunkSection::ToIndex( LocalBlockPos { local.x, local.y % CHUNK_SECTION_SIZE, local.z } ) );
+   if( !frontier.queued.test( index ) )
+   {
+      frontier.queued.set( index );
+      frontier.cells.push_back( index );
+   }
+}
+
+
+void FluidSimulator::Step( Kind kind, size_t& budget )
+{
+   // Take whole sections in turn so a step touches as few sections as it can; a section cut short by the
+   // budget stays at the front of the line and is finished first next step
+   FrontierMap&               frontiers = m_frontiers[ kind ];
+   std::deque< SectionKey >& order     = m_order[ kind ];
+   for( size_t visits = order.size(); budget > 0 && visits > 0; --visits )
+   {
+      const SectionKey key = order.front();
+      order.pop_front();
+
+      auto it = frontiers.find( key );
+      if( it == frontiers.end() )
+         continue;
+
+      Frontier&    frontier = it->second;
+      const size_t take     = ( std::min )( budget, frontier.cells.size() );
+      for( size_t n = 0; n < take; ++n )
+      {
+         const uint16_t index = frontier.cells.back();
+         frontier.cells.pop_back();
+         frontier.queued.reset( index );
+
+         UpdateCell( WorldBlockPos { key.cpos.x * CHUNK_SIZE_X + ( index & 0xF ),
+                                     key.section * CHUNK_SECTION_SIZE + ( index >> 8 ),
+                                     key.cpos.z * CHUNK_SIZE_Z + ( ( index >> 4 ) & 0xF ) } );
+      }
+
+      budget -= take;
+      m_stats.cellsUpdated += take;
+      if( frontier.cells.empty() )
+         frontiers.erase( it ); // settled
+      else
+         order.push_front( key );
+   }
+
+   if( m_writes.empty() )
+      return;
+
+   // Group by section so each section's storage is cloned and walked once; SetBlocks wakes the
+   // neighbors of every write for the next step
+   m_batch.clear();
+   for( const auto& [ pos, state ] : m_writes )
+      m_batch.push_back( Level::BlockWrite { pos, state } );
+
+   auto sectionOf = [ this ]( const Level::BlockWrite& write )
+   {
+      auto [ writeChunk, local ] = m_level.WorldToChunk( write.pos );
+      return std::tuple( writeChunk.x, writeChunk.z, local.y / CHUNK_SECTION_SIZE );
+   };
+   std::ranges::sort( m_batch, {}, sectionOf );
+
+   m_stats.blocksWritten += m_batch.size();
+   m_writes.clear();
+   m_level.SetBlocks( m_batch );
+}
+
+
+void FluidSimulator::UpdateCell( const WorldBlockPos& pos )
+{
+   const std::optional< BlockState > optState = Read( pos );
+   if( !optState || !FFluid( *optState ) )
+      return;
+
+   const BlockId id    = optState->GetId();
+   const int     step  = id == BlockId::Lava ? 2 : 1;
+   const uint8_t level = optState->GetFluidLevel();
+
+   auto fSameFluid = [ id ]( const std::optional< BlockState >& optOther ) { return optOther && optOther->GetId() == id; };
+
+   // Flowing fluid is only as strong as what feeds it
+   if( level != 0 )
+   {
+      int want = FLUID_LEVEL_MAX + 1;
+      if( fSameFluid( Read( WorldBlockPos { pos.x, pos.y + 1, pos.z } ) ) )
+         want = 1;
+      else
+      {
+         for( const glm::ivec3& d : kHorizontal )
+         {
+            const std::optional< BlockState > optNeighbor = Read( WorldBlockPos { pos.x + d.x, pos.y, pos.z + d.z } );
+            if( fSameFluid( optNeighbor ) )
+               want = ( std::min )( want, optNeighbor->GetFluidLevel() + step );
+         }
+      }
+
+      if( want > FLUID_LEVEL_MAX )
+      {
+         Write( pos, BlockState( BlockId::Air ) );
+         return;
+      }
+
+      if( want != level )
+      {
+         // The neighbors are woken by the write and spread from the new level next step
+         Write( pos, Fluid( id, static_cast< uint8_t >( want ) ) );
+         return;
+      }
+   }
+
+   // Fall before spreading; fluid resting on flowing fluid of its own kind stays put
+   const WorldBlockPos               below { pos.x, pos.y - 1, pos.z };
+   const std::optional< BlockState > optBelow = Read( below );
+   if( !optBelow )
+      return;
+   if( optBelow->GetId() == BlockId::Air )
+   {
+      Write( below, Fluid( id, 1 ) );
+      return;
+   }
+   if( FFluid( *optBelow ) )
+   {
+      if( optBelow->GetId() != id )
+         Write( below, BlockState( BlockId::Stone ) );
+      if( optBelow->GetId() != id || optBelow->GetFluidLevel() != 0 )
+         return;
+   }
+
+   const int next = level + step;
+   if( next > FLUID_LEVEL_MAX )
+      return;
+
+   for( const glm::ivec3& d : kHorizontal )
+   {
+      const WorldBlockPos               npos { pos.x + d.x, pos.y, pos.z + d.z };
+      const std::optional< BlockState > optNeighbor = Read( npos );
+      if( !optNeighbor )
+         continue;
+
+      if( optNeighbor->GetId() == BlockId::Air )
+         Write( npos, Fluid( id, static_cast< uint8_t >( next ) ) );
+      else if( FFluid( *optNeighbor ) && optNeighbor->GetId() != id )
+         Write( npos, BlockState( BlockId::Stone ) );
+   }
+}
+
+
+std::optional< BlockState > FluidSimulator::Read( const WorldBlockPos& pos ) const noexcept
+{
+   if( pos.y < 0 || pos.y >= CHUNK_SIZE_Y )
+      return std::nullopt;
+
+   auto [ cpos, local ] = m_level.WorldToChunk( pos );
+   const Chunk* pChunk  = m_level.m_chunks.Peek( cpos );
+   if( !pChunk )
+      return std::nullopt;
+
+   return pChunk->GetBlock( local );
+}
+
+
+void FluidSimulator::Write( const WorldBlockPos& pos, BlockState state )
+{
+   auto [ it, fNew ] = m_writes.try_emplace( pos, state );
+   if( !fNew )
+      it->second = Merge( it->second, state );
+}
+
+
+/*static*/ BlockState FluidSimulator::Merge( BlockState current, BlockState incoming ) noexcept
+{
+   // Two cells wrote the same block this step: fluid beats drying up, the stronger flow wins,
+   // and water meeting lava makes stone
+   if( current.GetId() == BlockId::Air )
+      return incoming;
+   if( incoming.GetId() == BlockId::Air )
+      return current;
+   if( FFluid( current ) && FFluid( incoming ) )
+   {
+      if( current.GetId() != incoming.GetId() )
+         return BlockState( BlockId::Stone );
+
+      return current.GetFluidLevel() <= incoming.GetFluidLevel() ? current : incoming;
+   }
+
+   return FFluid( current ) ? incoming : current;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Engine/World/Level.h>
+
+// ----------------------------------------------------------------
+// FluidSimulator - cellular water and lava flow for a Level
+// ----------------------------------------------------------------
+// Sources have fluid level 0. Flowing fluid takes one more than its best neighbor (lava two more), or 1
+// when fed from above, and dries up once that passes FLUID_LEVEL_MAX. Fluid falls into air below it
+// before it spreads sideways, and water meeting lava turns the cell it flows into to stone.
+//
+// Only the frontier is simulated: fluid cells next to a block that changed since they last updated. The
+// frontier is kept per section, so a settled body of fluid has none and costs nothing until something
+// beside it changes. A step reads the world as it stood when the step began, then applies every write
+// through Level::SetBlocks grouped by section, so each touched chunk is relit and remeshed once per step
+// however many of its cells flowed. A tick updates at most UPDATE_BUDGET cells; the rest stay on the
+// frontier for the next one.
+class FluidSimulator
+{
+public:
+   static constexpr uint32_t WATER_STEP_TICKS = 5;
+   static constexpr uint32_t LAVA_STEP_TICKS  = 30;
+   static constexpr size_t   UPDATE_BUDGET    = 4096; // cells per tick, water first
+
+   explicit FluidSimulator( Level& level );
+
+   // Wakes fluid at and next to blocks that changed. Main thread only.
+   void OnBlocksChanged( std::span< const WorldBlockPos > positions );
+
+   // Runs the water and lava steps that fall on `tick`
+   void Tick( uint64_t tick );
+
+   // Forgets the chunk's frontier; its fluid stays where it is and sleeps until woken again
+   void DropChunk( const ChunkPos& cpos );
+
+   const Level::FluidStats& GetStats() const noexcept { return m_stats; }
+
+private:
+   NO_COPY_MOVE( FluidSimulator )
+
+   enum Kind : uint8_t
+   {
+      Water,
+      Lava,
+      KindCount
+   };
+
+   struct SectionKey
+   {
+      ChunkPos cpos;
+      int      section { 0 };
+      bool     operator==( const SectionKey& ) const = default;
+   };
+
+   struct SectionKeyHash
+   {
+      std::size_t operator()( const SectionKey& key ) const noexcept { return ChunkPosHash {}( key.cpos ) ^ ( static_cast< std::size_t >( key.section ) * 0x9E3779B97F4A7C15ull ); }
+   };
+
+   // Cells of one section waiting for an update, indexed like SectionBlocks
+   struct Frontier
+   {
+      std::vector< uint16_t >               cells;
+      std::bitset< CHUNK_SECTION_VOLUME > queued;
+   };
+
+   using FrontierMap = std::unordered_map< SectionKey, Frontier, SectionKeyHash >;
+
+   static Kind       KindOf( BlockId id ) noexcept { return id == BlockId::Lava ? Lava : Water; }
+   static BlockState Fluid( BlockId id, uint8_t level ) noexcept { return BlockState( BlockProperties { .id = id, .fluidLevel = level } ); }
+   static BlockState Merge( BlockState current, BlockState incoming ) noexcept;
+
+   void                        Activate( const WorldBlockPos& pos );
+   void                        Step( Kind kind, size_t& budget );
+   void                        UpdateCell( const WorldBlockPos& pos );
+   std::optional< BlockState > Read( const WorldBlockPos& pos ) const noexcept; // nullopt outside loaded chunks
+   void                        Write( const WorldBlockPos& pos, BlockState state );
+
+   Level& m_level;
+
+   std::array< FrontierMap, KindCount >               m_frontiers;
+   std::array< std::deque< SectionKey >, KindCount > m_order; // round robin over m_frontiers
+
+   std::unordered_map< WorldBlockPos, BlockState, BlockPosHash > m_writes; // this step's, merged per cell
+   std::vector< Level::BlockWrite >                               m_batch;  // m_writes grouped by section
+
+   Level::FluidStats m_stats;
+};
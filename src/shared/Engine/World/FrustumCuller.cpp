@@ -0,0 +1,151 @@
+#include "FrustumCuller.h"
+
+// ----------------------------------------------------------------
+// ViewFrustum
+// ----------------------------------------------------------------
+ViewFrustum::ViewFrustum( const glm::mat4& pv )
+{
+   m_planes[ 0 ] = glm::vec4( pv[ 0 ][ 3 ] + pv[ 0 ][ 0 ], pv[ 1 ][ 3 ] + pv[ 1 ][ 0 ], pv[ 2 ][ 3 ] + pv[ 2 ][ 0 ], pv[ 3 ][ 3 ] + pv[ 3 ][ 0 ] );
+   m_planes[ 1 ] = glm::vec4( pv[ 0 ][ 3 ] - pv[ 0 ][ 0 ], pv[ 1 ][ 3 ] - pv[ 1 ][ 0 ], pv[ 2 ][ 3 ] - pv[ 2 ][ 0 ], pv[ 3 ][ 3 ] - pv[ 3 ][ 0 ] );
+   m_planes[ 2 ] = glm::vec4( pv[ 0 ][ 3 ] - pv[ 0 ][ 1 ], pv[ 1 ][ 3 ] - pv[ 1 ][ 1 ], pv[ 2 ][ 3 ] - pv[ 2 ][ 1 ], pv[ 3 ][ 3 ] - pv[ 3 ][ 1 ] );
+   m_planes[ 3 ] = glm::vec4( pv[ 0 ][ 3 ] + pv[ 0 ][ 1 ], pv[ 1 ][ 3 ] + pv[ 1 ][ 1 ], pv[ 2 ][ 3 ] + pv[ 2 ][ 1 ], pv[ 3 ][ 3 ] + pv[ 3 ][ 1 ] );
+   m_planes[ 4 ] = glm::vec4( pv[ 0 ][ 3 ] + pv[ 0 ][ 2 ], pv[ 1 ][ 3 ] + pv[ 1 ][ 2 ], pv[ 2 ][ 3 ] + pv[ 2 ][ 2 ], pv[ 3 ][ 3 ] + pv[ 3 ][ 2 ] );
+   m_planes[ 5 ] = glm::vec4( pv[ 0 ][ 3 ] - pv[ 0 ][ 2 ], pv[ 1 ][ 3 ] - pv[ 1 ][ 2 ], pv[ 2 ][ 3 ] - pv[ 2 ][ 2 ], pv[ 3 ][ 3 ] - pv[ 3 ][ 2 ] );
+   for( glm::vec4& plane : m_planes )
+      plane /= glm::length( glm::vec3( plane ) );
+}
+
+
+bool ViewFrustum::FInFrustum( const glm::vec3& min, const glm::vec3& max ) const
+{
+   for( const glm::vec4& plane : m_planes )
+   {
+      const glm::vec3 point( plane.x >= 0 ? max.x : min.x, plane.y >= 0 ? max.y : min.y, plane.z >= 0 ? max.z : min.z );
+      if( glm::dot( glm::vec3( plane ), point ) + plane.w < 0 )
+         return false;
+   }
+
+   return true;
+}
+
+
+// ----------------------------------------------------------------
+// FrustumCuller
+// ----------------------------------------------------------------
+void FrustumCuller::Bounds::Push( const glm::vec3& boxMin, const glm::vec3& boxMax )
+{
+   if( count % 4 == 0 )
+   {
+      for( int axis = 0; axis < 3; ++axis )
+      {
+         min[ axis ].resize( count + 4, 0.0f );
+         max[ axis ].resize( count + 4, 0.0f );
+      }
+   }
+
+   for( int axis = 0; axis < 3; ++axis )
+   {
+      min[ axis ][ count ] = boxMin[ axis ];
+      max[ axis ][ count ] = boxMax[ axis ];
+   }
+   ++count;
+}
+
+
+void FrustumCuller::Bounds::Clear() noexcept
+{
+   for( int axis = 0; axis < 3; ++axis )
+   {
+      min[ axis ].clear();
+      max[ axis ].clear();
+   }
+   count = 0;
+}
+
+
+void FrustumCuller::Clear() noexcept
+{
+   m_columns.Clear();
+   m_columnFirst.clear();
+   m_boxes.Clear();
+}
+
+
+void FrustumCuller::AddColumn( const glm::vec3& min, const glm::vec3& max )
+{
+   m_columns.Push( min, max );
+   m_columnFirst.push_back( static_cast< uint32_t >( m_boxes.count ) );
+}
+
+
+uint32_t FrustumCuller::Add( const glm::vec3& min, const glm::vec3& max )
+{
+   assert( !m_columnFirst.empty() );
+   m_boxes.Push( min, max );
+   return static_cast< uint32_t >( m_boxes.count - 1 );
+}
+
+
+/*static*/ int FrustumCuller::TestFour( const Bounds& bounds, size_t first, const ViewFrustum& frustum ) noexcept
+{
+#if defined( _M_X64 ) || defined( __SSE2__ )
+   // Per plane, the corner farthest along its normal is picked per axis by the sign of the normal, so each axis
+   // loads either the four mins or the four maxes
+   __m128 inside = _mm_castsi128_ps( _mm_set1_epi32( -1 ) );
+   for( const glm::vec4& plane : frustum.GetPlanes() )
+   {
+      const __m128 px = _mm_loadu_ps( ( plane.x >= 0 ? bounds.max : bounds.min )[ 0 ].data() + first );
+      const __m128 py = _mm_loadu_ps( ( plane.y >= 0 ? bounds.max : bounds.min )[ 1 ].data() + first );
+      const __m128 pz = _mm_loadu_ps( ( plane.z >= 0 ? bounds.max : bounds.min )[ 2 ].data() + first );
+
+      __m128 d = _mm_add_ps( _mm_mul_ps( px, _mm_set1_ps( plane.x ) ), _mm_mul_ps( py, _mm_set1_ps( plane.y ) ) );
+      d        = _mm_add_ps( _mm_add_ps( d, _mm_mul_ps( pz, _mm_set1_ps( plane.z ) ) ), _mm_set1_ps( plane.w ) );
+      inside   = _mm_and_ps( inside, _mm_cmpge_ps( d, _mm_setzero_ps() ) );
+   }
+
+   return _mm_movemask_ps( inside );
+#else
+   int mask = 0;
+   for( size_t k = 0; k < 4; ++k )
+   {
+      const size_t    i = first + k;
+      const glm::vec3 boxMin( bounds.min[ 0 ][ i ], bounds.min[ 1 ][ i ], bounds.min[ 2 ][ i ] );
+      const glm::vec3 boxMax( bounds.max[ 0 ][ i ], bounds.max[ 1 ][ i ], bounds.max[ 2 ][ i ] );
+      if( frustum.FInFrustum( boxMin, boxMax ) )
+         mask |= 1 << k;
+   }
+
+   return mask;
+#endif
+}
+
+
+void FrustumCuller::Cull( const ViewFrustum& frustum, std::vector< uint32_t >& visible ) const
+{
+   visible.clear();
+
+   const size_t columnCount = m_columnFirst.size();
+   for( size_t group = 0; group < columnCount; group += 4 )
+   {
+      // Lanes past the last column are padding and may pass
+      for( int columnMask = TestFour( m_columns, group, frustum ); columnMask != 0; columnMask &= columnMask - 1 )
+      {
+         const size_t column = group + static_cast< size_t >( std::countr_zero( static_cast< unsigned >( columnMask ) ) );
+         if( column >= columnCount )
+            break;
+
+         // A column's boxes need not start on a group of four; lanes belonging to its neighbours are masked off
+         const size_t first = m_columnFirst[ column ];
+         const size_t last  = column + 1 < columnCount ? m_columnFirst[ column + 1 ] : m_boxes.count;
+         for( size_t boxGroup = first & ~size_t( 3 ); boxGroup < last; boxGroup += 4 )
+         {
+            for( int boxMask = TestFour( m_boxes, boxGroup, frustum ); boxMask != 0; boxMask &= boxMask - 1 )
+            {
+               const size_t box = boxGroup + static_cast< size_t >( std::countr_zero( static_cast< unsigned >( boxMask ) ) );
+               if( box >= first && box < last )
+                  visible.push_back( static_cast< uint32_t >( box ) );
+            }
+         }
+      }
+   }
+}
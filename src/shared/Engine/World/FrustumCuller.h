@@ -0,0 +1,59 @@
+#pragma once
+
+// ----------------------------------------------------------------
+// ViewFrustum - frustum culling helper
+// ----------------------------------------------------------------
+class ViewFrustum
+{
+public:
+   explicit ViewFrustum( const glm::mat4& pv );
+
+   bool FInFrustum( const glm::vec3& min, const glm::vec3& max ) const;
+
+   // Inward-facing: a point is inside when dot( xyz, p ) + w >= 0 for all six
+   const std::array< glm::vec4, 6 >& GetPlanes() const noexcept { return m_planes; }
+
+private:
+   std::array< glm::vec4, 6 > m_planes;
+};
+
+
+// ----------------------------------------------------------------
+// FrustumCuller - boxes grouped into columns, tested against a frustum four at a time
+// ----------------------------------------------------------------
+// Bounds live in structure-of-arrays form so one SSE compare covers four boxes. Columns are tested first and
+// only the boxes of columns that pass are looked at, so a view that sees a quarter of the world pays for little
+// more than a quarter of the boxes. Indices are handed out in Add order and stay valid until Clear.
+class FrustumCuller
+{
+public:
+   void Clear() noexcept;
+
+   // Starts a column; boxes added until the next call must lie inside `min`..`max`
+   void     AddColumn( const glm::vec3& min, const glm::vec3& max );
+   uint32_t Add( const glm::vec3& min, const glm::vec3& max );
+
+   size_t Size() const noexcept { return m_boxes.count; }
+
+   // Replaces `visible` with the indices of every box that touches the frustum, in ascending order
+   void Cull( const ViewFrustum& frustum, std::vector< uint32_t >& visible ) const;
+
+private:
+   // Padded with zeroed boxes to a multiple of four, so a group of four never reads past the end
+   struct Bounds
+   {
+      std::array< std::vector< float >, 3 > min;
+      std::array< std::vector< float >, 3 > max;
+      size_t                                count { 0 };
+
+      void Push( const glm::vec3& boxMin, const glm::vec3& boxMax );
+      void Clear() noexcept;
+   };
+
+   // Bit k set when box first + k is inside all six planes
+   static int TestFour( const Bounds& bounds, size_t first, const ViewFrustum& frustum ) noexcept;
+
+   Bounds                  m_columns;
+   std::vector< uint32_t > m_columnFirst; // first box of each column; the next column's first ends it
+   Bounds                  m_boxes;
+};
@@ -1,14 +1,45 @@
 #include "Level.h"
 
 #include <Engine/Core/Time.h>
+#include <Engine/World/BlockDefs.h>
+#include <Engine/World/BlockTickScheduler.h>
+#include <Engine/World/ChunkSaveQueue.h>
+#include <Engine/World/FarField.h>
+#include <Engine/World/FluidSimulator.h>
+#include <Engine/World/LightEngine.h>
+#include <Engine/World/PackedSection.h>
+#include <Engine/World/PendingFeatureWrites.h>
+#include <Engine/World/RunLengthCodec.h>
+#include <Engine/World/TerrainGenerator.h>
+#include <Engine/World/WorldBackup.h>
 
 
 // ----------------------------------------------------------------
 // ChunkSection
 // ----------------------------------------------------------------
+ChunkSection::ChunkSection()  = default;
+ChunkSection::~ChunkSection() = default;
+
+
 BlockState ChunkSection::GetBlock( LocalBlockPos pos ) const noexcept
 {
-   return FInBounds( pos ) ? m_blocks[ ToIndex( pos ) ] : BlockState( BlockId::Air );
+   if( !FInBounds( pos ) )
+      return BlockState( BlockId::Air );
+   if( m_pBlocks )
+      return ( *m_pBlocks )[ ToIndex( pos ) ];
+
+   return m_pPacked ? m_pPacked->Get( ToIndex( pos ) ) : BlockState( BlockId::Air );
+}
+
+
+SectionBlocksPtr ChunkSection::Snapshot() const
+{
+   if( !m_pPacked )
+      return m_pBlocks;
+
+   auto pBlocks = std::make_shared< SectionBlocks >();
+   m_pPacked->Unpack( *pBlocks );
+   return pBlocks;
 }
 
 
@@ -17,12 +48,78 @@ void ChunkSection::SetBlock( LocalBlockPos pos, BlockState state )
    if( !FInBounds( pos ) )
       return;
 
-   const size_t idx = ToIndex( pos );
-   if( m_blocks[ idx ] == state )
+   const size_t     idx      = ToIndex( pos );
+   const BlockState oldState = GetBlock( pos );
+   if( oldState == state )
+      return;
+
+   m_randomTickCount      = static_cast< uint16_t >( m_randomTickCount - FRandomTicks( oldState ) + FRandomTicks( state ) );
+   MutableBlocks()[ idx ] = state;
+   m_fDirty               = true;
+}
+
+
+void ChunkSection::Restore( SectionBlocksPtr pBlocks, PackedSectionPtr pPacked ) noexcept
+{
+   m_pBlocks         = std::move( pBlocks );
+   m_pPacked         = m_pBlocks ? nullptr : std::move( pPacked );
+   m_randomTickCount = 0;
+   m_fDirty          = true;
+   if( m_pBlocks )
+      m_randomTickCount = static_cast< uint16_t >( std::ranges::count_if( *m_pBlocks, FRandomTicks ) );
+   else if( m_pPacked )
+   {
+      for( size_t i = 0; i < CHUNK_SECTION_VOLUME; ++i )
+         m_randomTickCount = static_cast< uint16_t >( m_randomTickCount + FRandomTicks( m_pPacked->Get( i ) ) );
+   }
+}
+
+
+void ChunkSection::Pack()
+{
+   if( !m_pBlocks )
+      return;
+
+   // A snapshot still holding the array keeps its own reference
+   m_pPacked = std::make_shared< const PackedSection >( PackedSection::Pack( *m_pBlocks ) );
+   m_pBlocks.reset();
+}
+
+
+void ChunkSection::Unpack()
+{
+   if( !m_pPacked )
       return;
 
-   m_blocks[ idx ] = state;
-   m_fDirty        = true;
+   auto pBlocks = std::make_shared< SectionBlocks >();
+   m_pPacked->Unpack( *pBlocks );
+   m_pBlocks = std::move( pBlocks );
+   m_pPacked.reset();
+}
+
+
+size_t ChunkSection::StorageBytes() const noexcept
+{
+   if( m_pBlocks )
+      return sizeof( SectionBlocks );
+
+   return m_pPacked ? sizeof( PackedSection ) + m_pPacked->ByteSize() : 0;
+}
+
+
+SectionBlocks& ChunkSection::MutableBlocks()
+{
+   Unpack();
+
+   // Only the owning thread copies m_pBlocks, so a use count of 1 means no snapshot can observe the write.
+   // A snapshot released concurrently on the save thread only costs an unnecessary clone.
+   if( !m_pBlocks )
+      m_pBlocks = std::make_shared< SectionBlocks >();
+   else if( m_pBlocks.use_count() > 1 )
+      m_pBlocks = std::make_shared< SectionBlocks >( *m_pBlocks );
+
+   // Storage is always allocated non-const above; the const in SectionBlocksPtr only protects snapshots.
+   return const_cast< SectionBlocks& >( *m_pBlocks );
 }
 
 
@@ -38,6 +135,170 @@ void ChunkSection::SetBlock( LocalBlockPos pos, BlockState state )
 }
 
 
+// ----------------------------------------------------------------
+// ChunkSnapshot
+// ----------------------------------------------------------------
+void ChunkSnapshot::UnpackSections()
+{
+   for( const auto& [ i, pPacked ] : packed | std::views::enumerate )
+   {
+      if( !pPacked )
+         continue;
+
+      auto pBlocks = std::make_shared< SectionBlocks >();
+      pPacked->Unpack( *pBlocks );
+      sections[ i ] = std::move( pBlocks );
+      pPacked.reset();
+   }
+}
+
+
+std::vector< std::byte > ChunkSnapshot::Encode() const
+{
+   std::vector< std::byte > bytes;
+   auto                     append = [ &bytes ]( const void* pData, size_t size )
+   {
+      const size_t offset = bytes.size();
+      bytes.resize( offset + size );
+      std::memcpy( bytes.data() + offset, pData, size );
+   };
+
+   const ChunkFileHeader header;
+   append( &header, sizeof( header ) );
+   for( const auto& [ i, pBlocks ] : sections | std::views::enumerate )
+   {
+      if( !pBlocks && !packed[ i ] )
+      {
+         const uint16_t paletteSize = 0;
+         append( &paletteSize, sizeof( paletteSize ) );
+         continue;
+      }
+
+      // Sections the chunk held packed are written as they are
+      const PackedSection  packedHere  = pBlocks ? PackedSection::Pack( *pBlocks ) : PackedSection {};
+      const PackedSection& section     = pBlocks ? packedHere : *packed[ i ];
+      const uint16_t       paletteSize = static_cast< uint16_t >( section.palette.size() );
+      append( &paletteSize, sizeof( paletteSize ) );
+      append( &section.bitsPerBlock, sizeof( section.bitsPerBlock ) );
+      append( section.palette.data(), section.palette.size() * sizeof( BlockState ) );
+      append( section.words.data(), section.words.size() * sizeof( uint64_t ) );
+   }
+
+   const uint32_t tickCount = static_cast< uint32_t >( ticks.size() );
+   append( &tickCount, sizeof( tickCount ) );
+   for( const ChunkBlockTick& tick : ticks )
+   {
+      append( &tick.x, sizeof( tick.x ) );
+      append( &tick.y, sizeof( tick.y ) );
+      append( &tick.z, sizeof( tick.z ) );
+      append( &tick.block, sizeof( tick.block ) );
+      append( &tick.dueTick, sizeof( tick.dueTick ) );
+   }
+
+   return bytes;
+}
+
+
+/*static*/ uint16_t ChunkSnapshot::FormatVersion( std::span< const std::byte > bytes ) noexcept
+{
+   ChunkFileHeader header;
+   if( bytes.size() >= sizeof( header ) )
+   {
+      std::memcpy( &header, bytes.data(), sizeof( header ) );
+      if( header.magic == FORMAT_MAGIC )
+         return header.version;
+   }
+
+   return bytes.size() == static_cast< size_t >( CHUNK_VOLUME ) * sizeof( BlockState ) ? 1 : 0;
+}
+
+
+/*static*/ std::optional< ChunkSnapshot > ChunkSnapshot::Decode( const ChunkPos& cpos, std::span< const std::byte > bytes )
+{
+   ChunkSnapshot snapshot { .cpos = cpos };
+   auto          keepIfNotAir = []( std::shared_ptr< SectionBlocks > pSection ) -> SectionBlocksPtr
+   {
+      const bool fAir = std::all_of( pSection->begin(), pSection->end(), []( BlockState state ) { return state.GetId() == BlockId::Air; } );
+      return fAir ? nullptr : std::move( pSection );
+   };
+
+   switch( FormatVersion( bytes ) )
+   {
+      case 1:
+      {
+         // The flat y/z/x order is the sections laid out back to back.
+         for( const auto& [ i, pBlocks ] : snapshot.sections | std::views::enumerate )
+         {
+            auto pSection = std::make_shared< SectionBlocks >();
+            std::memcpy( pSection->data(), bytes.data() + i * sizeof( SectionBlocks ), sizeof( SectionBlocks ) );
+            pBlocks = keepIfNotAir( std::move( pSection ) );
+         }
+
+         return snapshot;
+      }
+
+      case 2:
+      case 3:
+      {
+         size_t offset = sizeof( ChunkFileHeader );
+         auto   read   = [ & ]( void* pData, size_t size )
+         {
+            if( offset + size > bytes.size() )
+               return false;
+
+            std::memcpy( pData, bytes.data() + offset, size );
+            offset += size;
+            return true;
+         };
+
+         for( SectionBlocksPtr& pBlocks : snapshot.sections )
+         {
+            uint16_t paletteSize = 0;
+            if( !read( &paletteSize, sizeof( paletteSize ) ) )
+               return std::nullopt;
+            if( paletteSize == 0 )
+               continue;
+
+            PackedSection packed;
+            packed.palette.resize( paletteSize );
+            if( !read( &packed.bitsPerBlock, sizeof( packed.bitsPerBlock ) ) || packed.bitsPerBlock > 16 ||
+                !read( packed.palette.data(), packed.palette.size() * sizeof( BlockState ) ) )
+               return std::nullopt;
+
+            packed.words.resize( PackedSection::WordCount( packed.bitsPerBlock ) );
+            if( !read( packed.words.data(), packed.words.size() * sizeof( uint64_t ) ) )
+               return std::nullopt;
+
+            auto pSection = std::make_shared< SectionBlocks >();
+            packed.Unpack( *pSection );
+            pBlocks = keepIfNotAir( std::move( pSection ) );
+         }
+
+         if( FormatVersion( bytes ) >= 3 )
+         {
+            uint32_t tickCount = 0;
+            if( !read( &tickCount, sizeof( tickCount ) ) )
+               return std::nullopt;
+
+            for( uint32_t i = 0; i < tickCount; ++i )
+            {
+               ChunkBlockTick tick;
+               if( !read( &tick.x, sizeof( tick.x ) ) || !read( &tick.y, sizeof( tick.y ) ) || !read( &tick.z, sizeof( tick.z ) ) ||
+                   !read( &tick.block, sizeof( tick.block ) ) || !read( &tick.dueTick, sizeof( tick.dueTick ) ) )
+                  return std::nullopt;
+
+               snapshot.ticks.push_back( tick );
+            }
+         }
+
+         return snapshot;
+      }
+
+      default: return std::nullopt;
+   }
+}
+
+
 // ----------------------------------------------------------------
 // Chunk
 // ----------------------------------------------------------------
@@ -49,54 +310,92 @@ Chunk::Chunk( Level& level, const ChunkPos& cpos ) :
 
 bool Chunk::FLoadFromDisk()
 {
-   std::vector< std::byte > bytes;
-   if( !World::WorldSave::FLoadChunkBytes( m_level.m_worldDir, GetCoord3(), bytes ) )
-      return false;
+   // A snapshot still waiting on the save thread is newer than whatever is on disk.
+   std::optional< ChunkSnapshot > optSnapshot = m_level.m_pSaveQueue->FindPending( m_cpos );
+   if( !optSnapshot )
+   {
+      std::vector< std::byte > bytes;
+      if( !World::WorldSave::FLoadChunkBytes( m_level.m_worldDir, World::ChunkPos3 { m_cpos.x, 0, m_cpos.z }, bytes ) )
+         return false;
 
-   const size_t needed = static_cast< size_t >( CHUNK_VOLUME ) * sizeof( BlockState );
-   if( bytes.size() != needed )
-      return false;
+      optSnapshot = ChunkSnapshot::Decode( m_cpos, bytes );
+      if( !optSnapshot )
+         return false;
+   }
 
-   size_t            p   = 0;
-   const BlockState* src = reinterpret_cast< const BlockState* >( bytes.data() );
-   for( int y = 0; y < CHUNK_SIZE_Y; ++y )
+   Restore( *optSnapshot );
+   return true;
+}
+
+
+void Chunk::Restore( const ChunkSnapshot& snapshot )
+{
    {
-      for( int z = 0; z < CHUNK_SIZE_Z; ++z )
-      {
-         for( int x = 0; x < CHUNK_SIZE_X; ++x )
-            m_sections[ ToSectionIndex( y ) ].SetBlock( LocalBlockPos { x, ToSectionLocalY( y ), z }, src[ p++ ] );
-      }
+      std::unique_lock lock( m_blocksMutex );
+      for( const auto& [ i, section ] : m_sections | std::views::enumerate )
+         section.Restore( snapshot.sections[ i ], snapshot.packed[ i ] );
+   }
+
+   for( const ChunkBlockTick& tick : snapshot.ticks )
+   {
+      const WorldBlockPos wpos { m_cpos.x * CHUNK_SIZE_X + tick.x, tick.y, m_cpos.z * CHUNK_SIZE_Z + tick.z };
+      m_level.m_pTicks->FSchedule( m_cpos, wpos, tick.block, tick.dueTick );
    }
 
    m_dirty        = ChunkDirty::Mesh;
+   m_fMeshRebuild = true;
    m_meshRevision = m_meshRevision + 1;
-   return true;
 }
 
 
-void Chunk::SaveToDisk()
+void Chunk::PackSections()
 {
-   if( !( Any( m_dirty & ChunkDirty::Save ) ) )
-      return;
+   std::unique_lock lock( m_blocksMutex );
+   for( ChunkSection& section : m_sections )
+      section.Pack();
+}
+
 
-   // Persist in the original flat format for compatibility.
-   std::vector< BlockState > flat;
-   flat.resize( static_cast< size_t >( CHUNK_VOLUME ), BlockState( BlockId::Air ) );
+void Chunk::UnpackSections()
+{
+   std::unique_lock lock( m_blocksMutex );
+   for( ChunkSection& section : m_sections )
+      section.Unpack();
+}
+
+
+size_t Chunk::ResidentBytes() const noexcept
+{
+   size_t bytes = sizeof( Chunk );
+   for( const ChunkSection& section : m_sections )
+      bytes += section.StorageBytes();
+
+   return bytes;
+}
 
-   size_t p = 0;
-   for( int y = 0; y < CHUNK_SIZE_Y; ++y )
+
+ChunkSnapshot Chunk::Snapshot() const
+{
+   ChunkSnapshot snapshot { .cpos = m_cpos };
+   for( const auto& [ i, section ] : m_sections | std::views::enumerate )
    {
-      for( int z = 0; z < CHUNK_SIZE_Z; ++z )
-      {
-         for( int x = 0; x < CHUNK_SIZE_X; ++x )
-            flat[ p++ ] = m_sections[ ToSectionIndex( y ) ].GetBlock( LocalBlockPos { x, ToSectionLocalY( y ), z } );
-      }
+      // Packed storage is shared rather than unpacked here; whoever reads the blocks unpacks it on their thread
+      if( section.FPacked() )
+         snapshot.packed[ i ] = section.PackedSnapshot();
+      else
+         snapshot.sections[ i ] = section.Snapshot();
    }
 
-   const auto byteSpan = std::span< const std::byte >( reinterpret_cast< const std::byte* >( flat.data() ), flat.size() * sizeof( BlockState ) );
-   World::WorldSave::FSaveChunkBytes( m_level.m_worldDir, GetCoord3(), byteSpan );
+   for( const ScheduledBlockTick& tick : m_level.m_pTicks->ChunkTicks( m_cpos ) )
+   {
+      snapshot.ticks.push_back( ChunkBlockTick { .x       = static_cast< uint8_t >( tick.pos.x - m_cpos.x * CHUNK_SIZE_X ),
+                                                 .y       = static_cast< uint8_t >( tick.pos.y ),
+                                                 .z       = static_cast< uint8_t >( tick.pos.z - m_cpos.z * CHUNK_SIZE_Z ),
+                                                 .block   = tick.block,
+                                                 .dueTick = tick.dueTick } );
+   }
 
-   ClearDirty( ChunkDirty::Save );
+   return snapshot;
 }
 
 
@@ -111,20 +410,90 @@ BlockState Chunk::GetBlock( LocalBlockPos pos ) const noexcept
 }
 
 
+BlockState Chunk::ReadBlock( LocalBlockPos pos ) const
+{
+   std::shared_lock lock( m_blocksMutex );
+   return GetBlock( pos );
+}
+
+
 void Chunk::SetBlock( LocalBlockPos pos, BlockState state )
 {
    if( !FInBounds( pos ) )
       return;
 
+   // Reads without the lock are fine here: edits only come from the main thread
    const int sIndex = ToSectionIndex( pos.y );
    const int ly     = ToSectionLocalY( pos.y );
    if( m_sections[ sIndex ].GetBlock( LocalBlockPos { pos.x, ly, pos.z } ) == state )
       return;
 
-   m_sections[ sIndex ].SetBlock( LocalBlockPos { pos.x, ly, pos.z }, state );
+   {
+      std::unique_lock lock( m_blocksMutex );
+      m_sections[ sIndex ].SetBlock( LocalBlockPos { pos.x, ly, pos.z }, state );
+   }
 
-   MarkDirty( ChunkDirty::Save | ChunkDirty::Mesh );
+   MarkDirty( ChunkDirty::Save );
+   MarkMeshEdit( pos );
    ++m_meshRevision;
+   ++m_blockRevision;
+}
+
+
+void Chunk::ClearDirty( ChunkDirty bits ) noexcept
+{
+   m_dirty = static_cast< ChunkDirty >( static_cast< uint32_t >( m_dirty ) & ~static_cast< uint32_t >( bits ) );
+   if( Any( bits & ChunkDirty::Mesh ) )
+   {
+      m_meshEdits.clear();
+      m_fMeshRebuild = false;
+   }
+}
+
+
+void Chunk::MarkDirty( ChunkDirty bits ) noexcept
+{
+   m_dirty = m_dirty | bits;
+   if( Any( bits & ChunkDirty::Mesh ) )
+   {
+      m_meshEdits.clear();
+      m_fMeshRebuild = true;
+   }
+}
+
+
+void Chunk::MarkMeshEdit( LocalBlockPos pos )
+{
+   m_dirty = m_dirty | ChunkDirty::Mesh;
+   if( m_fMeshRebuild )
+      return;
+
+   if( m_meshEdits.size() == MAX_MESH_EDITS )
+      MarkDirty( ChunkDirty::Mesh );
+   else
+      m_meshEdits.push_back( pos );
+}
+
+
+uint8_t Chunk::GetSkyLight( LocalBlockPos pos ) const noexcept
+{
+   if( pos.y >= CHUNK_SIZE_Y )
+      return MAX_LIGHT_LEVEL;
+   if( !FInBounds( pos ) )
+      return 0;
+
+   const LocalBlockPos sectionPos { pos.x, ToSectionLocalY( pos.y ), pos.z };
+   return m_sections[ ToSectionIndex( pos.y ) ].GetLight().sky.Get( ChunkSection::ToIndex( sectionPos ) );
+}
+
+
+uint8_t Chunk::GetBlockLight( LocalBlockPos pos ) const noexcept
+{
+   if( !FInBounds( pos ) )
+      return 0;
+
+   const LocalBlockPos sectionPos { pos.x, ToSectionLocalY( pos.y ), pos.z };
+   return m_sections[ ToSectionIndex( pos.y ) ].GetLight().block.Get( ChunkSection::ToIndex( sectionPos ) );
 }
 
 
@@ -134,35 +503,154 @@ bool Chunk::FInBounds( LocalBlockPos pos ) const noexcept
 }
 
 
+// ----------------------------------------------------------------
+// ChunkMap
+// ----------------------------------------------------------------
+ChunkHandle ChunkMap::Find( const ChunkPos& cpos ) const
+{
+   const Shard&     shard = m_shards[ ShardIndex( cpos ) ];
+   std::shared_lock lock( shard.mutex );
+   auto             it = shard.chunks.find( cpos );
+   return it != shard.chunks.end() ? it->second : nullptr;
+}
+
+
+bool ChunkMap::FContains( const ChunkPos& cpos ) const
+{
+   const Shard&     shard = m_shards[ ShardIndex( cpos ) ];
+   std::shared_lock lock( shard.mutex );
+   return shard.chunks.contains( cpos );
+}
+
+
+Chunk* ChunkMap::Peek( const ChunkPos& cpos ) const noexcept
+{
+   // No lock: the calling main thread is the only writer, and concurrent readers do not modify the map
+   const Shard& shard = m_shards[ ShardIndex( cpos ) ];
+   auto         it    = shard.chunks.find( cpos );
+   return it != shard.chunks.end() ? it->second.get() : nullptr;
+}
+
+
+Chunk& ChunkMap::Emplace( Level& level, const ChunkPos& cpos )
+{
+   Shard& shard = m_shards[ ShardIndex( cpos ) ];
+   if( auto it = shard.chunks.find( cpos ); it != shard.chunks.end() )
+      return *it->second;
+
+   // Allocated outside the lock; workers only wait for the insert itself
+   ChunkHandle      pChunk = std::make_shared< Chunk >( level, cpos );
+   std::unique_lock lock( shard.mutex );
+   shard.chunks.emplace( cpos, pChunk );
+   m_size.fetch_add( 1, std::memory_order_relaxed );
+   return *pChunk;
+}
+
+
+void ChunkMap::Erase( const ChunkPos& cpos )
+{
+   // The chunk is destroyed outside the lock, or later by the last worker still holding a handle
+   ChunkHandle pChunk;
+   Shard&      shard = m_shards[ ShardIndex( cpos ) ];
+   {
+      std::unique_lock lock( shard.mutex );
+      auto             it = shard.chunks.find( cpos );
+      if( it == shard.chunks.end() )
+         return;
+
+      pChunk = std::move( it->second );
+      shard.chunks.erase( it );
+   }
+
+   m_size.fetch_sub( 1, std::memory_order_relaxed );
+}
+
+
 // ----------------------------------------------------------------
 // Level
 // ----------------------------------------------------------------
 Level::Level( std::filesystem::path worldName ) :
    m_worldDir( World::WorldSave::RootDir( worldName ) ),
-   m_autosaveTimer( AUTOSAVE_INTERVAL )
+   m_autosaveTimer( AUTOSAVE_INTERVAL ),
+   m_pSaveQueue( std::make_unique< ChunkSaveQueue >( m_worldDir ) )
 {
-   // Load meta if present; otherwise defaults
+   // Load meta if present; otherwise defaults. The seed must survive reopening, or chunks generated
+   // later (or ahead of time by pre-generation) would not line up with the saved ones.
    if( auto meta = World::WorldSave::LoadMeta( m_worldDir ) )
-   {
-      m_meta         = *meta;
-      m_meta.version = 1;
-      m_meta.seed    = 5;
-      m_meta.tick    = 0;
-      World::WorldSave::FSaveMeta( m_worldDir, m_meta );
-   }
+      m_meta = *meta;
+
+   World::WorldSave::FSaveMeta( m_worldDir, m_meta );
+
+   m_pGenerator       = std::make_unique< TerrainGenerator >( m_meta.seed );
+   m_pPendingFeatures = std::make_unique< PendingFeatureWrites >( m_worldDir );
+   m_pLight           = std::make_unique< LightEngine >( *this );
+   m_pTicks           = std::make_unique< BlockTickScheduler >( m_meta.tick );
+   m_pFluids          = std::make_unique< FluidSimulator >( *this );
+   m_pFarField        = std::make_unique< FarField >();
+}
 
-   m_noise.SetSeed( static_cast< int >( m_meta.seed ) );
-   m_noise.SetNoiseType( FastNoiseLite::NoiseType_Perlin );
-   m_noise.SetFrequency( 0.005f );
-   m_noise.SetFractalType( FastNoiseLite::FractalType_FBm );
-   m_noise.SetFractalOctaves( 5 );
+
+Level::~Level()
+{
+   Save();
 }
 
 
 void Level::Update( float dt )
 {
+   ++m_meta.tick;
+
+   m_pLight->ApplyFinished();
+   TickRandomBlocks();
+   RunScheduledTicks();
+   m_pFluids->Tick( m_meta.tick );
+
+   // Runs between fixed ticks, so the snapshots taken here are a consistent view of the world.
+   // Serialization and file I/O happen on the save thread.
    if( m_autosaveTimer.FTick( dt ) )
-      Save();
+   {
+      SaveMeta();
+      m_pPendingFeatures->FSave();
+      m_pSaveQueue->RetryFailed();
+      QueueDirtyChunks();
+   }
+
+   if( m_backupTimer.FTick( dt ) )
+      FBeginBackup();
+
+   if( m_pBackup && m_pBackup->FDone() )
+   {
+      if( m_pBackup->FSucceeded() )
+         std::println( "Backup of tick {} written to {} ({} chunks, {} bytes)",
+                       m_pBackup->SnapshotTick(),
+                       m_pBackup->ArchivePath().string(),
+                       m_pBackup->ChunksWritten(),
+                       m_pBackup->BytesWritten() );
+      else
+         std::println( std::cerr, "Backup of tick {} failed", m_pBackup->SnapshotTick() );
+
+      m_pBackup.reset();
+   }
+}
+
+
+bool Level::FBeginBackup( std::filesystem::path archivePath, size_t maxBytesPerSecond )
+{
+   if( m_pBackup )
+      return false;
+
+   // Everything in memory is captured now; loaded chunks are newer than their pending saves. Feature writes
+   // waiting for ungenerated chunks are part of the world too.
+   std::vector< ChunkSnapshot > captured = m_pSaveQueue->PendingSnapshots();
+   std::erase_if( captured, [ this ]( const ChunkSnapshot& snapshot ) { return m_chunks.Peek( snapshot.cpos ) != nullptr; } );
+   captured.reserve( captured.size() + m_chunks.Size() );
+   m_chunks.ForEach( [ & ]( const Chunk& chunk ) { captured.push_back( chunk.Snapshot() ); } );
+
+   if( archivePath.empty() )
+      archivePath = World::WorldSave::BackupPath( m_worldDir, m_meta.tick );
+
+   m_pBackup = std::make_unique< WorldBackup >( m_worldDir, std::move( archivePath ), m_meta, std::move( captured ), m_pPendingFeatures->Capture(), maxBytesPerSecond );
+   return true;
 }
 
 
@@ -181,12 +669,145 @@ void Level::SavePlayer( const glm::vec3& playerPos ) const
 }
 
 
-void Level::Save() const
+void Level::Save()
 {
    SaveMeta();
+   m_pPendingFeatures->FSave();
+
+   m_pSaveQueue->RetryFailed();
+   QueueDirtyChunks();
+   m_pSaveQueue->Flush();
+}
+
+
+Level::PreGenResult Level::PreGenerateChunk( const ChunkPos& cpos ) const
+{
+   const World::ChunkPos3 cpos3 { cpos.x, 0, cpos.z };
+   std::error_code        ec;
+   if( m_chunks.FContains( cpos ) || m_pSaveQueue->FindPending( cpos ) || std::filesystem::exists( World::WorldSave::ChunkPath( m_worldDir, cpos3 ), ec ) )
+      return PreGenResult::AlreadySaved;
+
+   // Chunk files are written atomically, so an interrupted run leaves either the whole chunk or nothing
+   const std::vector< ChunkFeatureWrite > incoming = m_pPendingFeatures->Take( cpos );
+   std::vector< FeatureSpill >            spill;
+   const std::vector< std::byte >         bytes = m_pGenerator->Generate( cpos, incoming, &spill ).Encode();
+   if( !World::WorldSave::FSaveChunkBytes( m_worldDir, cpos3, bytes ) )
+   {
+      m_pPendingFeatures->Add( cpos, incoming );
+      return PreGenResult::Failed;
+   }
 
-   for( auto& [ _, chunk ] : m_chunks )
-      const_cast< Chunk& >( chunk ).SaveToDisk();
+   m_pPendingFeatures->Add( spill );
+   return PreGenResult::Generated;
+}
+
+
+void Level::QueueChunkSave( Chunk& chunk )
+{
+   if( !Any( chunk.Dirty() & ChunkDirty::Save ) )
+      return;
+
+   // Clearing here is safe: an edit made while the snapshot is in flight sets the bit again,
+   // and the queue writes snapshots of the same chunk in order.
+   m_pSaveQueue->Enqueue( chunk.Snapshot() );
+   chunk.ClearDirty( ChunkDirty::Save );
+}
+
+
+void Level::QueueDirtyChunks()
+{
+   m_chunks.ForEach( [ this ]( Chunk& chunk ) { QueueChunkSave( chunk ); } );
+}
+
+
+void Level::TickRandomBlocks()
+{
+   const auto      start = std::chrono::steady_clock::now();
+   RandomTickStats stats;
+
+   // Each chunk draws from its own stream seeded by world seed, position and tick, so the blocks picked
+   // do not depend on the order chunks are visited in or on which other chunks are loaded.
+   m_dueRandomTicks.clear();
+   m_chunks.ForEach( [ & ]( const Chunk& chunk )
+   {
+      const ChunkPos cpos = chunk.GetChunkPos();
+      TickRng        rng( m_meta.seed ^ ( ChunkPosHash {}( cpos ) * 0x9E3779B97F4A7C15ull ) ^ ( m_meta.tick * 0xD1B54A32D192ED03ull ) );
+      for( const auto& [ i, section ] : chunk.m_sections | std::views::enumerate )
+      {
+         ++stats.sections;
+         if( section.RandomTickCount() == 0 )
+            continue;
+
+         ++stats.activeSections;
+         for( int n = 0; n < RANDOM_TICKS_PER_SECTION; ++n )
+         {
+            const uint32_t      index = rng.NextBelow( CHUNK_SECTION_VOLUME );
+            const LocalBlockPos local { static_cast< int >( index & 0xF ), static_cast< int >( index >> 8 ), static_cast< int >( ( index >> 4 ) & 0xF ) };
+            if( !FRandomTicks( section.GetBlock( local ) ) )
+               continue;
+
+            const WorldBlockPos wpos { cpos.x * CHUNK_SIZE_X + local.x, static_cast< int >( i ) * CHUNK_SECTION_SIZE + local.y, cpos.z * CHUNK_SIZE_Z + local.z };
+            m_dueRandomTicks.push_back( DueRandomTick { wpos, rng.Next() } );
+         }
+      }
+   } );
+
+   // Behaviors may edit blocks and load chunks, so they run once the walk over m_chunks is done
+   for( const DueRandomTick& due : m_dueRandomTicks )
+   {
+      // An earlier behavior this tick may have replaced the block
+      const BlockState state = GetBlock( due.pos );
+      if( auto pfnOnRandomTick = World::BlockDefRegistry::Get( state.GetId() ).OnRandomTick )
+      {
+         TickRng rng( due.rngSeed );
+         pfnOnRandomTick( *this, due.pos, rng );
+         ++stats.blocksTicked;
+      }
+   }
+
+   stats.milliseconds = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+   m_randomTickStats  = stats;
+}
+
+
+const Level::FluidStats& Level::GetFluidStats() const noexcept
+{
+   return m_pFluids->GetStats();
+}
+
+
+bool Level::FScheduleTick( WorldBlockPos pos, BlockId block, uint32_t delay )
+{
+   auto [ cpos, local ] = WorldToChunk( pos );
+   Chunk* pChunk        = m_chunks.Peek( cpos );
+   if( !pChunk || !pChunk->FInBounds( local ) )
+      return false;
+
+   if( !m_pTicks->FSchedule( cpos, pos, block, m_meta.tick + ( std::max )( delay, 1u ) ) )
+      return false;
+
+   pChunk->MarkDirty( ChunkDirty::Save );
+   return true;
+}
+
+
+void Level::RunScheduledTicks()
+{
+   std::vector< ScheduledBlockTick > due;
+   m_pTicks->Advance( m_meta.tick, due );
+   for( const ScheduledBlockTick& tick : due )
+   {
+      auto [ cpos, _ ] = WorldToChunk( tick.pos );
+      if( Chunk* pChunk = m_chunks.Peek( cpos ) )
+         pChunk->MarkDirty( ChunkDirty::Save ); // the saved tick list changed
+
+      // The block may have been replaced since the tick was scheduled
+      if( GetBlock( tick.pos ).GetId() != tick.block )
+         continue;
+
+      if( auto pfnOnScheduledTick = World::BlockDefRegistry::Get( tick.block ).OnScheduledTick )
+         pfnOnScheduledTick( *this, tick.pos );
+   }
 }
 
 
@@ -211,8 +832,16 @@ std::tuple< ChunkPos, LocalBlockPos > Level::WorldToChunk( WorldBlockPos wpos )
 BlockState Level::GetBlock( WorldBlockPos pos ) const noexcept
 {
    auto [ cpos, local ] = WorldToChunk( pos );
-   auto it              = m_chunks.find( cpos );
-   return it != m_chunks.end() ? it->second.GetBlock( local ) : BlockState( BlockId::Air );
+   const Chunk* pChunk  = m_chunks.Peek( cpos );
+   return pChunk ? pChunk->GetBlock( local ) : BlockState( BlockId::Air );
+}
+
+
+BlockState Level::GetBlockConcurrent( WorldBlockPos pos ) const
+{
+   auto [ cpos, local ]     = WorldToChunk( pos );
+   const ChunkHandle pChunk = m_chunks.Find( cpos );
+   return pChunk ? pChunk->ReadBlock( local ) : BlockState( BlockId::Air );
 }
 
 
@@ -221,13 +850,13 @@ void Level::SetBlock( WorldBlockPos pos, BlockState state )
    auto [ cpos, local ] = WorldToChunk( pos );
 
    Chunk& chunk = EnsureChunk( cpos );
-   chunk.SetBlock( local, state );
+   if( chunk.GetBlock( local ) == state )
+      return;
 
-   // Changing a boundary block can affect neighbor faces.
-   if( local.x == 0 || local.x == CHUNK_SIZE_X - 1 || local.z == 0 || local.z == CHUNK_SIZE_Z - 1 )
-      MarkChunkAndNeighborsMeshDirty( cpos );
-   else
-      chunk.MarkDirty( ChunkDirty::Mesh );
+   chunk.SetBlock( local, state );
+   MarkBorderMeshEdits( cpos, local );
+   m_pLight->OnBlocksChanged( std::span( &pos, 1 ) );
+   m_pFluids->OnBlocksChanged( std::span( &pos, 1 ) );
 }
 
 
@@ -241,7 +870,7 @@ void Level::Explode( WorldBlockPos pos, uint8_t radius )
    int   minZ     = static_cast< int >( std::floor( pos.z - radius ) );
    int   maxZ     = static_cast< int >( std::ceil( pos.z + radius ) );
 
-   std::unordered_set< ChunkPos, ChunkPosHash > touched;
+   std::vector< WorldBlockPos > changed;
    for( int x = minX; x <= maxX; ++x )
    {
       for( int y = minY; y <= maxY; ++y )
@@ -256,14 +885,59 @@ void Level::Explode( WorldBlockPos pos, uint8_t radius )
 
             auto [ cpos, local ] = WorldToChunk( WorldBlockPos { x, y, z } );
             Chunk& chunk         = EnsureChunk( cpos );
+            if( chunk.GetBlock( local ).GetId() == BlockId::Air )
+               continue;
+
             chunk.SetBlock( local, BlockState( BlockId::Air ) );
-            touched.insert( cpos );
+            MarkBorderMeshEdits( cpos, local );
+            changed.push_back( WorldBlockPos { x, y, z } );
          }
       }
    }
 
-   for( const ChunkPos& cpos : touched )
-      MarkChunkAndNeighborsMeshDirty( cpos );
+   // One relight pass for the whole crater
+   m_pLight->OnBlocksChanged( changed );
+   m_pFluids->OnBlocksChanged( changed );
+}
+
+
+void Level::SetBlocks( std::span< const BlockWrite > writes )
+{
+   std::vector< WorldBlockPos > changed;
+   for( const BlockWrite& write : writes )
+   {
+      auto [ cpos, local ] = WorldToChunk( write.pos );
+      Chunk* pChunk        = m_chunks.Peek( cpos );
+      if( !pChunk || !pChunk->FInBounds( local ) || pChunk->GetBlock( local ) == write.state )
+         continue;
+
+      pChunk->SetBlock( local, write.state );
+      MarkBorderMeshEdits( cpos, local );
+      TouchChunk( *pChunk );
+      changed.push_back( write.pos );
+   }
+
+   if( changed.empty() )
+      return;
+
+   m_pLight->OnBlocksChanged( changed );
+   m_pFluids->OnBlocksChanged( changed );
+}
+
+
+uint8_t Level::GetSkyLight( WorldBlockPos pos ) const noexcept
+{
+   auto [ cpos, local ] = WorldToChunk( pos );
+   const Chunk* pChunk  = m_chunks.Peek( cpos );
+   return pChunk && pChunk->FLit() ? pChunk->GetSkyLight( local ) : MAX_LIGHT_LEVEL;
+}
+
+
+uint8_t Level::GetBlockLight( WorldBlockPos pos ) const noexcept
+{
+   auto [ cpos, local ] = WorldToChunk( pos );
+   const Chunk* pChunk  = m_chunks.Peek( cpos );
+   return pChunk && pChunk->FLit() ? pChunk->GetBlockLight( local ) : 0;
 }
 
 
@@ -289,61 +963,255 @@ void Level::UpdateStreaming( const glm::vec3& playerPos, uint8_t viewRadius )
       for( int dz = -viewRadius; dz <= viewRadius; ++dz )
       {
          const ChunkPos cpos { playerChunk.x + dx, playerChunk.z + dz };
-         if( !m_chunks.contains( cpos ) )
+         if( !m_chunks.Peek( cpos ) )
             EnsureChunk( cpos );
       }
    }
 
-   auto inView = [ & ]( const ChunkPos& cpos ) { return std::abs( cpos.x - playerChunk.x ) <= viewRadius && std::abs( cpos.z - playerChunk.z ) <= viewRadius; };
-   for( auto it = m_chunks.begin(); it != m_chunks.end(); )
+   // The warm rings fill in a few chunks per update, nearest first, so a large simulation radius never stalls a
+   // frame. Nothing new is loaded while over budget, or the budget pass would only evict it again.
+   const int    simulationRadius = ( std::max )( static_cast< int >( viewRadius ), static_cast< int >( m_residency.simulationRadius ) );
+   const size_t residentBytes    = m_residencyStats.hotBytes + m_residencyStats.warmBytes + m_residencyStats.coldBytes;
+   int          loads            = residentBytes < m_residency.memoryBudgetBytes ? 0 : WARM_LOADS_PER_UPDATE;
+   for( int r = viewRadius + 1; r <= simulationRadius && loads < WARM_LOADS_PER_UPDATE; ++r )
    {
-      if( !inView( it->first ) )
+      for( int dx = -r; dx <= r && loads < WARM_LOADS_PER_UPDATE; ++dx )
       {
-         it->second.SaveToDisk();
-         it = m_chunks.erase( it );
+         // Rows strictly inside the ring only touch it at both ends
+         const int dzStep = std::abs( dx ) == r ? 1 : 2 * r;
+         for( int dz = -r; dz <= r && loads < WARM_LOADS_PER_UPDATE; dz += dzStep )
+         {
+            const ChunkPos cpos { playerChunk.x + dx, playerChunk.z + dz };
+            if( !m_chunks.Peek( cpos ) )
+            {
+               EnsureChunk( cpos );
+               ++loads;
+            }
+         }
       }
-      else
-         ++it;
    }
 
+   if( m_residencyTick != m_meta.tick )
+   {
+      m_residencyTick = m_meta.tick;
+      UpdateResidency( playerChunk, viewRadius, simulationRadius );
+      m_pFarField->BuildQueued();
+   }
+
+   if( playerChunk != m_lastPlayerChunk )
+      m_pFarField->EvictBeyond( playerChunk, ( std::max )( static_cast< int >( m_residency.farFieldRadius ), simulationRadius ) );
+
    m_lastPlayerChunk = playerChunk;
 }
 
 
-void Level::GenerateChunkData( Chunk& chunk )
+void Level::UpdateResidency( const ChunkPos& playerChunk, int viewRadius, int simulationRadius )
 {
-   const int baseX = chunk.GetChunkPos().x * CHUNK_SIZE_X;
-   const int baseZ = chunk.GetChunkPos().z * CHUNK_SIZE_Z;
-   for( int z = 0; z < CHUNK_SIZE_Z; ++z )
+   auto distance = [ & ]( const ChunkPos& cpos ) { return ( std::max )( std::abs( cpos.x - playerChunk.x ), std::abs( cpos.z - playerChunk.z ) ); };
+   const bool fDecay = m_meta.tick % HEAT_HALF_LIFE_TICKS == 0;
+
+   std::vector< ChunkPos >                   toCold;
+   std::vector< std::pair< int, ChunkPos > > warm; // distance, chunk
+   m_chunks.ForEach( [ & ]( Chunk& chunk )
    {
-      for( int x = 0; x < CHUNK_SIZE_X; ++x )
+      const ChunkPos cpos = chunk.GetChunkPos();
+      if( fDecay )
+         chunk.m_accessHeat /= 2;
+
+      const int d = distance( cpos );
+      if( d <= viewRadius )
       {
-         const float worldX = static_cast< float >( baseX + x );
-         const float worldZ = static_cast< float >( baseZ + z );
-
-         const int minHeight    = 32;
-         const int maxHeight    = 128;
-         const int heightRange  = maxHeight - minHeight;
-         float     noise        = ( m_noise.GetNoise( worldX, worldZ ) * 0.5f ) + 0.5f;
-         int       columnHeight = std::clamp( static_cast< int >( noise * heightRange ), minHeight, CHUNK_SIZE_Y - 1 );
-         for( int y = 0; y <= columnHeight; ++y )
+         if( chunk.m_tier != ChunkTier::Hot )
          {
-            BlockId id { BlockId::Air };
-            if( y == 0 )
-               id = BlockId::Bedrock;
-            else if( y < columnHeight - 4 )
-               id = BlockId::Stone;
-            else
-               id = BlockId::Dirt;
-
-            chunk.SetBlock( LocalBlockPos { x, y, z }, BlockState( id ) );
+            chunk.UnpackSections();
+            chunk.m_tier = ChunkTier::Hot;
+            ++m_residencyStats.promotions;
          }
       }
+      else if( d <= simulationRadius || chunk.m_accessHeat >= WARM_ACCESS_HEAT )
+      {
+         if( chunk.m_tier == ChunkTier::Hot )
+         {
+            chunk.m_tier = ChunkTier::Warm;
+            ++m_residencyStats.demotions;
+         }
+
+         // Sections unpacked by writes stay that way until the chunk goes quiet
+         if( chunk.m_accessHeat == 0 )
+            chunk.PackSections();
+
+         warm.emplace_back( d, cpos );
+      }
+      else
+         toCold.push_back( cpos );
+   } );
+
+   for( const ChunkPos& cpos : toCold )
+      DemoteToCold( cpos );
+
+   ResidencyStats& stats = m_residencyStats;
+   stats.hotChunks = stats.warmChunks = stats.hotBytes = stats.warmBytes = stats.coldBytes = 0;
+   m_chunks.ForEach( [ &stats ]( const Chunk& chunk )
+   {
+      ( chunk.m_tier == ChunkTier::Hot ? stats.hotChunks : stats.warmChunks ) += 1;
+      ( chunk.m_tier == ChunkTier::Hot ? stats.hotBytes : stats.warmBytes ) += chunk.ResidentBytes();
+   } );
+   for( const auto& [ _, cold ] : m_coldChunks )
+      stats.coldBytes += sizeof( ColdChunk ) + cold.bytes.size();
+   stats.coldChunks  = m_coldChunks.size();
+   stats.budgetBytes = m_residency.memoryBudgetBytes;
+
+   if( stats.hotBytes + stats.warmBytes + stats.coldBytes <= stats.budgetBytes )
+      return;
+
+   // Least recently used cold chunks go first; they were saved when they went cold, so dropping them is free
+   std::vector< std::pair< uint64_t, ChunkPos > > cold;
+   cold.reserve( m_coldChunks.size() );
+   for( const auto& [ cpos, entry ] : m_coldChunks )
+      cold.emplace_back( entry.lastAccessTick, cpos );
+   std::ranges::sort( cold, {}, &std::pair< uint64_t, ChunkPos >::first );
+
+   for( const auto& [ _, cpos ] : cold )
+   {
+      if( stats.hotBytes + stats.warmBytes + stats.coldBytes <= stats.budgetBytes )
+         break;
+
+      auto it = m_coldChunks.find( cpos );
+      stats.coldBytes -= sizeof( ColdChunk ) + it->second.bytes.size();
+      --stats.coldChunks;
+      ++stats.evictions;
+      m_coldChunks.erase( it );
+   }
+
+   // Then the farthest warm chunks, written back through the save queue. Hot chunks are never evicted.
+   std::ranges::sort( warm, std::greater<> {}, &std::pair< int, ChunkPos >::first );
+   for( const auto& [ _, cpos ] : warm )
+   {
+      if( stats.hotBytes + stats.warmBytes + stats.coldBytes <= stats.budgetBytes )
+         break;
+
+      stats.warmBytes -= m_chunks.Peek( cpos )->ResidentBytes();
+      --stats.warmChunks;
+      ++stats.evictions;
+      UnloadChunk( cpos );
    }
+}
+
+
+void Level::DemoteToCold( const ChunkPos& cpos )
+{
+   Chunk* pChunk = m_chunks.Peek( cpos );
+   if( !pChunk )
+      return;
+
+   // Cold chunks are always clean: unsaved edits are queued first, so evicting one later needs no I/O
+   Chunk&              chunk    = *pChunk;
+   const ChunkSnapshot snapshot = chunk.Snapshot();
+   if( Any( chunk.Dirty() & ChunkDirty::Save ) )
+   {
+      m_pSaveQueue->Enqueue( snapshot );
+      chunk.ClearDirty( ChunkDirty::Save );
+   }
+
+   std::vector< std::byte > compressed = RunLengthCodec::Encode( snapshot.Encode() );
+   m_pFarField->Queue( cpos, compressed );
+   m_coldChunks[ cpos ] = ColdChunk { .bytes = std::move( compressed ), .lastAccessTick = m_meta.tick };
+   ++m_residencyStats.demotions;
+
+   m_pTicks->DropChunk( cpos );
+   m_pFluids->DropChunk( cpos );
+   m_chunks.Erase( cpos );
+}
+
+
+bool Level::FRestoreFromCold( Chunk& chunk )
+{
+   auto it = m_coldChunks.find( chunk.GetChunkPos() );
+   if( it == m_coldChunks.end() )
+      return false;
+
+   // On failure the caller falls back to disk, where the same state was saved when the chunk went cold
+   std::optional< ChunkSnapshot >                   optSnapshot;
+   const std::optional< std::vector< std::byte > > optBytes = RunLengthCodec::Decode( it->second.bytes );
+   if( optBytes )
+      optSnapshot = ChunkSnapshot::Decode( chunk.GetChunkPos(), *optBytes );
+
+   m_coldChunks.erase( it );
+   if( !optSnapshot )
+      return false;
+
+   chunk.Restore( *optSnapshot );
+   ++m_residencyStats.promotions;
+   return true;
+}
+
+
+void Level::UnloadChunk( const ChunkPos& cpos )
+{
+   Chunk* pChunk = m_chunks.Peek( cpos );
+   if( !pChunk )
+      return;
+
+   QueueChunkSave( *pChunk );
+   m_pFarField->Queue( cpos, RunLengthCodec::Encode( pChunk->Snapshot().Encode() ) );
+   m_pTicks->DropChunk( cpos );
+   m_pFluids->DropChunk( cpos );
+   m_chunks.Erase( cpos );
+}
+
+
+void Level::TouchChunk( Chunk& chunk ) noexcept
+{
+   if( chunk.m_accessHeat < UINT32_MAX )
+      ++chunk.m_accessHeat;
+}
+
+
+void Level::GenerateChunkData( Chunk& chunk )
+{
+   std::vector< FeatureSpill > spill;
+   const ChunkSnapshot         generated = m_pGenerator->Generate( chunk.GetChunkPos(), m_pPendingFeatures->Take( chunk.GetChunkPos() ), &spill );
+   chunk.Restore( generated );
 
    // Mark chunk dirty and save
-   chunk.MarkDirty( ChunkDirty::Save | ChunkDirty::Mesh );
-   chunk.SaveToDisk();
+   chunk.MarkDirty( ChunkDirty::Save );
+   QueueChunkSave( chunk );
+
+   DeliverFeatureSpill( spill );
+}
+
+
+void Level::ApplyPendingFeatures( Chunk& chunk )
+{
+   // The chunk is not lit yet, so its light picks these up when it is computed
+   for( const ChunkFeatureWrite& write : m_pPendingFeatures->Take( chunk.GetChunkPos() ) )
+   {
+      const LocalBlockPos local { write.x, write.y, write.z };
+      if( chunk.GetBlock( local ).GetId() == BlockId::Air )
+         chunk.SetBlock( local, write.state );
+   }
+}
+
+
+void Level::DeliverFeatureSpill( std::span< const FeatureSpill > spill )
+{
+   // Loaded neighbors take their blocks now; everything else waits for its chunk rather than generating it
+   std::vector< BlockWrite > loaded;
+   for( const FeatureSpill& entry : spill )
+   {
+      const Chunk* pTarget = m_chunks.Peek( entry.target );
+      if( !pTarget )
+      {
+         m_pPendingFeatures->Add( std::span( &entry, 1 ) );
+         continue;
+      }
+
+      const LocalBlockPos local { entry.write.x, entry.write.y, entry.write.z };
+      if( pTarget->GetBlock( local ).GetId() == BlockId::Air )
+         loaded.push_back( BlockWrite { WorldBlockPos { entry.target.x * CHUNK_SIZE_X + local.x, local.y, entry.target.z * CHUNK_SIZE_Z + local.z }, entry.write.state } );
+   }
+
+   SetBlocks( loaded );
 }
 
 
@@ -351,8 +1219,8 @@ void Level::MarkChunkAndNeighborsMeshDirty( const ChunkPos& cpos )
 {
    auto mark = [ & ]( const ChunkPos& c )
    {
-      if( auto it = m_chunks.find( c ); it != m_chunks.end() )
-         it->second.MarkDirty( ChunkDirty::Mesh );
+      if( Chunk* pChunk = m_chunks.Peek( c ) )
+         pChunk->MarkDirty( ChunkDirty::Mesh );
    };
 
    mark( cpos );
@@ -363,15 +1231,54 @@ void Level::MarkChunkAndNeighborsMeshDirty( const ChunkPos& cpos )
 }
 
 
+void Level::MarkBorderMeshEdits( const ChunkPos& cpos, LocalBlockPos local )
+{
+   auto mark = [ & ]( const ChunkPos& c, int x, int z )
+   {
+      if( Chunk* pChunk = m_chunks.Peek( c ) )
+         pChunk->MarkMeshEdit( LocalBlockPos { x, local.y, z } );
+   };
+
+   // Blocks on a border have faces of the neighbor's blocks next to them
+   if( local.x == 0 )
+      mark( { cpos.x - 1, cpos.z }, CHUNK_SIZE_X, local.z );
+   else if( local.x == CHUNK_SIZE_X - 1 )
+      mark( { cpos.x + 1, cpos.z }, -1, local.z );
+
+   if( local.z == 0 )
+      mark( { cpos.x, cpos.z - 1 }, local.x, CHUNK_SIZE_Z );
+   else if( local.z == CHUNK_SIZE_Z - 1 )
+      mark( { cpos.x, cpos.z + 1 }, local.x, -1 );
+}
+
+
 Chunk& Level::EnsureChunk( const ChunkPos& cpos )
 {
-   if( auto it = m_chunks.find( cpos ); it != m_chunks.end() )
-      return it->second;
+   if( Chunk* pChunk = m_chunks.Peek( cpos ) )
+   {
+      TouchChunk( *pChunk );
+      return *pChunk;
+   }
+
+   Chunk& chunk = m_chunks.Emplace( *this, cpos );
+   if( FRestoreFromCold( chunk ) || chunk.FLoadFromDisk() )
+   {
+      if( m_pBackup )
+         m_pBackup->OnChunkLoaded( chunk );
+
+      // Neighbors generated since this chunk was saved may have grown into it
+      ApplyPendingFeatures( chunk );
+   }
+   else
+   {
+      // Report before generating; the generated chunk is queued for saving and its file may appear at any time.
+      if( m_pBackup )
+         m_pBackup->OnChunkGenerated( cpos );
 
-   Chunk& chunk = m_chunks.try_emplace( cpos, *this, cpos ).first->second;
-   if( !chunk.FLoadFromDisk() )
       GenerateChunkData( chunk );
+   }
 
+   m_pLight->QueueChunk( chunk );
    MarkChunkAndNeighborsMeshDirty( cpos );
 
    return chunk;
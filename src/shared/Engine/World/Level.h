@@ -4,8 +4,6 @@
 // "std headers only via PCH" rule.
 #include "pch_shared.h"
 
-#include <FastNoiseLite/FastNoiseLite.h>
-
 #include <Engine/Core/Time.h>
 #include <Engine/World/Blocks.h>
 #include <Engine/World/WorldSave.h>
@@ -127,32 +125,165 @@ struct LocalBlockPos : BlockPos
    using BlockPos::BlockPos;
 };
 
+// Block storage of a single section. Shared between a live section and any in-flight snapshots (copy-on-write).
+using SectionBlocks    = std::array< BlockState, CHUNK_SECTION_VOLUME >;
+using SectionBlocksPtr = std::shared_ptr< const SectionBlocks >;
+
+// Light levels run 0-15; skylight is 15 under open sky, block light is emitted by blocks such as furnaces
+static constexpr uint8_t MAX_LIGHT_LEVEL = 15;
+
+// ----------------------------------------------------------------
+// NibbleArray - one 4-bit value per block of a section
+// ----------------------------------------------------------------
+class NibbleArray
+{
+public:
+   uint8_t Get( size_t index ) const noexcept { return ( m_data[ index >> 1 ] >> ( ( index & 1 ) << 2 ) ) & 0xF; }
+   void    Set( size_t index, uint8_t value ) noexcept
+   {
+      const int shift       = ( index & 1 ) << 2;
+      m_data[ index >> 1 ] = static_cast< uint8_t >( ( m_data[ index >> 1 ] & ~( 0xF << shift ) ) | ( ( value & 0xF ) << shift ) );
+   }
+
+   void Fill( uint8_t value ) noexcept { m_data.fill( static_cast< uint8_t >( ( value & 0xF ) * 0x11 ) ); }
+
+private:
+   std::array< uint8_t, CHUNK_SECTION_VOLUME / 2 > m_data {};
+};
+
+// Light of a single section, indexed like SectionBlocks
+struct SectionLight
+{
+   NibbleArray sky;
+   NibbleArray block;
+};
+
+struct PackedSection;
+
+// Packed storage never changes once made (writes unpack the section first), so snapshots share it like SectionBlocks
+using PackedSectionPtr = std::shared_ptr< const PackedSection >;
+
 // ----------------------------------------------------------------
 // ChunkSection - 16x16x16 block subsection of a chunk
 // ----------------------------------------------------------------
 class ChunkSection
 {
 public:
-   ChunkSection()  = default;
-   ~ChunkSection() = default;
+   ChunkSection();
+   ~ChunkSection();
 
    BlockState GetBlock( LocalBlockPos pos ) const noexcept;
    void       SetBlock( LocalBlockPos pos, BlockState state );
 
+   // Copy-on-write view of the block storage, nullptr when the section is all air.
+   // Cheap to take; the next SetBlock clones the storage if the snapshot is still alive.
+   // A packed section is unpacked into a fresh copy; PackedSnapshot shares its packed storage instead.
+   SectionBlocksPtr        Snapshot() const;
+   const PackedSectionPtr& PackedSnapshot() const noexcept { return m_pPacked; } // nullptr unless packed
+   void                    Restore( SectionBlocksPtr pBlocks, PackedSectionPtr pPacked = nullptr ) noexcept;
+
+   bool FEmpty() const noexcept { return !m_pBlocks && !m_pPacked; }
+
+   // Residency: a packed section answers reads from its palette and unpacks itself on the next write
+   void   Pack();
+   void   Unpack();
+   bool   FPacked() const noexcept { return m_pPacked != nullptr; }
+   size_t StorageBytes() const noexcept; // heap held for blocks
+
+   // Number of blocks in the section that react to random ticks; sections with none are skipped
+   uint16_t RandomTickCount() const noexcept { return m_randomTickCount; }
+
+   const SectionLight& GetLight() const noexcept { return m_light; }
+   SectionLight&       GetLight() noexcept { return m_light; }
+
+   static size_t ToIndex( LocalBlockPos pos ) noexcept;
+
 private:
    NO_COPY_MOVE( ChunkSection )
 
-   static size_t ToIndex( LocalBlockPos pos ) noexcept;
-   static bool   FInBounds( LocalBlockPos pos ) noexcept;
+   static bool FInBounds( LocalBlockPos pos ) noexcept;
+
+   SectionBlocks& MutableBlocks();
 
-   std::array< BlockState, CHUNK_SECTION_VOLUME > m_blocks { BlockState( BlockId::Air ) };
-   bool                                           m_fDirty { true };
+   SectionBlocksPtr m_pBlocks;
+   PackedSectionPtr m_pPacked; // set instead of m_pBlocks while packed
+   SectionLight     m_light;   // not saved; recomputed when the chunk loads
+   uint16_t         m_randomTickCount { 0 };
+   bool             m_fDirty { true };
 
 public:
    bool FDirty() const noexcept { return m_fDirty; }
    void ClearDirty() noexcept { m_fDirty = false; }
 };
 
+
+// Scheduled block tick saved with its chunk
+struct ChunkBlockTick
+{
+   uint8_t  x { 0 }, y { 0 }, z { 0 }; // chunk-local
+   BlockId  block { BlockId::Air };
+   uint64_t dueTick { 0 }; // absolute, in level ticks (WorldMeta::tick)
+};
+
+// Block placed into a chunk by a feature (such as a tree) rooted in a neighboring chunk. Only replaces air.
+struct ChunkFeatureWrite
+{
+   uint8_t    x { 0 }, y { 0 }, z { 0 }; // chunk-local
+   BlockState state;
+};
+
+// Feature block that landed outside the chunk being generated, addressed to the chunk it belongs to
+struct FeatureSpill
+{
+   ChunkPos          target;
+   ChunkFeatureWrite write;
+};
+
+// ----------------------------------------------------------------
+// ChunkSnapshot - immutable copy of a chunk's blocks at a tick boundary
+// ----------------------------------------------------------------
+struct ChunkSnapshot
+{
+   ChunkPos                                           cpos;
+   std::array< SectionBlocksPtr, SECTIONS_PER_CHUNK > sections {};
+   std::array< PackedSectionPtr, SECTIONS_PER_CHUNK > packed {}; // set instead of sections[ i ] for sections the chunk held packed
+   std::vector< ChunkBlockTick >                      ticks;
+
+   World::ChunkPos3 Coord3() const noexcept { return World::ChunkPos3 { cpos.x, 0, cpos.z }; }
+
+   // A chunk's snapshot shares its packed sections rather than unpacking them on the main thread. Encode writes
+   // them as they are; anything reading `sections` calls this first, on its own thread.
+   void UnpackSections();
+
+   // On-disk chunk formats:
+   //   1 - legacy flat array of every block in y/z/x order (CHUNK_VOLUME * sizeof( BlockState ) bytes, no header)
+   //   2 - ChunkFileHeader, then per section: uint16 palette size (0 = all air), uint8 bits per block,
+   //       the palette, and the PackedSection words
+   //   3 - version 2, then uint32 scheduled tick count and per tick: uint8 x, y, z, uint16 block, uint64 due tick
+   static constexpr uint32_t FORMAT_MAGIC   = 0x4B43474F; // "OGCK"
+   static constexpr uint16_t FORMAT_VERSION = 3;
+
+   struct ChunkFileHeader
+   {
+      uint32_t magic { FORMAT_MAGIC };
+      uint16_t version { FORMAT_VERSION };
+      uint16_t sectionCount { SECTIONS_PER_CHUNK };
+   };
+
+   // Encode always writes FORMAT_VERSION; Decode reads every known version
+   std::vector< std::byte >               Encode() const;
+   static std::optional< ChunkSnapshot > Decode( const ChunkPos& cpos, std::span< const std::byte > bytes );
+   static uint16_t                        FormatVersion( std::span< const std::byte > bytes ) noexcept; // 0 if unrecognized
+};
+
+// Residency tier of a chunk held in memory; see Level::ResidencyOptions
+enum class ChunkTier : uint8_t
+{
+   Hot,  // within view: unpacked and meshed
+   Warm, // simulated: sections palette-packed while idle
+   Cold  // compressed bytes only, not simulated
+};
+
 // ----------------------------------------------------------------
 // Chunk - world data for a fixed-size region (no rendering ownership)
 // ----------------------------------------------------------------
@@ -161,68 +292,290 @@ class Chunk
 public:
    Chunk( class Level& level, const ChunkPos& cpos );
 
+   // GetBlock is for the main thread, which owns every edit. ReadBlock may run on any thread alongside edits.
    BlockState GetBlock( LocalBlockPos pos ) const noexcept;
+   BlockState ReadBlock( LocalBlockPos pos ) const;
    void       SetBlock( LocalBlockPos pos, BlockState state );
 
    ChunkPos GetChunkPos() const noexcept { return m_cpos; }
    bool     FInBounds( LocalBlockPos pos ) const noexcept;
 
-   bool FLoadFromDisk();
-   void SaveToDisk();
+   bool          FLoadFromDisk();
+   ChunkSnapshot Snapshot() const;
+
+   ChunkTier Tier() const noexcept { return m_tier; }
+   size_t    ResidentBytes() const noexcept;
 
    ChunkDirty Dirty() const noexcept { return m_dirty; }
-   void ClearDirty( ChunkDirty bits ) noexcept { m_dirty = static_cast< ChunkDirty >( static_cast< uint32_t >( m_dirty ) & ~static_cast< uint32_t >( bits ) ); }
+   void       ClearDirty( ChunkDirty bits ) noexcept;
    uint64_t MeshRevision() const noexcept { return m_meshRevision; }
 
+   // Blocks whose state, or the light in them, changed since the mesh dirty bit was last cleared, for meshes that
+   // patch the faces around each one instead of rebuilding. Chunk-relative, reaching one block past the x and z
+   // borders for changes in neighbors whose faces this chunk shows. Only meaningful while FMeshRebuild() is false:
+   // loads, lighting a chunk and runs of edits too long to list all mark the whole chunk instead.
+   static constexpr size_t          MAX_MESH_EDITS = 256;
+   std::span< const LocalBlockPos > MeshEdits() const noexcept { return m_meshEdits; }
+   bool                             FMeshRebuild() const noexcept { return m_fMeshRebuild; }
+
+   // False until the light engine has installed this chunk's initial lighting
+   bool FLit() const noexcept { return m_fLit; }
+
+   uint8_t GetSkyLight( LocalBlockPos pos ) const noexcept;
+   uint8_t GetBlockLight( LocalBlockPos pos ) const noexcept;
+
    std::span< const ChunkSection > GetSections() const noexcept { return m_sections; }
 
 private:
    NO_COPY_MOVE( Chunk )
 
-   void MarkDirty( ChunkDirty bits ) noexcept { m_dirty = m_dirty | bits; }
+   void MarkDirty( ChunkDirty bits ) noexcept;
+   void MarkMeshEdit( LocalBlockPos pos ); // sets the mesh dirty bit, listing `pos` in MeshEdits()
+   void Restore( const ChunkSnapshot& snapshot );
+   void PackSections();
+   void UnpackSections();
 
    static constexpr int ToSectionIndex( int y ) noexcept { return y / CHUNK_SECTION_SIZE; }
    static constexpr int ToSectionLocalY( int y ) noexcept { return y % CHUNK_SECTION_SIZE; }
 
-   World::ChunkPos3 GetCoord3() const noexcept { return World::ChunkPos3 { m_cpos.x, 0, m_cpos.z }; }
-
    class Level&   m_level;
    const ChunkPos m_cpos { INT32_MIN, INT32_MIN };
 
    std::array< ChunkSection, SECTIONS_PER_CHUNK > m_sections;
+   mutable std::shared_mutex                      m_blocksMutex; // shared by ReadBlock, exclusive while block storage changes
 
-   ChunkDirty m_dirty { ChunkDirty::Mesh };
-   uint64_t   m_meshRevision { 1 };
+   ChunkDirty                   m_dirty { ChunkDirty::Mesh };
+   std::vector< LocalBlockPos > m_meshEdits;
+   bool                         m_fMeshRebuild { true }; // the mesh is dirty beyond what m_meshEdits lists
+   uint64_t                     m_meshRevision { 1 };
+   uint64_t                     m_blockRevision { 0 }; // bumped on every block change, used to detect stale light jobs
+   uint64_t                     m_lightTicket { 0 };   // latest light job queued for this chunk
+   bool                         m_fLit { false };
+
+   ChunkTier m_tier { ChunkTier::Hot };
+   uint32_t  m_accessHeat { 0 }; // bumped by block access through the level, halved periodically
 
    friend class Level;
+   friend class LightEngine;
 };
 
+// Refcounted reference to a chunk. It keeps the chunk alive after it unloads, so a worker holding one never
+// reads freed memory; an unloaded chunk simply stops changing.
+using ChunkHandle = std::shared_ptr< Chunk >;
+
+// ----------------------------------------------------------------
+// ChunkMap - loaded chunks, shared between the main thread and workers
+// ----------------------------------------------------------------
+// Sharded by chunk position with a reader/writer lock per shard, so a lookup from a worker only waits on an
+// insert or erase that lands in the same shard. Only the main thread inserts and erases, so it may also read
+// without locking through Peek and ForEach; every other thread goes through Find and FContains.
+class ChunkMap
+{
+public:
+   static constexpr int    SHARD_BITS  = 6;
+   static constexpr size_t SHARD_COUNT = size_t( 1 ) << SHARD_BITS;
+
+   ChunkMap() = default;
+
+   // Any thread
+   ChunkHandle Find( const ChunkPos& cpos ) const;
+   bool        FContains( const ChunkPos& cpos ) const;
+   size_t      Size() const noexcept { return m_size.load( std::memory_order_relaxed ); }
+
+   // Main thread only
+   Chunk* Peek( const ChunkPos& cpos ) const noexcept;
+   Chunk& Emplace( class Level& level, const ChunkPos& cpos ); // the existing chunk if already present
+   void   Erase( const ChunkPos& cpos );
+
+   template< typename Fn >
+   void ForEach( Fn&& fn )
+   {
+      for( Shard& shard : m_shards )
+      {
+         for( auto& [ _, pChunk ] : shard.chunks )
+            fn( *pChunk );
+      }
+   }
+
+   template< typename Fn >
+   void ForEach( Fn&& fn ) const
+   {
+      for( const Shard& shard : m_shards )
+      {
+         for( const auto& [ _, pChunk ] : shard.chunks )
+            fn( std::as_const( *pChunk ) );
+      }
+   }
+
+private:
+   NO_COPY_MOVE( ChunkMap )
+
+   struct Shard
+   {
+      mutable std::shared_mutex                                   mutex;
+      std::unordered_map< ChunkPos, ChunkHandle, ChunkPosHash > chunks;
+   };
+
+   static size_t ShardIndex( const ChunkPos& cpos ) noexcept
+   {
+      // Top bits of the mixed hash, so the shard does not correlate with the bucket inside it
+      return static_cast< size_t >( ( static_cast< uint64_t >( ChunkPosHash {}( cpos ) ) * 0x9E3779B97F4A7C15ull ) >> ( 64 - SHARD_BITS ) );
+   }
+
+   std::array< Shard, SHARD_COUNT > m_shards;
+   std::atomic< size_t >            m_size { 0 };
+};
+
+
+// ----------------------------------------------------------------
+// TickRng - small deterministic generator for block ticks (SplitMix64)
+// ----------------------------------------------------------------
+class TickRng
+{
+public:
+   explicit TickRng( uint64_t seed ) noexcept :
+      m_state( seed )
+   {}
+
+   uint64_t Next() noexcept
+   {
+      uint64_t z = ( m_state += 0x9E3779B97F4A7C15ull );
+      z          = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+      z          = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+      return z ^ ( z >> 31 );
+   }
+
+   // Uniform in [0, bound)
+   uint32_t NextBelow( uint32_t bound ) noexcept { return static_cast< uint32_t >( ( ( Next() >> 32 ) * bound ) >> 32 ); }
+
+private:
+   uint64_t m_state;
+};
+
+
+class BlockTickScheduler;
+class ChunkSaveQueue;
+class FarField;
+class FluidSimulator;
+class LightEngine;
+class PendingFeatureWrites;
+class TerrainGenerator;
+class WorldBackup;
 
 class Level
 {
 public:
    explicit Level( std::filesystem::path worldName );
-   ~Level() = default;
+   ~Level();
 
+   // Advances the level by one fixed tick
    void Update( float dt );
 
    // World save
-   void Save() const;
+   void Save();
    void SaveMeta() const;
    void SavePlayer( const glm::vec3& playerPos ) const;
 
+   // Online backup: freezes the world at the current tick and streams it into a single archive on a background
+   // thread, at most `maxBytesPerSecond`. An empty path uses WorldSave::BackupPath. Fails if a backup is running.
+   bool FBeginBackup( std::filesystem::path archivePath = {}, size_t maxBytesPerSecond = BACKUP_BYTES_PER_SECOND );
+   bool FBackupInProgress() const noexcept { return m_pBackup != nullptr; }
+
+   uint64_t GetTick() const noexcept { return m_meta.tick; }
+
+   // Random ticks: every fixed tick, each section draws RANDOM_TICKS_PER_SECTION positions and blocks there
+   // with BlockFlag::RandomTick run World::BlockDef::OnRandomTick
+   static constexpr int RANDOM_TICKS_PER_SECTION = 3;
+   struct RandomTickStats
+   {
+      size_t sections { 0 };       // loaded sections considered
+      size_t activeSections { 0 }; // sections holding at least one random-ticking block
+      size_t blocksTicked { 0 };
+      double milliseconds { 0.0 };
+   };
+   const RandomTickStats& GetRandomTickStats() const noexcept { return m_randomTickStats; }
+
+   // Scheduled ticks: `block` at `pos` runs World::BlockDef::OnScheduledTick `delay` (>= 1) ticks from now, if it
+   // is still there. Saved with the chunk and dropped when it unloads. Returns false if the chunk is not loaded or
+   // the same block is already scheduled at `pos`.
+   bool FScheduleTick( WorldBlockPos pos, BlockId block, uint32_t delay );
+
+   // Pre-generation: generates a chunk that has never been saved and writes it straight to disk without loading it.
+   // Safe to call from several threads for distinct chunks while the level is not being updated. Features that
+   // reach into other chunks are left in the pending feature writes, which Save persists.
+   enum class PreGenResult : uint8_t
+   {
+      Generated,
+      AlreadySaved,
+      Failed
+   };
+   PreGenResult PreGenerateChunk( const ChunkPos& cpos ) const;
+
    BlockState GetBlock( WorldBlockPos pos ) const noexcept;
    void       SetBlock( WorldBlockPos pos, BlockState state );
    void       Explode( WorldBlockPos pos, uint8_t radius );
 
+   // Bulk edit: one relight pass for the whole batch; each block written is listed for the meshes that show it.
+   // Writes into chunks that are not loaded are dropped rather than loading them.
+   struct BlockWrite
+   {
+      WorldBlockPos pos;
+      BlockState    state;
+   };
+   void SetBlocks( std::span< const BlockWrite > writes );
+
+   // Fluids: water and lava flow in the fixed tick, see FluidSimulator
+   struct FluidStats
+   {
+      size_t activeSections { 0 }; // sections with fluid still waiting for an update after the tick
+      size_t activeCells { 0 };
+      size_t cellsUpdated { 0 };
+      size_t blocksWritten { 0 };
+   };
+   const FluidStats& GetFluidStats() const noexcept;
+
+   // Light at a block; unloaded or not-yet-lit chunks read as open sky with no block light
+   uint8_t GetSkyLight( WorldBlockPos pos ) const noexcept;
+   uint8_t GetBlockLight( WorldBlockPos pos ) const noexcept;
+
    int GetSurfaceY( WorldBlockPos pos ) noexcept;
    int GetSurfaceY( int wx, int wz ) noexcept { return GetSurfaceY( WorldBlockPos { wx, 0, wz } ); }
 
-   // Streaming only: ensures chunk *data* exists around the player.
+   // Streaming only: ensures chunk *data* exists around the player and moves chunks between residency tiers.
    // Rendering caches are owned elsewhere.
    void UpdateStreaming( const glm::vec3& playerPos, uint8_t viewRadius );
 
-   const auto& GetChunks() const { return m_chunks; }
+   // Residency: chunks within the view radius are hot. Chunks out to the simulation radius, or busy with block
+   // access, are warm: still ticked, with idle sections palette-packed. Chunks past that go cold: compressed in
+   // memory and not simulated, restored without disk I/O when accessed again. While the total exceeds the memory
+   // budget, the least recently used cold chunks and then the farthest warm chunks are written back to disk.
+   struct ResidencyOptions
+   {
+      uint8_t simulationRadius { 0 }; // chunks; never less than the view radius
+      uint8_t farFieldRadius { 64 };  // chunks; far field columns past it are dropped as the player moves
+      size_t  memoryBudgetBytes { 512ull * 1024 * 1024 };
+   };
+   struct ResidencyStats
+   {
+      size_t hotChunks { 0 }, warmChunks { 0 }, coldChunks { 0 };
+      size_t hotBytes { 0 }, warmBytes { 0 }, coldBytes { 0 };
+      size_t budgetBytes { 0 };
+      size_t promotions { 0 }, demotions { 0 }, evictions { 0 }; // running totals
+   };
+   void                  SetResidencyOptions( const ResidencyOptions& options ) noexcept { m_residency = options; }
+   const ResidencyStats& GetResidencyStats() const noexcept { return m_residencyStats; }
+
+   const ChunkMap& GetChunks() const noexcept { return m_chunks; }
+
+   // Worker access: safe from any thread while the main thread streams and edits. Unloaded chunks read as air.
+   ChunkHandle FindChunk( const ChunkPos& cpos ) const { return m_chunks.Find( cpos ); }
+   BlockState  GetBlockConcurrent( WorldBlockPos pos ) const;
+
+   // Coarse summary of the chunks that have left the simulation radius, out to the far field radius; see FarField
+   const FarField& GetFarField() const noexcept { return *m_pFarField; }
+
+   // Feature blocks waiting for chunks that have not been generated or loaded yet
+   const PendingFeatureWrites& GetPendingFeatureWrites() const noexcept { return *m_pPendingFeatures; }
 
 private:
    NO_COPY_MOVE( Level )
@@ -230,19 +583,70 @@ private:
    std::tuple< ChunkPos, LocalBlockPos > WorldToChunk( WorldBlockPos wpos ) const noexcept;
    Chunk&                                EnsureChunk( const ChunkPos& cpos );
    void                                  GenerateChunkData( Chunk& chunk );
+   void                                  ApplyPendingFeatures( Chunk& chunk );
+   void                                  TouchChunk( Chunk& chunk ) noexcept;
+   void                                  UpdateResidency( const ChunkPos& playerChunk, int viewRadius, int simulationRadius );
+   void                                  DemoteToCold( const ChunkPos& cpos );
+   bool                                  FRestoreFromCold( Chunk& chunk );
+   void                                  UnloadChunk( const ChunkPos& cpos );
+   void                                  DeliverFeatureSpill( std::span< const FeatureSpill > spill );
    void                                  MarkChunkAndNeighborsMeshDirty( const ChunkPos& cpos );
+   void                                  MarkBorderMeshEdits( const ChunkPos& cpos, LocalBlockPos local ); // lists an edit with the neighbors that show it
+
+   // Snapshots the chunk and hands it to the background writer if it has unsaved edits
+   void QueueChunkSave( Chunk& chunk );
+   void QueueDirtyChunks();
+
+   void TickRandomBlocks();
+   void RunScheduledTicks();
 
    // World saving/loading
-   static constexpr float AUTOSAVE_INTERVAL = 10.0f; // seconds
-   Time::IntervalTimer    m_autosaveTimer;
-   std::filesystem::path  m_worldDir;
-   World::WorldMeta       m_meta;
+   static constexpr float            AUTOSAVE_INTERVAL = 10.0f; // seconds
+   Time::IntervalTimer               m_autosaveTimer;
+   std::filesystem::path             m_worldDir;
+   World::WorldMeta                  m_meta;
+   std::unique_ptr< ChunkSaveQueue > m_pSaveQueue;
+
+   // Online backups
+   static constexpr float         BACKUP_INTERVAL         = 3600.0f;          // seconds
+   static constexpr size_t        BACKUP_BYTES_PER_SECOND = 8ull * 1024 * 1024;
+   Time::IntervalTimer            m_backupTimer { BACKUP_INTERVAL };
+   std::unique_ptr< WorldBackup > m_pBackup;
 
    ChunkPos m_lastPlayerChunk { INT32_MIN, INT32_MIN };
 
-   std::unordered_map< ChunkPos, Chunk, ChunkPosHash > m_chunks;
-
-   FastNoiseLite m_noise;
+   struct DueRandomTick
+   {
+      WorldBlockPos pos;
+      uint64_t      rngSeed;
+   };
+   std::vector< DueRandomTick > m_dueRandomTicks; // reused between ticks
+   RandomTickStats              m_randomTickStats;
+
+   ChunkMap m_chunks; // hot and warm
+
+   // Residency
+   static constexpr int      WARM_LOADS_PER_UPDATE = 8;   // chunks loaded past the view radius per streaming update
+   static constexpr uint32_t WARM_ACCESS_HEAT      = 8;   // heat that keeps a chunk warm outside the simulation radius
+   static constexpr uint64_t HEAT_HALF_LIFE_TICKS  = 100;
+   struct ColdChunk
+   {
+      std::vector< std::byte > bytes; // run-length coded chunk file encoding
+      uint64_t                 lastAccessTick { 0 };
+   };
+   ResidencyOptions                                        m_residency;
+   ResidencyStats                                          m_residencyStats;
+   std::unordered_map< ChunkPos, ColdChunk, ChunkPosHash > m_coldChunks;
+   uint64_t                                                m_residencyTick { UINT64_MAX };
+
+   std::unique_ptr< TerrainGenerator >     m_pGenerator;
+   std::unique_ptr< PendingFeatureWrites > m_pPendingFeatures;
+   std::unique_ptr< LightEngine >          m_pLight;
+   std::unique_ptr< BlockTickScheduler >   m_pTicks;
+   std::unique_ptr< FluidSimulator >       m_pFluids;
+   std::unique_ptr< FarField >             m_pFarField;
 
    friend class Chunk;
+   friend class FluidSimulator;
+   friend class LightEngine;
 };
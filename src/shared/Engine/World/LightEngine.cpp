@@ -0,0 +1,456 @@
+#include "LightEngine.h"
+
+namespace
+{
+
+struct Step
+{
+   int dx, dy, dz;
+};
+
+constexpr std::array< Step, 6 > kSteps = {
+   Step { 1,  0,  0  },
+   Step { -1, 0,  0  },
+   Step { 0,  0,  1  },
+   Step { 0,  0,  -1 },
+   Step { 0,  1,  0  },
+   Step { 0,  -1, 0  },
+};
+
+constexpr size_t STEP_DOWN = 5;
+
+// Skylight keeps its full strength going straight down, everything else falls off by one per block
+constexpr uint8_t SpreadLevel( bool fSky, size_t step, uint8_t level ) noexcept
+{
+   return fSky && step == STEP_DOWN && level == MAX_LIGHT_LEVEL ? MAX_LIGHT_LEVEL : static_cast< uint8_t >( level - 1 );
+}
+
+} // namespace
+
+
+// ----------------------------------------------------------------
+// LightEngine
+// ----------------------------------------------------------------
+LightEngine::LightEngine( Level& level ) :
+   m_level( level )
+{
+   const unsigned workerCount = std::clamp( std::thread::hardware_concurrency() / 2, 1u, 4u );
+   for( unsigned i = 0; i < workerCount; ++i )
+      m_workers.emplace_back( [ this ]( std::stop_token stopToken ) { WorkerLoop( stopToken ); } );
+}
+
+
+LightEngine::~LightEngine()
+{
+   for( std::jthread& worker : m_workers )
+      worker.request_stop();
+}
+
+
+void LightEngine::QueueChunk( Chunk& chunk )
+{
+   chunk.m_lightTicket = ++m_nextTicket;
+   {
+      std::lock_guard lock( m_mutex );
+      m_jobs.push_back( Job { .snapshot = chunk.Snapshot(), .ticket = chunk.m_lightTicket, .blockRevision = chunk.m_blockRevision } );
+   }
+
+   m_workCv.notify_one();
+}
+
+
+void LightEngine::WorkerLoop( std::stop_token stopToken )
+{
+   while( true )
+   {
+      Job job;
+      {
+         std::unique_lock lock( m_mutex );
+         if( !m_workCv.wait( lock, stopToken, [ this ]() { return !m_jobs.empty(); } ) )
+            return;
+
+         job = std::move( m_jobs.front() );
+         m_jobs.pop_front();
+      }
+
+      auto pLight = std::make_unique< ChunkLight >();
+      job.snapshot.UnpackSections();
+      ComputeChunkLight( job.snapshot, *pLight );
+
+      std::lock_guard lock( m_mutex );
+      m_finished.push_back( Result { .cpos = job.snapshot.cpos, .ticket = job.ticket, .blockRevision = job.blockRevision, .pLight = std::move( pLight ) } );
+   }
+}
+
+
+/*static*/ void LightEngine::ComputeChunkLight( const ChunkSnapshot& snapshot, ChunkLight& out )
+{
+   // Chunk-local index: x | z << 4 | y << 8, i.e. the section index plus the section base
+   auto sectionOf = []( uint32_t i ) { return i >> 12; };
+   auto localOf   = []( uint32_t i ) { return static_cast< size_t >( i & 0xFFF ); };
+   auto toIndex   = []( int x, int y, int z ) { return static_cast< uint32_t >( x | ( z << 4 ) | ( y << 8 ) ); };
+   auto block     = [ & ]( uint32_t i )
+   {
+      const SectionBlocksPtr& pBlocks = snapshot.sections[ sectionOf( i ) ];
+      return pBlocks ? ( *pBlocks )[ localOf( i ) ] : BlockState( BlockId::Air );
+   };
+
+   std::vector< uint32_t > queue;
+   auto                    propagate = [ & ]( bool fSky )
+   {
+      for( size_t head = 0; head < queue.size(); ++head )
+      {
+         const uint32_t i     = queue[ head ];
+         const NibbleArray& src = fSky ? out[ sectionOf( i ) ].sky : out[ sectionOf( i ) ].block;
+         const uint8_t      level = src.Get( localOf( i ) );
+         if( level <= 1 )
+            continue;
+
+         const int x = i & 0xF, z = ( i >> 4 ) & 0xF, y = static_cast< int >( i >> 8 );
+         for( const auto& [ s, step ] : kSteps | std::views::enumerate )
+         {
+            const int nx = x + step.dx, ny = y + step.dy, nz = z + step.dz;
+            if( nx < 0 || nx >= CHUNK_SIZE_X || nz < 0 || nz >= CHUNK_SIZE_Z || ny < 0 || ny >= CHUNK_SIZE_Y )
+               continue;
+
+            const uint32_t n = toIndex( nx, ny, nz );
+            if( FOpaque( block( n ) ) )
+               continue;
+
+            NibbleArray&  dst    = fSky ? out[ sectionOf( n ) ].sky : out[ sectionOf( n ) ].block;
+            const uint8_t target = SpreadLevel( fSky, static_cast< size_t >( s ), level );
+            if( dst.Get( localOf( n ) ) < target )
+            {
+               dst.Set( localOf( n ), target );
+               queue.push_back( n );
+            }
+         }
+      }
+   };
+
+   // Skylight: full strength down each column until the first opaque block
+   for( int z = 0; z < CHUNK_SIZE_Z; ++z )
+   {
+      for( int x = 0; x < CHUNK_SIZE_X; ++x )
+      {
+         for( int y = CHUNK_SIZE_Y - 1; y >= 0 && !FOpaque( block( toIndex( x, y, z ) ) ); --y )
+            out[ sectionOf( toIndex( x, y, z ) ) ].sky.Set( localOf( toIndex( x, y, z ) ), MAX_LIGHT_LEVEL );
+      }
+   }
+
+   // Only lit cells next to a dark, open cell can spread anything sideways
+   for( uint32_t i = 0; i < static_cast< uint32_t >( CHUNK_VOLUME ); ++i )
+   {
+      if( out[ sectionOf( i ) ].sky.Get( localOf( i ) ) != MAX_LIGHT_LEVEL )
+         continue;
+
+      const int x = i & 0xF, z = ( i >> 4 ) & 0xF, y = static_cast< int >( i >> 8 );
+      for( const Step& step : kSteps | std::views::take( 4 ) )
+      {
+         const int nx = x + step.dx, nz = z + step.dz;
+         if( nx < 0 || nx >= CHUNK_SIZE_X || nz < 0 || nz >= CHUNK_SIZE_Z )
+            continue;
+
+         const uint32_t n = toIndex( nx, y, nz );
+         if( out[ sectionOf( n ) ].sky.Get( localOf( n ) ) == 0 && !FOpaque( block( n ) ) )
+         {
+            queue.push_back( i );
+            break;
+         }
+      }
+   }
+   propagate( true /*fSky*/ );
+
+   // Block light from every emitter
+   queue.clear();
+   for( uint32_t i = 0; i < static_cast< uint32_t >( CHUNK_VOLUME ); ++i )
+   {
+      if( !snapshot.sections[ sectionOf( i ) ] )
+      {
+         i += CHUNK_SECTION_VOLUME - 1; // all air, nothing emits
+         continue;
+      }
+
+      if( const uint8_t emission = LightEmission( block( i ) ) )
+      {
+         out[ sectionOf( i ) ].block.Set( localOf( i ), emission );
+         queue.push_back( i );
+      }
+   }
+   propagate( false /*fSky*/ );
+}
+
+
+void LightEngine::ApplyFinished()
+{
+   std::vector< Result > finished;
+   {
+      std::lock_guard lock( m_mutex );
+      finished.swap( m_finished );
+   }
+
+   if( finished.empty() )
+      return;
+
+   m_pCachedChunk = nullptr;
+   for( Result& result : finished )
+   {
+      Chunk* pChunk = m_level.m_chunks.Peek( result.cpos );
+      if( !pChunk || pChunk->m_lightTicket != result.ticket )
+         continue; // unloaded, or superseded by a newer job
+
+      Chunk& chunk = *pChunk;
+      if( chunk.m_blockRevision != result.blockRevision )
+      {
+         QueueChunk( chunk ); // edited while the job ran; the edit was not relit because the chunk was unlit
+         continue;
+      }
+
+      for( const auto& [ i, section ] : chunk.m_sections | std::views::enumerate )
+         section.GetLight() = ( *result.pLight )[ i ];
+
+      chunk.m_fLit = true;
+      SeedChunkBorders( chunk );
+   }
+
+   Propagate( Sky );
+   Propagate( Block );
+   FlushTouched();
+}
+
+
+void LightEngine::SeedChunkBorders( const Chunk& chunk )
+{
+   const ChunkPos cpos = chunk.GetChunkPos();
+   m_touched.insert( cpos );
+
+   struct Border
+   {
+      int dx, dz;
+   };
+   for( const Border& border : { Border { 1, 0 }, Border { -1, 0 }, Border { 0, 1 }, Border { 0, -1 } } )
+   {
+      const ChunkPos ncpos { cpos.x + border.dx, cpos.z + border.dz };
+      const Chunk*   pNeighbor = m_level.m_chunks.Peek( ncpos );
+      if( !pNeighbor || !pNeighbor->m_fLit )
+         continue;
+
+      m_touched.insert( ncpos );
+
+      // Both sides of the shared face; Propagate ignores cells that cannot spread anything
+      const int baseX = cpos.x * CHUNK_SIZE_X, baseZ = cpos.z * CHUNK_SIZE_Z;
+      for( int y = 0; y < CHUNK_SIZE_Y; ++y )
+      {
+         for( int t = 0; t < CHUNK_SECTION_SIZE; ++t )
+         {
+            const int x = border.dx ? ( border.dx > 0 ? CHUNK_SIZE_X - 1 : 0 ) : t;
+            const int z = border.dz ? ( border.dz > 0 ? CHUNK_SIZE_Z - 1 : 0 ) : t;
+            for( std::deque< Node >& queue : m_addQueues )
+            {
+               queue.push_back( Node { baseX + x, y, baseZ + z, 0 } );
+               queue.push_back( Node { baseX + x + border.dx, y, baseZ + z + border.dz, 0 } );
+            }
+         }
+      }
+   }
+}
+
+
+void LightEngine::OnBlocksChanged( std::span< const WorldBlockPos > positions )
+{
+   m_pCachedChunk = nullptr;
+   for( Channel channel : { Sky, Block } )
+   {
+      // Take out all light at the changed blocks and whatever depended on it
+      Cell cell;
+      for( const WorldBlockPos& pos : positions )
+      {
+         if( !FResolve( pos.x, pos.y, pos.z, cell ) )
+            continue;
+
+         if( const uint8_t level = Get( channel, cell ) )
+         {
+            Set( channel, cell, 0 );
+            m_removeQueues[ channel ].push_back( Node { pos.x, pos.y, pos.z, level } );
+         }
+      }
+      Remove( channel );
+
+      // Re-seed the changed blocks from their own emission and their neighbors
+      for( const WorldBlockPos& pos : positions )
+      {
+         if( !FResolve( pos.x, pos.y, pos.z, cell ) )
+            continue;
+
+         const BlockState state = cell.pSection->GetBlock( LocalBlockPos { cell.lx, cell.ly, cell.lz } );
+         uint8_t          level = channel == Block ? LightEmission( state ) : 0;
+         if( !FOpaque( state ) )
+         {
+            for( const auto& [ s, step ] : kSteps | std::views::enumerate )
+            {
+               // Reverse direction: the light a neighbor would spread into this block
+               const size_t from = static_cast< size_t >( s ) ^ 1;
+               Cell         neighbor;
+               if( channel == Sky && step.dy > 0 && pos.y + 1 >= CHUNK_SIZE_Y )
+                  level = MAX_LIGHT_LEVEL; // open sky above the world
+               else if( FResolve( pos.x + step.dx, pos.y + step.dy, pos.z + step.dz, neighbor ) )
+               {
+                  if( const uint8_t nlevel = Get( channel, neighbor ) )
+                     level = ( std::max )( level, SpreadLevel( channel == Sky, from, nlevel ) );
+               }
+            }
+         }
+
+         if( level > Get( channel, cell ) )
+         {
+            Set( channel, cell, level );
+            m_addQueues[ channel ].push_back( Node { pos.x, pos.y, pos.z, 0 } );
+         }
+      }
+      Propagate( channel );
+   }
+
+   FlushTouched();
+}
+
+
+void LightEngine::Remove( Channel channel )
+{
+   std::deque< Node >& queue = m_removeQueues[ channel ];
+   while( !queue.empty() )
+   {
+      const Node node = queue.front();
+      queue.pop_front();
+
+      for( const auto& [ s, step ] : kSteps | std::views::enumerate )
+      {
+         Cell neighbor;
+         if( !FResolve( node.x + step.dx, node.y + step.dy, node.z + step.dz, neighbor ) )
+            continue;
+
+         const uint8_t nlevel = Get( channel, neighbor );
+         if( nlevel == 0 )
+            continue;
+
+         // Dimmer neighbors (and full-strength skylight straight below) were lit through this cell
+         const bool fDependent = nlevel < node.level || ( channel == Sky && static_cast< size_t >( s ) == STEP_DOWN && node.level == MAX_LIGHT_LEVEL );
+         if( !fDependent )
+         {
+            // Lit from elsewhere; it refills the removed region
+            m_addQueues[ channel ].push_back( Node { node.x + step.dx, node.y + step.dy, node.z + step.dz, 0 } );
+            continue;
+         }
+
+         Set( channel, neighbor, 0 );
+         m_removeQueues[ channel ].push_back( Node { node.x + step.dx, node.y + step.dy, node.z + step.dz, nlevel } );
+
+         // Emitters keep their own light
+         if( channel == Block )
+         {
+            const BlockState state = neighbor.pSection->GetBlock( LocalBlockPos { neighbor.lx, neighbor.ly, neighbor.lz } );
+            if( const uint8_t emission = LightEmission( state ) )
+            {
+               Set( channel, neighbor, emission );
+               m_addQueues[ channel ].push_back( Node { node.x + step.dx, node.y + step.dy, node.z + step.dz, 0 } );
+            }
+         }
+      }
+   }
+}
+
+
+void LightEngine::Propagate( Channel channel )
+{
+   std::deque< Node >& queue = m_addQueues[ channel ];
+   while( !queue.empty() )
+   {
+      const Node node = queue.front();
+      queue.pop_front();
+
+      Cell cell;
+      if( !FResolve( node.x, node.y, node.z, cell ) )
+         continue;
+
+      const uint8_t level = Get( channel, cell );
+      if( level <= 1 )
+         continue;
+
+      for( const auto& [ s, step ] : kSteps | std::views::enumerate )
+      {
+         const int nx = node.x + step.dx, ny = node.y + step.dy, nz = node.z + step.dz;
+         Cell      neighbor;
+         if( !FResolve( nx, ny, nz, neighbor ) )
+            continue;
+
+         const BlockState state = neighbor.pSection->GetBlock( LocalBlockPos { neighbor.lx, neighbor.ly, neighbor.lz } );
+         if( FOpaque( state ) )
+            continue;
+
+         const uint8_t target = SpreadLevel( channel == Sky, static_cast< size_t >( s ), level );
+         if( Get( channel, neighbor ) < target )
+         {
+            Set( channel, neighbor, target );
+            queue.push_back( Node { nx, ny, nz, 0 } );
+         }
+      }
+   }
+}
+
+
+bool LightEngine::FResolve( int x, int y, int z, Cell& out )
+{
+   if( y < 0 || y >= CHUNK_SIZE_Y )
+      return false;
+
+   auto [ cpos, local ] = m_level.WorldToChunk( WorldBlockPos { x, y, z } );
+   if( !m_pCachedChunk || m_cachedCpos != cpos )
+   {
+      m_cachedCpos   = cpos;
+      m_pCachedChunk = m_level.m_chunks.Peek( cpos );
+   }
+
+   // Unloaded and not-yet-lit chunks are left alone; their light is settled when they are installed
+   if( !m_pCachedChunk || !m_pCachedChunk->m_fLit )
+      return false;
+
+   const int ly = y % CHUNK_SECTION_SIZE;
+   out          = Cell { .pChunk   = m_pCachedChunk,
+                         .pSection = &m_pCachedChunk->m_sections[ y / CHUNK_SECTION_SIZE ],
+                         .index    = ChunkSection::ToIndex( LocalBlockPos { local.x, ly, local.z } ),
+                         .lx       = local.x,
+                         .ly       = ly,
+                         .lz       = local.z,
+                         .y        = y };
+   return true;
+}
+
+
+uint8_t LightEngine::Get( Channel channel, const Cell& cell ) const noexcept
+{
+   const SectionLight& light = cell.pSection->GetLight();
+   return ( channel == Sky ? light.sky : light.block ).Get( cell.index );
+}
+
+
+void LightEngine::Set( Channel channel, const Cell& cell, uint8_t level )
+{
+   SectionLight& light = cell.pSection->GetLight();
+   ( channel == Sky ? light.sky : light.block ).Set( cell.index, level );
+
+   // Faces next to the block are lit by it, including those on the far side of a chunk border
+   const LocalBlockPos local { cell.lx, cell.y, cell.lz };
+   cell.pChunk->MarkMeshEdit( local );
+   m_level.MarkBorderMeshEdits( cell.pChunk->GetChunkPos(), local );
+}
+
+
+void LightEngine::FlushTouched()
+{
+   for( const ChunkPos& cpos : m_touched )
+   {
+      if( Chunk* pChunk = m_level.m_chunks.Peek( cpos ) )
+         pChunk->MarkDirty( ChunkDirty::Mesh );
+   }
+
+   m_touched.clear();
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <Engine/World/Level.h>
+
+// ----------------------------------------------------------------
+// LightEngine - skylight and block light propagation for a Level
+// ----------------------------------------------------------------
+// A newly loaded chunk is lit in isolation on a worker thread from a snapshot of its blocks, then
+// installed on the main thread, where light is spread across its borders with lit neighbors.
+// Block edits are relit incrementally on the main thread with queue-based BFS: light that depended on
+// the changed blocks is removed, then the surrounding light refills the hole. Work is bounded by the
+// cells whose light actually changes, not by the chunk.
+//
+// Skylight travels straight down through non-opaque blocks without falling off and loses one level
+// per step in every other direction. Block light loses one level per step. Opaque blocks stop both.
+class LightEngine
+{
+public:
+   explicit LightEngine( Level& level );
+   ~LightEngine();
+
+   // Computes the chunk's initial light on a worker thread. It stays unlit until ApplyFinished installs it.
+   void QueueChunk( Chunk& chunk );
+
+   // Installs finished chunk light and spreads it into and out of neighboring chunks. Main thread only.
+   void ApplyFinished();
+
+   // Relights around blocks that changed. Passing every block of a bulk edit at once relights the whole
+   // region in a single removal pass and a single propagation pass. Main thread only.
+   void OnBlocksChanged( std::span< const WorldBlockPos > positions );
+
+private:
+   NO_COPY_MOVE( LightEngine )
+
+   using ChunkLight = std::array< SectionLight, SECTIONS_PER_CHUNK >;
+
+   enum Channel : uint8_t
+   {
+      Sky,
+      Block,
+      ChannelCount
+   };
+
+   struct Job
+   {
+      ChunkSnapshot snapshot;
+      uint64_t      ticket { 0 };
+      uint64_t      blockRevision { 0 };
+   };
+
+   struct Result
+   {
+      ChunkPos                      cpos;
+      uint64_t                      ticket { 0 };
+      uint64_t                      blockRevision { 0 };
+      std::unique_ptr< ChunkLight > pLight;
+   };
+
+   // Light queue entry; `level` is only used by removal
+   struct Node
+   {
+      int     x, y, z;
+      uint8_t level;
+   };
+
+   // A block in a loaded, lit chunk
+   struct Cell
+   {
+      Chunk*        pChunk { nullptr };
+      ChunkSection* pSection { nullptr };
+      size_t        index { 0 };
+      int           lx { 0 }, ly { 0 }, lz { 0 }; // ly is section-local
+      int           y { 0 };
+   };
+
+   void        WorkerLoop( std::stop_token stopToken );
+   static void ComputeChunkLight( const ChunkSnapshot& snapshot, ChunkLight& out ); // reads `sections` only; unpack first
+
+   bool    FResolve( int x, int y, int z, Cell& out );
+   uint8_t Get( Channel channel, const Cell& cell ) const noexcept;
+   void    Set( Channel channel, const Cell& cell, uint8_t level );
+
+   void SeedChunkBorders( const Chunk& chunk );
+   void Remove( Channel channel );
+   void Propagate( Channel channel );
+   void FlushTouched();
+
+   Level& m_level;
+
+   // Main thread BFS state
+   std::array< std::deque< Node >, ChannelCount > m_addQueues;
+   std::array< std::deque< Node >, ChannelCount > m_removeQueues;
+   std::unordered_set< ChunkPos, ChunkPosHash >   m_touched; // chunks whose meshes need rebuilding for newly installed light
+   ChunkPos                                       m_cachedCpos;
+   Chunk*                                         m_pCachedChunk { nullptr };
+   uint64_t                                       m_nextTicket { 0 };
+
+   // Worker state
+   std::mutex                  m_mutex;
+   std::condition_variable_any m_workCv;
+   std::deque< Job >           m_jobs;
+   std::vector< Result >       m_finished;
+
+   std::vector< std::jthread > m_workers; // declared last so they stop before the state they use is destroyed
+};
@@ -0,0 +1,207 @@
+#include "OcclusionCuller.h"
+
+OcclusionCuller::OcclusionCuller()
+{
+   for( int w = WIDTH, h = HEIGHT;; w = ( std::max )( w / 2, 1 ), h = ( std::max )( h / 2, 1 ) )
+   {
+      m_levels.push_back( DepthLevel { .width = w, .height = h, .depth = std::vector< float >( static_cast< size_t >( w * h ) ) } );
+      if( w == 1 && h == 1 )
+         break;
+   }
+}
+
+
+void OcclusionCuller::Begin( const glm::mat4& viewProjection, const glm::vec3& cameraPos )
+{
+   m_viewProjection = viewProjection;
+   m_cameraPos      = cameraPos;
+   m_stats          = {};
+   std::ranges::fill( m_levels.front().depth, std::numeric_limits< float >::infinity() );
+}
+
+
+bool OcclusionCuller::FProject( const glm::vec3& point, glm::vec3& out ) const noexcept
+{
+   const glm::vec4 clip = m_viewProjection * glm::vec4( point, 1.0f );
+   if( clip.w < NEAR_W )
+      return false;
+
+   out = glm::vec3( ( clip.x / clip.w * 0.5f + 0.5f ) * WIDTH, ( clip.y / clip.w * 0.5f + 0.5f ) * HEIGHT, clip.w );
+   return true;
+}
+
+
+void OcclusionCuller::AddOccluder( const glm::vec3& min, const glm::vec3& max )
+{
+   // Corner i takes max on axis a when bit a of i is set
+   std::array< glm::vec3, 8 > projected;
+   for( int i = 0; i < 8; ++i )
+   {
+      const glm::vec3 corner( i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z );
+      if( !FProject( corner, projected[ static_cast< size_t >( i ) ] ) )
+         return;
+   }
+
+   ++m_stats.occluders;
+   for( int axis = 0; axis < 3; ++axis )
+   {
+      // A box shows at most one face per axis, and none while the camera is between its two planes
+      int side;
+      if( m_cameraPos[ axis ] < min[ axis ] )
+         side = 0;
+      else if( m_cameraPos[ axis ] > max[ axis ] )
+         side = 1;
+      else
+         continue;
+
+      const int b = 1 << ( ( axis + 1 ) % 3 ), c = 1 << ( ( axis + 2 ) % 3 ), base = side << axis;
+      RasterizeQuad( { projected[ static_cast< size_t >( base ) ],
+                       projected[ static_cast< size_t >( base | b ) ],
+                       projected[ static_cast< size_t >( base | b | c ) ],
+                       projected[ static_cast< size_t >( base | c ) ] } );
+   }
+}
+
+
+void OcclusionCuller::RasterizeQuad( const std::array< glm::vec3, 4 >& corners )
+{
+   float area = 0.0f, depth = 0.0f;
+   float minX = static_cast< float >( WIDTH ), minY = static_cast< float >( HEIGHT ), maxX = 0.0f, maxY = 0.0f;
+   for( size_t i = 0; i < 4; ++i )
+   {
+      const glm::vec3& p = corners[ i ];
+      const glm::vec3& q = corners[ ( i + 1 ) % 4 ];
+      area += p.x * q.y - q.x * p.y;
+      depth = ( std::max )( depth, p.z );
+      minX  = ( std::min )( minX, p.x );
+      minY  = ( std::min )( minY, p.y );
+      maxX  = ( std::max )( maxX, p.x );
+      maxY  = ( std::max )( maxY, p.y );
+   }
+
+   if( std::abs( area ) < 1e-6f )
+      return;
+
+   // Edge functions are positive inside whatever the winding. Shifting each by half a pixel along both axes
+   // makes a pixel count only when its whole square is inside, so occluders never grow past their outline.
+   const float            winding = area > 0.0f ? 1.0f : -1.0f;
+   std::array< float, 4 > ea, eb, ec;
+   for( size_t i = 0; i < 4; ++i )
+   {
+      const glm::vec3& p = corners[ i ];
+      const glm::vec3& q = corners[ ( i + 1 ) % 4 ];
+
+      ea[ i ] = -( q.y - p.y ) * winding;
+      eb[ i ] = ( q.x - p.x ) * winding;
+      ec[ i ] = -( ea[ i ] * p.x + eb[ i ] * p.y ) - 0.5f * ( std::abs( ea[ i ] ) + std::abs( eb[ i ] ) );
+   }
+
+   const int x0 = ( std::max )( static_cast< int >( std::floor( minX ) ), 0 );
+   const int y0 = ( std::max )( static_cast< int >( std::floor( minY ) ), 0 );
+   const int x1 = ( std::min )( static_cast< int >( std::ceil( maxX ) ), WIDTH ) - 1;
+   const int y1 = ( std::min )( static_cast< int >( std::ceil( maxY ) ), HEIGHT ) - 1;
+   if( x0 > x1 || y0 > y1 )
+      return;
+
+   ++m_stats.faces;
+   std::vector< float >& buffer = m_levels.front().depth;
+   for( int y = y0; y <= y1; ++y )
+   {
+      float* const           row = buffer.data() + static_cast< size_t >( y ) * WIDTH;
+      const float            cy  = static_cast< float >( y ) + 0.5f;
+      std::array< float, 4 > rowC;
+      for( size_t i = 0; i < 4; ++i )
+         rowC[ i ] = eb[ i ] * cy + ec[ i ];
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+      // Four pixels per step; rows are a multiple of four wide, so aligning the start down never overruns
+      const __m128 depth4 = _mm_set1_ps( depth );
+      const __m128 lanes  = _mm_setr_ps( 0.5f, 1.5f, 2.5f, 3.5f );
+      for( int x = x0 & ~3; x <= x1; x += 4 )
+      {
+         const __m128 cx   = _mm_add_ps( _mm_set1_ps( static_cast< float >( x ) ), lanes );
+         __m128       mask = _mm_castsi128_ps( _mm_set1_epi32( -1 ) );
+         for( size_t i = 0; i < 4; ++i )
+         {
+            const __m128 e = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( ea[ i ] ), cx ), _mm_set1_ps( rowC[ i ] ) );
+            mask           = _mm_and_ps( mask, _mm_cmpge_ps( e, _mm_setzero_ps() ) );
+         }
+
+         const __m128 current = _mm_loadu_ps( row + x );
+         const __m128 nearer  = _mm_min_ps( current, depth4 );
+         _mm_storeu_ps( row + x, _mm_or_ps( _mm_and_ps( mask, nearer ), _mm_andnot_ps( mask, current ) ) );
+      }
+#else
+      for( int x = x0; x <= x1; ++x )
+      {
+         const float cx = static_cast< float >( x ) + 0.5f;
+         if( std::ranges::all_of( std::views::iota( size_t { 0 }, size_t { 4 } ), [ & ]( size_t i ) { return ea[ i ] * cx + rowC[ i ] >= 0.0f; } ) )
+            row[ x ] = ( std::min )( row[ x ], depth );
+      }
+#endif
+   }
+}
+
+
+void OcclusionCuller::Finish()
+{
+   for( size_t level = 1; level < m_levels.size(); ++level )
+   {
+      const DepthLevel& fine   = m_levels[ level - 1 ];
+      DepthLevel&       coarse = m_levels[ level ];
+      for( int y = 0; y < coarse.height; ++y )
+      {
+         const int fy0 = ( std::min )( 2 * y, fine.height - 1 ), fy1 = ( std::min )( 2 * y + 1, fine.height - 1 );
+         for( int x = 0; x < coarse.width; ++x )
+         {
+            const int fx0 = ( std::min )( 2 * x, fine.width - 1 ), fx1 = ( std::min )( 2 * x + 1, fine.width - 1 );
+            coarse.depth[ static_cast< size_t >( y * coarse.width + x ) ] =
+               ( std::max )( { fine.depth[ static_cast< size_t >( fy0 * fine.width + fx0 ) ], fine.depth[ static_cast< size_t >( fy0 * fine.width + fx1 ) ],
+                               fine.depth[ static_cast< size_t >( fy1 * fine.width + fx0 ) ], fine.depth[ static_cast< size_t >( fy1 * fine.width + fx1 ) ] } );
+         }
+      }
+   }
+}
+
+
+bool OcclusionCuller::FOccluded( const glm::vec3& min, const glm::vec3& max )
+{
+   ++m_stats.tests;
+
+   float minX = std::numeric_limits< float >::max(), minY = minX, maxX = -minX, maxY = -minX, nearest = minX;
+   for( int i = 0; i < 8; ++i )
+   {
+      glm::vec3 p;
+      if( !FProject( glm::vec3( i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z ), p ) )
+         return false;
+
+      minX    = ( std::min )( minX, p.x );
+      minY    = ( std::min )( minY, p.y );
+      maxX    = ( std::max )( maxX, p.x );
+      maxY    = ( std::max )( maxY, p.y );
+      nearest = ( std::min )( nearest, p.z );
+   }
+
+   // Off screen is the frustum's call; only the part on screen can be hidden
+   if( maxX < 0.0f || maxY < 0.0f || minX > WIDTH || minY > HEIGHT )
+      return false;
+
+   const int x0 = std::clamp( static_cast< int >( std::floor( minX ) ), 0, WIDTH - 1 );
+   const int y0 = std::clamp( static_cast< int >( std::floor( minY ) ), 0, HEIGHT - 1 );
+   const int x1 = std::clamp( static_cast< int >( std::floor( maxX ) ), 0, WIDTH - 1 );
+   const int y1 = std::clamp( static_cast< int >( std::floor( maxY ) ), 0, HEIGHT - 1 );
+
+   // Coarsest level at which the rectangle still spans at most 2x2 texels
+   size_t level = 0;
+   while( level + 1 < m_levels.size() && ( ( x1 >> level ) - ( x0 >> level ) > 1 || ( y1 >> level ) - ( y0 >> level ) > 1 ) )
+      ++level;
+
+   const DepthLevel& hiZ = m_levels[ level ];
+   for( int ty = y0 >> level; ty <= ( std::min )( y1 >> level, hiZ.height - 1 ); ++ty )
+      for( int tx = x0 >> level; tx <= ( std::min )( x1 >> level, hiZ.width - 1 ); ++tx )
+         if( hiZ.depth[ static_cast< size_t >( ty * hiZ.width + tx ) ] >= nearest )
+            return false;
+
+   ++m_stats.occluded;
+   return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+// ----------------------------------------------------------------
+// OcclusionCuller - software depth buffer and Hi-Z pyramid for culling boxes behind solid terrain
+// ----------------------------------------------------------------
+// Each frame the camera-facing faces of known-solid boxes are rasterized into a small depth buffer, then a
+// pyramid keeps the farthest depth of every 2x2 block of the level below. A box is occluded when its nearest
+// point lies behind the farthest occluder depth over every texel its screen rectangle touches.
+//
+// Everything errs toward drawing: occluder faces only cover pixels they cover entirely and are written at the
+// depth of their farthest corner, and anything crossing the near plane is neither an occluder nor occluded.
+// Depth is clip-space w, the distance along the view direction. No GPU involved.
+class OcclusionCuller
+{
+public:
+   static constexpr int   WIDTH  = 128; // multiple of 4 for the SSE rows
+   static constexpr int   HEIGHT = 64;
+   static constexpr float NEAR_W = 0.05f;
+
+   struct Stats
+   {
+      size_t occluders { 0 };
+      size_t faces { 0 }; // occluder faces rasterized
+      size_t tests { 0 };
+      size_t occluded { 0 };
+   };
+
+   OcclusionCuller();
+
+   // Clears the depth buffer for a new view; `cameraPos` picks which faces of each occluder face the camera
+   void Begin( const glm::mat4& viewProjection, const glm::vec3& cameraPos );
+
+   // Box that is solid throughout, such as a run of sections with no open block
+   void AddOccluder( const glm::vec3& min, const glm::vec3& max );
+
+   // Builds the pyramid; call after the last occluder and before the first test
+   void Finish();
+
+   bool FOccluded( const glm::vec3& min, const glm::vec3& max );
+
+   const Stats& GetStats() const noexcept { return m_stats; }
+
+   // Level 0 is the full-resolution buffer
+   std::span< const float > GetDepth( int level = 0 ) const noexcept { return m_levels[ static_cast< size_t >( level ) ].depth; }
+
+private:
+   NO_COPY_MOVE( OcclusionCuller )
+
+   struct DepthLevel
+   {
+      int                  width { 0 };
+      int                  height { 0 };
+      std::vector< float > depth;
+   };
+
+   // Screen-space position in pixels plus clip w; false when the point is behind the near plane
+   bool FProject( const glm::vec3& point, glm::vec3& out ) const noexcept;
+
+   void RasterizeQuad( const std::array< glm::vec3, 4 >& corners );
+
+   glm::mat4                 m_viewProjection { 1.0f };
+   glm::vec3                 m_cameraPos { 0.0f };
+   std::vector< DepthLevel > m_levels; // Hi-Z pyramid, full resolution first
+   Stats                     m_stats;
+};
@@ -0,0 +1,62 @@
+#include "PackedSection.h"
+
+// ----------------------------------------------------------------
+// PackedSection
+// ----------------------------------------------------------------
+/*static*/ PackedSection PackedSection::Pack( const SectionBlocks& blocks )
+{
+   PackedSection packed;
+
+   // Palettes are tiny in practice; a linear search with a last-hit shortcut beats hashing here.
+   std::array< uint16_t, CHUNK_SECTION_VOLUME > indices;
+   uint16_t                                     last = 0;
+   for( size_t i = 0; i < blocks.size(); ++i )
+   {
+      if( packed.palette.empty() || packed.palette[ last ] != blocks[ i ] )
+      {
+         auto it = std::find( packed.palette.begin(), packed.palette.end(), blocks[ i ] );
+         if( it == packed.palette.end() )
+            it = packed.palette.insert( it, blocks[ i ] );
+
+         last = static_cast< uint16_t >( it - packed.palette.begin() );
+      }
+
+      indices[ i ] = last;
+   }
+
+   packed.bitsPerBlock = packed.palette.size() <= 1 ? 0 : static_cast< uint8_t >( std::bit_width( packed.palette.size() - 1 ) );
+   if( packed.bitsPerBlock == 0 )
+      return packed;
+
+   const size_t perWord = 64 / packed.bitsPerBlock;
+   packed.words.assign( WordCount( packed.bitsPerBlock ), 0 );
+   for( size_t i = 0; i < indices.size(); ++i )
+      packed.words[ i / perWord ] |= static_cast< uint64_t >( indices[ i ] ) << ( ( i % perWord ) * packed.bitsPerBlock );
+
+   return packed;
+}
+
+
+void PackedSection::Unpack( SectionBlocks& out ) const
+{
+   if( bitsPerBlock == 0 )
+   {
+      out.fill( palette.empty() ? BlockState( BlockId::Air ) : palette.front() );
+      return;
+   }
+
+   for( size_t i = 0; i < out.size(); ++i )
+      out[ i ] = Get( i );
+}
+
+
+BlockState PackedSection::Get( size_t index ) const noexcept
+{
+   if( bitsPerBlock == 0 )
+      return palette.empty() ? BlockState( BlockId::Air ) : palette.front();
+
+   const size_t   perWord = 64 / bitsPerBlock;
+   const uint64_t mask    = ( uint64_t { 1 } << bitsPerBlock ) - 1;
+   const size_t   entry   = static_cast< size_t >( ( words[ index / perWord ] >> ( ( index % perWord ) * bitsPerBlock ) ) & mask );
+   return entry < palette.size() ? palette[ entry ] : BlockState( BlockId::Air );
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Engine/World/Level.h>
+
+// ----------------------------------------------------------------
+// PackedSection - palette + bit-packed index form of a section's blocks
+// ----------------------------------------------------------------
+// Indices never straddle a 64-bit word, so a word holds floor(64 / bitsPerBlock) blocks.
+// A single-entry palette stores no indices at all (bitsPerBlock == 0).
+struct PackedSection
+{
+   std::vector< BlockState > palette;
+   uint8_t                   bitsPerBlock { 0 };
+   std::vector< uint64_t >   words;
+
+   static PackedSection Pack( const SectionBlocks& blocks );
+   void                 Unpack( SectionBlocks& out ) const;
+   BlockState           Get( size_t index ) const noexcept;
+
+   static constexpr size_t WordCount( uint8_t bitsPerBlock ) noexcept
+   {
+      return bitsPerBlock == 0 ? 0 : ( CHUNK_SECTION_VOLUME + ( 64 / bitsPerBlock ) - 1 ) / ( 64 / bitsPerBlock );
+   }
+
+   size_t ByteSize() const noexcept { return palette.size() * sizeof( BlockState ) + words.size() * sizeof( uint64_t ); }
+};
@@ -0,0 +1,181 @@
+#include "PendingFeatureWrites.h"
+
+// ----------------------------------------------------------------
+// PendingFeatureWrites
+// ----------------------------------------------------------------
+PendingFeatureWrites::PendingFeatureWrites( std::filesystem::path worldDir ) :
+   m_worldDir( std::move( worldDir ) )
+{
+   std::vector< std::byte > bytes;
+   if( World::WorldSave::FLoadFeatureBytes( m_worldDir, bytes ) && !FDecode( bytes ) )
+      std::println( std::cerr, "Ignoring unreadable pending feature writes in {}", m_worldDir.string() );
+}
+
+
+void PendingFeatureWrites::Add( std::span< const FeatureSpill > spill )
+{
+   if( spill.empty() )
+      return;
+
+   std::scoped_lock lock( m_mutex );
+   for( const FeatureSpill& entry : spill )
+      m_byChunk[ entry.target ].push_back( entry.write );
+
+   m_writeCount += spill.size();
+   m_fDirty = true;
+}
+
+
+void PendingFeatureWrites::Add( const ChunkPos& cpos, std::span< const ChunkFeatureWrite > writes )
+{
+   if( writes.empty() )
+      return;
+
+   std::scoped_lock lock( m_mutex );
+   std::ranges::copy( writes, std::back_inserter( m_byChunk[ cpos ] ) );
+   m_writeCount += writes.size();
+   m_fDirty = true;
+}
+
+
+std::vector< ChunkFeatureWrite > PendingFeatureWrites::Take( const ChunkPos& cpos )
+{
+   std::scoped_lock lock( m_mutex );
+   auto             it = m_byChunk.find( cpos );
+   if( it == m_byChunk.end() )
+      return {};
+
+   std::vector< ChunkFeatureWrite > writes = std::move( it->second );
+   m_byChunk.erase( it );
+   m_writeCount -= writes.size();
+   m_fDirty = true;
+   return writes;
+}
+
+
+bool PendingFeatureWrites::FSave()
+{
+   std::vector< std::byte > bytes;
+   {
+      std::scoped_lock lock( m_mutex );
+      if( !m_fDirty )
+         return true;
+
+      bytes    = Encode();
+      m_fDirty = false;
+   }
+
+   if( World::WorldSave::FSaveFeatureBytes( m_worldDir, bytes ) )
+      return true;
+
+   std::scoped_lock lock( m_mutex );
+   m_fDirty = true; // try again on the next save
+   return false;
+}
+
+
+std::vector< std::byte > PendingFeatureWrites::Capture() const
+{
+   std::scoped_lock lock( m_mutex );
+   return Encode();
+}
+
+
+size_t PendingFeatureWrites::ChunkCount() const
+{
+   std::scoped_lock lock( m_mutex );
+   return m_byChunk.size();
+}
+
+
+size_t PendingFeatureWrites::WriteCount() const
+{
+   std::scoped_lock lock( m_mutex );
+   return m_writeCount;
+}
+
+
+std::vector< std::byte > PendingFeatureWrites::Encode() const
+{
+   std::vector< std::byte > bytes;
+   auto                     append = [ &bytes ]( const void* pData, size_t size )
+   {
+      const size_t offset = bytes.size();
+      bytes.resize( offset + size );
+      std::memcpy( bytes.data() + offset, pData, size );
+   };
+
+   const uint32_t magic      = FORMAT_MAGIC;
+   const uint16_t version    = FORMAT_VERSION;
+   const uint32_t chunkCount = static_cast< uint32_t >( m_byChunk.size() );
+   append( &magic, sizeof( magic ) );
+   append( &version, sizeof( version ) );
+   append( &chunkCount, sizeof( chunkCount ) );
+   for( const auto& [ cpos, writes ] : m_byChunk )
+   {
+      const int32_t  x          = cpos.x;
+      const int32_t  z          = cpos.z;
+      const uint32_t writeCount = static_cast< uint32_t >( writes.size() );
+      append( &x, sizeof( x ) );
+      append( &z, sizeof( z ) );
+      append( &writeCount, sizeof( writeCount ) );
+      for( const ChunkFeatureWrite& write : writes )
+      {
+         append( &write.x, sizeof( write.x ) );
+         append( &write.y, sizeof( write.y ) );
+         append( &write.z, sizeof( write.z ) );
+         append( &write.state, sizeof( write.state ) );
+      }
+   }
+
+   return bytes;
+}
+
+
+bool PendingFeatureWrites::FDecode( std::span< const std::byte > bytes )
+{
+   size_t offset = 0;
+   auto   read   = [ & ]( void* pData, size_t size )
+   {
+      if( offset + size > bytes.size() )
+         return false;
+
+      std::memcpy( pData, bytes.data() + offset, size );
+      offset += size;
+      return true;
+   };
+
+   uint32_t magic = 0, chunkCount = 0;
+   uint16_t version = 0;
+   if( !read( &magic, sizeof( magic ) ) || magic != FORMAT_MAGIC || !read( &version, sizeof( version ) ) || version != FORMAT_VERSION ||
+       !read( &chunkCount, sizeof( chunkCount ) ) )
+      return false;
+
+   std::unordered_map< ChunkPos, std::vector< ChunkFeatureWrite >, ChunkPosHash > byChunk;
+   size_t                                                                          writeCount = 0;
+   for( uint32_t i = 0; i < chunkCount; ++i )
+   {
+      int32_t  x = 0, z = 0;
+      uint32_t count = 0;
+      if( !read( &x, sizeof( x ) ) || !read( &z, sizeof( z ) ) || !read( &count, sizeof( count ) ) )
+         return false;
+
+      std::vector< ChunkFeatureWrite >& writes = byChunk[ ChunkPos { x, z } ];
+      for( uint32_t n = 0; n < count; ++n )
+      {
+         ChunkFeatureWrite write;
+         if( !read( &write.x, sizeof( write.x ) ) || !read( &write.y, sizeof( write.y ) ) || !read( &write.z, sizeof( write.z ) ) ||
+             !read( &write.state, sizeof( write.state ) ) || write.x >= CHUNK_SIZE_X || write.z >= CHUNK_SIZE_Z )
+            return false;
+
+         writes.push_back( write );
+      }
+
+      writeCount += count;
+   }
+
+   std::scoped_lock lock( m_mutex );
+   m_byChunk    = std::move( byChunk );
+   m_writeCount = writeCount;
+   return true;
+}
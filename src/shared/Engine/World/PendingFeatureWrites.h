@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Engine/World/Level.h>
+
+// ----------------------------------------------------------------
+// PendingFeatureWrites - feature blocks waiting for the chunk they landed in
+// ----------------------------------------------------------------
+// When a generated feature reaches into a chunk that is not loaded, its blocks are parked here, keyed by
+// that chunk, and handed over the next time the chunk is generated or loaded. Generating a chunk
+// therefore never generates its neighbors. The buffer is saved with the world and is thread-safe, so
+// pre-generation workers can share it.
+//
+// File layout: magic, version, uint32 chunk count, then per chunk: int32 x, z, uint32 write count and
+// per write: uint8 x, y, z and the BlockState.
+class PendingFeatureWrites
+{
+public:
+   static constexpr uint32_t FORMAT_MAGIC   = 0x5746474F; // "OGFW"
+   static constexpr uint16_t FORMAT_VERSION = 1;
+
+   // Loads the buffer saved in `worldDir`, if any
+   explicit PendingFeatureWrites( std::filesystem::path worldDir );
+
+   void Add( std::span< const FeatureSpill > spill );
+   void Add( const ChunkPos& cpos, std::span< const ChunkFeatureWrite > writes );
+
+   // Removes and returns every write waiting for the chunk
+   std::vector< ChunkFeatureWrite > Take( const ChunkPos& cpos );
+
+   // Writes the buffer to disk if it changed since the last save
+   bool FSave();
+
+   // The buffer as it stands, in the file layout; backups archive it with the chunks of the same tick
+   std::vector< std::byte > Capture() const;
+
+   size_t ChunkCount() const;
+   size_t WriteCount() const;
+
+private:
+   NO_COPY_MOVE( PendingFeatureWrites )
+
+   std::vector< std::byte > Encode() const; // requires m_mutex
+   bool                     FDecode( std::span< const std::byte > bytes );
+
+   const std::filesystem::path m_worldDir;
+
+   mutable std::mutex                                                              m_mutex;
+   std::unordered_map< ChunkPos, std::vector< ChunkFeatureWrite >, ChunkPosHash > m_byChunk;
+   size_t                                                                          m_writeCount { 0 };
+   bool                                                                            m_fDirty { false };
+};
@@ -0,0 +1,126 @@
+#include "RangeAllocator.h"
+
+RangeAllocator::RangeAllocator( uint32_t capacity )
+{
+   Grow( capacity );
+}
+
+
+std::optional< uint32_t > RangeAllocator::Allocate( uint32_t size )
+{
+   assert( size > 0 );
+
+   // Ties go to the lowest offset, which keeps the front of the buffer full
+   const auto fit = m_freeBySize.lower_bound( { size, 0 } );
+   if( fit == m_freeBySize.end() )
+      return std::nullopt;
+
+   const auto [ available, offset ] = *fit;
+   EraseFree( m_freeByOffset.find( offset ) );
+   if( available > size )
+      InsertFree( offset + size, available - size );
+
+   m_live.emplace( offset, size );
+   m_used += size;
+   return offset;
+}
+
+
+void RangeAllocator::Free( uint32_t offset )
+{
+   const auto live = m_live.find( offset );
+   assert( live != m_live.end() );
+
+   uint32_t start = offset;
+   uint32_t size  = live->second;
+   m_used -= size;
+   m_live.erase( live );
+
+   // Merge with the free ranges on either side
+   const auto next = m_freeByOffset.lower_bound( offset );
+   if( next != m_freeByOffset.end() && next->first == offset + size )
+   {
+      size += next->second;
+      EraseFree( next );
+   }
+
+   if( auto prev = m_freeByOffset.lower_bound( offset ); prev != m_freeByOffset.begin() )
+   {
+      --prev;
+      if( prev->first + prev->second == offset )
+      {
+         start = prev->first;
+         size += prev->second;
+         EraseFree( prev );
+      }
+   }
+
+   InsertFree( start, size );
+}
+
+
+void RangeAllocator::Grow( uint32_t capacity )
+{
+   if( capacity <= m_capacity )
+      return;
+
+   // The new space joins a free range that already runs to the end
+   uint32_t start = m_capacity;
+   if( !m_freeByOffset.empty() )
+   {
+      const auto last = std::prev( m_freeByOffset.end() );
+      if( last->first + last->second == m_capacity )
+      {
+         start = last->first;
+         EraseFree( last );
+      }
+   }
+
+   InsertFree( start, capacity - start );
+   m_capacity = capacity;
+}
+
+
+std::vector< RangeAllocator::Move > RangeAllocator::Compact()
+{
+   std::vector< Move >            moves;
+   std::map< uint32_t, uint32_t > packed;
+   uint32_t                       next = 0;
+   for( const auto& [ offset, size ] : m_live )
+   {
+      if( offset != next )
+         moves.push_back( Move { .from = offset, .to = next, .size = size } );
+
+      packed.emplace_hint( packed.end(), next, size );
+      next += size;
+   }
+
+   m_live = std::move( packed );
+   m_freeByOffset.clear();
+   m_freeBySize.clear();
+   if( next < m_capacity )
+      InsertFree( next, m_capacity - next );
+
+   return moves;
+}
+
+
+float RangeAllocator::GetFragmentation() const noexcept
+{
+   const uint32_t free = m_capacity - m_used;
+   return free ? 1.0f - static_cast< float >( GetLargestFree() ) / static_cast< float >( free ) : 0.0f;
+}
+
+
+void RangeAllocator::InsertFree( uint32_t offset, uint32_t size )
+{
+   m_freeByOffset.emplace( offset, size );
+   m_freeBySize.emplace( size, offset );
+}
+
+
+void RangeAllocator::EraseFree( std::map< uint32_t, uint32_t >::iterator it )
+{
+   m_freeBySize.erase( { it->second, it->first } );
+   m_freeByOffset.erase( it );
+}
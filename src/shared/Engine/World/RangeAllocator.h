@@ -0,0 +1,51 @@
+#pragma once
+
+// ----------------------------------------------------------------
+// RangeAllocator - hands out ranges of a fixed-size buffer
+// ----------------------------------------------------------------
+// Units are whatever the caller counts in (vertices, indices); nothing is read or written here, so the same
+// bookkeeping backs a GPU buffer or a plain array. Free ranges are kept both by offset, to merge neighbours when a
+// range comes back, and by size, so an allocation takes the smallest range that fits and leaves large ones whole.
+class RangeAllocator
+{
+public:
+   // One live range sliding down during Compact
+   struct Move
+   {
+      uint32_t from { 0 };
+      uint32_t to { 0 };
+      uint32_t size { 0 };
+   };
+
+   explicit RangeAllocator( uint32_t capacity = 0 );
+
+   // Offset of a new range of `size` units; nullopt when no free range is large enough
+   std::optional< uint32_t > Allocate( uint32_t size );
+   void                      Free( uint32_t offset );
+
+   // Adds space at the end; shrinking is not supported
+   void Grow( uint32_t capacity );
+
+   // Slides every live range down to close the gaps, keeping their order. Moves come back by ascending offset,
+   // and each range's destination lies at or below its source.
+   std::vector< Move > Compact();
+
+   uint32_t GetCapacity() const noexcept { return m_capacity; }
+   uint32_t GetUsed() const noexcept { return m_used; }
+   uint32_t GetLargestFree() const noexcept { return m_freeBySize.empty() ? 0 : m_freeBySize.rbegin()->first; }
+   size_t   GetFreeRangeCount() const noexcept { return m_freeByOffset.size(); }
+   size_t   GetLiveRangeCount() const noexcept { return m_live.size(); }
+
+   // Share of the free space outside the largest free range: 0 when it is all in one piece
+   float GetFragmentation() const noexcept;
+
+private:
+   void InsertFree( uint32_t offset, uint32_t size );
+   void EraseFree( std::map< uint32_t, uint32_t >::iterator it );
+
+   std::map< uint32_t, uint32_t >              m_freeByOffset; // offset -> size
+   std::set< std::pair< uint32_t, uint32_t > > m_freeBySize;   // ( size, offset )
+   std::map< uint32_t, uint32_t >              m_live;         // offset -> size
+   uint32_t                                    m_capacity { 0 };
+   uint32_t                                    m_used { 0 };
+};
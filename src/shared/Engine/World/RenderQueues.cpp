@@ -0,0 +1,166 @@
+#include "RenderQueues.h"
+
+namespace Engine
+{
+
+namespace
+{
+
+constexpr uint64_t DEPTH_MASK    = ( 1ull << RenderKey::DEPTH_BITS ) - 1;
+constexpr uint64_t MATERIAL_MASK = ( 1ull << RenderKey::MATERIAL_BITS ) - 1;
+constexpr uint64_t SHADER_MASK   = ( 1ull << RenderKey::SHADER_BITS ) - 1;
+constexpr uint64_t LAYER_MASK    = ( 1ull << RenderKey::LAYER_BITS ) - 1;
+
+// Non-negative floats order the same as their bit patterns, so the top bits are a depth that needs no far plane
+uint64_t QuantizeDepth( float depth ) noexcept
+{
+   return std::bit_cast< uint32_t >( ( std::max )( depth, 0.0f ) ) >> ( 32 - RenderKey::DEPTH_BITS );
+}
+
+} // namespace
+
+
+// ----------------------------------------------------------------
+// RenderKey
+// ----------------------------------------------------------------
+/*static*/ RenderKey RenderKey::Opaque( uint8_t layer, uint8_t shader, uint32_t material, float depth ) noexcept
+{
+   return RenderKey { .value = ( ( layer & LAYER_MASK ) << 56 ) | ( ( shader & SHADER_MASK ) << 48 ) | ( ( material & MATERIAL_MASK ) << 24 ) |
+                               QuantizeDepth( depth ) };
+}
+
+
+/*static*/ RenderKey RenderKey::Transparent( uint8_t layer, uint8_t shader, uint32_t material, float depth ) noexcept
+{
+   return RenderKey { .value = ( 1ull << 63 ) | ( ( layer & LAYER_MASK ) << 56 ) | ( ( DEPTH_MASK - QuantizeDepth( depth ) ) << 32 ) |
+                               ( ( shader & SHADER_MASK ) << 24 ) | ( material & MATERIAL_MASK ) };
+}
+
+
+uint8_t RenderKey::GetShader() const noexcept
+{
+   return static_cast< uint8_t >( ( value >> ( FTransparent() ? 24 : 48 ) ) & SHADER_MASK );
+}
+
+
+uint32_t RenderKey::GetMaterial() const noexcept
+{
+   return static_cast< uint32_t >( ( value >> ( FTransparent() ? 0 : 24 ) ) & MATERIAL_MASK );
+}
+
+
+uint64_t RenderKey::GetState() const noexcept
+{
+   return FTransparent() ? value & ~( DEPTH_MASK << 32 ) : value & ~DEPTH_MASK;
+}
+
+
+// ----------------------------------------------------------------
+// RenderQueues
+// ----------------------------------------------------------------
+void RenderQueues::Clear()
+{
+   m_opaqueIndexed.clear();
+   m_overlayIndexed.clear();
+   m_opaqueBatches.clear();
+   m_instanceTransforms.clear();
+}
+
+
+void RenderQueues::Sort()
+{
+   SortByKey( m_opaqueIndexed );
+   SortByKey( m_overlayIndexed );
+   BuildBatches();
+}
+
+
+void RenderQueues::SortByKey( std::vector< IndexedDraw >& draws )
+{
+   const size_t count = draws.size();
+   if( count < 2 )
+      return;
+
+   // Sorting small (key, index) pairs and moving each draw once afterwards beats shuffling the matrices around
+   m_sortEntries.resize( count );
+   m_sortScratch.resize( count );
+   for( size_t i = 0; i < count; ++i )
+      m_sortEntries[ i ] = SortEntry { .key = draws[ i ].key.value, .index = static_cast< uint32_t >( i ) };
+
+   // One pass over the keys counts every byte; a byte all keys share would move nothing and is skipped
+   constexpr size_t                                  PASSES = sizeof( uint64_t );
+   std::array< std::array< uint32_t, 256 >, PASSES > counts {};
+   for( const SortEntry& entry : m_sortEntries )
+   {
+      for( size_t pass = 0; pass < PASSES; ++pass )
+         ++counts[ pass ][ ( entry.key >> ( pass * 8 ) ) & 0xFF ];
+   }
+
+   // Least significant byte first; each pass is stable, so equal keys keep submission order
+   for( size_t pass = 0; pass < PASSES; ++pass )
+   {
+      std::array< uint32_t, 256 >& bucket = counts[ pass ];
+      if( bucket[ ( m_sortEntries[ 0 ].key >> ( pass * 8 ) ) & 0xFF ] == count )
+         continue;
+
+      uint32_t offset = 0;
+      for( uint32_t& slot : bucket )
+         offset += std::exchange( slot, offset );
+
+      for( const SortEntry& entry : m_sortEntries )
+         m_sortScratch[ bucket[ ( entry.key >> ( pass * 8 ) ) & 0xFF ]++ ] = entry;
+
+      m_sortEntries.swap( m_sortScratch );
+   }
+
+   m_drawScratch.clear();
+   m_drawScratch.reserve( count );
+   for( const SortEntry& entry : m_sortEntries )
+      m_drawScratch.push_back( draws[ entry.index ] );
+
+   draws.swap( m_drawScratch );
+}
+
+
+void RenderQueues::BuildBatches()
+{
+   m_opaqueBatches.clear();
+   m_instanceTransforms.clear();
+   m_instanceTransforms.reserve( m_opaqueIndexed.size() );
+
+   // Depth only orders instances within a batch; it never starts a new one
+   for( const IndexedDraw& item : m_opaqueIndexed )
+   {
+      InstanceBatch* pBatch = m_opaqueBatches.empty() ? nullptr : &m_opaqueBatches.back();
+      if( !pBatch || pBatch->key.GetState() != item.key.GetState() || pBatch->vertexArrayId != item.vertexArrayId || pBatch->textureId != item.textureId )
+      {
+         pBatch = &m_opaqueBatches.emplace_back( InstanceBatch { .key           = item.key,
+                                                                 .vertexArrayId = item.vertexArrayId,
+                                                                 .textureId     = item.textureId,
+                                                                 .indexCount    = item.indexCount,
+                                                                 .firstInstance = static_cast< uint32_t >( m_instanceTransforms.size() ) } );
+      }
+
+      assert( pBatch->indexCount == item.indexCount );
+      m_instanceTransforms.push_back( item.model );
+      ++pBatch->instanceCount;
+   }
+}
+
+
+/*static*/ RenderQueues::StateChanges RenderQueues::CountStateChanges( std::span< const IndexedDraw > draws ) noexcept
+{
+   StateChanges       changes;
+   const IndexedDraw* pPrev = nullptr;
+   for( const IndexedDraw& draw : draws )
+   {
+      changes.shaders += !pPrev || pPrev->key.GetShader() != draw.key.GetShader() ? 1 : 0;
+      changes.materials += !pPrev || pPrev->key.GetMaterial() != draw.key.GetMaterial() ? 1 : 0;
+      changes.vertexArrays += !pPrev || pPrev->vertexArrayId != draw.vertexArrayId ? 1 : 0;
+      changes.textures += !pPrev || pPrev->textureId != draw.textureId ? 1 : 0;
+      pPrev = &draw;
+   }
+   return changes;
+}
+
+} // namespace Engine
@@ -0,0 +1,114 @@
+#pragma once
+
+namespace Engine
+{
+
+// ----------------------------------------------------------------
+// RenderKey - one integer that sorts draws into submission order
+// ----------------------------------------------------------------
+// Opaque:      [ 0 | Layer (7) | Shader (8) | Material (24) | Depth (24) ]
+// Transparent: [ 1 | Layer (7) | Far-to-near depth (24) | Shader (8) | Material (24) ]
+//
+// Opaque draws group by state and go front to back within it, so early depth testing rejects what is hidden.
+// Transparent draws must blend back to front, so depth ranks above state for them. Depth is any non-negative
+// distance measure (squared distance works as well as distance); only its order is kept.
+struct RenderKey
+{
+   static constexpr uint32_t DEPTH_BITS    = 24;
+   static constexpr uint32_t MATERIAL_BITS = 24;
+   static constexpr uint32_t SHADER_BITS   = 8;
+   static constexpr uint32_t LAYER_BITS    = 7;
+
+   uint64_t value {};
+
+   static RenderKey Opaque( uint8_t layer, uint8_t shader, uint32_t material, float depth ) noexcept;
+   static RenderKey Transparent( uint8_t layer, uint8_t shader, uint32_t material, float depth ) noexcept;
+
+   bool     FTransparent() const noexcept { return ( value >> 63 ) != 0; }
+   uint8_t  GetLayer() const noexcept { return static_cast< uint8_t >( ( value >> 56 ) & 0x7F ); }
+   uint8_t  GetShader() const noexcept;
+   uint32_t GetMaterial() const noexcept;
+
+   // The key without its depth: draws that agree here need no state change between them
+   uint64_t GetState() const noexcept;
+
+   bool operator<( const RenderKey& other ) const { return value < other.value; }
+};
+
+// ----------------------------------------------------------------
+// RenderQueues - draws collected for a frame, grouped into instance batches
+// ----------------------------------------------------------------
+// Nothing here touches GL: draws name their vertex array and texture by id, and the renderer turns each batch
+// into one instanced call reading its transforms from GetInstanceTransforms(). The key's material should tell
+// meshes and textures apart; draws sharing a material but not a mesh still come out in depth order, just split
+// into more batches.
+class RenderQueues
+{
+public:
+   struct IndexedDraw
+   {
+      RenderKey key;
+      uint32_t  vertexArrayId {};
+      uint32_t  textureId {};
+      uint32_t  indexCount {};
+      glm::mat4 model { 1.0f };
+   };
+
+   // Consecutive opaque draws sharing key state, vertex array and texture; their transforms are contiguous
+   struct InstanceBatch
+   {
+      RenderKey key;
+      uint32_t  vertexArrayId {};
+      uint32_t  textureId {};
+      uint32_t  indexCount {};
+      uint32_t  firstInstance {}; // into GetInstanceTransforms()
+      uint32_t  instanceCount {};
+   };
+
+   // Binds a renderer would make walking draws in order; the first draw counts as one of each
+   struct StateChanges
+   {
+      uint32_t shaders {};
+      uint32_t materials {};
+      uint32_t vertexArrays {};
+      uint32_t textures {};
+   };
+
+   void Clear();
+
+   void SubmitOpaque( const IndexedDraw& item ) { m_opaqueIndexed.push_back( item ); }
+   void SubmitOverlay( const IndexedDraw& item ) { m_overlayIndexed.push_back( item ); }
+
+   // Orders draws by key, keeping submission order among equal keys, and rebuilds the opaque batches
+   void Sort();
+
+   std::span< const IndexedDraw > GetOpaqueIndexed() const { return m_opaqueIndexed; }
+   std::span< const IndexedDraw > GetOverlayIndexed() const { return m_overlayIndexed; }
+
+   std::span< const InstanceBatch > GetOpaqueBatches() const { return m_opaqueBatches; }
+   std::span< const glm::mat4 >     GetInstanceTransforms() const { return m_instanceTransforms; }
+
+   static StateChanges CountStateChanges( std::span< const IndexedDraw > draws ) noexcept;
+
+private:
+   struct SortEntry
+   {
+      uint64_t key;
+      uint32_t index;
+   };
+
+   void SortByKey( std::vector< IndexedDraw >& draws );
+   void BuildBatches();
+
+   std::vector< IndexedDraw >   m_opaqueIndexed;
+   std::vector< IndexedDraw >   m_overlayIndexed;
+   std::vector< InstanceBatch > m_opaqueBatches;
+   std::vector< glm::mat4 >     m_instanceTransforms; // sorted opaque draws' models, in batch order
+
+   // Kept between frames so sorting does not allocate
+   std::vector< SortEntry >   m_sortEntries;
+   std::vector< SortEntry >   m_sortScratch;
+   std::vector< IndexedDraw > m_drawScratch;
+};
+
+} // namespace Engine
@@ -1,6 +1,7 @@
 #include "RenderSystem.h"
 
 #include <Engine/World/Level.h>
+#include <Engine/Renderer/RenderDevice.h>
 #include <Engine/Renderer/Shader.h>
 #include <Engine/Renderer/Texture.h>
 #include <Engine/ECS/Components.h>
@@ -23,25 +24,26 @@ struct ReticleGL
          glm::vec3( -r, 0.0f, 0.0f ), glm::vec3( r, 0.0f, 0.0f ), glm::vec3( 0.0f, -r, 0.0f ), glm::vec3( 0.0f, r, 0.0f )
       };
 
-      glGenVertexArrays( 1, &vao );
-      glGenBuffers( 1, &vbo );
+      RenderDevice& device = RenderDevice::Get();
+      vao                  = device.CreateVertexArray();
+      vbo                  = device.CreateBuffer();
 
-      glBindVertexArray( vao );
-      glBindBuffer( GL_ARRAY_BUFFER, vbo );
-      glBufferData( GL_ARRAY_BUFFER, sizeof( glm::vec3 ) * verts.size(), verts.data(), GL_STATIC_DRAW );
+      device.BindVertexArray( vao );
+      device.BindBuffer( GL_ARRAY_BUFFER, vbo );
+      device.BufferData( GL_ARRAY_BUFFER, sizeof( glm::vec3 ) * verts.size(), verts.data(), GL_STATIC_DRAW );
 
-      glEnableVertexAttribArray( 0 );
-      glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof( float ), ( void* )0 );
+      device.EnableVertexAttribArray( 0 );
+      device.VertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof( float ), 0 );
 
-      glBindVertexArray( 0 );
+      device.BindVertexArray( 0 );
    }
 
    void Destroy()
    {
       if( vbo )
-         glDeleteBuffers( 1, &vbo );
+         RenderDevice::Get().DeleteBuffer( vbo );
       if( vao )
-         glDeleteVertexArrays( 1, &vao );
+         RenderDevice::Get().DeleteVertexArray( vao );
 
       vbo = 0;
       vao = 0;
@@ -51,57 +53,165 @@ struct ReticleGL
 };
 
 
-// ----------------------------------------------------------------
-// ViewFrustum - frustum culling helper
-// ----------------------------------------------------------------
-class ViewFrustum
+struct TerrainLighting
 {
-public:
-   explicit ViewFrustum( const glm::mat4& pv )
-   {
-      m_planes[ 0 ] = glm::vec4( pv[ 0 ][ 3 ] + pv[ 0 ][ 0 ], pv[ 1 ][ 3 ] + pv[ 1 ][ 0 ], pv[ 2 ][ 3 ] + pv[ 2 ][ 0 ], pv[ 3 ][ 3 ] + pv[ 3 ][ 0 ] );
-      m_planes[ 1 ] = glm::vec4( pv[ 0 ][ 3 ] - pv[ 0 ][ 0 ], pv[ 1 ][ 3 ] - pv[ 1 ][ 0 ], pv[ 2 ][ 3 ] - pv[ 2 ][ 0 ], pv[ 3 ][ 3 ] - pv[ 3 ][ 0 ] );
-      m_planes[ 2 ] = glm::vec4( pv[ 0 ][ 3 ] - pv[ 0 ][ 1 ], pv[ 1 ][ 3 ] - pv[ 1 ][ 1 ], pv[ 2 ][ 3 ] - pv[ 2 ][ 1 ], pv[ 3 ][ 3 ] - pv[ 3 ][ 1 ] );
-      m_planes[ 3 ] = glm::vec4( pv[ 0 ][ 3 ] + pv[ 0 ][ 1 ], pv[ 1 ][ 3 ] + pv[ 1 ][ 1 ], pv[ 2 ][ 3 ] + pv[ 2 ][ 1 ], pv[ 3 ][ 3 ] + pv[ 3 ][ 1 ] );
-      m_planes[ 4 ] = glm::vec4( pv[ 0 ][ 3 ] + pv[ 0 ][ 2 ], pv[ 1 ][ 3 ] + pv[ 1 ][ 2 ], pv[ 2 ][ 3 ] + pv[ 2 ][ 2 ], pv[ 3 ][ 3 ] + pv[ 3 ][ 2 ] );
-      m_planes[ 5 ] = glm::vec4( pv[ 0 ][ 3 ] - pv[ 0 ][ 2 ], pv[ 1 ][ 3 ] - pv[ 1 ][ 2 ], pv[ 2 ][ 3 ] - pv[ 2 ][ 2 ], pv[ 3 ][ 3 ] - pv[ 3 ][ 2 ] );
-      for( glm::vec4& plane : m_planes )
-         plane /= glm::length( glm::vec3( plane ) );
-   }
+   glm::vec3 sunDir { glm::normalize( glm::vec3( -0.35f, 0.85f, -0.25f ) ) };
+   glm::vec3 sunColor { glm::vec3( 1.0f, 0.98f, 0.92f ) * 3.0f };
+   glm::vec3 ambientColor { glm::vec3( 0.12f, 0.16f, 0.22f ) };
+};
+
+// Per-frame data, laid out as the std140 FrameData block the terrain shaders declare
+struct FrameUniforms
+{
+   glm::mat4 viewProjection { 1.0f };
+   glm::vec4 sunDirection { 0.0f };
+   glm::vec4 sunColor { 0.0f };
+   glm::vec4 ambientColor { 0.0f };
+   glm::vec4 viewPos { 0.0f };
+};
+
+constexpr GLuint FRAME_UNIFORMS_BINDING = 0;
+
+struct FrameUniformsGL
+{
+   GLuint ubo = 0;
 
-   bool FInFrustum( const glm::vec3& min, const glm::vec3& max ) const
+   void Upload( const FrameUniforms& uniforms )
    {
-      for( const glm::vec4& plane : m_planes )
+      RenderDevice& device = RenderDevice::Get();
+      if( !ubo )
       {
-         const glm::vec3 point( plane.x >= 0 ? max.x : min.x, plane.y >= 0 ? max.y : min.y, plane.z >= 0 ? max.z : min.z );
-         if( glm::dot( glm::vec3( plane ), point ) + plane.w < 0 )
-            return false;
+         ubo = device.CreateBuffer();
+         device.BindBuffer( GL_UNIFORM_BUFFER, ubo );
+         device.BufferData( GL_UNIFORM_BUFFER, sizeof( FrameUniforms ), nullptr, GL_DYNAMIC_DRAW );
       }
 
-      return true;
+      device.BindBuffer( GL_UNIFORM_BUFFER, ubo );
+      device.BufferSubData( GL_UNIFORM_BUFFER, 0, sizeof( FrameUniforms ), &uniforms );
+      device.BindBuffer( GL_UNIFORM_BUFFER, 0 );
+      device.BindBufferBase( GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, ubo );
    }
 
-private:
-   std::array< glm::vec4, 6 > m_planes;
+   void Destroy()
+   {
+      if( ubo )
+         RenderDevice::Get().DeleteBuffer( ubo );
+
+      ubo = 0;
+   }
+
+   ~FrameUniformsGL() { Destroy(); }
 };
 
-struct TerrainLighting
+// Terrain program with its per-object uniform looked up once; everything else comes from FrameData
+struct TerrainProgram
 {
-   glm::vec3 sunDir { glm::normalize( glm::vec3( -0.35f, 0.85f, -0.25f ) ) };
-   glm::vec3 sunColor { glm::vec3( 1.0f, 0.98f, 0.92f ) * 3.0f };
-   glm::vec3 ambientColor { glm::vec3( 0.12f, 0.16f, 0.22f ) };
+   Shader                shader { Shader::FILE, "terrain_vert.glsl", "terrain_frag.glsl" };
+   Shader::UniformHandle model { shader.GetUniformHandle( "u_model" ) };
+
+   TerrainProgram()
+   {
+      shader.BindUniformBlock( "FrameData", FRAME_UNIFORMS_BINDING );
+      shader.Bind();
+      shader.SetUniform( "u_blockTextures", 0 );
+      shader.Unbind();
+   }
 };
 
-static void SetTerrainCommonUniforms( Shader& shader, const glm::vec3& viewPos, const TerrainLighting& light )
+static TerrainProgram& GetTerrainProgram()
 {
-   shader.SetUniform( "u_sunDirection", light.sunDir );
-   shader.SetUniform( "u_sunColor", light.sunColor );
-   shader.SetUniform( "u_ambientColor", light.ambientColor );
-   shader.SetUniform( "u_blockTextures", 0 );
-   shader.SetUniform( "u_viewPos", viewPos );
+   static TerrainProgram s_program;
+   return s_program;
 }
 
 
+// Same inputs as the terrain program, with the model matrix read per instance instead of from a uniform
+struct InstancedProgram
+{
+   Shader shader { Shader::FILE, "instanced_vert.glsl", "terrain_frag.glsl" };
+
+   InstancedProgram()
+   {
+      shader.BindUniformBlock( "FrameData", FRAME_UNIFORMS_BINDING );
+      shader.Bind();
+      shader.SetUniform( "u_blockTextures", 0 );
+      shader.Unbind();
+   }
+};
+
+// Shader ids in render keys
+constexpr uint8_t INSTANCED_SHADER = 0;
+
+static InstancedProgram& GetInstancedProgram()
+{
+   static InstancedProgram s_program;
+   return s_program;
+}
+
+// Per-instance model matrices, refilled every frame
+struct InstanceBufferGL
+{
+   static constexpr GLuint FIRST_ATTRIBUTE = 4; // a_model, one column per location
+
+   GLuint     vbo      = 0;
+   GLsizeiptr capacity = 0;
+
+   void Upload( std::span< const glm::mat4 > transforms )
+   {
+      RenderDevice& device = RenderDevice::Get();
+      if( !vbo )
+         vbo = device.CreateBuffer();
+
+      // Orphaning the old storage lets the driver hand out fresh memory instead of waiting on last frame's draws
+      const GLsizeiptr size = static_cast< GLsizeiptr >( transforms.size_bytes() );
+      device.BindBuffer( GL_ARRAY_BUFFER, vbo );
+      if( size > capacity )
+         capacity = ( std::max )( size, capacity * 2 );
+
+      device.BufferData( GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW );
+      device.BufferSubData( GL_ARRAY_BUFFER, 0, size, transforms.data() );
+      device.BindBuffer( GL_ARRAY_BUFFER, 0 );
+   }
+
+   // Points the bound vertex array's a_model at the transforms from `firstInstance` on
+   void Attach( uint32_t firstInstance ) const
+   {
+      RenderDevice& device = RenderDevice::Get();
+      device.BindBuffer( GL_ARRAY_BUFFER, vbo );
+      for( GLuint column = 0; column < 4; ++column )
+      {
+         const size_t offset = firstInstance * sizeof( glm::mat4 ) + column * sizeof( glm::vec4 );
+         device.EnableVertexAttribArray( FIRST_ATTRIBUTE + column );
+         device.VertexAttribPointer( FIRST_ATTRIBUTE + column, 4, GL_FLOAT, GL_FALSE, sizeof( glm::mat4 ), offset );
+         device.VertexAttribDivisor( FIRST_ATTRIBUTE + column, 1 );
+      }
+      device.BindBuffer( GL_ARRAY_BUFFER, 0 );
+   }
+
+   // Meshes are shared with non-instanced draws, which must not see the per-instance attributes
+   static void Detach()
+   {
+      RenderDevice& device = RenderDevice::Get();
+      for( GLuint column = 0; column < 4; ++column )
+      {
+         device.VertexAttribDivisor( FIRST_ATTRIBUTE + column, 0 );
+         device.DisableVertexAttribArray( FIRST_ATTRIBUTE + column );
+      }
+   }
+
+   void Destroy()
+   {
+      if( vbo )
+         RenderDevice::Get().DeleteBuffer( vbo );
+
+      vbo      = 0;
+      capacity = 0;
+   }
+
+   ~InstanceBufferGL() { Destroy(); }
+};
+
+
 // ----------------------------------------------------------------
 // RenderSystem
 // ----------------------------------------------------------------
@@ -118,13 +228,14 @@ void RenderSystem::Update( const glm::vec3& playerPos, uint8_t viewRadius )
 
 void RenderSystem::Run( const FrameContext& ctx )
 {
-   glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+   RenderDevice::Get().Clear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 
-   RenderQueues queues;
-   BuildQueues( ctx, queues );
+   UploadFrameUniforms( ctx );
+
+   BuildQueues( ctx, m_queues );
 
    DrawTerrainPass( ctx );
-   DrawOpaquePass( ctx, queues );
+   DrawOpaquePass( ctx, m_queues );
 
    if( m_fHighlightEnabled )
       DrawBlockHighlight( ctx );
@@ -132,13 +243,26 @@ void RenderSystem::Run( const FrameContext& ctx )
    if( m_fSkyboxEnabled )
       DrawSkybox( ctx );
 
-   DrawOverlayPass( ctx, queues );
+   DrawOverlayPass( ctx, m_queues );
 
    if( m_fReticleEnabled )
       DrawReticle( ctx );
 }
 
 
+void RenderSystem::UploadFrameUniforms( const FrameContext& ctx )
+{
+   static FrameUniformsGL s_frameUniforms;
+
+   const TerrainLighting lighting;
+   s_frameUniforms.Upload( FrameUniforms { .viewProjection = ctx.viewProjection,
+                                           .sunDirection   = glm::vec4( lighting.sunDir, 0.0f ),
+                                           .sunColor       = glm::vec4( lighting.sunColor, 0.0f ),
+                                           .ambientColor   = glm::vec4( lighting.ambientColor, 0.0f ),
+                                           .viewPos        = glm::vec4( ctx.viewPos, 1.0f ) } );
+}
+
+
 void RenderSystem::BuildQueues( const FrameContext& ctx, RenderQueues& outQueues )
 {
    outQueues.Clear();
@@ -149,48 +273,119 @@ void RenderSystem::BuildQueues( const FrameContext& ctx, RenderQueues& outQueues
 }
 
 
-void RenderSystem::DrawTerrainPass( const FrameContext& ctx )
+void RenderSystem::BuildOccluders( const FrameContext& ctx )
 {
-   TextureAtlasManager::Get().Bind();
-
-   static Shader s_terrainShader( Shader::FILE, "terrain_vert.glsl", "terrain_frag.glsl" );
-   s_terrainShader.Bind();
+   // Solid sections close to the camera hide the most; farther ones rarely cover more than a few pixels
+   constexpr int OCCLUDER_RADIUS = 4; // chunks
 
-   TerrainLighting lighting;
-   SetTerrainCommonUniforms( s_terrainShader, ctx.viewPos, lighting );
+   m_occlusion.Begin( ctx.viewProjection, ctx.viewPos );
 
-   ViewFrustum frustum( ctx.viewProjection );
+   const int cameraX = static_cast< int >( std::floor( ctx.viewPos.x / CHUNK_SIZE_X ) );
+   const int cameraZ = static_cast< int >( std::floor( ctx.viewPos.z / CHUNK_SIZE_Z ) );
    for( const auto& [ cc, chunkEntry ] : m_chunkRenderer.GetEntries() )
    {
+      if( chunkEntry.lod != 0 || std::abs( cc.x - cameraX ) > OCCLUDER_RADIUS || std::abs( cc.z - cameraZ ) > OCCLUDER_RADIUS )
+         continue;
+
+      // Runs of opaque sections become one tall box, so no seam runs between them
       const float worldX0 = static_cast< float >( cc.x * CHUNK_SIZE_X );
       const float worldZ0 = static_cast< float >( cc.z * CHUNK_SIZE_Z );
-      for( const auto& [ i, sec ] : chunkEntry.sections | std::views::enumerate )
+      for( int first = 0; first < SECTIONS_PER_CHUNK; )
       {
-         if( sec.fEmpty || sec.indexCount == 0 || sec.vao == 0 )
-            continue;
+         int last = first;
+         while( last < SECTIONS_PER_CHUNK && chunkEntry.sections[ static_cast< size_t >( last ) ].visibility.FOpaque() )
+            ++last;
 
-         const float     y0 = static_cast< float >( i * CHUNK_SECTION_SIZE );
-         const glm::vec3 secMin( worldX0, y0, worldZ0 );
-         const glm::vec3 secMax( worldX0 + CHUNK_SIZE_X, y0 + CHUNK_SECTION_SIZE, worldZ0 + CHUNK_SIZE_Z );
-         if( !frustum.FInFrustum( secMin, secMax ) )
-            continue;
+         if( last > first )
+            m_occlusion.AddOccluder( glm::vec3( worldX0, static_cast< float >( first * CHUNK_SECTION_SIZE ), worldZ0 ),
+                                     glm::vec3( worldX0 + CHUNK_SIZE_X, static_cast< float >( last * CHUNK_SECTION_SIZE ), worldZ0 + CHUNK_SIZE_Z ) );
 
-         // Section mesh has world-space Y baked in already. Only translate by chunk XZ.
-         const glm::mat4 model = glm::translate( glm::mat4( 1.0f ), glm::vec3( worldX0, 0.0f, worldZ0 ) );
-         const glm::mat4 mvp   = ctx.viewProjection * model;
+         first = last + 1;
+      }
+   }
 
-         s_terrainShader.SetUniform( "u_mvp", mvp );
-         s_terrainShader.SetUniform( "u_model", model );
+   m_occlusion.Finish();
+}
 
-         glBindVertexArray( sec.vao );
-         glDrawElements( GL_TRIANGLES, static_cast< GLsizei >( sec.indexCount ), GL_UNSIGNED_INT, nullptr );
-      }
+
+void RenderSystem::DrawTerrainPass( const FrameContext& ctx )
+{
+   BuildOccluders( ctx );
+
+   TextureAtlasManager::Get().Bind();
+
+   // Meshes go into one indirect draw; the model matrix is identity since each draw carries its chunk origin
+   TerrainProgram& program = GetTerrainProgram();
+   program.shader.Bind();
+   program.shader.SetUniform( program.model, glm::mat4( 1.0f ) );
+
+   m_terrainDraws.Clear();
+
+   const ViewFrustum frustum( ctx.viewProjection );
+   auto              draw = [ & ]( const ChunkRenderer::SectionEntry& mesh, const glm::vec3& meshMin, const glm::vec3& meshMax )
+   {
+      if( mesh.fEmpty || m_occlusion.FOccluded( meshMin, meshMax ) )
+         return;
+
+      // Meshes have world-space Y baked in already. Only offset by chunk XZ. Face groups turned away from the
+      // camera are left out, which drops about half the triangles before they are shaded.
+      m_chunkRenderer.Queue( m_terrainDraws, mesh, glm::vec3( meshMin.x, 0.0f, meshMin.z ), ChunkRenderer::FacingFaces( ctx.viewPos, meshMin, meshMax ) );
+   };
+
+   // Every box in view in one batched pass; distant chunks draw their whole column straight from it
+   const FrustumCuller& culler = m_chunkRenderer.GetCuller();
+   culler.Cull( frustum, m_visibleBounds );
+
+   m_fBoundsInView.assign( culler.Size(), false );
+   for( const uint32_t index : m_visibleBounds )
+   {
+      m_fBoundsInView[ index ] = true;
+
+      const ChunkRenderer::BoundsOwner& owner = m_chunkRenderer.GetBoundsOwner( index );
+      if( owner.section >= 0 )
+         continue;
+
+      const float worldX0 = static_cast< float >( owner.cc.x * CHUNK_SIZE_X );
+      const float worldZ0 = static_cast< float >( owner.cc.z * CHUNK_SIZE_Z );
+      draw( owner.pEntry->coarse, glm::vec3( worldX0, 0.0f, worldZ0 ), glm::vec3( worldX0 + CHUNK_SIZE_X, CHUNK_SIZE_Y, worldZ0 + CHUNK_SIZE_Z ) );
    }
 
-   glBindVertexArray( 0 );
+   // Full-detail sections are drawn as the visibility walk reaches them, so sections sealed off from the camera
+   // by solid rock are skipped. The walk only needs to cover the rings that can hold them. A camera above or below
+   // the world is left unclamped; the walk starts from the whole layer facing it.
+   auto floorDiv = []( float v, int size ) { return static_cast< int >( std::floor( v / static_cast< float >( size ) ) ); };
+
+   const SectionPos camera { floorDiv( ctx.viewPos.x, CHUNK_SIZE_X ),
+                             floorDiv( ctx.viewPos.y, CHUNK_SECTION_SIZE ),
+                             floorDiv( ctx.viewPos.z, CHUNK_SIZE_Z ) };
+
+   const int radius = ( std::min )( static_cast< int >( m_chunkRenderer.GetViewRadius() ), ChunkRenderer::LOD_RING_DISTANCES[ 0 ] + ChunkRenderer::LOD_HYSTERESIS );
+
+   const auto& entries = m_chunkRenderer.GetEntries();
+   auto        lookup  = [ this ]( const SectionPos& pos ) { return m_chunkRenderer.GetVisibility( pos ); };
+   auto        visit   = [ & ]( const SectionPos& pos )
+   {
+      const glm::vec3 secMin( static_cast< float >( pos.x * CHUNK_SIZE_X ), static_cast< float >( pos.y * CHUNK_SECTION_SIZE ), static_cast< float >( pos.z * CHUNK_SIZE_Z ) );
+      const glm::vec3 secMax = secMin + glm::vec3( CHUNK_SIZE_X, CHUNK_SECTION_SIZE, CHUNK_SIZE_Z );
+
+      // Sections of full-detail chunks were tested in the batch above; anything else is tested on its own
+      const auto it = entries.find( ChunkPos { pos.x, pos.z } );
+      if( it == entries.end() || it->second.lod != 0 )
+         return frustum.FInFrustum( secMin, secMax );
+
+      if( !m_fBoundsInView[ it->second.firstBounds + static_cast< uint32_t >( pos.y ) ] )
+         return false;
+
+      draw( it->second.sections[ static_cast< size_t >( pos.y ) ], secMin, secMax );
+      return true;
+   };
+   WalkVisibleSections( camera, radius, lookup, visit );
+
+   m_chunkRenderer.Submit( m_terrainDraws );
+
    TextureAtlasManager::Get().Unbind();
 
-   s_terrainShader.Unbind();
+   program.shader.Unbind();
 }
 
 
@@ -210,8 +405,9 @@ void RenderSystem::QueueItemDrops( const FrameContext& ctx, RenderQueues& outQue
    for( auto [ tran, mesh, phys, drop ] : ctx.registry.CView< CTransform, CMesh, CPhysics, CItemDrop >() )
    {
       // Culling: distance and frustum
-      const glm::vec3 toDrop = tran.position - ctx.viewPos;
-      if( glm::dot( toDrop, toDrop ) > MAX_ITEM_DROP_DISTANCE_SQ || !frustum.FInFrustum( tran.position + phys.bbMin, tran.position + phys.bbMax ) )
+      const glm::vec3 toDrop     = tran.position - ctx.viewPos;
+      const float     distanceSq = glm::dot( toDrop, toDrop );
+      if( distanceSq > MAX_ITEM_DROP_DISTANCE_SQ || !frustum.FInFrustum( tran.position + phys.bbMin, tran.position + phys.bbMax ) )
          continue;
 
       // Interpolate position
@@ -224,13 +420,14 @@ void RenderSystem::QueueItemDrops( const FrameContext& ctx, RenderQueues& outQue
       // Rotation around Y axis
       const float rotationY = t * ROTATION_SPEED;
 
-      glm::mat4 model = glm::translate( glm::mat4( 1.0f ), renderPos );
-      model           = glm::rotate( model, glm::radians( tran.rotation.x ), glm::vec3( 1, 0, 0 ) );
-      model           = glm::rotate( model, glm::radians( rotationY ), glm::vec3( 0, 1, 0 ) );
-      model           = glm::rotate( model, glm::radians( tran.rotation.z ), glm::vec3( 0, 0, 1 ) );
+      // X * Y * Z in one matrix rather than three rotate calls
+      glm::mat4 model = glm::eulerAngleXYZ( glm::radians( tran.rotation.x ), glm::radians( rotationY ), glm::radians( tran.rotation.z ) );
+      model[ 3 ]      = glm::vec4( renderPos, 1.0f );
 
-      outQueues.SubmitOpaque( RenderQueues::IndexedDraw { .key           = RenderKey { 0 },
-                                                          .vertexArrayId = mesh.mesh->GetMeshBuffer().GetVertexArrayID(),
+      // Drops of one block share a mesh, so its vertex array names the material
+      const uint32_t vertexArrayId = mesh.mesh->GetMeshBuffer().GetVertexArrayID();
+      outQueues.SubmitOpaque( RenderQueues::IndexedDraw { .key           = RenderKey::Opaque( 0, INSTANCED_SHADER, vertexArrayId, distanceSq ),
+                                                          .vertexArrayId = vertexArrayId,
                                                           .textureId     = 0,
                                                           .indexCount    = mesh.mesh->GetMeshBuffer().GetIndexCount(),
                                                           .model         = model } );
@@ -238,39 +435,32 @@ void RenderSystem::QueueItemDrops( const FrameContext& ctx, RenderQueues& outQue
 }
 
 
-void RenderSystem::DrawOpaquePass( const FrameContext& ctx, const RenderQueues& queues )
+void RenderSystem::DrawOpaquePass( const FrameContext& /*ctx*/, const RenderQueues& queues )
 {
-   if( queues.GetOpaqueIndexed().empty() )
+   if( queues.GetOpaqueBatches().empty() )
       return;
 
-   TextureAtlasManager::Get().Bind();
+   static InstanceBufferGL s_instances;
+   s_instances.Upload( queues.GetInstanceTransforms() );
 
-   static Shader s_terrainShader( Shader::FILE, "terrain_vert.glsl", "terrain_frag.glsl" );
-   s_terrainShader.Bind();
+   TextureAtlasManager::Get().Bind();
 
-   TerrainLighting lighting;
-   SetTerrainCommonUniforms( s_terrainShader, ctx.viewPos, lighting );
+   InstancedProgram& program = GetInstancedProgram();
+   program.shader.Bind();
 
-   uint32_t currentVao = 0;
-   for( const auto& item : queues.GetOpaqueIndexed() )
+   RenderDevice& device = RenderDevice::Get();
+   for( const RenderQueues::InstanceBatch& batch : queues.GetOpaqueBatches() )
    {
-      const glm::mat4 mvp = ctx.viewProjection * item.model;
-      s_terrainShader.SetUniform( "u_mvp", mvp );
-      s_terrainShader.SetUniform( "u_model", item.model );
-
-      if( item.vertexArrayId != currentVao )
-      {
-         glBindVertexArray( item.vertexArrayId );
-         currentVao = item.vertexArrayId;
-      }
-
-      glDrawElements( GL_TRIANGLES, static_cast< GLsizei >( item.indexCount ), GL_UNSIGNED_INT, nullptr );
+      device.BindVertexArray( batch.vertexArrayId );
+      s_instances.Attach( batch.firstInstance );
+      device.DrawElementsInstanced( GL_TRIANGLES, static_cast< GLsizei >( batch.indexCount ), GL_UNSIGNED_INT, 0, static_cast< GLsizei >( batch.instanceCount ) );
+      InstanceBufferGL::Detach();
    }
 
-   glBindVertexArray( 0 );
+   device.BindVertexArray( 0 );
    TextureAtlasManager::Get().Unbind();
 
-   s_terrainShader.Unbind();
+   program.shader.Unbind();
 }
 
 
@@ -311,6 +501,8 @@ void RenderSystem::DrawBlockHighlight( const FrameContext& ctx )
 
    // Static OpenGL resources for wire cube
    static GLuint s_vao = 0, s_vbo = 0, s_ebo = 0;
+
+   RenderDevice& device = RenderDevice::Get();
    if( s_vao == 0 )
    {
       constexpr glm::vec3 vertices[ 8 ] = {
@@ -324,17 +516,17 @@ void RenderSystem::DrawBlockHighlight( const FrameContext& ctx )
          { -0.5f, 0.5f,  0.5f  },
       };
 
-      glGenVertexArrays( 1, &s_vao );
-      glGenBuffers( 1, &s_vbo );
-      glGenBuffers( 1, &s_ebo );
-
-      glBindVertexArray( s_vao );
-      glBindBuffer( GL_ARRAY_BUFFER, s_vbo );
-      glBufferData( GL_ARRAY_BUFFER, sizeof( vertices ), vertices, GL_STATIC_DRAW );
-      glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, s_ebo );
-      glEnableVertexAttribArray( 0 );
-      glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, sizeof( glm::vec3 ), nullptr );
-      glBindVertexArray( 0 );
+      s_vao = device.CreateVertexArray();
+      s_vbo = device.CreateBuffer();
+      s_ebo = device.CreateBuffer();
+
+      device.BindVertexArray( s_vao );
+      device.BindBuffer( GL_ARRAY_BUFFER, s_vbo );
+      device.BufferData( GL_ARRAY_BUFFER, sizeof( vertices ), vertices, GL_STATIC_DRAW );
+      device.BindBuffer( GL_ELEMENT_ARRAY_BUFFER, s_ebo );
+      device.EnableVertexAttribArray( 0 );
+      device.VertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, sizeof( glm::vec3 ), 0 );
+      device.BindVertexArray( 0 );
    }
 
    // Face edge indices for exposed faces
@@ -385,10 +577,10 @@ void RenderSystem::DrawBlockHighlight( const FrameContext& ctx )
    const glm::vec3 highlightColor = glm::vec3( 1.0f, 0.5f, 0.0f ) * pulse;
    s_shader.SetUniform( "u_color", highlightColor );
 
-   glBindVertexArray( s_vao );
-   glBufferData( GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof( unsigned int ), indices.data(), GL_DYNAMIC_DRAW );
-   glDrawElements( GL_LINES, static_cast< GLsizei >( indices.size() ), GL_UNSIGNED_INT, nullptr );
-   glBindVertexArray( 0 );
+   device.BindVertexArray( s_vao );
+   device.BufferData( GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof( unsigned int ), indices.data(), GL_DYNAMIC_DRAW );
+   device.DrawElements( GL_LINES, static_cast< GLsizei >( indices.size() ), GL_UNSIGNED_INT, 0 );
+   device.BindVertexArray( 0 );
 
    s_shader.Unbind();
 }
@@ -428,17 +620,17 @@ void RenderSystem::DrawReticle( const FrameContext& ctx )
    s_reticleShader.Bind();
    s_reticleShader.SetUniform( "u_color", glm::vec3( 1.0f ) ); // white reticle
 
-   GLint vp[ 4 ];
-   glGetIntegerv( GL_VIEWPORT, vp );
+   RenderDevice&    device = RenderDevice::Get();
+   const glm::ivec4 vp     = device.GetViewport();
    s_reticleShader.SetUniform( "u_aspect", float( vp[ 2 ] ) / float( vp[ 3 ] ) );
 
-   glDisable( GL_DEPTH_TEST ); // disable depth testing, render over everything
+   device.Disable( GL_DEPTH_TEST ); // disable depth testing, render over everything
 
-   glBindVertexArray( s_reticle.vao );
-   glDrawArrays( GL_LINES, 0, 4 );
-   glBindVertexArray( 0 );
+   device.BindVertexArray( s_reticle.vao );
+   device.DrawArrays( GL_LINES, 0, 4 );
+   device.BindVertexArray( 0 );
 
-   glEnable( GL_DEPTH_TEST ); // restore depth testing
+   device.Enable( GL_DEPTH_TEST ); // restore depth testing
 
    s_reticleShader.Unbind();
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Engine/World/ChunkRenderer.h>
+#include <Engine/World/OcclusionCuller.h>
+#include <Engine/World/RenderQueues.h>
 #include <Engine/Core/Time.h>
 
 #include <Engine/ECS/Registry.h>
@@ -9,49 +11,6 @@
 namespace Engine
 {
 
-struct RenderKey
-{
-   // [ Transparent (1) | Layer (8) | Shader (8) | Material (15) ] (implementation-defined by caller)
-   uint32_t value {};
-   bool     operator<( const RenderKey& other ) const { return value < other.value; }
-};
-
-class RenderQueues
-{
-public:
-   struct IndexedDraw
-   {
-      RenderKey key;
-      uint32_t  vertexArrayId {};
-      uint32_t  textureId {};
-      uint32_t  indexCount {};
-      glm::mat4 model { 1.0f };
-   };
-
-   void Clear()
-   {
-      m_opaqueIndexed.clear();
-      m_overlayIndexed.clear();
-   }
-
-   void SubmitOpaque( const IndexedDraw& item ) { m_opaqueIndexed.push_back( item ); }
-   void SubmitOverlay( const IndexedDraw& item ) { m_overlayIndexed.push_back( item ); }
-
-   void Sort()
-   {
-      auto byKey = []( const IndexedDraw& a, const IndexedDraw& b ) { return a.key < b.key; };
-      std::sort( m_opaqueIndexed.begin(), m_opaqueIndexed.end(), byKey );
-      std::sort( m_overlayIndexed.begin(), m_overlayIndexed.end(), byKey );
-   }
-
-   std::span< const IndexedDraw > GetOpaqueIndexed() const { return m_opaqueIndexed; }
-   std::span< const IndexedDraw > GetOverlayIndexed() const { return m_overlayIndexed; }
-
-private:
-   std::vector< IndexedDraw > m_opaqueIndexed;
-   std::vector< IndexedDraw > m_overlayIndexed;
-};
-
 class RenderSystem
 {
 public:
@@ -82,8 +41,10 @@ public:
 private:
    NO_COPY_MOVE( RenderSystem )
 
+   void UploadFrameUniforms( const FrameContext& ctx );
    void BuildQueues( const FrameContext& ctx, RenderQueues& outQueues );
 
+   void BuildOccluders( const FrameContext& ctx );
    void DrawTerrainPass( const FrameContext& ctx );
    void DrawOpaquePass( const FrameContext& ctx, const RenderQueues& queues );
    void DrawOverlayPass( const FrameContext& ctx, const RenderQueues& queues );
@@ -93,8 +54,14 @@ private:
    void DrawSkybox( const FrameContext& ctx );
    void DrawReticle( const FrameContext& ctx );
 
-   Level&        m_level;
-   ChunkRenderer m_chunkRenderer;
+   Level&          m_level;
+   ChunkRenderer   m_chunkRenderer;
+   OcclusionCuller m_occlusion;
+
+   std::vector< uint32_t > m_visibleBounds; // culler indices in view this frame
+   std::vector< bool >     m_fBoundsInView; // the same, by culler index
+   ChunkRenderer::DrawList m_terrainDraws;
+   RenderQueues            m_queues; // rebuilt every frame, kept for its storage
 
    bool m_fSkyboxEnabled { true };
    bool m_fReticleEnabled { true };
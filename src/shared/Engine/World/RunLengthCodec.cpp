@@ -0,0 +1,80 @@
+#include "RunLengthCodec.h"
+
+static constexpr size_t MIN_RUN     = 3;
+static constexpr size_t MAX_RUN     = 130;
+static constexpr size_t MAX_LITERAL = 128;
+
+// ----------------------------------------------------------------
+// RunLengthCodec
+// ----------------------------------------------------------------
+/*static*/ std::vector< std::byte > RunLengthCodec::Encode( std::span< const std::byte > bytes )
+{
+   std::vector< std::byte > out;
+   out.reserve( bytes.size() / 4 + 16 );
+
+   size_t literalStart = 0;
+   auto   flushLiterals = [ & ]( size_t end )
+   {
+      while( literalStart < end )
+      {
+         const size_t count = ( std::min )( end - literalStart, MAX_LITERAL );
+         out.push_back( static_cast< std::byte >( count - 1 ) );
+         out.insert( out.end(), bytes.begin() + literalStart, bytes.begin() + literalStart + count );
+         literalStart += count;
+      }
+   };
+
+   size_t i = 0;
+   while( i < bytes.size() )
+   {
+      size_t run = 1;
+      while( i + run < bytes.size() && run < MAX_RUN && bytes[ i + run ] == bytes[ i ] )
+         ++run;
+
+      if( run < MIN_RUN )
+      {
+         i += run;
+         continue;
+      }
+
+      flushLiterals( i );
+      out.push_back( static_cast< std::byte >( run + 125 ) );
+      out.push_back( bytes[ i ] );
+      i += run;
+      literalStart = i;
+   }
+
+   flushLiterals( bytes.size() );
+   return out;
+}
+
+
+/*static*/ std::optional< std::vector< std::byte > > RunLengthCodec::Decode( std::span< const std::byte > bytes )
+{
+   std::vector< std::byte > out;
+   out.reserve( bytes.size() * 4 );
+
+   size_t i = 0;
+   while( i < bytes.size() )
+   {
+      const size_t control = static_cast< size_t >( bytes[ i++ ] );
+      if( control < MAX_LITERAL )
+      {
+         const size_t count = control + 1;
+         if( i + count > bytes.size() )
+            return std::nullopt;
+
+         out.insert( out.end(), bytes.begin() + i, bytes.begin() + i + count );
+         i += count;
+      }
+      else
+      {
+         if( i >= bytes.size() )
+            return std::nullopt;
+
+         out.insert( out.end(), control - 125, bytes[ i++ ] );
+      }
+   }
+
+   return out;
+}
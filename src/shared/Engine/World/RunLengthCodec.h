@@ -0,0 +1,14 @@
+#pragma once
+
+// ----------------------------------------------------------------
+// RunLengthCodec - byte-oriented run-length coding (PackBits style)
+// ----------------------------------------------------------------
+// Control byte c < 128 is followed by c + 1 literal bytes; c >= 128 by one byte repeated c - 125 times
+// (3 to 130). Encoded chunks are mostly long runs of zero words and repeated palette indices, which this
+// shrinks cheaply; incompressible input grows by at most one byte in 128.
+class RunLengthCodec
+{
+public:
+   static std::vector< std::byte >                 Encode( std::span< const std::byte > bytes );
+   static std::optional< std::vector< std::byte > > Decode( std::span< const std::byte > bytes );
+};
@@ -0,0 +1,65 @@
+#include "SectionVisibility.h"
+
+/*static*/ SectionVisibility SectionVisibility::Compute( const SectionBlocksPtr& pBlocks )
+{
+   if( !pBlocks )
+      return All();
+
+   std::array< bool, CHUNK_SECTION_VOLUME > fClosed;
+   bool                                     fAnyOpen = false;
+   for( size_t i = 0; i < CHUNK_SECTION_VOLUME; ++i )
+   {
+      fClosed[ i ] = FHasFlag( GetBlockInfo( ( *pBlocks )[ i ] ).flags, BlockFlag::Opaque );
+      fAnyOpen |= !fClosed[ i ];
+   }
+
+   if( !fAnyOpen )
+      return Opaque();
+
+   // Each fill marks what it reaches as closed, so every open block is filled from exactly once
+   SectionVisibility       visibility;
+   std::vector< uint16_t > stack;
+   stack.reserve( CHUNK_SECTION_VOLUME );
+   for( size_t start = 0; start < CHUNK_SECTION_VOLUME; ++start )
+   {
+      if( fClosed[ start ] )
+         continue;
+
+      uint8_t faces = 0; // bit per face the region touches
+
+      fClosed[ start ] = true;
+      stack.push_back( static_cast< uint16_t >( start ) );
+      while( !stack.empty() )
+      {
+         const int index = stack.back();
+         stack.pop_back();
+
+         // Index = x + z * 16 + y * 256
+         const int x = index & 15, z = ( index >> 4 ) & 15, y = index >> 8;
+         faces |= ( x == 0 ? 1u << 0 : 0u ) | ( x == 15 ? 1u << 1 : 0u ) | ( y == 0 ? 1u << 2 : 0u ) | ( y == 15 ? 1u << 3 : 0u ) |
+                  ( z == 0 ? 1u << 4 : 0u ) | ( z == 15 ? 1u << 5 : 0u );
+
+         auto push = [ & ]( bool fInside, int neighbor )
+         {
+            if( fInside && !fClosed[ neighbor ] )
+            {
+               fClosed[ neighbor ] = true;
+               stack.push_back( static_cast< uint16_t >( neighbor ) );
+            }
+         };
+         push( x > 0, index - 1 );
+         push( x < 15, index + 1 );
+         push( z > 0, index - 16 );
+         push( z < 15, index + 16 );
+         push( y > 0, index - 256 );
+         push( y < 15, index + 256 );
+      }
+
+      for( int a = 0; a < FACE_COUNT; ++a )
+         for( int b = a + 1; b < FACE_COUNT; ++b )
+            if( ( faces >> a & 1 ) && ( faces >> b & 1 ) )
+               visibility.Connect( a, b );
+   }
+
+   return visibility;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <Engine/World/Level.h>
+
+// ----------------------------------------------------------------
+// SectionVisibility - which faces of a section see each other
+// ----------------------------------------------------------------
+// Two faces are connected when a path of non-opaque blocks inside the section touches both. Computed by a flood
+// fill when the section is meshed; the renderer walks these connections outward from the camera so sections
+// sealed off behind solid rock (most caves, seen from the surface) are never drawn.
+//
+// Faces are numbered 0 -X, 1 +X, 2 -Y, 3 +Y, 4 -Z, 5 +Z, so opposite faces differ in the lowest bit.
+class SectionVisibility
+{
+public:
+   static constexpr int FACE_COUNT = 6;
+
+   static constexpr SectionVisibility All() noexcept { return SectionVisibility( ( 1u << PAIR_COUNT ) - 1 ); }
+   static constexpr SectionVisibility None() noexcept { return SectionVisibility( 0 ); }
+   static constexpr SectionVisibility Opaque() noexcept { return SectionVisibility( OPAQUE_BIT ); } // no open block at all
+
+   // nullptr is an all-air section
+   static SectionVisibility Compute( const SectionBlocksPtr& pBlocks );
+
+   constexpr SectionVisibility() noexcept = default;
+
+   bool FConnected( int a, int b ) const noexcept { return a == b || ( m_pairs & PairBit( a, b ) ) != 0; }
+   bool FOpaque() const noexcept { return ( m_pairs & OPAQUE_BIT ) != 0; } // usable as an occluder
+   void Connect( int a, int b ) noexcept
+   {
+      if( a != b )
+         m_pairs |= PairBit( a, b );
+   }
+
+   bool operator==( const SectionVisibility& ) const noexcept = default;
+
+private:
+   static constexpr int      PAIR_COUNT = FACE_COUNT * ( FACE_COUNT - 1 ) / 2;
+   static constexpr uint16_t OPAQUE_BIT = 1u << PAIR_COUNT;
+
+   constexpr explicit SectionVisibility( uint16_t pairs ) noexcept :
+      m_pairs( pairs )
+   {}
+
+   static constexpr uint16_t PairBit( int a, int b ) noexcept
+   {
+      const int lo = ( std::min )( a, b ), hi = ( std::max )( a, b );
+      return static_cast< uint16_t >( 1u << ( lo * ( 2 * FACE_COUNT - lo - 1 ) / 2 + hi - lo - 1 ) );
+   }
+
+   uint16_t m_pairs { 0 }; // one bit per unordered pair of faces, then OPAQUE_BIT
+};
+
+
+// Section of a chunk column: chunk x, section index, chunk z
+struct SectionPos
+{
+   int x { 0 };
+   int y { 0 };
+   int z { 0 };
+
+   bool operator==( const SectionPos& ) const noexcept = default;
+};
+
+
+// Breadth-first walk over sections that may be visible from `camera`, at most `radius` chunks away horizontally.
+//   lookup( SectionPos ) -> SectionVisibility, All() for anything not meshed yet
+//   visit( SectionPos ) -> bool, false stops the walk there (outside the frustum, say)
+// A section is only left through a face connected to the one it was entered by, and the walk never turns back
+// toward the camera, so it cannot wrap around through open space to reach what a wall hides. Each section is
+// visited once but expanded again when reached through a new face.
+//
+// A camera above or below the world sees every section of the top or bottom layer within `radius` face on, so
+// the walk starts from all of them as if entered from outside, rather than from one section that may be out of view.
+template< typename Lookup, typename Visit >
+void WalkVisibleSections( const SectionPos& camera, int radius, Lookup&& lookup, Visit&& visit )
+{
+   constexpr std::array< SectionPos, SectionVisibility::FACE_COUNT > offsets {
+      SectionPos { -1, 0, 0 }, SectionPos { 1, 0, 0 }, SectionPos { 0, -1, 0 }, SectionPos { 0, 1, 0 }, SectionPos { 0, 0, -1 }, SectionPos { 0, 0, 1 },
+   };
+
+   constexpr uint8_t SEEN     = 1u << 6;
+   constexpr uint8_t ACCEPTED = 1u << 7;
+
+   struct Step
+   {
+      SectionPos pos;
+      int8_t     enteredFrom { -1 }; // face, -1 for the camera's section
+      uint8_t    directions { 0 };   // faces the walk has left through so far
+   };
+
+   // Per section: faces it was entered through in the low bits, SEEN and ACCEPTED above
+   const int              width = 2 * radius + 1;
+   std::vector< uint8_t > state( static_cast< size_t >( width * width * SECTIONS_PER_CHUNK ), 0 );
+   auto                   stateAt = [ & ]( const SectionPos& pos ) -> uint8_t&
+   {
+      return state[ static_cast< size_t >( ( pos.x - camera.x + radius ) + ( pos.z - camera.z + radius ) * width + pos.y * width * width ) ];
+   };
+
+   std::deque< Step > queue;
+   if( camera.y >= 0 && camera.y < SECTIONS_PER_CHUNK )
+      queue.push_back( Step { .pos = camera } );
+   else
+   {
+      const bool fAbove = camera.y >= SECTIONS_PER_CHUNK;
+      const int  face   = fAbove ? 3 : 2; // the layer's outer face
+      const int  y      = fAbove ? SECTIONS_PER_CHUNK - 1 : 0;
+      for( int dz = -radius; dz <= radius; ++dz )
+      {
+         for( int dx = -radius; dx <= radius; ++dx )
+         {
+            const SectionPos pos { camera.x + dx, y, camera.z + dz };
+            stateAt( pos ) |= static_cast< uint8_t >( 1u << face );
+            queue.push_back( Step { .pos = pos, .enteredFrom = static_cast< int8_t >( face ), .directions = static_cast< uint8_t >( 1u << ( face ^ 1 ) ) } );
+         }
+      }
+   }
+
+   while( !queue.empty() )
+   {
+      const Step step = queue.front();
+      queue.pop_front();
+
+      uint8_t& s = stateAt( step.pos );
+      if( !( s & SEEN ) )
+      {
+         s |= SEEN;
+         if( visit( step.pos ) )
+            s |= ACCEPTED;
+      }
+
+      if( !( s & ACCEPTED ) )
+         continue;
+
+      const SectionVisibility visibility = lookup( step.pos );
+      for( int face = 0; face < SectionVisibility::FACE_COUNT; ++face )
+      {
+         if( step.directions & ( 1u << ( face ^ 1 ) ) )
+            continue;
+         if( step.enteredFrom >= 0 && !visibility.FConnected( step.enteredFrom, face ) )
+            continue;
+
+         const SectionPos next { step.pos.x + offsets[ face ].x, step.pos.y + offsets[ face ].y, step.pos.z + offsets[ face ].z };
+         if( next.y < 0 || next.y >= SECTIONS_PER_CHUNK || std::abs( next.x - camera.x ) > radius || std::abs( next.z - camera.z ) > radius )
+            continue;
+
+         uint8_t& nextState = stateAt( next );
+         if( nextState & ( 1u << ( face ^ 1 ) ) )
+            continue;
+
+         nextState |= static_cast< uint8_t >( 1u << ( face ^ 1 ) );
+         queue.push_back( Step { .pos = next, .enteredFrom = static_cast< int8_t >( face ^ 1 ), .directions = static_cast< uint8_t >( step.directions | ( 1u << face ) ) } );
+      }
+   }
+}
@@ -0,0 +1,161 @@
+#include "TerrainGenerator.h"
+
+// ----------------------------------------------------------------
+// TerrainGenerator
+// ----------------------------------------------------------------
+TerrainGenerator::TerrainGenerator( uint64_t seed ) :
+   m_seed( seed )
+{
+   m_noise.SetSeed( static_cast< int >( seed ) );
+   m_noise.SetNoiseType( FastNoiseLite::NoiseType_Perlin );
+   m_noise.SetFrequency( 0.005f );
+   m_noise.SetFractalType( FastNoiseLite::FractalType_FBm );
+   m_noise.SetFractalOctaves( 5 );
+
+   m_forestNoise.SetSeed( static_cast< int >( seed ) + 1 );
+   m_forestNoise.SetNoiseType( FastNoiseLite::NoiseType_OpenSimplex2 );
+   m_forestNoise.SetFrequency( 0.01f );
+}
+
+
+ChunkSnapshot TerrainGenerator::Generate( const ChunkPos& cpos, std::span< const ChunkFeatureWrite > incoming, std::vector< FeatureSpill >* pSpill ) const
+{
+   std::array< std::shared_ptr< SectionBlocks >, SECTIONS_PER_CHUNK > sections {};
+   auto blockAt = [ & ]( int x, int y, int z ) -> BlockState&
+   {
+      auto& pSection = sections[ y / CHUNK_SECTION_SIZE ];
+      if( !pSection )
+         pSection = std::make_shared< SectionBlocks >();
+
+      const int ly = y % CHUNK_SECTION_SIZE;
+      return ( *pSection )[ static_cast< size_t >( x + ( z * CHUNK_SIZE_X ) + ( ly * CHUNK_SIZE_X * CHUNK_SIZE_Z ) ) ];
+   };
+   auto setBlock = [ & ]( int x, int y, int z, BlockId id ) { blockAt( x, y, z ) = BlockState( id ); };
+
+   const int baseX = cpos.x * CHUNK_SIZE_X;
+   const int baseZ = cpos.z * CHUNK_SIZE_Z;
+   for( int z = 0; z < CHUNK_SIZE_Z; ++z )
+   {
+      for( int x = 0; x < CHUNK_SIZE_X; ++x )
+      {
+         const int columnHeight = ColumnHeight( baseX + x, baseZ + z );
+         for( int y = 0; y <= columnHeight; ++y )
+         {
+            BlockId id { BlockId::Air };
+            if( y == 0 )
+               id = BlockId::Bedrock;
+            else if( y < columnHeight - 4 )
+               id = BlockId::Stone;
+            else
+               id = BlockId::Dirt;
+
+            setBlock( x, y, z, id );
+         }
+      }
+   }
+
+   // Trees: a feature only ever writes through here, so its blocks outside this chunk become spill
+   auto placeOverAir = [ & ]( int wx, int y, int wz, BlockId id )
+   {
+      if( y < 0 || y >= CHUNK_SIZE_Y )
+         return;
+
+      const int lx = wx - baseX, lz = wz - baseZ;
+      if( lx >= 0 && lx < CHUNK_SIZE_X && lz >= 0 && lz < CHUNK_SIZE_Z )
+      {
+         BlockState& state = blockAt( lx, y, lz );
+         if( state.GetId() == BlockId::Air )
+            state = BlockState( id );
+      }
+      else if( pSpill )
+      {
+         const ChunkPos target { cpos.x + ( lx < 0 ? -1 : lx >= CHUNK_SIZE_X ? 1 : 0 ), cpos.z + ( lz < 0 ? -1 : lz >= CHUNK_SIZE_Z ? 1 : 0 ) };
+         pSpill->push_back( FeatureSpill { .target = target,
+                                           .write  = ChunkFeatureWrite { .x     = static_cast< uint8_t >( wx - target.x * CHUNK_SIZE_X ),
+                                                                         .y     = static_cast< uint8_t >( y ),
+                                                                         .z     = static_cast< uint8_t >( wz - target.z * CHUNK_SIZE_Z ),
+                                                                         .state = BlockState( id ) } } );
+      }
+   };
+
+   const float density = std::clamp( m_forestNoise.GetNoise( static_cast< float >( baseX ), static_cast< float >( baseZ ) ), 0.0f, 1.0f );
+   const int   trees   = static_cast< int >( density * TREE_MAX_PER_CHUNK );
+   TickRng     rng( m_seed ^ ( ChunkPosHash {}( cpos ) * 0xC2B2AE3D27D4EB4Full ) );
+   for( int tree = 0; tree < trees; ++tree )
+   {
+      const int lx     = static_cast< int >( rng.NextBelow( CHUNK_SIZE_X ) );
+      const int lz     = static_cast< int >( rng.NextBelow( CHUNK_SIZE_Z ) );
+      const int height = 4 + static_cast< int >( rng.NextBelow( 3 ) );
+      const int rootY  = ColumnHeight( baseX + lx, baseZ + lz ) + 1;
+      if( rootY + height + 1 >= CHUNK_SIZE_Y || blockAt( lx, rootY, lz ).GetId() != BlockId::Air )
+         continue;
+
+      for( int dy = 0; dy < height; ++dy )
+         setBlock( lx, rootY + dy, lz, BlockId::Log );
+
+      // Two wide layers around the top of the trunk, then two narrow ones above them
+      for( int dy = height - 2; dy <= height + 1; ++dy )
+      {
+         const int radius = dy < height ? TREE_CANOPY_RADIUS : 1;
+         for( int dx = -radius; dx <= radius; ++dx )
+         {
+            for( int dz = -radius; dz <= radius; ++dz )
+            {
+               if( std::abs( dx ) == radius && std::abs( dz ) == radius && radius == TREE_CANOPY_RADIUS )
+                  continue; // round off the corners
+
+               placeOverAir( baseX + lx + dx, rootY + dy, baseZ + lz + dz, BlockId::Leaves );
+            }
+         }
+      }
+   }
+
+   for( const ChunkFeatureWrite& write : incoming )
+   {
+      BlockState& state = blockAt( write.x, write.y, write.z );
+      if( state.GetId() == BlockId::Air )
+         state = write.state;
+   }
+
+   ChunkSnapshot snapshot { .cpos = cpos };
+   std::ranges::move( sections, snapshot.sections.begin() );
+   return snapshot;
+}
+
+
+bool TerrainGenerator::FMatchesGenerated( const ChunkSnapshot& snapshot ) const
+{
+   static const SectionBlocks s_air {};
+
+   // Generation never schedules ticks
+   if( !snapshot.ticks.empty() )
+      return false;
+
+   // Blocks spilled in from neighbors' features are not reproduced, so chunks holding them never match.
+   // Chunks whose own features spill never match either: regenerating one delivers its spill again, into
+   // neighbors that may have been edited since (leaves grown back where the player mined them).
+   std::vector< FeatureSpill > spill;
+   const ChunkSnapshot         generated = Generate( snapshot.cpos, {}, &spill );
+   if( !spill.empty() )
+      return false;
+
+   for( const auto& [ i, pBlocks ] : snapshot.sections | std::views::enumerate )
+   {
+      const SectionBlocks& lhs = pBlocks ? *pBlocks : s_air;
+      const SectionBlocks& rhs = generated.sections[ i ] ? *generated.sections[ i ] : s_air;
+      if( lhs != rhs )
+         return false;
+   }
+
+   return true;
+}
+
+
+int TerrainGenerator::ColumnHeight( int wx, int wz ) const noexcept
+{
+   const int minHeight   = 32;
+   const int maxHeight   = 128;
+   const int heightRange = maxHeight - minHeight;
+   float     noise       = ( m_noise.GetNoise( static_cast< float >( wx ), static_cast< float >( wz ) ) * 0.5f ) + 0.5f;
+   return std::clamp( static_cast< int >( noise * heightRange ), minHeight, CHUNK_SIZE_Y - 1 );
+}
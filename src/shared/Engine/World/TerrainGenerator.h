@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Engine/World/Level.h>
+
+#include <FastNoiseLite/FastNoiseLite.h>
+
+// ----------------------------------------------------------------
+// TerrainGenerator - seed-only chunk generation, usable without a Level
+// ----------------------------------------------------------------
+// Generate is const and only reads the noise state, so one generator can be shared across threads.
+//
+// Features (trees) are rooted in the chunk being generated but may reach across its border. Those blocks
+// are never written into the neighbor; they are returned as spill for the caller to deliver, and a chunk
+// is generated together with whatever its neighbors spilled into it earlier.
+class TerrainGenerator
+{
+public:
+   explicit TerrainGenerator( uint64_t seed );
+
+   // `incoming` is applied over air once the chunk's own terrain and features are in place.
+   // Feature blocks outside `cpos` go to `pSpill`, or are dropped when it is null.
+   ChunkSnapshot Generate( const ChunkPos& cpos, std::span< const ChunkFeatureWrite > incoming = {}, std::vector< FeatureSpill >* pSpill = nullptr ) const;
+
+   // True when `snapshot` holds exactly what Generate would produce for its position, and generating it
+   // again would not spill anything into its neighbors, so dropping it and regenerating it later is lossless
+   bool FMatchesGenerated( const ChunkSnapshot& snapshot ) const;
+
+private:
+   NO_COPY_MOVE( TerrainGenerator )
+
+   static constexpr int TREE_MAX_PER_CHUNK = 12;
+   static constexpr int TREE_CANOPY_RADIUS = 2;
+
+   int ColumnHeight( int wx, int wz ) const noexcept;
+
+   uint64_t      m_seed;
+   FastNoiseLite m_noise;
+   FastNoiseLite m_forestNoise; // tree density
+};
@@ -0,0 +1,206 @@
+#include "WorldBackup.h"
+
+// ----------------------------------------------------------------
+// WorldBackup
+// ----------------------------------------------------------------
+WorldBackup::WorldBackup( std::filesystem::path        worldDir,
+                          std::filesystem::path        archivePath,
+                          const World::WorldMeta&      meta,
+                          std::vector< ChunkSnapshot > captured,
+                          std::vector< std::byte >     pendingFeatures,
+                          size_t                       maxBytesPerSecond ) :
+   m_worldDir( std::move( worldDir ) ),
+   m_archivePath( std::move( archivePath ) ),
+   m_meta( meta ),
+   m_maxBytesPerSecond( maxBytesPerSecond ),
+   m_captured( std::move( captured ) ),
+   m_pendingFeatures( std::move( pendingFeatures ) ),
+   m_start( std::chrono::steady_clock::now() )
+{
+   for( const ChunkSnapshot& snapshot : m_captured )
+      m_archived.insert( snapshot.cpos );
+
+   m_worker = std::jthread( [ this ]( std::stop_token stopToken ) { Run( stopToken ); } );
+}
+
+
+WorldBackup::~WorldBackup()
+{
+   m_worker.request_stop();
+}
+
+
+void WorldBackup::OnChunkLoaded( const Chunk& chunk )
+{
+   const ChunkPos  cpos = chunk.GetChunkPos();
+   std::lock_guard lock( m_mutex );
+   if( m_archived.contains( cpos ) || m_generated.contains( cpos ) || m_loaded.contains( cpos ) )
+      return;
+
+   // Nothing could have modified the chunk between the snapshot point and this load, so this is its snapshot state
+   m_loaded.emplace( cpos, chunk.Snapshot() );
+}
+
+
+void WorldBackup::OnChunkGenerated( const ChunkPos& cpos )
+{
+   std::lock_guard lock( m_mutex );
+   m_generated.insert( cpos );
+}
+
+
+void WorldBackup::Run( std::stop_token stopToken )
+{
+   std::filesystem::path tmpPath = m_archivePath;
+   tmpPath += ".tmp";
+
+   std::error_code ec;
+   std::filesystem::create_directories( m_archivePath.parent_path(), ec );
+
+   std::ofstream out( tmpPath, std::ios::binary | std::ios::trunc );
+   ArchiveHeader header { .meta = m_meta };
+   out.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+   bool fOk = out.good();
+
+   // Chunks that were loaded or waiting on the save queue at the snapshot point
+   for( ChunkSnapshot& snapshot : m_captured )
+   {
+      if( !fOk )
+         break;
+
+      fOk      = FWriteChunk( out, snapshot.Coord3(), snapshot.Encode(), stopToken );
+      snapshot = {}; // release the section storage as soon as it has been archived
+   }
+   m_captured.clear();
+
+   // Chunks that only existed on disk. Files written after the snapshot point either belong to chunks
+   // captured above, chunks generated since, or chunks whose snapshot-point state was recorded on load.
+   if( fOk )
+   {
+      for( const World::ChunkPos3& cpos3 : World::WorldSave::ListChunks( m_worldDir ) )
+      {
+         const ChunkPos cpos { cpos3.x, cpos3.z };
+         {
+            std::lock_guard lock( m_mutex );
+            if( m_archived.contains( cpos ) || m_generated.contains( cpos ) )
+               continue;
+         }
+
+         std::vector< std::byte > bytes;
+         const bool               fRead = World::WorldSave::FLoadChunkBytes( m_worldDir, cpos3, bytes );
+         {
+            std::lock_guard lock( m_mutex );
+            if( auto it = m_loaded.find( cpos ); it != m_loaded.end() )
+            {
+               bytes = it->second.Encode();
+               m_loaded.erase( it );
+            }
+            else if( !fRead )
+               continue;
+
+            m_archived.insert( cpos );
+         }
+
+         fOk = FWriteChunk( out, cpos3, bytes, stopToken );
+         if( !fOk )
+            break;
+      }
+   }
+
+   // Pending feature writes as of the snapshot point, after the chunks they will land in
+   if( fOk )
+   {
+      const uint64_t featureBytes = m_pendingFeatures.size();
+      out.write( reinterpret_cast< const char* >( &featureBytes ), sizeof( featureBytes ) );
+      out.write( reinterpret_cast< const char* >( m_pendingFeatures.data() ), static_cast< std::streamsize >( m_pendingFeatures.size() ) );
+      fOk = out.good();
+      m_bytesWritten.fetch_add( sizeof( featureBytes ) + m_pendingFeatures.size(), std::memory_order_relaxed );
+   }
+
+   // Patch the final chunk count into the header
+   header.chunkCount = m_chunksWritten.load( std::memory_order_relaxed );
+   out.seekp( 0 );
+   out.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+   fOk = fOk && out.good();
+   out.close();
+
+   if( fOk )
+      std::filesystem::rename( tmpPath, m_archivePath, ec );
+   if( !fOk || ec )
+   {
+      std::filesystem::remove( tmpPath, ec );
+      fOk = false;
+   }
+
+   m_fSucceeded.store( fOk, std::memory_order_release );
+   m_fDone.store( true, std::memory_order_release );
+}
+
+
+bool WorldBackup::FWriteChunk( std::ofstream& out, const World::ChunkPos3& cpos, std::span< const std::byte > bytes, std::stop_token stopToken )
+{
+   const ChunkHeader chunkHeader { .cpos = cpos, .size = static_cast< uint32_t >( bytes.size() ) };
+   out.write( reinterpret_cast< const char* >( &chunkHeader ), sizeof( chunkHeader ) );
+   out.write( reinterpret_cast< const char* >( bytes.data() ), static_cast< std::streamsize >( bytes.size() ) );
+   if( !out.good() )
+      return false;
+
+   m_chunksWritten.fetch_add( 1, std::memory_order_relaxed );
+   const uint64_t written = m_bytesWritten.fetch_add( sizeof( chunkHeader ) + bytes.size(), std::memory_order_relaxed ) + sizeof( chunkHeader ) + bytes.size();
+
+   // Throttle to the configured average rate so the backup never competes with autosave for the disk
+   if( m_maxBytesPerSecond > 0 )
+   {
+      using Clock    = std::chrono::steady_clock;
+      const auto due = m_start + std::chrono::duration_cast< Clock::duration >(
+                                    std::chrono::duration< double >( static_cast< double >( written ) / static_cast< double >( m_maxBytesPerSecond ) ) );
+      for( auto now = Clock::now(); now < due && !stopToken.stop_requested(); now = Clock::now() )
+         std::this_thread::sleep_for( ( std::min )( Clock::duration( due - now ), Clock::duration( std::chrono::milliseconds( 50 ) ) ) );
+   }
+
+   return !stopToken.stop_requested();
+}
+
+
+/*static*/ std::optional< WorldBackup::Contents > WorldBackup::Read( const std::filesystem::path& archivePath )
+{
+   std::ifstream in( archivePath, std::ios::binary );
+   if( !in )
+      return std::nullopt;
+
+   ArchiveHeader header;
+   in.read( reinterpret_cast< char* >( &header ), sizeof( header ) );
+   if( !in.good() || header.magic != MAGIC || header.version < 1 || header.version > VERSION )
+      return std::nullopt;
+
+   Contents contents { .meta = header.meta };
+   for( uint64_t i = 0; i < header.chunkCount; ++i )
+   {
+      ChunkHeader chunkHeader;
+      in.read( reinterpret_cast< char* >( &chunkHeader ), sizeof( chunkHeader ) );
+      if( !in.good() )
+         return std::nullopt;
+
+      std::vector< std::byte > bytes( chunkHeader.size );
+      in.read( reinterpret_cast< char* >( bytes.data() ), static_cast< std::streamsize >( bytes.size() ) );
+      if( !in.good() )
+         return std::nullopt;
+
+      contents.chunks.insert_or_assign( ChunkPos { chunkHeader.cpos.x, chunkHeader.cpos.z }, std::move( bytes ) );
+   }
+
+   if( header.version >= 2 )
+   {
+      uint64_t featureBytes = 0;
+      in.read( reinterpret_cast< char* >( &featureBytes ), sizeof( featureBytes ) );
+      if( !in.good() )
+         return std::nullopt;
+
+      contents.pendingFeatures.resize( featureBytes );
+      in.read( reinterpret_cast< char* >( contents.pendingFeatures.data() ), static_cast< std::streamsize >( featureBytes ) );
+      if( !in.good() )
+         return std::nullopt;
+   }
+
+   return contents;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Engine/World/Level.h>
+
+// ----------------------------------------------------------------
+// WorldBackup - streams a consistent point-in-time copy of a live world into a single archive
+// ----------------------------------------------------------------
+//
+// The snapshot point is the tick at which the backup is constructed. Chunks that are loaded or waiting
+// on the save queue are captured right there (copy-on-write, no block copies). Chunks that only exist
+// on disk cannot change until they are loaded, so the level reports each load while the backup runs
+// and the first loaded state wins over whatever is on disk by the time the backup thread reaches it.
+// Pending feature writes (features.bin) are captured at the snapshot point too, since they hold blocks of
+// chunks that have not been generated yet.
+//
+// Archive layout:
+//   ArchiveHeader
+//   ChunkHeader + encoded chunk bytes, repeated ArchiveHeader::chunkCount times
+//   version 2: uint64 size + the pending feature writes in the features.bin layout
+class WorldBackup
+{
+public:
+   static constexpr uint32_t MAGIC   = 0x4257474F; // "OGWB"
+   static constexpr uint32_t VERSION = 2;
+
+   struct ArchiveHeader
+   {
+      uint32_t         magic { MAGIC };
+      uint32_t         version { VERSION };
+      World::WorldMeta meta {}; // meta.tick is the snapshot tick
+      uint64_t         chunkCount { 0 };
+   };
+
+   struct ChunkHeader
+   {
+      World::ChunkPos3 cpos {};
+      uint32_t         size { 0 };
+   };
+
+   WorldBackup( std::filesystem::path worldDir, std::filesystem::path archivePath, const World::WorldMeta& meta, std::vector< ChunkSnapshot > captured, std::vector< std::byte > pendingFeatures, size_t maxBytesPerSecond );
+   ~WorldBackup();
+
+   // Called on the game thread for every chunk the level loads or generates while the backup runs
+   void OnChunkLoaded( const Chunk& chunk );
+   void OnChunkGenerated( const ChunkPos& cpos );
+
+   bool     FDone() const noexcept { return m_fDone.load( std::memory_order_acquire ); }
+   bool     FSucceeded() const noexcept { return m_fSucceeded.load( std::memory_order_acquire ); }
+   uint64_t SnapshotTick() const noexcept { return m_meta.tick; }
+   uint64_t ChunksWritten() const noexcept { return m_chunksWritten.load( std::memory_order_relaxed ); }
+   uint64_t BytesWritten() const noexcept { return m_bytesWritten.load( std::memory_order_relaxed ); }
+
+   const std::filesystem::path& ArchivePath() const noexcept { return m_archivePath; }
+
+   // Reads an archive back into memory (restore/verification)
+   struct Contents
+   {
+      World::WorldMeta                                                 meta {};
+      std::unordered_map< ChunkPos, std::vector< std::byte >, ChunkPosHash > chunks;
+      std::vector< std::byte >                                         pendingFeatures; // empty for version 1 archives
+   };
+   static std::optional< Contents > Read( const std::filesystem::path& archivePath );
+
+private:
+   NO_COPY_MOVE( WorldBackup )
+
+   void Run( std::stop_token stopToken );
+   bool FWriteChunk( std::ofstream& out, const World::ChunkPos3& cpos, std::span< const std::byte > bytes, std::stop_token stopToken );
+
+   const std::filesystem::path m_worldDir;
+   const std::filesystem::path m_archivePath;
+   const World::WorldMeta      m_meta;
+   const size_t                m_maxBytesPerSecond;
+
+   std::vector< ChunkSnapshot > m_captured;        // owned by the backup thread
+   std::vector< std::byte >     m_pendingFeatures; // likewise
+
+   // Disk-only chunks at the snapshot point that were loaded before the backup thread archived them
+   std::mutex                                                  m_mutex;
+   std::unordered_map< ChunkPos, ChunkSnapshot, ChunkPosHash > m_loaded;
+   std::unordered_set< ChunkPos, ChunkPosHash >                m_archived;  // captured or already written
+   std::unordered_set< ChunkPos, ChunkPosHash >                m_generated; // did not exist at the snapshot point
+
+   std::chrono::steady_clock::time_point m_start;
+   std::atomic< uint64_t >               m_chunksWritten { 0 };
+   std::atomic< uint64_t >               m_bytesWritten { 0 };
+   std::atomic< bool >                   m_fDone { false };
+   std::atomic< bool >                   m_fSucceeded { false };
+
+   std::jthread m_worker; // declared last so it stops before the state it uses is destroyed
+};
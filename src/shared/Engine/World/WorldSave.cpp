@@ -9,6 +9,7 @@ enum class SaveKind : uint16_t
    Player,
    Chunk,
    Entity,
+   Features,
    Count // Keep as last, new entries should be inserted before this
 };
 
@@ -21,10 +22,11 @@ struct Directory
 
 static constexpr std::string_view SavesDirectory = "saves";
 static constexpr std::array       Directories    = {
-   Directory { .kind = SaveKind::Meta,   .directory = "",         .filePattern = "meta.bin"           },
-   Directory { .kind = SaveKind::Player, .directory = "",         .filePattern = "player.dat"         },
-   Directory { .kind = SaveKind::Chunk,  .directory = "chunks",   .filePattern = "chunk_{}_{}_{}.bin" },
-   Directory { .kind = SaveKind::Entity, .directory = "entities", .filePattern = "entity_{}.ent"      },
+   Directory { .kind = SaveKind::Meta,     .directory = "",         .filePattern = "meta.bin"           },
+   Directory { .kind = SaveKind::Player,   .directory = "",         .filePattern = "player.dat"         },
+   Directory { .kind = SaveKind::Chunk,    .directory = "chunks",   .filePattern = "chunk_{}_{}_{}.bin" },
+   Directory { .kind = SaveKind::Entity,   .directory = "entities", .filePattern = "entity_{}.ent"      },
+   Directory { .kind = SaveKind::Features, .directory = "",         .filePattern = "features.bin"       },
 };
 
 
@@ -64,12 +66,22 @@ static void EnsureDirectories( const std::filesystem::path& worldDir )
 
 static bool FWriteAllBytes( const std::filesystem::path& path, std::span< const std::byte > bytes )
 {
-   std::ofstream out( path, std::ios::binary | std::ios::trunc );
-   if( !out )
-      return false;
+   // Write next to the target and swap it in, so readers (loads, online backups) never see a torn file.
+   std::filesystem::path tmpPath = path;
+   tmpPath += ".tmp";
+   {
+      std::ofstream out( tmpPath, std::ios::binary | std::ios::trunc );
+      if( !out )
+         return false;
+
+      out.write( reinterpret_cast< const char* >( bytes.data() ), static_cast< std::streamsize >( bytes.size() ) );
+      if( !out.good() )
+         return false;
+   }
 
-   out.write( reinterpret_cast< const char* >( bytes.data() ), static_cast< std::streamsize >( bytes.size() ) );
-   return out.good();
+   std::error_code ec;
+   std::filesystem::rename( tmpPath, path, ec );
+   return !ec;
 }
 
 
@@ -182,4 +194,77 @@ static T Deserialize( std::span< const std::byte > bytes )
 }
 
 
+/*static*/ std::filesystem::path WorldSave::ChunkPath( const std::filesystem::path& worldDir, const ChunkPos3& cpos )
+{
+   return Path( worldDir, SaveKind::Chunk, cpos.x, cpos.y, cpos.z );
+}
+
+
+/*static*/ bool WorldSave::FDeleteChunkFile( const std::filesystem::path& worldDir, const ChunkPos3& cpos )
+{
+   std::error_code ec;
+   return std::filesystem::remove( Path( worldDir, SaveKind::Chunk, cpos.x, cpos.y, cpos.z ), ec );
+}
+
+
+// Pending feature writes
+/*static*/ bool WorldSave::FSaveFeatureBytes( const std::filesystem::path& worldDir, std::span< const std::byte > bytes )
+{
+   EnsureDirectories( worldDir );
+   return FWriteAllBytes( Path( worldDir, SaveKind::Features ), bytes );
+}
+
+
+/*static*/ bool WorldSave::FLoadFeatureBytes( const std::filesystem::path& worldDir, std::vector< std::byte >& outBytes )
+{
+   return FReadAllBytes( Path( worldDir, SaveKind::Features ), outBytes );
+}
+
+
+/*static*/ std::vector< ChunkPos3 > WorldSave::ListChunks( const std::filesystem::path& worldDir )
+{
+   std::vector< ChunkPos3 > chunks;
+
+   std::error_code ec;
+   for( const auto& entry : std::filesystem::directory_iterator( worldDir / Directories[ static_cast< size_t >( SaveKind::Chunk ) ].directory, ec ) )
+   {
+      // Mirrors the "chunk_{}_{}_{}.bin" file pattern
+      ChunkPos3         cpos;
+      const std::string name     = entry.path().filename().string();
+      int               consumed = 0;
+      if( std::sscanf( name.c_str(), "chunk_%d_%d_%d.bin%n", &cpos.x, &cpos.y, &cpos.z, &consumed ) == 3 && consumed == static_cast< int >( name.size() ) )
+         chunks.push_back( cpos );
+   }
+
+   return chunks;
+}
+
+
+/*static*/ size_t WorldSave::RemoveTempFiles( const std::filesystem::path& worldDir )
+{
+   size_t                       removed = 0;
+   std::set< std::string_view > visited;
+   for( const Directory& dir : Directories )
+   {
+      if( !visited.insert( dir.directory ).second )
+         continue;
+
+      std::error_code ec;
+      for( const auto& entry : std::filesystem::directory_iterator( worldDir / dir.directory, ec ) )
+      {
+         if( entry.path().extension() == ".tmp" && std::filesystem::remove( entry.path(), ec ) )
+            ++removed;
+      }
+   }
+
+   return removed;
+}
+
+
+/*static*/ std::filesystem::path WorldSave::BackupPath( const std::filesystem::path& worldDir, uint64_t tick )
+{
+   return worldDir.parent_path() / "backups" / std::format( "{}_{}.wbak", worldDir.filename().string(), tick );
+}
+
+
 } // namespace World
@@ -47,6 +47,22 @@ public:
 
    static bool FSaveChunkBytes( const std::filesystem::path& worldDir, const ChunkPos3& cpos, std::span< const std::byte > bytes );
    static bool FLoadChunkBytes( const std::filesystem::path& worldDir, const ChunkPos3& cpos, std::vector< std::byte >& outBytes );
+
+   static std::filesystem::path ChunkPath( const std::filesystem::path& worldDir, const ChunkPos3& cpos );
+   static bool                  FDeleteChunkFile( const std::filesystem::path& worldDir, const ChunkPos3& cpos );
+
+   // Feature blocks generated into chunks that did not exist yet (see PendingFeatureWrites)
+   static bool FSaveFeatureBytes( const std::filesystem::path& worldDir, std::span< const std::byte > bytes );
+   static bool FLoadFeatureBytes( const std::filesystem::path& worldDir, std::vector< std::byte >& outBytes );
+
+   // Every chunk that currently has a file in the world directory
+   static std::vector< ChunkPos3 > ListChunks( const std::filesystem::path& worldDir );
+
+   // Removes temporary files left behind by interrupted writes. Only safe while no writer is running.
+   static size_t RemoveTempFiles( const std::filesystem::path& worldDir );
+
+   // Default archive location for an online backup taken at `tick` (outside the world directory)
+   static std::filesystem::path BackupPath( const std::filesystem::path& worldDir, uint64_t tick );
 };
 
 } // namespace World
@@ -27,6 +27,8 @@ constexpr float PLAYER_EYE_HEIGHT = 1.62f;
 constexpr float GROUND_MAXSPEED   = 4.3f;
 constexpr float SPRINT_MODIFIER   = 1.3f;
 
+constexpr uint8_t VIEW_RADIUS = 8; // chunks
+
 static void MouseLookSystem( Entity::Registry& registry, Window& window )
 {
    for( auto [ look ] : registry.CView< CLookInput >() )
@@ -473,6 +475,15 @@ void InGameState::OnEnter()
    {
       if( e.GetKeyCode() == Input::KeyCode::R )
          registry.Get< CTransform >( m_player ).position.y += 64;
+
+      // Manual online backup; the level reports where it was written once it finishes
+      if( e.GetKeyCode() == Input::KeyCode::F9 && m_pLevel )
+      {
+         if( m_pLevel->FBeginBackup() )
+            std::println( "Backup of tick {} started", m_pLevel->GetTick() );
+         else
+            std::println( "A backup is already running" );
+      }
    } );
 
    m_events.Subscribe< Events::MouseButtonPressedEvent >( [ this, &registry ]( const Events::MouseButtonPressedEvent& e ) noexcept
@@ -534,7 +545,7 @@ void InGameState::Update( float dt )
    if( CTransform* pPlayerTran = registry.TryGet< CTransform >( m_player ) )
    {
       const glm::vec3 interpolatedPos = glm::mix( pPlayerTran->prevPosition, pPlayerTran->position, alpha );
-      m_pRenderSystem->Update( interpolatedPos, 8 );
+      m_pRenderSystem->Update( interpolatedPos, VIEW_RADIUS );
    }
 }
 
@@ -557,6 +568,8 @@ void InGameState::FixedUpdate( float tickInterval )
    ItemDropSystem( registry, tickInterval );
    PhysicsSystem( registry, *m_pLevel, tickInterval );
 
+   m_pLevel->Update( tickInterval );
+
    // Collect generic collisions and let gameplay consume them.
    Engine::Physics::CollectEntityAABBCollisions( registry, g_collisionEvents );
    ProjectileDamageSystem( registry, g_collisionEvents );
@@ -0,0 +1,197 @@
+#include "pch_server.h"
+
+#include "ArenaBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/Renderer/NullRenderDevice.h>
+#include <Engine/World/ChunkMeshArena.h>
+#include <Engine/World/Level.h>
+#include <Engine/World/RangeAllocator.h>
+
+namespace Tools
+{
+
+ArenaBenchReport BenchArena( const ArenaBenchOptions& options )
+{
+   ArenaBenchReport report;
+   auto             check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   // Fixed cases
+   {
+      RangeAllocator allocator( 100 );
+      const auto     a = allocator.Allocate( 30 );
+      const auto     b = allocator.Allocate( 10 );
+      const auto     c = allocator.Allocate( 20 );
+      const auto     d = allocator.Allocate( 10 );
+      check( a == 0u && b == 30u && c == 40u && d == 60u );
+
+      // A freed range is handed out again, and the smallest fitting range is preferred over the tail
+      allocator.Free( *b );
+      check( allocator.Allocate( 10 ) == 30u );
+      allocator.Free( *c );
+      check( allocator.Allocate( 15 ) == 40u && allocator.GetFreeRangeCount() == 2 );
+
+      check( !allocator.Allocate( 31 ) );
+      check( allocator.GetFragmentation() > 0.0f );
+
+      // Packing slides the 10 at 60 down against the 15 at 40
+      const std::vector< RangeAllocator::Move > moves = allocator.Compact();
+      check( moves.size() == 1 && moves[ 0 ].from == 60 && moves[ 0 ].to == 55 && moves[ 0 ].size == 10 );
+      check( allocator.GetFreeRangeCount() == 1 && allocator.GetLargestFree() == 35 && allocator.GetFragmentation() == 0.0f );
+
+      // Growing extends the free tail rather than adding a range beside it
+      allocator.Grow( 200 );
+      check( allocator.GetFreeRangeCount() == 1 && allocator.GetLargestFree() == 135 );
+
+      // Freeing everything, in an order that needs merges on both sides, leaves one range
+      for( const uint32_t offset : { 30u, 0u, 55u, 40u } )
+         allocator.Free( offset );
+      check( allocator.GetUsed() == 0 && allocator.GetFreeRangeCount() == 1 && allocator.GetLargestFree() == 200 );
+   }
+
+   // Random churn around a steady number of live meshes, like sections being rebuilt while the player moves, through
+   // the real ChunkMeshArena against the null device. Sizes follow a section mesh: mostly small, occasionally a few
+   // thousand quads.
+   constexpr size_t   TARGET_LIVE   = 2000;
+   constexpr uint32_t VERTEX_STRIDE = sizeof( uint32_t );
+
+   // Declared before the arena, which frees its buffers through the current device when it is destroyed
+   NullRenderDevice         device;
+   const ScopedRenderDevice scopedDevice( device );
+
+   const uint32_t                               startIndices = ( std::max )( options.capacity / 4 * 6, 6u );
+   ChunkMeshArena                               arena( VERTEX_STRIDE, options.capacity, startIndices );
+   const uint64_t                               baseMemory = device.GetBufferMemory(); // the arena creates its buffers with the first mesh
+   std::vector< uint32_t >                      scratch( 4000 * 6 );                   // vertex and index data; only sizes matter here
+   std::map< ChunkMeshArena::Handle, uint32_t > shadow;                                // handle -> quads, what should be live
+   std::vector< ChunkMeshArena::Handle >        live;                                  // for picking one to free
+   TickRng                                      rng( options.seed );
+   bool                                         fConsistent      = true;
+   double                                       fragmentationSum = 0.0;
+
+   // Live ranges must lie inside the buffers without overlapping, and keep the sizes they were allocated with
+   auto fRangesValid = [ & ]()
+   {
+      std::vector< std::pair< uint32_t, uint32_t > > vertices, indices;
+      for( const auto& [ handle, quads ] : shadow )
+      {
+         const ChunkMeshArena::Range& range = arena.GetRange( handle );
+         if( range.vertexCount != quads * 4 || range.indexCount != quads * 6 )
+            return false;
+
+         vertices.emplace_back( range.firstVertex, range.vertexCount );
+         indices.emplace_back( range.firstIndex, range.indexCount );
+      }
+
+      auto fDisjoint = []( std::vector< std::pair< uint32_t, uint32_t > >& ranges, uint32_t capacity )
+      {
+         std::ranges::sort( ranges );
+         uint32_t end = 0;
+         for( const auto& [ first, count ] : ranges )
+         {
+            if( first < end || static_cast< uint64_t >( first ) + count > capacity )
+               return false;
+            end = first + count;
+         }
+         return true;
+      };
+      return fDisjoint( vertices, arena.GetVertexAllocator().GetCapacity() ) && fDisjoint( indices, arena.GetIndexAllocator().GetCapacity() );
+   };
+
+   // Only the arena's own calls are timed, not the checking around them
+   using Clock      = std::chrono::steady_clock;
+   double elapsedNs = 0.0;
+   auto   timed     = [ &elapsedNs ]( auto&& fn )
+   {
+      const auto start = Clock::now();
+      fn();
+      elapsedNs += std::chrono::duration< double, std::nano >( Clock::now() - start ).count();
+   };
+
+   for( int op = 0; op < options.operations; ++op )
+   {
+      if( live.empty() || rng.NextBelow( 100 ) < ( live.size() < TARGET_LIVE ? 70u : 30u ) )
+      {
+         const uint32_t quads = rng.NextBelow( 8 ) == 0 ? 250 + rng.NextBelow( 3000 ) : 6 + rng.NextBelow( 375 );
+
+         const uint32_t generation     = arena.GetGeneration();
+         const uint32_t vertexCapacity = arena.GetVertexAllocator().GetCapacity();
+         const uint32_t indexCapacity  = arena.GetIndexAllocator().GetCapacity();
+         const uint64_t liveBytes      = static_cast< uint64_t >( arena.GetVertexAllocator().GetUsed() ) * VERTEX_STRIDE +
+                                    static_cast< uint64_t >( arena.GetIndexAllocator().GetUsed() ) * sizeof( uint32_t );
+
+         device.Reset();
+         ChunkMeshArena::Handle handle = ChunkMeshArena::INVALID_HANDLE;
+         timed( [ & ] { handle = arena.Allocate( scratch.data(), quads * 4, std::span( scratch ).first( quads * 6 ) ); } );
+
+         // A replaced pair of buffers must be packed, at least half empty once this mesh is in, and no bigger than
+         // that needs; the old live data is copied across and the old buffers are gone. The first mesh creates the
+         // buffers, which is not a rebuild.
+         const uint32_t rebuilds = arena.GetGeneration() - generation - ( generation == 0 ? 1 : 0 );
+         if( rebuilds > 0 )
+         {
+            report.compactions += rebuilds;
+            report.grows += arena.GetVertexAllocator().GetCapacity() != vertexCapacity || arena.GetIndexAllocator().GetCapacity() != indexCapacity ? 1 : 0;
+
+            auto fPolicy = []( const RangeAllocator& allocator, uint32_t before )
+            {
+               const uint32_t capacity = allocator.GetCapacity();
+               const bool     fHalf    = allocator.GetUsed() <= capacity / 2;
+               const bool     fTight   = capacity == before || allocator.GetUsed() > capacity / 4;
+               return capacity >= before && fHalf && fTight && allocator.GetFragmentation() == 0.0f;
+            };
+            fConsistent &= fPolicy( arena.GetVertexAllocator(), vertexCapacity ) && fPolicy( arena.GetIndexAllocator(), indexCapacity );
+
+            uint64_t copied = 0;
+            for( const RenderCommand& command : device.GetCommands() )
+               copied += command.type == RenderCommand::Type::CopyBuffer ? command.bytes : 0;
+            fConsistent &= copied == liveBytes;
+            fConsistent &= device.GetBufferMemory() - baseMemory ==
+                           static_cast< uint64_t >( arena.GetVertexAllocator().GetCapacity() ) * VERTEX_STRIDE +
+                              static_cast< uint64_t >( arena.GetIndexAllocator().GetCapacity() ) * sizeof( uint32_t );
+         }
+         else
+            fConsistent &= arena.GetVertexAllocator().GetCapacity() == vertexCapacity && arena.GetIndexAllocator().GetCapacity() == indexCapacity;
+
+         // Handles are reused, so one still live would mean two meshes share it
+         fConsistent &= !shadow.contains( handle );
+         shadow.insert_or_assign( handle, quads );
+         live.push_back( handle );
+      }
+      else
+      {
+         const size_t pick = rng.NextBelow( static_cast< uint32_t >( live.size() ) );
+         timed( [ & ] { arena.Free( live[ pick ] ); } );
+         shadow.erase( live[ pick ] );
+         live[ pick ] = live.back();
+         live.pop_back();
+      }
+
+      if( op % 1024 == 0 )
+      {
+         uint32_t quads = 0;
+         for( const auto& [ _, q ] : shadow )
+            quads += q;
+         fConsistent &= quads * 4 == arena.GetVertexAllocator().GetUsed() && quads * 6 == arena.GetIndexAllocator().GetUsed() && fRangesValid();
+      }
+
+      const RangeAllocator& vertices = arena.GetVertexAllocator();
+      report.peakUsed          = ( std::max )( report.peakUsed, vertices.GetUsed() );
+      report.peakFragmentation = ( std::max )( report.peakFragmentation, vertices.GetFragmentation() );
+      fragmentationSum += vertices.GetFragmentation();
+   }
+   check( fConsistent && fRangesValid() );
+   check( options.operations == 0 || arena.GetGeneration() == report.compactions + 1 );
+
+   report.finalCapacity           = arena.GetVertexAllocator().GetCapacity();
+   report.meanFragmentation       = options.operations > 0 ? static_cast< float >( fragmentationSum / options.operations ) : 0.0f;
+   report.nanosecondsPerOperation = options.operations > 0 ? elapsedNs / options.operations : 0.0;
+   return report;
+}
+
+} // namespace Tools
@@ -0,0 +1,32 @@
+#pragma once
+
+namespace Tools
+{
+
+struct ArenaBenchOptions
+{
+   uint32_t capacity { 1u << 20 }; // starting vertices; indices start at half as many again
+   uint64_t seed { 1 };
+   int      operations { 200000 }; // allocations and frees, in random order
+};
+
+struct ArenaBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // fixed cases, plus any overlap or miscount during the random run
+
+   size_t   compactions { 0 }; // arena rebuilds, each packing its buffers
+   size_t   grows { 0 };
+   uint32_t finalCapacity { 0 }; // vertices, as are the figures below
+   uint32_t peakUsed { 0 };
+   float    peakFragmentation { 0.0f };
+   float    meanFragmentation { 0.0f };
+   double   nanosecondsPerOperation { 0.0 };
+};
+
+// Checks RangeAllocator on fixed cases (reuse, best fit, merging, growing, packing), then churns a ChunkMeshArena
+// with section-sized meshes through NullRenderDevice. Every rebuild is checked for packing, the capacity it chose
+// and the bytes it copied and allocated; live ranges are checked against a plain map of what should be live.
+ArenaBenchReport BenchArena( const ArenaBenchOptions& options );
+
+} // namespace Tools
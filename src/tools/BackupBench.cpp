@@ -0,0 +1,142 @@
+#include "pch_server.h"
+
+#include "BackupBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/World/Level.h>
+#include <Engine/World/PendingFeatureWrites.h>
+#include <Engine/World/WorldBackup.h>
+
+namespace Tools
+{
+
+BackupBenchReport BenchBackup( const BackupBenchOptions& options )
+{
+   const ScratchWorld          world( "BackupBench", options.seed );
+   const std::filesystem::path worldDir    = world.GetDir();
+   const std::filesystem::path archivePath = world.GetFile( "backup.wbak" );
+
+   BackupBenchReport report;
+   auto              check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   std::unordered_map< ChunkPos, ChunkSnapshot, ChunkPosHash > expected;
+   std::vector< std::byte >                                    expectedFeatures;
+   uint64_t                                                    snapshotTick = 0;
+   {
+      Level level( worldDir );
+
+      // No memory budget: everything that leaves the view is written back and dropped, so at the snapshot tick
+      // the world is part loaded chunks and part chunks that only exist on disk
+      level.SetResidencyOptions( Level::ResidencyOptions { .simulationRadius = static_cast< uint8_t >( options.radius ), .memoryBudgetBytes = 0 } );
+
+      constexpr float TICK_INTERVAL = 1.0f / 20.0f; // the application's fixed tick rate
+      TickRng         editRng( options.seed );
+      auto            step = [ & ]( int chunkX )
+      {
+         level.Update( TICK_INTERVAL );
+         level.UpdateStreaming( glm::vec3( chunkX * CHUNK_SIZE_X + 8.0f, 100.0f, 8.0f ), static_cast< uint8_t >( options.radius ) );
+
+         // Edits in the chunks around the player, which the walk back leaves behind and saves again
+         std::vector< Level::BlockWrite > writes;
+         for( int n = 0; n < 64; ++n )
+         {
+            const WorldBlockPos pos { chunkX * CHUNK_SIZE_X + static_cast< int >( editRng.NextBelow( CHUNK_SIZE_X * 5 ) ) - 2 * CHUNK_SIZE_X,
+                                      static_cast< int >( editRng.NextBelow( CHUNK_SIZE_Y ) ),
+                                      static_cast< int >( editRng.NextBelow( CHUNK_SIZE_Z * 5 ) ) - 2 * CHUNK_SIZE_Z };
+            writes.push_back( Level::BlockWrite { pos, BlockState( n % 2 ? BlockId::Stone : BlockId::Air ) } );
+         }
+         level.SetBlocks( writes );
+         return writes.size();
+      };
+
+      for( int x = 0; x <= options.chunks; ++x )
+      {
+         for( int tick = 0; tick < options.ticksPerChunk; ++tick )
+            step( x );
+      }
+
+      // Once the save queue is flushed, disk plus the loaded chunks is the whole world
+      level.Save();
+      for( const World::ChunkPos3& cpos3 : World::WorldSave::ListChunks( worldDir ) )
+      {
+         const ChunkPos           cpos { cpos3.x, cpos3.z };
+         std::vector< std::byte > bytes;
+         if( !World::WorldSave::FLoadChunkBytes( worldDir, cpos3, bytes ) )
+            continue;
+
+         if( std::optional< ChunkSnapshot > optSnapshot = ChunkSnapshot::Decode( cpos, bytes ) )
+            expected.insert_or_assign( cpos, std::move( *optSnapshot ) );
+      }
+      level.GetChunks().ForEach( [ & ]( const Chunk& chunk )
+      {
+         ChunkSnapshot snapshot = chunk.Snapshot();
+         snapshot.UnpackSections();
+         expected.insert_or_assign( chunk.GetChunkPos(), std::move( snapshot ) );
+      } );
+      report.chunks        = expected.size();
+      report.featureWrites = level.GetPendingFeatureWrites().WriteCount();
+      expectedFeatures     = level.GetPendingFeatureWrites().Capture();
+      snapshotTick         = level.GetTick();
+
+      const auto start = std::chrono::steady_clock::now();
+      check( level.FBeginBackup( archivePath, options.bytesPerSecond ) );
+
+      // Walk back past the start while the backup streams: chunks written out before the snapshot load again and
+      // get edited, chunks loaded at the snapshot are saved with new edits, and unseen chunks are generated
+      constexpr auto TIMEOUT = std::chrono::minutes( 5 );
+      int            x       = options.chunks;
+      while( level.FBackupInProgress() && std::chrono::steady_clock::now() - start < TIMEOUT )
+      {
+         report.edits += step( x );
+         if( ++report.ticks % static_cast< size_t >( ( std::max )( options.ticksPerChunk, 1 ) ) == 0 )
+         {
+            x = ( std::max )( x - 1, -options.chunks );
+            level.Save();
+         }
+      }
+      check( !level.FBackupInProgress() );
+      report.seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+   }
+
+   std::error_code ec;
+   report.archiveBytes = static_cast< size_t >( std::filesystem::file_size( archivePath, ec ) );
+
+   const std::optional< WorldBackup::Contents > optContents = WorldBackup::Read( archivePath );
+   check( optContents.has_value() );
+   if( optContents )
+   {
+      check( optContents->meta.tick == snapshotTick && optContents->meta.seed == options.seed );
+
+      report.archivedChunks = optContents->chunks.size();
+      for( const auto& [ cpos, snapshot ] : expected )
+      {
+         auto it = optContents->chunks.find( cpos );
+         if( it == optContents->chunks.end() )
+         {
+            ++report.missingChunks;
+            continue;
+         }
+
+         const std::optional< ChunkSnapshot > optArchived = ChunkSnapshot::Decode( cpos, it->second );
+         report.mismatchedChunks += optArchived && FSameChunk( snapshot, *optArchived ) ? 0 : 1;
+      }
+      for( const auto& [ cpos, _ ] : optContents->chunks )
+         report.extraChunks += expected.contains( cpos ) ? 0 : 1;
+
+      check( report.missingChunks == 0 );
+      check( report.extraChunks == 0 );
+      check( report.mismatchedChunks == 0 );
+
+      report.fFeaturesArchived = optContents->pendingFeatures == expectedFeatures;
+      check( report.fFeaturesArchived );
+   }
+
+   return report;
+}
+
+} // namespace Tools
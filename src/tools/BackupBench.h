@@ -0,0 +1,39 @@
+#pragma once
+
+namespace Tools
+{
+
+struct BackupBenchOptions
+{
+   int      radius { 6 };                     // view radius streamed around the walking player
+   int      chunks { 16 };                    // distance walked along +x before the backup, and back past the start during it
+   int      ticksPerChunk { 10 };             // fixed ticks spent in each chunk
+   size_t   bytesPerSecond { 512ull * 1024 }; // backup throttle; low, so the walk back overlaps the backup
+   uint64_t seed { 1 };
+};
+
+struct BackupBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 };
+
+   size_t chunks { 0 };                // chunks in the world at the snapshot tick
+   size_t archivedChunks { 0 };        // chunks read back from the archive
+   size_t missingChunks { 0 };         // in the world at the snapshot tick but not in the archive
+   size_t extraChunks { 0 };           // in the archive but generated after the snapshot tick
+   size_t mismatchedChunks { 0 };      // archived with blocks or scheduled ticks that differ from the snapshot tick
+   size_t featureWrites { 0 };         // feature blocks waiting for ungenerated chunks at the snapshot tick
+   bool   fFeaturesArchived { false }; // the archive holds exactly those writes
+   size_t edits { 0 };                 // block writes issued while the backup ran
+   size_t ticks { 0 };                 // fixed ticks the backup ran for
+   size_t archiveBytes { 0 };
+   double seconds { 0.0 };
+};
+
+// Stress test for WorldBackup: walks a player across a throwaway world so chunks are written out and dropped,
+// records the state of every chunk, then starts a backup and walks back past the start, editing, loading,
+// generating and saving chunks until it finishes. The archive is read back and compared chunk by chunk, along with
+// the pending feature writes, which chunks generated during the walk back take from the live buffer.
+BackupBenchReport BenchBackup( const BackupBenchOptions& options );
+
+} // namespace Tools
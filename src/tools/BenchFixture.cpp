@@ -0,0 +1,95 @@
+#include "pch_server.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/Renderer/NullRenderDevice.h>
+#include <Engine/World/Level.h>
+#include <Engine/World/WorldSave.h>
+
+namespace Tools
+{
+
+namespace
+{
+
+// Constructed by the first guard, before the renderer creates any statics, so it is destroyed after all of them
+RenderDevice& ReleasedDevice() noexcept
+{
+   static NullRenderDevice s_released;
+   return s_released;
+}
+
+} // namespace
+
+
+ScratchWorld::ScratchWorld( std::string_view name, uint64_t seed )
+{
+   constexpr int MAX_ATTEMPTS = 16;
+
+   std::random_device random;
+   for( int attempt = 0; m_root.empty(); ++attempt )
+   {
+      if( attempt == MAX_ATTEMPTS )
+         throw std::runtime_error( std::format( "no free scratch directory for {}", name ) );
+
+      const std::filesystem::path root = std::filesystem::temp_directory_path() / std::format( "OpenGL_{}_{:08x}", name, random() );
+      if( std::filesystem::create_directory( root ) )
+         m_root = root;
+   }
+
+   m_worldDir = m_root / "world";
+   World::WorldSave::FSaveMeta( m_worldDir, World::WorldMeta { .seed = seed } );
+}
+
+
+ScratchWorld::~ScratchWorld()
+{
+   std::error_code ec;
+   std::filesystem::remove_all( m_root, ec );
+}
+
+
+ScopedRenderDevice::ScopedRenderDevice( RenderDevice& device ) noexcept
+{
+   ReleasedDevice();
+   m_pPrevious = RenderDevice::Set( &device );
+}
+
+
+ScopedRenderDevice::~ScopedRenderDevice()
+{
+   RenderDevice::Set( m_pPrevious == &RenderDevice::GetOpenGL() ? &ReleasedDevice() : m_pPrevious );
+}
+
+
+bool FSameChunk( const ChunkSnapshot& expected, const ChunkSnapshot& actual )
+{
+   // A section may be stored as null or as all air depending on where it came from
+   auto blockAt = []( const SectionBlocksPtr& pBlocks, size_t index ) { return pBlocks ? ( *pBlocks )[ index ] : BlockState( BlockId::Air ); };
+   for( size_t i = 0; i < SECTIONS_PER_CHUNK; ++i )
+   {
+      if( expected.sections[ i ] == actual.sections[ i ] )
+         continue;
+
+      for( size_t index = 0; index < CHUNK_SECTION_VOLUME; ++index )
+      {
+         if( blockAt( expected.sections[ i ], index ) != blockAt( actual.sections[ i ], index ) )
+            return false;
+      }
+   }
+
+   // Ticks restored from disk are rescheduled, so their order is not preserved
+   auto sortedTicks = []( std::vector< ChunkBlockTick > ticks )
+   {
+      std::ranges::sort( ticks, {}, []( const ChunkBlockTick& tick ) { return std::tuple( tick.dueTick, tick.x, tick.y, tick.z, tick.block ); } );
+      return ticks;
+   };
+   const std::vector< ChunkBlockTick > expectedTicks = sortedTicks( expected.ticks );
+   const std::vector< ChunkBlockTick > actualTicks   = sortedTicks( actual.ticks );
+   return std::ranges::equal( expectedTicks, actualTicks, []( const ChunkBlockTick& a, const ChunkBlockTick& b )
+   {
+      return a.x == b.x && a.y == b.y && a.z == b.z && a.block == b.block && a.dueTick == b.dueTick;
+   } );
+}
+
+} // namespace Tools
@@ -0,0 +1,51 @@
+#pragma once
+
+class RenderDevice;
+struct ChunkSnapshot;
+
+namespace Tools
+{
+
+// A world directory of its own for one bench run, seeded before any Level opens it. The directory name is unique
+// to the run, so two benches (or two copies of one) never share files, and it goes away with everything in it,
+// sidecar files included, when the scratch world does, also when a check throws. Declare it before the Level so
+// the level saves into it before it is removed.
+class ScratchWorld
+{
+public:
+   ScratchWorld( std::string_view name, uint64_t seed );
+   ~ScratchWorld();
+
+   ScratchWorld( const ScratchWorld& )            = delete;
+   ScratchWorld& operator=( const ScratchWorld& ) = delete;
+
+   const std::filesystem::path& GetDir() const noexcept { return m_worldDir; }
+
+   // A path next to the world (a backup archive, say) that is removed along with it
+   std::filesystem::path GetFile( std::string_view fileName ) const { return m_root / fileName; }
+
+private:
+   std::filesystem::path m_root;
+   std::filesystem::path m_worldDir;
+};
+
+// Makes a device current for its lifetime and puts the previous one back afterwards. The renderer keeps GPU objects
+// in function statics that outlive any bench; once the last guard is gone they are released into a null device that
+// drops them, rather than into an OpenGL device with no context, so the bench's own device can be a local.
+class ScopedRenderDevice
+{
+public:
+   explicit ScopedRenderDevice( RenderDevice& device ) noexcept;
+   ~ScopedRenderDevice();
+
+   ScopedRenderDevice( const ScopedRenderDevice& )            = delete;
+   ScopedRenderDevice& operator=( const ScopedRenderDevice& ) = delete;
+
+private:
+   RenderDevice* m_pPrevious;
+};
+
+// Whether two unpacked snapshots of a chunk hold the same blocks and scheduled ticks
+bool FSameChunk( const ChunkSnapshot& expected, const ChunkSnapshot& actual );
+
+} // namespace Tools
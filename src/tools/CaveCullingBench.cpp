@@ -0,0 +1,176 @@
+#include "pch_server.h"
+
+#include "CaveCullingBench.h"
+
+#include <Engine/World/SectionVisibility.h>
+#include <Engine/World/TerrainGenerator.h>
+
+namespace Tools
+{
+
+namespace
+{
+
+// Sections of a 3x3 chunk world: stone below section 8, air above, with a hollow 8^3 cave in section 3 of the
+// center column and optionally a one-block shaft from the cave up to the surface
+class SyntheticWorld
+{
+public:
+   explicit SyntheticWorld( bool fShaft )
+   {
+      auto fill = []( auto&& fAir )
+      {
+         auto pBlocks = std::make_shared< SectionBlocks >();
+         for( int y = 0; y < CHUNK_SECTION_SIZE; ++y )
+            for( int z = 0; z < CHUNK_SECTION_SIZE; ++z )
+               for( int x = 0; x < CHUNK_SECTION_SIZE; ++x )
+                  ( *pBlocks )[ ChunkSection::ToIndex( LocalBlockPos { x, y, z } ) ] = BlockState( fAir( x, y, z ) ? BlockId::Air : BlockId::Stone );
+         return SectionVisibility::Compute( pBlocks );
+      };
+
+      auto fShaftAt = [ fShaft ]( int x, int z ) { return fShaft && x == 8 && z == 8; };
+      m_stone       = fill( []( int, int, int ) { return false; } );
+      m_shaft       = fill( [ & ]( int x, int, int z ) { return fShaftAt( x, z ); } );
+      m_cave        = fill( [ & ]( int x, int y, int z )
+      {
+         const bool fInCave = x >= 4 && x < 12 && y >= 4 && y < 12 && z >= 4 && z < 12;
+         return fInCave || ( y >= 8 && fShaftAt( x, z ) );
+      } );
+   }
+
+   SectionVisibility Lookup( const SectionPos& pos ) const
+   {
+      if( pos.y >= SURFACE_SECTION )
+         return SectionVisibility::All();
+
+      const bool fCenter = pos.x == 0 && pos.z == 0;
+      return fCenter && pos.y == CAVE_SECTION ? m_cave : fCenter && pos.y > CAVE_SECTION ? m_shaft : m_stone;
+   }
+
+   // Number of sections reached, and whether the cave was one of them. `hidden` is treated as outside the frustum.
+   std::pair< size_t, bool > Walk( const SectionPos& camera, const SectionPos& hidden = SectionPos { 0, -1, 0 } ) const
+   {
+      size_t reached = 0;
+      bool   fCave   = false;
+      WalkVisibleSections( camera,
+                           1,
+                           [ this ]( const SectionPos& pos ) { return Lookup( pos ); },
+                           [ & ]( const SectionPos& pos )
+      {
+         ++reached;
+         fCave |= pos == SectionPos { 0, CAVE_SECTION, 0 };
+         return pos != hidden;
+      } );
+      return { reached, fCave };
+   }
+
+   static constexpr int CAVE_SECTION    = 3;
+   static constexpr int SURFACE_SECTION = 8;
+
+private:
+   SectionVisibility m_stone, m_shaft, m_cave;
+};
+
+} // namespace
+
+CaveCullingBenchReport BenchCaveCulling( const CaveCullingBenchOptions& options )
+{
+   CaveCullingBenchReport report;
+   auto                   check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   // Flood fill on single sections
+   check( SectionVisibility::Compute( nullptr ) == SectionVisibility::All() );
+   {
+      SyntheticWorld world( true );
+      const SectionVisibility shaft = world.Lookup( SectionPos { 0, SyntheticWorld::CAVE_SECTION + 1, 0 } );
+      check( shaft.FConnected( 2, 3 ) && !shaft.FConnected( 0, 1 ) && !shaft.FConnected( 2, 4 ) );
+      check( world.Lookup( SectionPos { 1, 0, 1 } ) == SectionVisibility::Opaque() );
+   }
+
+   // From the sky a sealed cave stays hidden; the 9 columns show their 8 air sections and their top stone one
+   const SectionPos sky { 0, 10, 0 };
+   const auto [ sealedReached, fSealedCave ] = SyntheticWorld( false ).Walk( sky );
+   check( !fSealedCave && sealedReached == 9 * ( SECTIONS_PER_CHUNK - SyntheticWorld::SURFACE_SECTION + 1 ) );
+
+   // The shaft opens the four sections down to the cave
+   const auto [ openReached, fOpenCave ] = SyntheticWorld( true ).Walk( sky );
+   check( fOpenCave && openReached == sealedReached + 4 );
+
+   // Above the world the whole top layer is in sight, so losing the column's own top section to the frustum
+   // hides nothing else; below it, the stone floor shows its bottom layer and no more
+   const SectionPos above { 0, SECTIONS_PER_CHUNK + 4, 0 };
+   const SectionPos topSection { 0, SECTIONS_PER_CHUNK - 1, 0 };
+   check( SyntheticWorld( false ).Walk( above, topSection ).first == sealedReached );
+   check( SyntheticWorld( true ).Walk( above, topSection ) == std::pair( openReached, true ) );
+   check( SyntheticWorld( false ).Walk( SectionPos { 0, -3, 0 } ).first == 9 );
+
+   // From inside a sealed cave only the cave and the stone around it can be seen
+   const auto [ caveReached, _ ] = SyntheticWorld( false ).Walk( SectionPos { 0, SyntheticWorld::CAVE_SECTION, 0 } );
+   check( caveReached == 7 );
+
+   // Generated terrain: everything non-empty would be drawn without culling
+   TerrainGenerator                 generator( options.seed );
+   const int                        width = 2 * options.radius + 1;
+   std::vector< SectionVisibility > visibility( static_cast< size_t >( width * width * SECTIONS_PER_CHUNK ) );
+   std::vector< bool >              fNonEmpty( visibility.size(), false );
+   auto                             indexOf = [ & ]( const SectionPos& pos )
+   {
+      return static_cast< size_t >( ( pos.x + options.radius ) + ( pos.z + options.radius ) * width + pos.y * width * width );
+   };
+
+   int surfaceY = 0;
+   for( int cz = -options.radius; cz <= options.radius; ++cz )
+   {
+      for( int cx = -options.radius; cx <= options.radius; ++cx )
+      {
+         const ChunkSnapshot snapshot = generator.Generate( ChunkPos { cx, cz } );
+         const auto          start    = std::chrono::steady_clock::now();
+         for( int sy = 0; sy < SECTIONS_PER_CHUNK; ++sy )
+         {
+            const size_t index  = indexOf( SectionPos { cx, sy, cz } );
+            visibility[ index ] = SectionVisibility::Compute( snapshot.sections[ static_cast< size_t >( sy ) ] );
+            fNonEmpty[ index ]  = snapshot.sections[ static_cast< size_t >( sy ) ] != nullptr;
+            report.sections += fNonEmpty[ index ] ? 1 : 0;
+         }
+         report.computeMilliseconds += std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+
+         if( cx == 0 && cz == 0 )
+         {
+            for( int y = CHUNK_SIZE_Y - 1; y > 0 && !surfaceY; --y )
+            {
+               const SectionBlocksPtr& pBlocks = snapshot.sections[ static_cast< size_t >( y / CHUNK_SECTION_SIZE ) ];
+               if( pBlocks && ( *pBlocks )[ ChunkSection::ToIndex( LocalBlockPos { 8, y % CHUNK_SECTION_SIZE, 8 } ) ].GetId() != BlockId::Air )
+                  surfaceY = y;
+            }
+         }
+      }
+   }
+
+   // Camera a few blocks above the ground at the center, as a player standing there would be
+   const SectionPos camera { 0, ( std::min )( ( surfaceY + 2 ) / CHUNK_SECTION_SIZE, SECTIONS_PER_CHUNK - 1 ), 0 };
+
+   constexpr int WALKS = 100;
+   const auto    start = std::chrono::steady_clock::now();
+   for( int walk = 0; walk < WALKS; ++walk )
+   {
+      size_t reached = 0;
+      WalkVisibleSections( camera,
+                           options.radius,
+                           [ & ]( const SectionPos& pos ) { return visibility[ indexOf( pos ) ]; },
+                           [ & ]( const SectionPos& pos )
+      {
+         reached += fNonEmpty[ indexOf( pos ) ] ? 1 : 0;
+         return true;
+      } );
+      report.reachedSections = reached;
+   }
+   report.walkMicroseconds = std::chrono::duration< double, std::micro >( std::chrono::steady_clock::now() - start ).count() / WALKS;
+
+   return report;
+}
+
+} // namespace Tools
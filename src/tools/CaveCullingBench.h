@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Tools
+{
+
+struct CaveCullingBenchOptions
+{
+   int      radius { 8 }; // generated chunks around the origin, walked from above the surface at its center
+   uint64_t seed { 1 };
+};
+
+struct CaveCullingBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // synthetic worlds whose walk reached or missed the wrong sections
+
+   size_t sections { 0 };              // non-empty sections of the generated world, the draws without culling
+   size_t reachedSections { 0 };       // non-empty sections the walk reached from the camera
+   double computeMilliseconds { 0.0 }; // flood fills over every section
+   double walkMicroseconds { 0.0 };    // one walk, averaged
+};
+
+// Checks SectionVisibility and WalkVisibleSections against hand-built worlds with sealed and open caves, then
+// measures both on generated terrain
+CaveCullingBenchReport BenchCaveCulling( const CaveCullingBenchOptions& options );
+
+} // namespace Tools
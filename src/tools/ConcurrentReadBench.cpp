@@ -0,0 +1,114 @@
+#include "pch_server.h"
+
+#include "ConcurrentReadBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/World/Level.h>
+
+namespace Tools
+{
+
+ConcurrentReadBenchReport BenchConcurrentReads( const ConcurrentReadBenchOptions& options )
+{
+   const ScratchWorld world( "ConcurrentReadBench", options.seed );
+
+   auto fValid = []( BlockState state ) { return state.GetId() < BlockId::Count; };
+
+   ConcurrentReadBenchReport report;
+   {
+      Level level( world.GetDir() );
+
+      // Everything past the view radius goes cold right away, so chunks leave the map as fast as they enter it
+      level.SetResidencyOptions( Level::ResidencyOptions { .simulationRadius = static_cast< uint8_t >( options.radius ) } );
+
+      std::atomic< int >    playerChunkX { 0 };
+      std::atomic< bool >   fStop { false };
+      std::atomic< size_t > reads { 0 }, loadedReads { 0 }, handleReads { 0 }, invalidReads { 0 };
+
+      auto reader = [ & ]( uint64_t seed )
+      {
+         TickRng     rng( seed );
+         ChunkHandle pHeld; // read again after the main thread has moved on, and possibly unloaded it
+         size_t      localReads = 0, localLoaded = 0, localHandle = 0, localInvalid = 0;
+         while( !fStop.load( std::memory_order_relaxed ) )
+         {
+            // Cover two chunks past the view on every side, where chunks load and unload
+            const int      reach = options.radius + 2;
+            const ChunkPos cpos { playerChunkX.load( std::memory_order_relaxed ) - reach + static_cast< int >( rng.NextBelow( 2 * reach + 1 ) ),
+                                  static_cast< int >( rng.NextBelow( 2 * reach + 1 ) ) - reach };
+
+            const LocalBlockPos local { static_cast< int >( rng.NextBelow( CHUNK_SIZE_X ) ),
+                                        static_cast< int >( rng.NextBelow( CHUNK_SIZE_Y ) ),
+                                        static_cast< int >( rng.NextBelow( CHUNK_SIZE_Z ) ) };
+
+            const BlockState state = level.GetBlockConcurrent( WorldBlockPos { cpos.x * CHUNK_SIZE_X + local.x, local.y, cpos.z * CHUNK_SIZE_Z + local.z } );
+            ++localReads;
+            localInvalid += fValid( state ) ? 0 : 1;
+
+            if( ChunkHandle pChunk = level.FindChunk( cpos ) )
+            {
+               ++localLoaded;
+               if( rng.NextBelow( 64 ) == 0 )
+                  pHeld = std::move( pChunk );
+            }
+
+            if( pHeld )
+            {
+               localInvalid += fValid( pHeld->ReadBlock( local ) ) ? 0 : 1;
+               ++localHandle;
+            }
+         }
+
+         reads += localReads;
+         loadedReads += localLoaded;
+         handleReads += localHandle;
+         invalidReads += localInvalid;
+      };
+
+      constexpr float TICK_INTERVAL = 1.0f / 20.0f; // the application's fixed tick rate
+      level.UpdateStreaming( glm::vec3( 0.0f ), static_cast< uint8_t >( options.radius ) );
+
+      const auto                 start = std::chrono::steady_clock::now();
+      std::vector< std::thread > threads;
+      for( int i = 0; i < ( std::max )( options.readers, 1 ); ++i )
+         threads.emplace_back( reader, options.seed * 0x9E3779B97F4A7C15ull + static_cast< uint64_t >( i ) );
+
+      TickRng editRng( options.seed );
+      for( int x = 0; x <= options.chunks; ++x )
+      {
+         playerChunkX.store( x, std::memory_order_relaxed );
+         const glm::vec3 playerPos( x * CHUNK_SIZE_X + 8.0f, 100.0f, 8.0f );
+         for( int tick = 0; tick < options.ticksPerChunk; ++tick )
+         {
+            level.Update( TICK_INTERVAL );
+            level.UpdateStreaming( playerPos, static_cast< uint8_t >( options.radius ) );
+
+            // Edits clone section storage under the chunk's lock while readers are inside it
+            for( int n = 0; n < 64; ++n )
+            {
+               const WorldBlockPos pos { x * CHUNK_SIZE_X + static_cast< int >( editRng.NextBelow( CHUNK_SIZE_X * 3 ) ) - CHUNK_SIZE_X,
+                                         static_cast< int >( editRng.NextBelow( CHUNK_SIZE_Y ) ),
+                                         static_cast< int >( editRng.NextBelow( CHUNK_SIZE_Z * 3 ) ) - CHUNK_SIZE_Z };
+               level.SetBlocks( std::array { Level::BlockWrite { pos, BlockState( n % 2 ? BlockId::Stone : BlockId::Air ) } } );
+               ++report.edits;
+            }
+         }
+      }
+
+      fStop = true;
+      for( std::thread& thread : threads )
+         thread.join();
+
+      report.milliseconds   = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+      report.reads          = reads;
+      report.loadedReads    = loadedReads;
+      report.handleReads    = handleReads;
+      report.invalidReads   = invalidReads;
+      report.demotions      = level.GetResidencyStats().demotions;
+   }
+
+   return report;
+}
+
+} // namespace Tools
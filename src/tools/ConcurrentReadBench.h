@@ -0,0 +1,30 @@
+#pragma once
+
+namespace Tools
+{
+
+struct ConcurrentReadBenchOptions
+{
+   int      readers { 4 };        // worker threads calling Level::GetBlockConcurrent
+   int      radius { 8 };         // view radius streamed around the walking player
+   int      chunks { 64 };        // distance walked along +x, one chunk at a time
+   int      ticksPerChunk { 10 }; // fixed ticks spent in each chunk
+   uint64_t seed { 1 };
+};
+
+struct ConcurrentReadBenchReport
+{
+   size_t reads { 0 };
+   size_t loadedReads { 0 };  // reads that found their chunk loaded
+   size_t handleReads { 0 };  // reads through a handle held across a streaming update
+   size_t invalidReads { 0 }; // block ids outside BlockId; anything but 0 is a bug
+   size_t edits { 0 };        // block writes the main thread issued while the readers ran
+   size_t demotions { 0 };    // chunks that left the view, most of them dropped from the map
+   double milliseconds { 0.0 };
+};
+
+// Stress test for ChunkMap: walks a player across a throwaway world, loading, editing and unloading chunks on
+// the calling thread while reader threads hammer GetBlockConcurrent and hold chunk handles across updates
+ConcurrentReadBenchReport BenchConcurrentReads( const ConcurrentReadBenchOptions& options );
+
+} // namespace Tools
@@ -0,0 +1,291 @@
+#include "pch_server.h"
+
+#include "DeferredDeviceBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/Renderer/DeferredRenderDevice.h>
+#include <Engine/Renderer/NullRenderDevice.h>
+#include <Engine/Renderer/Texture.h>
+#include <Engine/World/Level.h>
+#include <Engine/World/RenderSystem.h>
+
+namespace Tools
+{
+
+using Engine::RenderSystem;
+
+namespace
+{
+
+// Meshing uploads go through the copy target, so they are told apart from the per-frame streams
+uint64_t MeshUploadBytes( std::span< const RenderCommand > commands )
+{
+   uint64_t bytes = 0;
+   for( const RenderCommand& command : commands )
+   {
+      if( command.type == RenderCommand::Type::UploadBuffer && command.target == GL_COPY_WRITE_BUFFER )
+         bytes += command.bytes;
+   }
+   return bytes;
+}
+
+
+// Object ids numbered by first use, and uniform locations by first use within their program, so streams from
+// devices that hand out ids and locations differently compare equal when they do the same work
+std::vector< RenderCommand > Canonical( std::span< const RenderCommand > commands )
+{
+   std::unordered_map< uint32_t, uint32_t >              objects;
+   std::map< std::pair< uint32_t, uint32_t >, uint32_t > locations; // by program and location
+   uint32_t                                              program = 0;
+
+   std::vector< RenderCommand > result( commands.begin(), commands.end() );
+   for( RenderCommand& command : result )
+   {
+      // State changes keep the value set in `object`, not an id
+      if( command.object != 0 && command.type != RenderCommand::Type::SetState )
+         command.object = objects.try_emplace( command.object, static_cast< uint32_t >( objects.size() + 1 ) ).first->second;
+
+      if( command.type == RenderCommand::Type::UseProgram )
+         program = command.object;
+      else if( command.type == RenderCommand::Type::SetUniform && command.target != static_cast< uint32_t >( -1 ) )
+         command.target = locations.try_emplace( std::pair( program, command.target ), static_cast< uint32_t >( locations.size() ) ).first->second;
+   }
+   return result;
+}
+
+
+size_t CountMismatches( std::span< const RenderCommand > a, std::span< const RenderCommand > b )
+{
+   size_t mismatches = a.size() > b.size() ? a.size() - b.size() : b.size() - a.size();
+   for( size_t i = 0; i < ( std::min )( a.size(), b.size() ); ++i )
+   {
+      const bool fSame = a[ i ].type == b[ i ].type && a[ i ].target == b[ i ].target && a[ i ].object == b[ i ].object && a[ i ].bytes == b[ i ].bytes &&
+                         a[ i ].draws == b[ i ].draws && a[ i ].instances == b[ i ].instances && a[ i ].elements == b[ i ].elements;
+      mismatches += fSame ? 0 : 1;
+   }
+   return mismatches;
+}
+
+} // namespace
+
+
+DeferredDeviceBenchReport BenchDeferredDevice( const DeferredDeviceBenchOptions& options )
+{
+   DeferredDeviceBenchReport report;
+   auto                      check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   // Ids and names, on devices of their own
+   {
+      RenderPacket         packet;
+      DeferredRenderDevice deferred( glm::ivec4( 0, 0, 1920, 1080 ) );
+      NullRenderDevice     device;
+      RenderPacketPlayer   player( device );
+      deferred.SetPacket( packet );
+
+      // A deleted id is handed out again; it must play as the object created under it the second time
+      const GLuint first  = deferred.CreateBuffer();
+      const GLuint second = deferred.CreateBuffer();
+      deferred.DeleteBuffer( first );
+      const GLuint reused = deferred.CreateBuffer();
+      check( reused == first && second != first );
+
+      deferred.BindBuffer( GL_ARRAY_BUFFER, reused );
+      deferred.BufferData( GL_ARRAY_BUFFER, 64, nullptr, GL_STATIC_DRAW );
+      deferred.BindBuffer( GL_ARRAY_BUFFER, second );
+      deferred.BufferData( GL_ARRAY_BUFFER, 16, nullptr, GL_STATIC_DRAW );
+
+      // Names are handed out while recording whether or not the program has the uniform
+      const GLuint program = deferred.CreateProgram( "uniform float u_present;\nvoid main() {}", "void main() {}" );
+      const GLint  present = deferred.GetUniformLocation( program, "u_present" );
+      const GLint  missing = deferred.GetUniformLocation( program, "u_missing" );
+      check( present != -1 && missing != -1 && present != missing );
+      deferred.UseProgram( program );
+      deferred.Uniform1f( present, 1.0f );
+      deferred.Uniform1f( missing, 1.0f );
+
+      player.Play( packet );
+      packet.Clear();
+
+      // The reused id binds a buffer newer than the second, and the sizes land on the live buffers
+      std::vector< uint32_t > buffers;
+      std::vector< uint32_t > uniforms;
+      for( const RenderCommand& command : device.GetCommands() )
+      {
+         if( command.type == RenderCommand::Type::BindBuffer && command.object != 0 )
+            buffers.push_back( command.object );
+         if( command.type == RenderCommand::Type::SetUniform )
+            uniforms.push_back( command.target );
+      }
+      check( buffers.size() == 2 && buffers[ 0 ] > buffers[ 1 ] );
+      check( device.GetLiveBuffers() == 2 && device.GetBufferMemory() == 80 );
+      check( uniforms == std::vector< uint32_t > { 0u, static_cast< uint32_t >( -1 ) } );
+
+      // Deleting the reused id deletes the newer buffer, not the second
+      deferred.DeleteBuffer( reused );
+      deferred.DeleteProgram( program );
+      player.Play( packet );
+      check( device.GetLiveBuffers() == 1 && device.GetBufferMemory() == 16 && device.GetLivePrograms() == 0 );
+   }
+
+   // The renderer keeps GPU objects in function statics, created once against whatever device is current. Here that
+   // is the deferred device, and the first frame, which creates them, is played into both null devices before
+   // anything is deleted, so the ids the statics hold are the ids both devices gave them. The direct frame can then
+   // run against its device with the same statics.
+   DeferredRenderDevice deferredDevice( glm::ivec4( 0, 0, 1920, 1080 ) ); // the null devices' viewport
+   NullRenderDevice     playedDevice;
+   NullRenderDevice     directDevice;
+
+   RenderPacket packet;
+   deferredDevice.SetPacket( packet );
+   const ScopedRenderDevice scopedDeferred( deferredDevice );
+
+   RenderPacketPlayer toPlayed( playedDevice );
+   RenderPacketPlayer toDirect( directDevice );
+   auto               play = [ & ]( RenderPacketPlayer& player )
+   {
+      player.Play( packet );
+      packet.Clear();
+   };
+
+   TextureAtlasManager::Get().CompileBlockAtlas();
+
+   const ScratchWorld world( "DeferredDeviceBench", options.seed );
+   {
+      constexpr float TICK_INTERVAL = 1.0f / 20.0f; // the application's fixed tick rate
+      const uint8_t   radius        = static_cast< uint8_t >( options.radius );
+
+      Level                     level( world.GetDir() );
+      Entity::Registry          registry;
+      const Time::FixedTimeStep time( 20 );
+
+      // Looking along +x and a little down, with the block underfoot highlighted
+      glm::vec3 eye( 8.0f, 100.0f, 8.0f );
+      int       surfaceY     = 64;
+      auto      frameContext = [ & ]()
+      {
+         const glm::mat4 view       = glm::lookAt( eye, eye + glm::vec3( 1.0f, -0.2f, 0.0f ), glm::vec3( 0.0f, 1.0f, 0.0f ) );
+         const glm::mat4 projection = glm::perspective( glm::radians( 70.0f ), 1920.0f / 1080.0f, 0.1f, 1000.0f );
+         return RenderSystem::FrameContext { .registry          = registry,
+                                             .time              = time,
+                                             .view              = view,
+                                             .projection        = projection,
+                                             .viewProjection    = projection * view,
+                                             .viewPos           = eye,
+                                             .optHighlightBlock = glm::ivec3( 8, surfaceY, 8 ) };
+      };
+
+      // Updates until one meshes nothing, each played into `device` when it was recorded
+      auto meshView = [ & ]( RenderSystem& renderSystem, NullRenderDevice& device, RenderPacketPlayer* pPlayer )
+      {
+         for( int update = 0; update < 256; ++update )
+         {
+            device.Reset();
+            renderSystem.Update( eye, radius );
+            if( pPlayer )
+               play( *pPlayer );
+            if( MeshUploadBytes( device.GetCommands() ) == 0 )
+               break;
+         }
+      };
+
+      std::vector< RenderCommand > played;
+      {
+         RenderSystem renderSystem( level );
+         renderSystem.Run( frameContext() );
+         toDirect.Play( packet );
+         play( toPlayed );
+
+         // Light is computed off-thread and chunks are not meshed until they are lit
+         auto fAllLit = [ &level ]()
+         {
+            bool fLit = true;
+            level.GetChunks().ForEach( [ &fLit ]( const Chunk& chunk ) { fLit &= chunk.FLit(); } );
+            return fLit;
+         };
+         level.UpdateStreaming( eye, radius );
+         for( int tick = 0; tick < 1000 && !fAllLit(); ++tick )
+         {
+            level.Update( TICK_INTERVAL );
+            std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+         }
+         check( fAllLit() );
+
+         // Stand two blocks above the surface at the origin column
+         surfaceY = CHUNK_SIZE_Y - 1;
+         while( surfaceY > 0 && level.GetBlock( WorldBlockPos { 8, surfaceY, 8 } ).GetId() == BlockId::Air )
+            --surfaceY;
+         eye.y = static_cast< float >( surfaceY ) + 2.0f;
+
+         // A renderer that meshes the view and goes away leaves its ids to be handed out again to the one that draws
+         {
+            ChunkRenderer scratch;
+            scratch.Update( level, eye, radius );
+         }
+         play( toPlayed );
+         meshView( renderSystem, playedDevice, &toPlayed );
+
+         playedDevice.Reset();
+         const RenderSystem::FrameContext ctx = frameContext();
+         renderSystem.Run( ctx );
+         report.packetBytes    = packet.stream.size();
+         report.packetCommands = packet.commands;
+         play( toPlayed );
+         played = Canonical( playedDevice.GetCommands() );
+
+         // Later frames, timed; nothing moved, so each plays the same as the one before
+         std::vector< RenderCommand > previous;
+         double                       recordMs = 0.0, playMs = 0.0;
+         const int                    frames   = ( std::max )( options.frames, 1 );
+         for( int frame = 0; frame < frames; ++frame )
+         {
+            playedDevice.Reset();
+            const auto start = std::chrono::steady_clock::now();
+            renderSystem.Run( ctx );
+            const auto recorded = std::chrono::steady_clock::now();
+            toPlayed.Play( packet );
+            const auto finished = std::chrono::steady_clock::now();
+            packet.Clear();
+
+            recordMs += std::chrono::duration< double, std::milli >( recorded - start ).count();
+            playMs += std::chrono::duration< double, std::milli >( finished - recorded ).count();
+
+            std::vector< RenderCommand > commands = Canonical( playedDevice.GetCommands() );
+            check( frame == 0 || CountMismatches( commands, previous ) == 0 );
+            previous = std::move( commands );
+         }
+         report.recordMicroseconds = recordMs * 1000.0 / frames;
+         report.playMicroseconds   = playMs * 1000.0 / frames;
+      }
+      play( toPlayed );
+
+      // The same frame straight into a null device, from a renderer that starts with an empty frame and meshes the
+      // same level, as the first one did
+      {
+         const ScopedRenderDevice scopedDirect( directDevice );
+         RenderSystem renderSystem( level );
+         renderSystem.Run( frameContext() );
+         meshView( renderSystem, directDevice, nullptr );
+
+         directDevice.Reset();
+         renderSystem.Run( frameContext() );
+         const std::vector< RenderCommand > direct = Canonical( directDevice.GetCommands() );
+
+         report.commands           = direct.size();
+         report.mismatchedCommands = CountMismatches( played, direct );
+         check( report.commands > 0 && report.mismatchedCommands == 0 );
+         check( std::ranges::any_of( direct, []( const RenderCommand& command )
+         {
+            return command.type == RenderCommand::Type::MultiDrawIndirect && command.elements > 0;
+         } ) );
+      }
+   }
+
+   return report;
+}
+
+} // namespace Tools
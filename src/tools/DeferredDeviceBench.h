@@ -0,0 +1,34 @@
+#pragma once
+
+namespace Tools
+{
+
+struct DeferredDeviceBenchOptions
+{
+   int      radius { 6 }; // view radius in chunks around the origin
+   uint64_t seed { 1 };
+   int      frames { 100 }; // recorded and played after the compared one, for timing
+};
+
+struct DeferredDeviceBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // played frames that differ from direct ones, ids or uniforms that play wrongly
+
+   size_t commands { 0 };          // in the compared frame, as the null device records it
+   size_t mismatchedCommands { 0 }; // played against direct, after ids and locations are numbered by first use
+   size_t packetBytes { 0 };       // of one recorded frame
+   size_t packetCommands { 0 };
+
+   double recordMicroseconds { 0.0 }; // RenderSystem::Run into a packet, per frame
+   double playMicroseconds { 0.0 };   // playing that packet into the null device
+};
+
+// Checks DeferredRenderDevice and RenderPacketPlayer. A short sequence of calls checks that an id handed out again
+// after a delete plays as the new object and that a uniform the program lacks plays as -1. Then a RenderSystem frame
+// over generated terrain is recorded into a packet and played into NullRenderDevice, and compared with the same
+// frame recorded straight into a NullRenderDevice. Must be the first thing in the process to use the renderer, and
+// expects to run from the directory the game runs from, since shaders and textures load from assets/.
+DeferredDeviceBenchReport BenchDeferredDevice( const DeferredDeviceBenchOptions& options );
+
+} // namespace Tools
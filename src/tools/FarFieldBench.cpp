@@ -0,0 +1,70 @@
+#include "pch_server.h"
+
+#include "FarFieldBench.h"
+
+#include <Engine/World/FarField.h>
+#include <Engine/World/RunLengthCodec.h>
+#include <Engine/World/TerrainGenerator.h>
+
+namespace Tools
+{
+
+FarFieldBenchReport BenchFarField( const FarFieldBenchOptions& options )
+{
+   using Clock = std::chrono::steady_clock;
+   auto msSince = []( Clock::time_point start ) { return std::chrono::duration< double, std::milli >( Clock::now() - start ).count(); };
+
+   FarFieldBenchReport report;
+   TerrainGenerator    generator( options.seed );
+   FarField            farField;
+
+   for( int cz = -options.radius; cz <= options.radius; ++cz )
+   {
+      for( int cx = -options.radius; cx <= options.radius; ++cx )
+      {
+         const ChunkSnapshot snapshot = generator.Generate( ChunkPos { cx, cz } );
+         report.detailedBytes += static_cast< size_t >( std::ranges::count_if( snapshot.sections, []( const SectionBlocksPtr& p ) { return p != nullptr; } ) ) * sizeof( SectionBlocks );
+         report.coldBytes += RunLengthCodec::Encode( snapshot.Encode() ).size();
+
+         const auto start = Clock::now();
+         farField.Summarize( snapshot );
+         report.buildMilliseconds += msSince( start );
+      }
+   }
+
+   const FarField::Stats stats = farField.GetStats();
+   report.columns              = stats.columns;
+   report.nodes                = stats.nodes;
+   report.farFieldBytes        = stats.nodeBytes + stats.columnBytes;
+   report.indexBytes           = stats.indexBytes;
+
+   // Rays leave from above the origin in every direction, mostly shallow so they cross many columns
+   TickRng     rng( options.seed );
+   const float reach = static_cast< float >( options.radius * CHUNK_SIZE_X );
+   auto        start = Clock::now();
+   for( int i = 0; i < options.rays; ++i )
+   {
+      const float     yaw   = glm::radians( rng.NextBelow( 3600 ) / 10.0f );
+      const float     pitch = glm::radians( -( rng.NextBelow( 300 ) / 10.0f ) );
+      const glm::vec3 direction( glm::cos( yaw ) * glm::cos( pitch ), glm::sin( pitch ), glm::sin( yaw ) * glm::cos( pitch ) );
+      report.rayHits += farField.Raycast( Ray { .origin = glm::vec3( 8.0f, CHUNK_SIZE_Y - 8.0f, 8.0f ), .direction = direction, .maxDistance = reach } ) ? 1 : 0;
+   }
+   report.rayMilliseconds = msSince( start );
+
+   std::vector< FarField::CoarseQuad > quads;
+   start = Clock::now();
+   for( int cz = -options.radius; cz <= options.radius; ++cz )
+   {
+      for( int cx = -options.radius; cx <= options.radius; ++cx )
+      {
+         quads.clear();
+         farField.ExtractCoarseMesh( ChunkPos { cx, cz }, options.lod, quads );
+         report.coarseQuads += quads.size();
+      }
+   }
+   report.meshMilliseconds = msSince( start );
+
+   return report;
+}
+
+} // namespace Tools
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace Tools
+{
+
+struct FarFieldBenchOptions
+{
+   int      radius { 32 };  // chunks around the origin summarized into the far field
+   uint64_t seed { 1 };
+   int      lod { 2 };      // coarse mesh level extracted for every column, 0 to 4
+   int      rays { 10000 }; // long-distance rays cast from above the origin
+};
+
+struct FarFieldBenchReport
+{
+   size_t columns { 0 };
+   size_t nodes { 0 };
+   size_t farFieldBytes { 0 }; // nodes and column roots; the intern table is reported separately
+   size_t indexBytes { 0 };
+   size_t detailedBytes { 0 }; // unpacked sections of the same columns
+   size_t coldBytes { 0 };     // the same columns encoded as the cold residency tier stores them
+   size_t rayHits { 0 };
+   size_t coarseQuads { 0 };
+   double buildMilliseconds { 0.0 }; // summarizing only; generation is not counted
+   double rayMilliseconds { 0.0 };
+   double meshMilliseconds { 0.0 };
+};
+
+// Generates a throwaway set of columns with the given seed, summarizes them into a FarField and measures its
+// memory, build time, raycasts across the whole area and coarse mesh extraction
+FarFieldBenchReport BenchFarField( const FarFieldBenchOptions& options );
+
+} // namespace Tools
@@ -0,0 +1,45 @@
+#include "pch_server.h"
+
+#include "FeatureBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/World/Level.h>
+#include <Engine/World/PendingFeatureWrites.h>
+
+namespace Tools
+{
+
+FeatureBenchReport BenchFeatures( const FeatureBenchOptions& options )
+{
+   const ScratchWorld world( "FeatureBench", options.seed );
+
+   FeatureBenchReport report;
+   report.chunksRequested = static_cast< size_t >( ( 2 * options.radius + 1 ) * ( 2 * options.radius + 1 ) );
+   {
+      Level level( world.GetDir() );
+
+      const auto start = std::chrono::steady_clock::now();
+      level.UpdateStreaming( glm::vec3( 0.0f ), static_cast< uint8_t >( options.radius ) );
+      report.milliseconds = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+
+      report.chunksLoaded  = level.GetChunks().Size();
+      report.pendingChunks = level.GetPendingFeatureWrites().ChunkCount();
+      report.pendingWrites = level.GetPendingFeatureWrites().WriteCount();
+      level.GetChunks().ForEach( [ &report ]( const Chunk& chunk )
+      {
+         for( const ChunkSection& section : chunk.GetSections() )
+         {
+            if( const SectionBlocksPtr pBlocks = section.Snapshot() )
+            {
+               report.logs += std::ranges::count( *pBlocks, BlockState( BlockId::Log ) );
+               report.leaves += std::ranges::count( *pBlocks, BlockState( BlockId::Leaves ) );
+            }
+         }
+      } );
+   }
+
+   return report;
+}
+
+} // namespace Tools
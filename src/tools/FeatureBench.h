@@ -0,0 +1,26 @@
+#pragma once
+
+namespace Tools
+{
+
+struct FeatureBenchOptions
+{
+   int      radius { 16 }; // chunks around the origin
+   uint64_t seed { 1 };    // pick one whose origin sits in dense forest to stress cross-chunk trees
+};
+
+struct FeatureBenchReport
+{
+   size_t chunksRequested { 0 };
+   size_t chunksLoaded { 0 }; // equal to chunksRequested unless generation cascaded into neighbors
+   size_t logs { 0 };
+   size_t leaves { 0 };
+   size_t pendingChunks { 0 }; // chunks outside the radius still waiting on spilled feature blocks
+   size_t pendingWrites { 0 };
+   double milliseconds { 0.0 };
+};
+
+// Generates a throwaway world with the given seed and measures chunk generation with feature placement
+FeatureBenchReport BenchFeatures( const FeatureBenchOptions& options );
+
+} // namespace Tools
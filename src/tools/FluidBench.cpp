@@ -0,0 +1,232 @@
+#include "pch_server.h"
+
+#include "FluidBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/World/FluidSimulator.h>
+#include <Engine/World/Level.h>
+
+namespace Tools
+{
+
+namespace
+{
+
+constexpr float TICK_INTERVAL = 1.0f / 20.0f; // the application's fixed tick rate
+
+constexpr std::array< glm::ivec3, 4 > kHorizontal = {
+   glm::ivec3 { 1, 0, 0 },
+   glm::ivec3 { -1, 0, 0 },
+   glm::ivec3 { 0, 0, 1 },
+   glm::ivec3 { 0, 0, -1 },
+};
+
+struct FluidCount
+{
+   size_t cells { 0 };
+   size_t unsettled { 0 };
+};
+
+
+ChunkPos ChunkOf( const WorldBlockPos& pos )
+{
+   auto divFloor = []( int a, int b ) { return a / b - ( a % b < 0 ? 1 : 0 ); };
+   return ChunkPos { divFloor( pos.x, CHUNK_SIZE_X ), divFloor( pos.z, CHUNK_SIZE_Z ) };
+}
+
+
+int SurfaceY( const Level& level, int x, int z )
+{
+   int y = CHUNK_SIZE_Y - 1;
+   while( y > 0 && level.GetBlock( WorldBlockPos { x, y, z } ).GetId() == BlockId::Air )
+      --y;
+   return y;
+}
+
+
+// The block at `pos`, or nullopt outside the loaded chunks, the way FluidSimulator reads it
+std::optional< BlockState > Read( const Level& level, const WorldBlockPos& pos )
+{
+   if( pos.y < 0 || pos.y >= CHUNK_SIZE_Y || !level.GetChunks().Peek( ChunkOf( pos ) ) )
+      return std::nullopt;
+
+   return level.GetBlock( pos );
+}
+
+
+// Whether updating the fluid at `pos` would write anything, by the rules FluidSimulator documents: flowing fluid
+// one weaker than what feeds it, falling into air, spreading into air, and water and lava making stone
+bool FWouldFlow( const Level& level, const WorldBlockPos& pos )
+{
+   const BlockState state = level.GetBlock( pos );
+   const BlockId    id    = state.GetId();
+   const int        step  = id == BlockId::Lava ? 2 : 1;
+   auto             fSame = [ id ]( const std::optional< BlockState >& optOther ) { return optOther && optOther->GetId() == id; };
+
+   if( state.GetFluidLevel() != 0 )
+   {
+      int want = FLUID_LEVEL_MAX + 1;
+      if( fSame( Read( level, WorldBlockPos { pos.x, pos.y + 1, pos.z } ) ) )
+         want = 1;
+      else
+      {
+         for( const glm::ivec3& d : kHorizontal )
+         {
+            const std::optional< BlockState > optNeighbor = Read( level, WorldBlockPos { pos.x + d.x, pos.y, pos.z + d.z } );
+            if( fSame( optNeighbor ) )
+               want = ( std::min )( want, optNeighbor->GetFluidLevel() + step );
+         }
+      }
+
+      if( want != state.GetFluidLevel() )
+         return true;
+   }
+
+   const std::optional< BlockState > optBelow = Read( level, WorldBlockPos { pos.x, pos.y - 1, pos.z } );
+   if( !optBelow )
+      return false;
+   if( optBelow->GetId() == BlockId::Air )
+      return true;
+   if( FFluid( *optBelow ) && ( optBelow->GetId() != id || optBelow->GetFluidLevel() != 0 ) )
+      return optBelow->GetId() != id;
+
+   if( state.GetFluidLevel() + step > FLUID_LEVEL_MAX )
+      return false;
+
+   for( const glm::ivec3& d : kHorizontal )
+   {
+      const std::optional< BlockState > optNeighbor = Read( level, WorldBlockPos { pos.x + d.x, pos.y, pos.z + d.z } );
+      if( optNeighbor && ( optNeighbor->GetId() == BlockId::Air || ( FFluid( *optNeighbor ) && optNeighbor->GetId() != id ) ) )
+         return true;
+   }
+   return false;
+}
+
+
+FluidCount CountFluid( const Level& level )
+{
+   FluidCount count;
+   level.GetChunks().ForEach( [ &level, &count ]( const Chunk& chunk )
+   {
+      const ChunkPos cpos = chunk.GetChunkPos();
+      for( int y = 0; y < CHUNK_SIZE_Y; ++y )
+      {
+         for( int z = 0; z < CHUNK_SIZE_Z; ++z )
+         {
+            for( int x = 0; x < CHUNK_SIZE_X; ++x )
+            {
+               if( !FFluid( chunk.GetBlock( LocalBlockPos { x, y, z } ) ) )
+                  continue;
+
+               ++count.cells;
+               count.unsettled += FWouldFlow( level, WorldBlockPos { cpos.x * CHUNK_SIZE_X + x, y, cpos.z * CHUNK_SIZE_Z + z } ) ? 1 : 0;
+            }
+         }
+      }
+   } );
+   return count;
+}
+
+} // namespace
+
+
+FluidBenchReport BenchFluids( const FluidBenchOptions& options )
+{
+   FluidBenchReport report;
+   auto             check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   const ScratchWorld world( "FluidBench", options.seed );
+   Level              level( world.GetDir() );
+   level.UpdateStreaming( glm::vec3( 0.0f ), static_cast< uint8_t >( options.radius ) );
+
+   // Ticks until the simulator has nothing left to update; 0 if it does not settle in time
+   auto settle = [ & ]() -> size_t
+   {
+      for( int tick = 1; tick <= options.maxTicks; ++tick )
+      {
+         level.Update( TICK_INTERVAL );
+
+         const Level::FluidStats& stats = level.GetFluidStats();
+         report.peakCellsUpdated = ( std::max )( report.peakCellsUpdated, stats.cellsUpdated );
+         report.fullBudgetTicks += stats.cellsUpdated == FluidSimulator::UPDATE_BUDGET ? 1 : 0;
+         report.blocksWritten += stats.blocksWritten;
+         if( stats.activeCells == 0 )
+            return static_cast< size_t >( tick );
+      }
+      return 0;
+   };
+
+   // Water and lava close enough to meet, and one of each on its own
+   std::vector< WorldBlockPos > sources;
+   auto                         pour = [ & ]( int x, int z, BlockId fluid )
+   {
+      sources.push_back( WorldBlockPos { x, SurfaceY( level, x, z ) + 1, z } );
+      level.SetBlock( sources.back(), BlockState( fluid ) );
+   };
+   pour( 0, 0, BlockId::Water );
+   pour( 6, 0, BlockId::Lava );
+   pour( -20, 12, BlockId::Water );
+   pour( 12, -20, BlockId::Lava );
+
+   report.pourTicks = settle();
+   check( report.pourTicks > 0 );
+
+   FluidCount count = CountFluid( level );
+   report.unsettledCells += count.unsettled;
+   check( count.unsettled == 0 );
+
+   // A sheet of sources high above the ground falls and spreads all at once, more cells than one tick updates
+   const int half = options.flood / 2;
+   int       top  = 0;
+   for( int x = -half; x < options.flood - half; ++x )
+   {
+      for( int z = -half; z < options.flood - half; ++z )
+         top = ( std::max )( top, SurfaceY( level, x, z ) );
+   }
+   top = ( std::min )( top + 8, CHUNK_SIZE_Y - 1 );
+
+   std::vector< Level::BlockWrite > flood;
+   for( int x = -half; x < options.flood - half; ++x )
+   {
+      for( int z = -half; z < options.flood - half; ++z )
+      {
+         flood.push_back( Level::BlockWrite { WorldBlockPos { x, top, z }, BlockState( BlockId::Water ) } );
+         sources.push_back( WorldBlockPos { x, top, z } );
+      }
+   }
+   level.SetBlocks( flood );
+
+   report.floodTicks = settle();
+   check( report.floodTicks > 0 );
+   check( report.peakCellsUpdated <= FluidSimulator::UPDATE_BUDGET );
+   if( flood.size() >= FluidSimulator::UPDATE_BUDGET )
+      check( report.fullBudgetTicks > 0 );
+
+   count             = CountFluid( level );
+   report.fluidCells = count.cells;
+   report.unsettledCells += count.unsettled;
+   check( count.unsettled == 0 );
+
+   // Without its sources every flowing cell weakens past FLUID_LEVEL_MAX and dries up
+   std::vector< Level::BlockWrite > drain;
+   for( const WorldBlockPos& pos : sources )
+      drain.push_back( Level::BlockWrite { pos, BlockState( BlockId::Air ) } );
+   level.SetBlocks( drain );
+
+   report.drainTicks = settle();
+   check( report.drainTicks > 0 );
+
+   count                 = CountFluid( level );
+   report.remainingCells = count.cells;
+   report.unsettledCells += count.unsettled;
+   check( count.cells == 0 );
+
+   return report;
+}
+
+} // namespace Tools
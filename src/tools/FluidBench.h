@@ -0,0 +1,36 @@
+#pragma once
+
+namespace Tools
+{
+
+struct FluidBenchOptions
+{
+   int      radius { 3 };       // view radius in chunks around the origin
+   uint64_t seed { 1 };
+   int      flood { 64 };       // side of the square of water sources dropped onto the terrain at once
+   int      maxTicks { 20000 }; // for each phase to settle in
+};
+
+struct FluidBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // phases that did not settle, ticks over budget, cells left flowing or wet
+
+   size_t pourTicks { 0 };        // ticks until a few water and lava sources on the surface settled
+   size_t floodTicks { 0 };       // ticks until the flood settled
+   size_t drainTicks { 0 };       // ticks until everything dried up with the sources removed
+   size_t fullBudgetTicks { 0 };  // ticks that updated UPDATE_BUDGET cells and left the rest for later
+   size_t peakCellsUpdated { 0 }; // in one tick, never more than UPDATE_BUDGET
+   size_t blocksWritten { 0 };
+   size_t fluidCells { 0 };       // water and lava in the loaded chunks once the flood settled
+   size_t unsettledCells { 0 };   // fluid that would still flow if updated, after each phase settled
+   size_t remainingCells { 0 };   // fluid left once the drain settled
+};
+
+// Pours water and lava onto generated terrain and ticks the level until FluidSimulator reports nothing left to
+// update, then checks that no fluid cell would change if it were updated anyway. A flood of sources larger than
+// the per-tick budget checks the budget holds and the backlog still drains; removing every source checks all the
+// flowing fluid dries up again.
+FluidBenchReport BenchFluids( const FluidBenchOptions& options );
+
+} // namespace Tools
@@ -0,0 +1,77 @@
+#include "pch_server.h"
+
+#include "FrustumBench.h"
+
+#include <Engine/World/FrustumCuller.h>
+#include <Engine/World/Level.h>
+
+namespace Tools
+{
+
+FrustumBenchReport BenchFrustum( const FrustumBenchOptions& options )
+{
+   FrustumBenchReport report;
+
+   // Laid out the way ChunkRenderer fills it: one full-height column per chunk, then its sections bottom up
+   FrustumCuller                                    culler;
+   std::vector< std::pair< glm::vec3, glm::vec3 > > boxes;
+   for( int cz = -options.radius; cz <= options.radius; ++cz )
+   {
+      for( int cx = -options.radius; cx <= options.radius; ++cx )
+      {
+         const glm::vec3 columnMin( static_cast< float >( cx * CHUNK_SIZE_X ), 0.0f, static_cast< float >( cz * CHUNK_SIZE_Z ) );
+         culler.AddColumn( columnMin, columnMin + glm::vec3( CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z ) );
+         for( int sy = 0; sy < SECTIONS_PER_CHUNK; ++sy )
+         {
+            const glm::vec3 secMin = columnMin + glm::vec3( 0.0f, static_cast< float >( sy * CHUNK_SECTION_SIZE ), 0.0f );
+            const glm::vec3 secMax = secMin + glm::vec3( CHUNK_SIZE_X, CHUNK_SECTION_SIZE, CHUNK_SIZE_Z );
+            culler.Add( secMin, secMax );
+            boxes.emplace_back( secMin, secMax );
+         }
+         ++report.columns;
+      }
+   }
+   report.boxes = boxes.size();
+
+   const glm::mat4 projection = glm::perspective( glm::radians( 70.0f ), 16.0f / 9.0f, 0.1f, 1000.0f );
+   const glm::vec3 eye( 8.0f, 80.0f, 8.0f );
+
+   using Clock = std::chrono::steady_clock;
+   TickRng                 rng( options.seed );
+   std::vector< uint32_t > batched, scalar;
+   double                  batchedMs = 0.0, scalarMs = 0.0;
+   size_t                  visibleTotal = 0;
+   for( int frame = 0; frame < ( std::max )( options.frames, 1 ); ++frame )
+   {
+      // Any heading, pitched at most 60 degrees up or down
+      const float       yaw   = glm::radians( static_cast< float >( rng.NextBelow( 360 ) ) );
+      const float       pitch = glm::radians( static_cast< float >( rng.NextBelow( 121 ) ) - 60.0f );
+      const glm::vec3   forward( std::cos( pitch ) * std::cos( yaw ), std::sin( pitch ), std::cos( pitch ) * std::sin( yaw ) );
+      const ViewFrustum frustum( projection * glm::lookAt( eye, eye + forward, glm::vec3( 0.0f, 1.0f, 0.0f ) ) );
+
+      auto start = Clock::now();
+      culler.Cull( frustum, batched );
+      batchedMs += std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+
+      start = Clock::now();
+      scalar.clear();
+      for( const auto& [ index, box ] : boxes | std::views::enumerate )
+      {
+         if( frustum.FInFrustum( box.first, box.second ) )
+            scalar.push_back( static_cast< uint32_t >( index ) );
+      }
+      scalarMs += std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+
+      ++report.checks;
+      report.failedChecks += batched == scalar ? 0 : 1;
+      visibleTotal += batched.size();
+   }
+
+   const double frames        = ( std::max )( options.frames, 1 );
+   report.visibleBoxes        = static_cast< double >( visibleTotal ) / frames;
+   report.batchedMicroseconds = batchedMs * 1000.0 / frames;
+   report.scalarMicroseconds  = scalarMs * 1000.0 / frames;
+   return report;
+}
+
+} // namespace Tools
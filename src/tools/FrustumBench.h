@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Tools
+{
+
+struct FrustumBenchOptions
+{
+   int      radius { 32 }; // chunk columns around the origin, 16 section boxes each
+   uint64_t seed { 1 };
+   int      frames { 200 }; // random camera orientations
+};
+
+struct FrustumBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // frames where the batched and per-box results differ
+
+   size_t boxes { 0 };
+   size_t columns { 0 };
+   double visibleBoxes { 0.0 };        // per frame, on average
+   double batchedMicroseconds { 0.0 }; // per frame: FrustumCuller::Cull
+   double scalarMicroseconds { 0.0 };  // per frame: ViewFrustum::FInFrustum on every box
+};
+
+// Culls a grid of section boxes the size of a radius-`radius` view with FrustumCuller, checking each frame's
+// visible list against testing every box on its own and timing both
+FrustumBenchReport BenchFrustum( const FrustumBenchOptions& options );
+
+} // namespace Tools
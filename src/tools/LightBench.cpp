@@ -0,0 +1,258 @@
+#include "pch_server.h"
+
+#include "LightBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/World/Level.h>
+
+namespace Tools
+{
+
+namespace
+{
+
+constexpr float TICK_INTERVAL = 1.0f / 20.0f; // the application's fixed tick rate
+
+// Light and blocks of one chunk, cell by cell in y/z/x order
+struct ChunkLight
+{
+   std::vector< uint8_t >    sky;
+   std::vector< uint8_t >    block;
+   std::vector< BlockState > blocks;
+};
+
+using LightMap = std::unordered_map< ChunkPos, ChunkLight, ChunkPosHash >;
+
+
+// Light is computed off-thread when chunks load; ticks the level until every loaded chunk has it
+bool FWaitForLight( Level& level )
+{
+   auto fAllLit = [ &level ]()
+   {
+      bool fLit = true;
+      level.GetChunks().ForEach( [ &fLit ]( const Chunk& chunk ) { fLit &= chunk.FLit(); } );
+      return fLit;
+   };
+   for( int tick = 0; tick < 1000 && !fAllLit(); ++tick )
+   {
+      level.Update( TICK_INTERVAL );
+      std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+   }
+   return fAllLit();
+}
+
+
+LightMap RecordLight( const Level& level, int radius )
+{
+   LightMap light;
+   for( int cx = -radius; cx <= radius; ++cx )
+   {
+      for( int cz = -radius; cz <= radius; ++cz )
+      {
+         const Chunk* pChunk = level.GetChunks().Peek( ChunkPos { cx, cz } );
+         if( !pChunk )
+            continue;
+
+         ChunkLight& chunk = light[ pChunk->GetChunkPos() ];
+         chunk.sky.reserve( CHUNK_VOLUME );
+         chunk.block.reserve( CHUNK_VOLUME );
+         chunk.blocks.reserve( CHUNK_VOLUME );
+         for( int y = 0; y < CHUNK_SIZE_Y; ++y )
+         {
+            for( int z = 0; z < CHUNK_SIZE_Z; ++z )
+            {
+               for( int x = 0; x < CHUNK_SIZE_X; ++x )
+               {
+                  const LocalBlockPos local { x, y, z };
+                  chunk.sky.push_back( pChunk->GetSkyLight( local ) );
+                  chunk.block.push_back( pChunk->GetBlockLight( local ) );
+                  chunk.blocks.push_back( pChunk->GetBlock( local ) );
+               }
+            }
+         }
+      }
+   }
+   return light;
+}
+
+
+int SurfaceY( const Level& level, int x, int z )
+{
+   int y = CHUNK_SIZE_Y - 1;
+   while( y > 0 && level.GetBlock( WorldBlockPos { x, y, z } ).GetId() == BlockId::Air )
+      --y;
+   return y;
+}
+
+} // namespace
+
+
+LightBenchReport BenchLighting( const LightBenchOptions& options )
+{
+   LightBenchReport report;
+   auto             check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   // The outermost ring is lit without all of its neighbors, so it is streamed but not compared. Edits stay a
+   // further chunk in, where the light they move (at most 15 blocks) never reaches that ring.
+   const int     radius         = ( std::max )( options.radius, 2 );
+   const int     comparedRadius = radius - 1;
+   const int     editMin        = -( radius - 2 ) * CHUNK_SIZE_X;
+   const int     editMax        = ( radius - 1 ) * CHUNK_SIZE_X - 1;
+   const size_t  chunks         = static_cast< size_t >( ( 2 * comparedRadius + 1 ) * ( 2 * comparedRadius + 1 ) );
+   const uint8_t viewRadius     = static_cast< uint8_t >( radius );
+
+   const ScratchWorld world( "LightBench", options.seed );
+
+   LightMap incremental;
+   {
+      Level level( world.GetDir() );
+      level.UpdateStreaming( glm::vec3( 0.0f ), viewRadius );
+      check( FWaitForLight( level ) );
+
+      // Nothing ticks the level from here on, so the only changes are the edits and the relighting they cause
+      const LightMap before = RecordLight( level, comparedRadius );
+
+      std::mt19937_64                      rng( options.seed );
+      std::uniform_int_distribution< int > column( editMin, editMax );
+      auto                                 clampY = []( int y ) { return std::clamp( y, 1, CHUNK_SIZE_Y - 1 ); };
+      auto                                 below  = [ &rng ]( int n ) { return static_cast< int >( rng() % static_cast< uint64_t >( n ) ); };
+
+      std::vector< WorldBlockPos > furnaces;
+      size_t                       writes     = 0;
+      int                          explosions = 0;
+
+      const auto start             = std::chrono::steady_clock::now();
+      const int  editsPerExplosion = options.explosions > 0 ? ( std::max )( options.edits / options.explosions, 1 ) : ( std::numeric_limits< int >::max )();
+      for( int edit = 0; edit < options.edits || explosions < options.explosions; ++edit )
+      {
+         const int x       = column( rng );
+         const int z       = column( rng );
+         const int surface = SurfaceY( level, x, z );
+
+         if( edit % editsPerExplosion == editsPerExplosion - 1 && explosions < options.explosions )
+         {
+            // Every other one is buried, opening a cave the sky does not reach
+            const int depth = explosions % 2 ? 4 + below( 6 ) : 0;
+            level.Explode( WorldBlockPos { x, clampY( surface - depth ), z }, static_cast< uint8_t >( 2 + below( 3 ) ) );
+            ++explosions;
+            ++writes;
+         }
+
+         if( edit >= options.edits )
+            continue;
+
+         switch( below( 4 ) )
+         {
+            case 0:
+            {
+               level.SetBlock( WorldBlockPos { x, surface, z }, BlockState( BlockId::Air ) );
+               break;
+            }
+            case 1:
+            {
+               const BlockId shade = below( 2 ) ? BlockId::Stone : BlockId::Leaves;
+               level.SetBlock( WorldBlockPos { x, clampY( surface + 1 + below( 4 ) ), z }, BlockState( shade ) );
+               break;
+            }
+            case 2:
+            {
+               furnaces.push_back( WorldBlockPos { x, clampY( surface - below( 4 ) ), z } );
+               level.SetBlock( furnaces.back(), BlockState( BlockId::Furnace ) );
+               break;
+            }
+            default:
+            {
+               // Takes a light away again while light from the others still crosses the cells it lit
+               const WorldBlockPos pos = furnaces.empty() ? WorldBlockPos { x, clampY( surface - 1 ), z } : furnaces[ below( static_cast< int >( furnaces.size() ) ) ];
+               level.SetBlock( pos, BlockState( BlockId::Air ) );
+               break;
+            }
+         }
+         ++writes;
+      }
+
+      // A roof with a furnace under it shades the ground in one batch; a second batch opens a hole in its middle
+      constexpr int ROOF_HALF = 4;
+      for( int batch = 0; batch < options.batches; ++batch )
+      {
+         const int x = std::clamp( column( rng ), editMin + ROOF_HALF, editMax - ROOF_HALF );
+         const int z = std::clamp( column( rng ), editMin + ROOF_HALF, editMax - ROOF_HALF );
+         const int y = clampY( SurfaceY( level, x, z ) + 5 );
+
+         std::vector< Level::BlockWrite > roof;
+         for( int dx = -ROOF_HALF; dx <= ROOF_HALF; ++dx )
+         {
+            for( int dz = -ROOF_HALF; dz <= ROOF_HALF; ++dz )
+               roof.push_back( Level::BlockWrite { WorldBlockPos { x + dx, y, z + dz }, BlockState( BlockId::Stone ) } );
+         }
+         roof.push_back( Level::BlockWrite { WorldBlockPos { x, y - 1, z }, BlockState( BlockId::Furnace ) } );
+         level.SetBlocks( roof );
+
+         std::vector< Level::BlockWrite > hole;
+         for( int dx = -1; dx <= 1; ++dx )
+         {
+            for( int dz = -1; dz <= 1; ++dz )
+               hole.push_back( Level::BlockWrite { WorldBlockPos { x + dx, y, z + dz }, BlockState( BlockId::Air ) } );
+         }
+         level.SetBlocks( hole );
+         writes += roof.size() + hole.size();
+      }
+
+      const double microseconds  = std::chrono::duration< double, std::micro >( std::chrono::steady_clock::now() - start ).count();
+      report.microsecondsPerEdit = writes > 0 ? microseconds / static_cast< double >( writes ) : 0.0;
+
+      incremental = RecordLight( level, comparedRadius );
+      for( const auto& [ cpos, after ] : incremental )
+      {
+         auto it = before.find( cpos );
+         if( it == before.end() )
+            continue;
+
+         for( size_t i = 0; i < CHUNK_VOLUME; ++i )
+            report.relitCells += after.sky[ i ] != it->second.sky[ i ] || after.block[ i ] != it->second.block[ i ];
+      }
+      check( report.relitCells > 0 );
+   } // saved here
+
+   // The same chunks, loaded from what was just saved and lit from scratch
+   Level level( world.GetDir() );
+   level.UpdateStreaming( glm::vec3( 0.0f ), viewRadius );
+   check( FWaitForLight( level ) );
+
+   const LightMap relit = RecordLight( level, comparedRadius );
+   check( incremental.size() == chunks && relit.size() == chunks );
+
+   // Ticking the reopened level while it lights may let smothered grass die back; dirt lets no more light through
+   auto fSameBlock = []( BlockState a, BlockState b )
+   {
+      auto fSoil = []( BlockState state ) { return state.GetId() == BlockId::Grass || state.GetId() == BlockId::Dirt; };
+      return a == b || ( fSoil( a ) && fSoil( b ) );
+   };
+   for( const auto& [ cpos, expected ] : incremental )
+   {
+      auto it = relit.find( cpos );
+      if( it == relit.end() )
+         continue;
+
+      ++report.chunks;
+      const ChunkLight& actual = it->second;
+      for( size_t i = 0; i < CHUNK_VOLUME; ++i )
+      {
+         report.mismatchedSky += expected.sky[ i ] != actual.sky[ i ];
+         report.mismatchedBlock += expected.block[ i ] != actual.block[ i ];
+         report.changedBlocks += !fSameBlock( expected.blocks[ i ], actual.blocks[ i ] );
+      }
+   }
+   check( report.mismatchedSky == 0 );
+   check( report.mismatchedBlock == 0 );
+   check( report.changedBlocks == 0 );
+
+   return report;
+}
+
+} // namespace Tools
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace Tools
+{
+
+struct LightBenchOptions
+{
+   int      radius { 4 };      // view radius in chunks around the origin; edits stay two chunks inside it
+   uint64_t seed { 1 };
+   int      edits { 256 };     // random digs, placements, furnaces and leaves on the surface, one relight each
+   int      explosions { 16 }; // spread through the edits, some of them buried
+   int      batches { 8 };     // SetBlocks roofs over the surface, each opened up again by a second batch
+};
+
+struct LightBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // cells lit differently than a from-scratch relight, blocks lost on reload
+
+   size_t chunks { 0 };                // compared, out to one chunk inside the view radius
+   size_t relitCells { 0 };            // cells whose light the edits changed
+   size_t mismatchedSky { 0 };         // cells whose sky light differs from the relight
+   size_t mismatchedBlock { 0 };       // cells whose block light differs from the relight
+   size_t changedBlocks { 0 };         // cells whose block differs after the reload, other than grass dying back
+   double microsecondsPerEdit { 0.0 }; // block write and its synchronous relight, over every kind of edit
+};
+
+// Lights generated terrain, then edits it the way play does: surface digs and placements, furnaces placed and
+// removed again, explosions, and SetBlocks batches that roof the ground over and open it up again, each relit
+// incrementally by LightEngine. The level is then saved and reopened, so every chunk is lit from scratch, and the
+// sky and block light of every cell is compared with what the incremental updates left behind.
+LightBenchReport BenchLighting( const LightBenchOptions& options );
+
+} // namespace Tools
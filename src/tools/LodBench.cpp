@@ -0,0 +1,113 @@
+#include "pch_server.h"
+
+#include "LodBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/Renderer/NullRenderDevice.h>
+#include <Engine/Renderer/Texture.h>
+#include <Engine/World/ChunkRenderer.h>
+#include <Engine/World/Level.h>
+
+namespace Tools
+{
+
+LodBenchReport BenchLod( const LodBenchOptions& options )
+{
+   LodBenchReport report;
+   auto           check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   NullRenderDevice         device;
+   const ScopedRenderDevice scopedDevice( device );
+   TextureAtlasManager::Get().CompileBlockAtlas();
+
+   const ScratchWorld world( "LodBench", options.seed );
+   {
+      constexpr float TICK_INTERVAL = 1.0f / 20.0f; // the application's fixed tick rate
+      const int       farRadius     = ( std::max )( options.farRadius, options.nearRadius );
+
+      Level level( world.GetDir() );
+
+      // Meshes are not built until their chunk is lit, which happens off-thread
+      const glm::vec3 eye( 8.0f, 100.0f, 8.0f );
+      level.UpdateStreaming( eye, static_cast< uint8_t >( farRadius ) );
+      auto fAllLit = [ &level ]()
+      {
+         bool fLit = true;
+         level.GetChunks().ForEach( [ &fLit ]( const Chunk& chunk ) { fLit &= chunk.FLit(); } );
+         return fLit;
+      };
+      for( int tick = 0; tick < 10000 && !fAllLit(); ++tick )
+      {
+         level.Update( TICK_INTERVAL );
+         std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+      }
+      check( fAllLit() );
+
+      // Near view: every section at full detail, as it was drawn before the LOD rings
+      ChunkRenderer::MeshData mesh;
+      level.GetChunks().ForEach( [ & ]( const Chunk& chunk )
+      {
+         const ChunkPos cpos = chunk.GetChunkPos();
+         if( ( std::max )( std::abs( cpos.x ), std::abs( cpos.z ) ) > options.nearRadius )
+            return;
+
+         ++report.nearChunks;
+         for( int i = 0; i < SECTIONS_PER_CHUNK; ++i )
+         {
+            ChunkRenderer::BuildSectionMesh( level, chunk, i, mesh );
+            report.nearVertices += mesh.vertices.size();
+            report.nearQuads += mesh.indices.size() / 6;
+         }
+      } );
+
+      // Far view: whatever ChunkRenderer draws. Coarse columns are built a budget at a time, so keep updating until
+      // every chunk has its mesh.
+      const size_t  farChunks = static_cast< size_t >( ( 2 * farRadius + 1 ) * ( 2 * farRadius + 1 ) );
+      ChunkRenderer renderer;
+      auto          fAllMeshed = [ & ]()
+      {
+         return renderer.GetEntries().size() == farChunks &&
+                std::ranges::all_of( renderer.GetEntries(), []( const auto& entry ) { return entry.second.lod >= 0; } );
+      };
+
+      const auto start = std::chrono::steady_clock::now();
+      for( int update = 0; update < 4096 && !fAllMeshed(); ++update )
+         renderer.Update( level, eye, static_cast< uint8_t >( farRadius ) );
+      report.milliseconds = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+      check( fAllMeshed() );
+
+      const ChunkMeshArena& arena = renderer.GetArena();
+      auto                  count = [ & ]( const ChunkRenderer::SectionEntry& e, int lod )
+      {
+         if( e.mesh == ChunkMeshArena::INVALID_HANDLE )
+            return;
+
+         const ChunkMeshArena::Range& range = arena.GetRange( e.mesh );
+         report.farVertices += range.vertexCount;
+         report.farQuads += range.indexCount / 6;
+         report.farQuadsByLod[ static_cast< size_t >( std::clamp( lod, 0, 3 ) ) ] += range.indexCount / 6;
+      };
+      for( const auto& [ _, entry ] : renderer.GetEntries() )
+      {
+         for( const ChunkRenderer::SectionEntry& section : entry.sections )
+            count( section, 0 );
+
+         count( entry.coarse, entry.lod );
+      }
+      report.farChunks = renderer.GetEntries().size();
+
+      // The rings are only worth having if the wide view costs about what the narrow one did
+      check( report.nearQuads > 0 );
+      check( static_cast< double >( report.farQuads ) <= options.tolerance * static_cast< double >( report.nearQuads ) );
+      check( static_cast< double >( report.farVertices ) <= options.tolerance * static_cast< double >( report.nearVertices ) );
+   }
+
+   return report;
+}
+
+} // namespace Tools
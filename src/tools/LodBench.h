@@ -0,0 +1,36 @@
+#pragma once
+
+namespace Tools
+{
+
+struct LodBenchOptions
+{
+   int      nearRadius { 12 }; // view radius drawn at full detail
+   int      farRadius { 32 };  // view radius drawn with the LOD rings
+   uint64_t seed { 1 };
+   float    tolerance { 1.25f }; // how far the far view may exceed the near one before the check fails
+};
+
+struct LodBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // views left partly unmeshed, or a far view costing more than the tolerance allows
+
+   size_t   nearChunks { 0 };
+   uint64_t nearQuads { 0 };
+   uint64_t nearVertices { 0 };
+
+   size_t                   farChunks { 0 };
+   uint64_t                 farQuads { 0 };
+   uint64_t                 farVertices { 0 };
+   std::array< uint64_t, 4 > farQuadsByLod {}; // lod 0 sections, then the coarse meshes of each ring
+
+   double milliseconds { 0.0 }; // meshing the far view through ChunkRenderer
+};
+
+// Streams generated terrain out to the far radius, then counts the quads and vertices of the near radius meshed at
+// full detail against the far radius meshed by ChunkRenderer with its LOD rings, through NullRenderDevice. Expects
+// to run from the directory the game runs from, since the block atlas loads from assets/.
+LodBenchReport BenchLod( const LodBenchOptions& options );
+
+} // namespace Tools
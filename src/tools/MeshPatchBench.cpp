@@ -0,0 +1,465 @@
+#include "pch_server.h"
+
+#include "MeshPatchBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/Renderer/NullRenderDevice.h>
+#include <Engine/Renderer/Texture.h>
+#include <Engine/World/ChunkRenderer.h>
+#include <Engine/World/Level.h>
+
+namespace Tools
+{
+
+namespace
+{
+
+using Vertex                = ChunkRenderer::Vertex;
+constexpr size_t FACE_COUNT = ChunkRenderer::FACE_COUNT;
+
+// A quad's face group and the bytes of its four vertices
+using QuadBytes = std::array< std::byte, 4 * sizeof( Vertex ) >;
+using Quad      = std::pair< size_t, QuadBytes >;
+
+struct Scratch
+{
+   ChunkRenderer::MeshData                mesh;
+   std::vector< Quad >                    built;
+   std::vector< Quad >                    uploaded;
+   std::unordered_map< uint16_t, size_t > quadsByFace; // quad of the build by block index * FACE_COUNT + face
+};
+
+
+// Meshing uploads go through the copy target, so they are told apart from the per-frame streams
+uint64_t MeshUploadBytes( std::span< const RenderCommand > commands )
+{
+   uint64_t bytes = 0;
+   for( const RenderCommand& command : commands )
+   {
+      if( command.type == RenderCommand::Type::UploadBuffer && command.target == GL_COPY_WRITE_BUFFER )
+         bytes += command.bytes;
+   }
+   return bytes;
+}
+
+
+ChunkPos ChunkOf( const WorldBlockPos& pos )
+{
+   auto divFloor = []( int a, int b ) { return a / b - ( a % b < 0 ? 1 : 0 ); };
+   return ChunkPos { divFloor( pos.x, CHUNK_SIZE_X ), divFloor( pos.z, CHUNK_SIZE_Z ) };
+}
+
+
+int SurfaceY( const Level& level, int x, int z )
+{
+   int y = CHUNK_SIZE_Y - 1;
+   while( y > 0 && level.GetBlock( WorldBlockPos { x, y, z } ).GetId() == BlockId::Air )
+      --y;
+   return y;
+}
+
+
+// Stone walled in by stone on every side, on every other block so holes dug there never touch, and clear of the
+// section's and chunk's borders so each hole's faces stay in its section: a hole adds one quad to every face group
+std::vector< WorldBlockPos > BuriedBlocks( const Level& level, const ChunkPos& cc, int sectionIndex )
+{
+   auto fStone = [ &level ]( int x, int y, int z ) { return level.GetBlock( WorldBlockPos { x, y, z } ).GetId() == BlockId::Stone; };
+
+   std::vector< WorldBlockPos > blocks;
+   for( int ly = 1; ly < CHUNK_SECTION_SIZE - 1; ly += 2 )
+   {
+      for( int lz = 1; lz < CHUNK_SIZE_Z - 1; lz += 2 )
+      {
+         for( int lx = 1; lx < CHUNK_SIZE_X - 1; lx += 2 )
+         {
+            const int x = cc.x * CHUNK_SIZE_X + lx;
+            const int y = sectionIndex * CHUNK_SECTION_SIZE + ly;
+            const int z = cc.z * CHUNK_SIZE_Z + lz;
+            if( fStone( x, y, z ) && fStone( x - 1, y, z ) && fStone( x + 1, y, z ) && fStone( x, y - 1, z ) && fStone( x, y + 1, z ) &&
+                fStone( x, y, z - 1 ) && fStone( x, y, z + 1 ) )
+               blocks.push_back( WorldBlockPos { x, y, z } );
+         }
+      }
+   }
+   return blocks;
+}
+
+
+// Quads of a mesh, a face group at a time, sorted. A quad's six indices must reach the four vertices from the lowest
+// of them, as AddQuad lays them out; any other six come out as a quad of no group, which no build has.
+void ReadQuads( std::span< const std::byte >              vertices,
+                std::span< const std::byte >              indices,
+                const std::array< uint32_t, FACE_COUNT >& faceFirstIndex,
+                const std::array< uint32_t, FACE_COUNT >& faceIndexCounts,
+                std::vector< Quad >&                      out )
+{
+   out.clear();
+   for( size_t face = 0; face < FACE_COUNT; ++face )
+   {
+      for( size_t at = faceFirstIndex[ face ]; at < faceFirstIndex[ face ] + faceIndexCounts[ face ]; at += 6 )
+      {
+         std::array< uint32_t, 6 > quad {};
+         const bool                fIndexed = ( at + quad.size() ) * sizeof( uint32_t ) <= indices.size();
+         if( fIndexed )
+            std::memcpy( quad.data(), indices.data() + at * sizeof( uint32_t ), sizeof( quad ) );
+
+         const size_t first = std::ranges::min( quad );
+         const bool   fQuad = fIndexed && ( first + 4 ) * sizeof( Vertex ) <= vertices.size() &&
+                            std::ranges::all_of( quad, [ first ]( uint32_t index ) { return index - first < 4; } );
+
+         Quad& read = out.emplace_back( fQuad ? face : FACE_COUNT, QuadBytes {} );
+         if( fQuad )
+            std::memcpy( read.second.data(), vertices.data() + first * sizeof( Vertex ), sizeof( QuadBytes ) );
+      }
+   }
+   std::sort( out.begin(), out.end() );
+}
+
+
+// Whether the section as the arena holds it draws the quads a fresh build gives, face group by face group. For a
+// patchable section the face map must also agree: each slot in use holds the quad the build has for its face, the
+// map points back at the slot, and the groups draw exactly their slots in use.
+bool FSectionMatches( const Level&                       level,
+                      const Chunk&                       chunk,
+                      int                                sectionIndex,
+                      const ChunkRenderer&               renderer,
+                      const ChunkRenderer::SectionEntry& e,
+                      const NullRenderDevice&            device,
+                      Scratch&                           scratch )
+{
+   const ChunkRenderer::MeshData& mesh = scratch.mesh;
+   ChunkRenderer::BuildSectionMesh( level, chunk, sectionIndex, scratch.mesh );
+
+   std::array< uint32_t, FACE_COUNT > firstIndex {};
+   for( size_t face = 1; face < FACE_COUNT; ++face )
+      firstIndex[ face ] = firstIndex[ face - 1 ] + mesh.faceIndexCounts[ face - 1 ];
+   ReadQuads( std::as_bytes( std::span( mesh.vertices ) ), std::as_bytes( std::span( mesh.indices ) ), firstIndex, mesh.faceIndexCounts, scratch.built );
+
+   std::span< const std::byte > vertices;
+   std::span< const std::byte > indices;
+   if( e.mesh != ChunkMeshArena::INVALID_HANDLE )
+   {
+      const ChunkMeshArena&        arena       = renderer.GetArena();
+      const ChunkMeshArena::Range& range       = arena.GetRange( e.mesh );
+      const std::span              allVertices = device.GetBufferContents( arena.GetVertexBuffer() );
+      const std::span              allIndices  = device.GetBufferContents( arena.GetIndexBuffer() );
+      if( ( static_cast< size_t >( range.firstVertex ) + range.vertexCount ) * sizeof( Vertex ) > allVertices.size() ||
+          ( static_cast< size_t >( range.firstIndex ) + range.indexCount ) * sizeof( uint32_t ) > allIndices.size() )
+         return false;
+
+      vertices = allVertices.subspan( range.firstVertex * sizeof( Vertex ), range.vertexCount * sizeof( Vertex ) );
+      indices  = allIndices.subspan( range.firstIndex * sizeof( uint32_t ), range.indexCount * sizeof( uint32_t ) );
+   }
+
+   scratch.uploaded.clear();
+   if( !e.fEmpty )
+      ReadQuads( vertices, indices, e.faceFirstIndex, e.faceIndexCounts, scratch.uploaded );
+   if( scratch.uploaded != scratch.built )
+      return false;
+
+   if( !e.pFaces )
+      return true;
+
+   scratch.quadsByFace.clear();
+   for( size_t quad = 0; quad < mesh.quadFaces.size(); ++quad )
+      scratch.quadsByFace.emplace( mesh.quadFaces[ quad ], quad );
+
+   const ChunkRenderer::SectionFaces& faces = *e.pFaces;
+   size_t                             slots = 0;
+   for( size_t face = 0; face < FACE_COUNT; ++face )
+   {
+      if( faces.quads[ face ] > faces.capacity[ face ] || e.faceFirstIndex[ face ] != faces.firstSlot[ face ] * 6 || e.faceIndexCounts[ face ] != faces.quads[ face ] * 6 )
+         return false;
+
+      for( uint32_t slot = faces.firstSlot[ face ]; slot < faces.firstSlot[ face ] + faces.quads[ face ]; ++slot, ++slots )
+      {
+         const uint16_t key = slot < faces.slotFaces.size() ? faces.slotFaces[ slot ] : ChunkRenderer::SectionFaces::NO_SLOT;
+         const auto     it  = scratch.quadsByFace.find( key );
+         if( it == scratch.quadsByFace.end() || key % FACE_COUNT != face || faces.faceSlots[ key ] != slot || ( slot + 1 ) * sizeof( QuadBytes ) > vertices.size() ||
+             std::memcmp( vertices.data() + slot * sizeof( QuadBytes ), mesh.vertices.data() + it->second * 4, sizeof( QuadBytes ) ) != 0 )
+            return false;
+      }
+   }
+   return slots == scratch.quadsByFace.size();
+}
+
+} // namespace
+
+
+MeshPatchBenchReport BenchMeshPatch( const MeshPatchBenchOptions& options )
+{
+   MeshPatchBenchReport report;
+   auto                 check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   // Contents are kept from the start, so the arena's buffers hold every vertex and index it was given
+   NullRenderDevice device;
+   device.SetKeepBufferContents( true );
+   const ScopedRenderDevice scopedDevice( device );
+   TextureAtlasManager::Get().CompileBlockAtlas();
+
+   const ScratchWorld world( "MeshPatchBench", options.seed );
+   {
+      constexpr float TICK_INTERVAL = 1.0f / 20.0f; // the application's fixed tick rate
+      const uint8_t   radius        = static_cast< uint8_t >( ( std::min )( options.radius, ChunkRenderer::LOD_RING_DISTANCES[ 0 ] - 1 ) ); // all at full detail
+      const glm::vec3 eye( 8.0f, 100.0f, 8.0f );
+
+      Level         level( world.GetDir() );
+      ChunkRenderer renderer;
+      Scratch       scratch;
+
+      // Light is computed off-thread and chunks are not meshed until they are lit. Nothing ticks the level after
+      // this, so the only changes from here on are the bench's edits and the relighting they cause.
+      auto fAllLit = [ &level ]()
+      {
+         bool fLit = true;
+         level.GetChunks().ForEach( [ &fLit ]( const Chunk& chunk ) { fLit &= chunk.FLit(); } );
+         return fLit;
+      };
+      level.UpdateStreaming( eye, radius );
+      for( int tick = 0; tick < 1000 && !fAllLit(); ++tick )
+      {
+         level.Update( TICK_INTERVAL );
+         std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+      }
+      check( fAllLit() );
+
+      for( int update = 0; update < 256; ++update )
+      {
+         device.Reset();
+         renderer.Update( level, eye, radius );
+         if( MeshUploadBytes( device.GetCommands() ) == 0 )
+            break;
+      }
+      report.chunks = renderer.GetEntries().size();
+      check( report.chunks == static_cast< size_t >( ( 2 * radius + 1 ) * ( 2 * radius + 1 ) ) );
+
+      auto sectionAt = [ &renderer ]( const ChunkPos& cc, int sectionIndex ) -> const ChunkRenderer::SectionEntry*
+      {
+         const auto it = renderer.GetEntries().find( cc );
+         return it != renderer.GetEntries().end() && it->second.lod == 0 ? &it->second.sections[ static_cast< size_t >( sectionIndex ) ] : nullptr;
+      };
+
+      auto verify = [ & ]( const ChunkPos& cc )
+      {
+         const Chunk* pChunk = level.GetChunks().Peek( cc );
+         for( int i = 0; pChunk && i < SECTIONS_PER_CHUNK; ++i )
+         {
+            if( const ChunkRenderer::SectionEntry* pSection = sectionAt( cc, i ) )
+            {
+               ++report.verifiedSections;
+               report.mismatchedSections += FSectionMatches( level, *pChunk, i, renderer, *pSection, device, scratch ) ? 0 : 1;
+            }
+         }
+      };
+      auto verifyAll = [ & ]()
+      {
+         const size_t mismatched = report.mismatchedSections;
+         for( const auto& [ cc, _ ] : renderer.GetEntries() )
+            verify( cc );
+         return report.mismatchedSections == mismatched;
+      };
+
+      // Reading back what the arena holds must give the build before anything is patched
+      check( verifyAll() );
+
+      // One update per batch of writes, then every section that can show them: the writes' chunks and their neighbors
+      double updateMs = 0.0;
+      auto   apply    = [ & ]( std::span< const Level::BlockWrite > writes )
+      {
+         level.SetBlocks( writes );
+
+         const uint32_t generation = renderer.GetArena().GetGeneration();
+         device.Reset();
+         const auto start = std::chrono::steady_clock::now();
+         renderer.Update( level, eye, radius );
+         updateMs += std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+         ++report.updates;
+
+         // A patch copies only to move a quad into a hole; a rebuild of the arena copies every mesh
+         if( renderer.GetArena().GetGeneration() == generation )
+            report.swaps += static_cast< size_t >( std::ranges::count( device.GetCommands(), RenderCommand::Type::CopyBuffer, &RenderCommand::type ) );
+
+         std::unordered_set< ChunkPos, ChunkPosHash > chunks;
+         for( const Level::BlockWrite& blockWrite : writes )
+         {
+            const ChunkPos cc = ChunkOf( blockWrite.pos );
+            for( int dx = -1; dx <= 1; ++dx )
+            {
+               for( int dz = -1; dz <= 1; ++dz )
+                  chunks.insert( ChunkPos { cc.x + dx, cc.z + dz } );
+            }
+         }
+         for( const ChunkPos& cc : chunks )
+            verify( cc );
+      };
+      auto write = [ & ]( const WorldBlockPos& pos, BlockId id ) { apply( std::array { Level::BlockWrite { pos, BlockState( id ) } } ); };
+      auto dig   = [ & ]( int x, int z ) { write( WorldBlockPos { x, SurfaceY( level, x, z ), z }, BlockId::Air ); };
+      auto place = [ & ]( int x, int z ) { write( WorldBlockPos { x, SurfaceY( level, x, z ) + 1, z }, BlockId::Dirt ); };
+
+      // Surface edits let the sky in or shade the ground, so they carry light edits along with the block. The first
+      // rebuilds its section into a patchable layout; the ones after patch it.
+      const BlockState underfoot = level.GetBlock( WorldBlockPos { 8, SurfaceY( level, 8, 8 ), 8 } );
+      dig( 8, 8 );
+      write( WorldBlockPos { 8, SurfaceY( level, 8, 8 ) + 1, 8 }, underfoot.GetId() );
+      const int pillarY = SurfaceY( level, 5, 5 ) + 1;
+      apply( std::array { Level::BlockWrite { WorldBlockPos { 5, pillarY, 5 }, BlockState( BlockId::Dirt ) },
+                          Level::BlockWrite { WorldBlockPos { 5, pillarY + 1, 5 }, BlockState( BlockId::Dirt ) } } );
+      apply( std::array { Level::BlockWrite { WorldBlockPos { 5, pillarY + 1, 5 }, BlockState( BlockId::Air ) },
+                          Level::BlockWrite { WorldBlockPos { 5, pillarY, 5 }, BlockState( BlockId::Air ) } } );
+
+      // Either side of a border between chunks, where the faces an edit touches belong to the neighbor
+      for( const auto [ x, z ] : { std::pair( 15, 8 ), std::pair( 16, 8 ), std::pair( 8, -1 ), std::pair( 8, 0 ) } )
+      {
+         dig( x, z );
+         place( x, z );
+      }
+
+      TickRng rng( options.seed );
+      for( int edit = 0; edit < options.edits; ++edit )
+      {
+         const int x = static_cast< int >( rng.NextBelow( 3 * CHUNK_SIZE_X ) ) - CHUNK_SIZE_X;
+         const int z = static_cast< int >( rng.NextBelow( 3 * CHUNK_SIZE_Z ) ) - CHUNK_SIZE_Z;
+         if( edit % 2 )
+            place( x, z );
+         else
+            dig( x, z );
+      }
+
+      // Block light: a furnace at the end of a two-block pocket lights the faces around the other block
+      const ChunkPos               pocketChunk { -1, -1 };
+      std::vector< WorldBlockPos > pocket;
+      for( int i = 1; i < SECTIONS_PER_CHUNK && pocket.empty(); ++i )
+         pocket = BuriedBlocks( level, pocketChunk, i );
+      check( !pocket.empty() );
+      if( !pocket.empty() )
+      {
+         const WorldBlockPos furnace = pocket[ 0 ];
+         const WorldBlockPos lit { furnace.x + 1, furnace.y, furnace.z };
+         apply( std::array { Level::BlockWrite { furnace, BlockState( BlockId::Air ) }, Level::BlockWrite { lit, BlockState( BlockId::Air ) } } );
+
+         const uint8_t dark = level.GetBlockLight( lit );
+         write( furnace, BlockId::Furnace );
+         check( level.GetBlockLight( lit ) > dark );
+         write( furnace, BlockId::Air );
+         check( level.GetBlockLight( lit ) == dark );
+         apply( std::array { Level::BlockWrite { furnace, BlockState( BlockId::Stone ) }, Level::BlockWrite { lit, BlockState( BlockId::Stone ) } } );
+      }
+
+      // Spare slots: a hole makes the section patchable, then one update digs more holes than one of its groups has
+      // spare slots for, so the patch gives up and the section is rebuilt with room for them
+      const ChunkPos               origin { 0, 0 };
+      int                          spareSection = 1;
+      std::vector< WorldBlockPos > holes;
+      for( int i = 1; i < SECTIONS_PER_CHUNK; ++i )
+      {
+         std::vector< WorldBlockPos > blocks = BuriedBlocks( level, origin, i );
+         if( blocks.size() > holes.size() )
+         {
+            spareSection = i;
+            holes        = std::move( blocks );
+         }
+      }
+
+      check( holes.size() > 1 );
+      if( holes.size() > 1 )
+      {
+         write( holes[ 0 ], BlockId::Air );
+
+         const ChunkRenderer::SectionEntry* pSection = sectionAt( origin, spareSection );
+         check( pSection && pSection->pFaces );
+         if( pSection && pSection->pFaces )
+         {
+            const std::array< uint32_t, FACE_COUNT > capacity = pSection->pFaces->capacity;
+            uint32_t                                 spare    = UINT32_MAX;
+            for( size_t face = 0; face < FACE_COUNT; ++face )
+               spare = ( std::min )( spare, capacity[ face ] - pSection->pFaces->quads[ face ] );
+
+            const size_t dug = ( std::min )( static_cast< size_t >( spare ) + 1, holes.size() - 1 );
+            check( dug > spare && dug < Chunk::MAX_MESH_EDITS );
+
+            std::vector< Level::BlockWrite > writes;
+            for( size_t i = 1; i <= dug; ++i )
+               writes.push_back( Level::BlockWrite { holes[ i ], BlockState( BlockId::Air ) } );
+            apply( writes );
+
+            pSection       = sectionAt( origin, spareSection );
+            bool fOverflow = false;
+            for( size_t face = 0; pSection && pSection->pFaces && face < FACE_COUNT; ++face )
+               fOverflow |= pSection->pFaces->capacity[ face ] > capacity[ face ];
+            report.overflows += fOverflow ? 1 : 0;
+            check( fOverflow );
+
+            // Filled back in the order they were dug, each hole but the last leaves a gap in its groups that the
+            // last quad of the group moves into
+            const size_t swaps = report.swaps;
+            for( size_t i = 0; i <= dug; ++i )
+               write( holes[ i ], BlockId::Stone );
+            check( report.swaps > swaps );
+         }
+      }
+
+      // Face maps: a hole in each chunk of the view, one update each, edits more sections than keep face maps. Only
+      // the most recent ones keep theirs; editing the oldest again takes one back from the next oldest.
+      std::vector< std::pair< ChunkPos, WorldBlockPos > > lruHoles;
+      for( int cx = -radius; cx <= radius; ++cx )
+      {
+         for( int cz = -radius; cz <= radius; ++cz )
+         {
+            const ChunkPos cc { cx, cz };
+            for( int i = 1; i < SECTIONS_PER_CHUNK; ++i )
+            {
+               const std::vector< WorldBlockPos > blocks = BuriedBlocks( level, cc, i );
+               if( !blocks.empty() )
+               {
+                  lruHoles.emplace_back( cc, blocks[ 0 ] );
+                  break;
+               }
+            }
+         }
+      }
+
+      constexpr size_t MAX_PATCHABLE = ChunkRenderer::MAX_PATCHABLE_SECTIONS;
+      check( lruHoles.size() > MAX_PATCHABLE );
+      if( lruHoles.size() > MAX_PATCHABLE )
+      {
+         auto fPatchable = [ & ]( size_t hole )
+         {
+            const ChunkRenderer::SectionEntry* pSection = sectionAt( lruHoles[ hole ].first, lruHoles[ hole ].second.y / CHUNK_SECTION_SIZE );
+            return pSection && pSection->pFaces;
+         };
+
+         for( const auto& [ _, pos ] : lruHoles )
+            write( pos, BlockId::Air );
+
+         size_t patchable = 0;
+         for( const auto& [ _, entry ] : renderer.GetEntries() )
+            patchable += static_cast< size_t >( std::ranges::count_if( entry.sections, []( const ChunkRenderer::SectionEntry& e ) { return e.pFaces != nullptr; } ) );
+         check( patchable == MAX_PATCHABLE );
+
+         const size_t kept = lruHoles.size() - MAX_PATCHABLE;
+         for( size_t hole = 0; hole < lruHoles.size(); ++hole )
+         {
+            report.evictions += hole < kept && !fPatchable( hole ) ? 1 : 0;
+            check( fPatchable( hole ) == ( hole >= kept ) );
+         }
+
+         write( lruHoles[ 0 ].second, BlockId::Stone );
+         report.evictions += fPatchable( kept ) ? 0 : 1;
+         check( fPatchable( 0 ) && !fPatchable( kept ) );
+      }
+
+      // Patched, rebuilt and evicted sections alike, across the whole view
+      check( verifyAll() );
+      check( report.mismatchedSections == 0 );
+      report.microsecondsPerUpdate = report.updates ? updateMs * 1000.0 / static_cast< double >( report.updates ) : 0.0;
+   }
+
+   return report;
+}
+
+} // namespace Tools
@@ -0,0 +1,37 @@
+#pragma once
+
+namespace Tools
+{
+
+struct MeshPatchBenchOptions
+{
+   int      radius { 4 }; // view radius in chunks around the origin; the LRU pass edits every chunk inside it
+   uint64_t seed { 1 };
+   int      edits { 64 }; // random digs and placements on the surface around the origin, one update each
+};
+
+struct MeshPatchBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // sections that differ from a fresh build, and edit cases that did not happen
+
+   size_t chunks { 0 };             // meshed before the first edit
+   size_t updates { 0 };            // ChunkRenderer::Update calls after an edit
+   size_t verifiedSections { 0 };   // read back from the arena and compared, over all updates
+   size_t mismatchedSections { 0 }; // quads or face maps that differ from BuildSectionMesh
+   size_t swaps { 0 };              // holes filled by copying a group's last quad
+   size_t overflows { 0 };          // sections rebuilt because a group ran out of spare slots
+   size_t evictions { 0 };          // face maps dropped for more recently edited sections
+
+   double microsecondsPerUpdate { 0.0 };
+};
+
+// Meshes generated terrain through ChunkRenderer into a NullRenderDevice that keeps buffer contents, then edits it:
+// digs and placements on the surface and across chunk borders, a furnace lighting a pocket, enough holes in one
+// section to outgrow its spare slots and then filled back in, and one edit in each of more sections than keep face
+// maps. After each update the quads of every section around the edit are read back from the arena and compared,
+// face by face, with a fresh BuildSectionMesh, along with the face maps of patchable sections. Expects to run from
+// the directory the game runs from, since the block atlas loads from assets/.
+MeshPatchBenchReport BenchMeshPatch( const MeshPatchBenchOptions& options );
+
+} // namespace Tools
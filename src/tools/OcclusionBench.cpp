@@ -0,0 +1,158 @@
+#include "pch_server.h"
+
+#include "OcclusionBench.h"
+
+#include <Engine/World/OcclusionCuller.h>
+#include <Engine/World/SectionVisibility.h>
+#include <Engine/World/TerrainGenerator.h>
+
+namespace Tools
+{
+
+OcclusionBenchReport BenchOcclusion( const OcclusionBenchOptions& options )
+{
+   OcclusionBenchReport report;
+   auto                 check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   const glm::mat4 projection = glm::perspective( glm::radians( 70.0f ), 16.0f / 9.0f, 0.1f, 1000.0f );
+   OcclusionCuller culler;
+
+   // A 40x20 wall 20 blocks in front of the camera
+   {
+      const glm::vec3 eye( 0.0f, 10.0f, 0.0f );
+      const glm::vec3 wallMin( -20.0f, 0.0f, -24.0f ), wallMax( 20.0f, 20.0f, -20.0f );
+      culler.Begin( projection * glm::lookAt( eye, eye + glm::vec3( 0.0f, 0.0f, -1.0f ), glm::vec3( 0.0f, 1.0f, 0.0f ) ), eye );
+      culler.AddOccluder( wallMin, wallMax );
+      culler.Finish();
+
+      check( culler.FOccluded( glm::vec3( -2.0f, 2.0f, -40.0f ), glm::vec3( 2.0f, 6.0f, -36.0f ) ) );    // behind
+      check( culler.FOccluded( glm::vec3( -5.0f, 0.0f, -200.0f ), glm::vec3( 5.0f, 10.0f, -190.0f ) ) ); // far behind
+      check( culler.FOccluded( glm::vec3( -2.0f, 2.0f, -28.0f ), glm::vec3( 2.0f, 6.0f, -24.0f ) ) );    // touching its back
+      check( !culler.FOccluded( glm::vec3( -2.0f, 18.0f, -40.0f ), glm::vec3( 2.0f, 26.0f, -36.0f ) ) ); // peeking over
+      check( !culler.FOccluded( glm::vec3( -2.0f, 2.0f, -12.0f ), glm::vec3( 2.0f, 6.0f, -8.0f ) ) );    // in front
+      check( !culler.FOccluded( glm::vec3( 30.0f, 2.0f, -40.0f ), glm::vec3( 34.0f, 6.0f, -36.0f ) ) );  // beside
+      check( !culler.FOccluded( glm::vec3( -30.0f, -30.0f, 5.0f ), glm::vec3( 30.0f, 30.0f, 10.0f ) ) ); // behind the camera
+
+      // Every culled box must be hidden from every point of it: the line of sight has to cross the wall's front
+      // or top face first
+      auto fHidden = [ & ]( const glm::vec3& p )
+      {
+         const glm::vec3 d = p - eye;
+         if( p.z > wallMax.z )
+            return false;
+
+         const glm::vec3 front = eye + d * ( ( wallMax.z - eye.z ) / d.z );
+         if( front.x >= wallMin.x && front.x <= wallMax.x && front.y >= wallMin.y && front.y <= wallMax.y )
+            return true;
+
+         const float     t   = d.y != 0.0f ? ( wallMax.y - eye.y ) / d.y : -1.0f;
+         const glm::vec3 top = eye + d * t;
+         return t > 0.0f && t < 1.0f && top.x >= wallMin.x && top.x <= wallMax.x && top.z >= wallMin.z && top.z <= wallMax.z;
+      };
+
+      TickRng rng( options.seed );
+      bool    fConservative = true;
+      for( int i = 0; i < 20000 && fConservative; ++i )
+      {
+         const glm::vec3 boxMin( static_cast< float >( rng.NextBelow( 120 ) ) - 60.0f, static_cast< float >( rng.NextBelow( 40 ) ) - 10.0f, -1.0f - static_cast< float >( rng.NextBelow( 200 ) ) );
+         const glm::vec3 boxMax = boxMin + glm::vec3( 1.0f + rng.NextBelow( 8 ), 1.0f + rng.NextBelow( 8 ), 1.0f + rng.NextBelow( 8 ) );
+         if( !culler.FOccluded( boxMin, boxMax ) )
+            continue;
+
+         for( int corner = 0; corner < 8; ++corner )
+            fConservative &= fHidden( glm::vec3( corner & 1 ? boxMax.x : boxMin.x, corner & 2 ? boxMax.y : boxMin.y, corner & 4 ? boxMax.z : boxMin.z ) );
+      }
+      check( fConservative );
+   }
+
+   // Generated terrain: opaque runs within four chunks occlude, every non-empty section is tested
+   using Box = std::pair< glm::vec3, glm::vec3 >;
+
+   TerrainGenerator   generator( options.seed );
+   std::vector< Box > occluders, sections;
+   int                surfaceY = 0;
+   for( int cz = -options.radius; cz <= options.radius; ++cz )
+   {
+      for( int cx = -options.radius; cx <= options.radius; ++cx )
+      {
+         const ChunkSnapshot snapshot = generator.Generate( ChunkPos { cx, cz } );
+         const glm::vec3     origin( static_cast< float >( cx * CHUNK_SIZE_X ), 0.0f, static_cast< float >( cz * CHUNK_SIZE_Z ) );
+         const bool          fNear = std::abs( cx ) <= 4 && std::abs( cz ) <= 4;
+         for( int first = 0; first < SECTIONS_PER_CHUNK; )
+         {
+            int last = first;
+            while( last < SECTIONS_PER_CHUNK && fNear && SectionVisibility::Compute( snapshot.sections[ static_cast< size_t >( last ) ] ).FOpaque() )
+               ++last;
+
+            if( last > first )
+               occluders.emplace_back( origin + glm::vec3( 0.0f, static_cast< float >( first * CHUNK_SECTION_SIZE ), 0.0f ),
+                                       origin + glm::vec3( CHUNK_SIZE_X, static_cast< float >( last * CHUNK_SECTION_SIZE ), CHUNK_SIZE_Z ) );
+
+            first = last + 1;
+         }
+
+         for( int sy = 0; sy < SECTIONS_PER_CHUNK; ++sy )
+         {
+            if( snapshot.sections[ static_cast< size_t >( sy ) ] )
+               sections.emplace_back( origin + glm::vec3( 0.0f, static_cast< float >( sy * CHUNK_SECTION_SIZE ), 0.0f ),
+                                      origin + glm::vec3( CHUNK_SIZE_X, static_cast< float >( ( sy + 1 ) * CHUNK_SECTION_SIZE ), CHUNK_SIZE_Z ) );
+         }
+
+         if( cx == 0 && cz == 0 )
+         {
+            for( int y = CHUNK_SIZE_Y - 1; y > 0 && !surfaceY; --y )
+            {
+               const SectionBlocksPtr& pBlocks = snapshot.sections[ static_cast< size_t >( y / CHUNK_SECTION_SIZE ) ];
+               if( pBlocks && ( *pBlocks )[ ChunkSection::ToIndex( LocalBlockPos { 8, y % CHUNK_SECTION_SIZE, 8 } ) ].GetId() != BlockId::Air )
+                  surfaceY = y;
+            }
+         }
+      }
+   }
+
+   const glm::vec3 eye( 8.0f, static_cast< float >( surfaceY ) + 2.6f, 8.0f );
+   const glm::mat4 viewProjection = projection * glm::lookAt( eye, eye + glm::vec3( 1.0f, -0.2f, 0.0f ), glm::vec3( 0.0f, 1.0f, 0.0f ) );
+
+   // Only sections in front of the camera count, as the frustum would have dropped the rest
+   auto fInFront = [ & ]( const Box& box )
+   {
+      for( int corner = 0; corner < 8; ++corner )
+      {
+         const glm::vec4 clip = viewProjection * glm::vec4( corner & 1 ? box.second.x : box.first.x, corner & 2 ? box.second.y : box.first.y, corner & 4 ? box.second.z : box.first.z, 1.0f );
+         if( clip.w > 0.0f && std::abs( clip.x ) <= clip.w && std::abs( clip.y ) <= clip.w )
+            return true;
+      }
+      return false;
+   };
+   std::erase_if( sections, [ & ]( const Box& box ) { return !fInFront( box ); } );
+
+   using Clock = std::chrono::steady_clock;
+   double rasterMs = 0.0, testMs = 0.0;
+   for( int frame = 0; frame < ( std::max )( options.frames, 1 ); ++frame )
+   {
+      auto start = Clock::now();
+      culler.Begin( viewProjection, eye );
+      for( const auto& [ boxMin, boxMax ] : occluders )
+         culler.AddOccluder( boxMin, boxMax );
+      culler.Finish();
+      rasterMs += std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+
+      start           = Clock::now();
+      report.occluded = 0;
+      for( const auto& [ boxMin, boxMax ] : sections )
+         report.occluded += culler.FOccluded( boxMin, boxMax ) ? 1 : 0;
+      testMs += std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+   }
+
+   report.occluders          = culler.GetStats().occluders;
+   report.tested             = sections.size();
+   report.rasterMicroseconds = rasterMs * 1000.0 / ( std::max )( options.frames, 1 );
+   report.testMicroseconds   = testMs * 1000.0 / ( std::max )( options.frames, 1 );
+   return report;
+}
+
+} // namespace Tools
@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Tools
+{
+
+struct OcclusionBenchOptions
+{
+   int      radius { 8 }; // generated chunks around the origin
+   uint64_t seed { 1 };
+   int      frames { 100 }; // repetitions of the per-frame work, for timing
+};
+
+struct OcclusionBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // hand-placed boxes culled or kept wrongly, or random boxes culled while visible
+
+   size_t occluders { 0 }; // runs of opaque sections rasterized per frame
+   size_t tested { 0 };    // non-empty sections in the frustum
+   size_t occluded { 0 };
+   double rasterMicroseconds { 0.0 }; // per frame: clearing, occluders and the pyramid
+   double testMicroseconds { 0.0 };   // per frame: every section test
+};
+
+// Checks OcclusionCuller against a single wall, then measures it on generated terrain seen by a player standing
+// at the origin and looking along +x
+OcclusionBenchReport BenchOcclusion( const OcclusionBenchOptions& options );
+
+} // namespace Tools
@@ -0,0 +1,64 @@
+#include "pch_server.h"
+
+#include "RandomTickBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/World/Level.h>
+
+namespace Tools
+{
+
+RandomTickBenchReport BenchRandomTicks( const RandomTickBenchOptions& options )
+{
+   const ScratchWorld world( "RandomTickBench", 0 );
+
+   RandomTickBenchReport report;
+   {
+      Level level( world.GetDir() );
+      level.UpdateStreaming( glm::vec3( 0.0f ), static_cast< uint8_t >( options.radius ) );
+
+      if( options.fGrass )
+      {
+         std::vector< WorldBlockPos > surface;
+         level.GetChunks().ForEach( [ &surface ]( const Chunk& chunk )
+         {
+            const ChunkPos cpos = chunk.GetChunkPos();
+            for( int z = 0; z < CHUNK_SIZE_Z; ++z )
+            {
+               for( int x = 0; x < CHUNK_SIZE_X; ++x )
+               {
+                  int y = CHUNK_SIZE_Y - 1;
+                  while( y > 0 && chunk.GetBlock( LocalBlockPos { x, y, z } ).GetId() == BlockId::Air )
+                     --y;
+
+                  surface.push_back( WorldBlockPos { cpos.x * CHUNK_SIZE_X + x, y, cpos.z * CHUNK_SIZE_Z + z } );
+               }
+            }
+         } );
+
+         for( const WorldBlockPos& pos : surface )
+            level.SetBlock( pos, BlockState( BlockId::Grass ) );
+      }
+
+      constexpr float TICK_INTERVAL = 1.0f / 20.0f; // the application's fixed tick rate
+      double          total         = 0.0;
+      for( int tick = 0; tick < options.ticks; ++tick )
+      {
+         level.Update( TICK_INTERVAL );
+
+         const Level::RandomTickStats& stats = level.GetRandomTickStats();
+         total += stats.milliseconds;
+         report.maxMilliseconds = ( std::max )( report.maxMilliseconds, stats.milliseconds );
+         report.blocksTicked += stats.blocksTicked;
+         report.sections       = stats.sections;
+         report.activeSections = stats.activeSections;
+      }
+
+      report.avgMilliseconds = options.ticks > 0 ? total / options.ticks : 0.0;
+   }
+
+   return report;
+}
+
+} // namespace Tools
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace Tools
+{
+
+struct RandomTickBenchOptions
+{
+   int  radius { 16 };   // chunks around the origin
+   int  ticks { 1000 };  // fixed ticks to measure
+   bool fGrass { true }; // cover the surface with grass so every surface section is active
+};
+
+struct RandomTickBenchReport
+{
+   size_t sections { 0 };
+   size_t activeSections { 0 };
+   size_t blocksTicked { 0 };
+   double avgMilliseconds { 0.0 };
+   double maxMilliseconds { 0.0 };
+};
+
+// Loads a throwaway world at the given radius and measures Level's random tick pass over it
+RandomTickBenchReport BenchRandomTicks( const RandomTickBenchOptions& options );
+
+} // namespace Tools
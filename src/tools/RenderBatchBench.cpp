@@ -0,0 +1,141 @@
+#include "pch_server.h"
+
+#include "RenderBatchBench.h"
+
+#include <Engine/World/Level.h>
+#include <Engine/World/RenderQueues.h>
+
+namespace Tools
+{
+
+using Engine::RenderKey;
+using Engine::RenderQueues;
+
+// Each draw's transform carries what it was submitted with, so a misfiled instance shows up in its batch. The
+// material tells mesh and texture apart, as the renderer's keys do.
+static RenderQueues::IndexedDraw MakeDraw( uint8_t shader, uint32_t vertexArrayId, uint32_t textureId, uint32_t drawIndex, float depth )
+{
+   glm::mat4 model( 1.0f );
+   model[ 3 ] = glm::vec4( static_cast< float >( shader ), static_cast< float >( vertexArrayId ), static_cast< float >( textureId ), static_cast< float >( drawIndex ) );
+   model[ 2 ] = glm::vec4( depth );
+   return RenderQueues::IndexedDraw { .key           = RenderKey::Opaque( 0, shader, vertexArrayId << 1 | textureId, depth ),
+                                      .vertexArrayId = vertexArrayId,
+                                      .textureId     = textureId,
+                                      .indexCount    = vertexArrayId * 6,
+                                      .model         = model };
+}
+
+
+static bool FBatchesMatch( const RenderQueues& queues, size_t draws, size_t distinct )
+{
+   const auto batches    = queues.GetOpaqueBatches();
+   const auto transforms = queues.GetInstanceTransforms();
+   if( batches.size() != distinct || transforms.size() != draws )
+      return false;
+
+   std::vector< bool > fSeen( draws, false );
+   uint32_t            next = 0;
+   for( const auto& [ index, batch ] : batches | std::views::enumerate )
+   {
+      // Contiguous, non-empty, and strictly ordered by state, which also rules out two batches for one group
+      if( batch.firstInstance != next || batch.instanceCount == 0 || batch.indexCount != batch.vertexArrayId * 6 )
+         return false;
+      if( index > 0 )
+      {
+         const auto& prev = batches[ static_cast< size_t >( index - 1 ) ];
+         if( prev.key.GetState() >= batch.key.GetState() )
+            return false;
+      }
+
+      for( uint32_t i = batch.firstInstance; i < batch.firstInstance + batch.instanceCount; ++i )
+      {
+         const glm::vec4& tag       = transforms[ i ][ 3 ];
+         const size_t     drawIndex = static_cast< size_t >( tag.w );
+         if( static_cast< uint32_t >( tag.x ) != batch.key.GetShader() || static_cast< uint32_t >( tag.y ) != batch.vertexArrayId ||
+             static_cast< uint32_t >( tag.z ) != batch.textureId || drawIndex >= draws || fSeen[ drawIndex ] )
+            return false;
+
+         // Front to back within the batch
+         if( i > batch.firstInstance && transforms[ i - 1 ][ 2 ].x > transforms[ i ][ 2 ].x )
+            return false;
+
+         fSeen[ drawIndex ] = true;
+      }
+      next += batch.instanceCount;
+   }
+   return true;
+}
+
+
+RenderBatchBenchReport BenchRenderBatches( const RenderBatchBenchOptions& options )
+{
+   RenderBatchBenchReport report;
+   auto                   check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   // Fixed cases
+   {
+      RenderQueues queues;
+      queues.Sort();
+      check( queues.GetOpaqueBatches().empty() && queues.GetInstanceTransforms().empty() );
+
+      // Interleaved submissions of two meshes at different depths come back as two batches, lower shader first
+      queues.SubmitOpaque( MakeDraw( 1, 7, 0, 0, 5.0f ) );
+      queues.SubmitOpaque( MakeDraw( 0, 9, 0, 1, 9.0f ) );
+      queues.SubmitOpaque( MakeDraw( 1, 7, 0, 2, 1.0f ) );
+      queues.SubmitOpaque( MakeDraw( 0, 9, 0, 3, 2.0f ) );
+      queues.SubmitOpaque( MakeDraw( 0, 9, 0, 4, 4.0f ) );
+      queues.Sort();
+      const auto batches = queues.GetOpaqueBatches();
+      check( batches.size() == 2 && batches[ 0 ].vertexArrayId == 9 && batches[ 0 ].instanceCount == 3 && batches[ 1 ].firstInstance == 3 &&
+             batches[ 1 ].instanceCount == 2 );
+      check( FBatchesMatch( queues, 5, 2 ) );
+
+      // The same mesh under another texture is a batch of its own
+      queues.SubmitOpaque( MakeDraw( 0, 9, 1, 5, 3.0f ) );
+      queues.Sort();
+      check( FBatchesMatch( queues, 6, 3 ) );
+
+      queues.Clear();
+      check( queues.GetOpaqueBatches().empty() && queues.GetInstanceTransforms().empty() );
+   }
+
+   using Clock = std::chrono::steady_clock;
+   TickRng                                                rng( options.seed );
+   RenderQueues                                           queues;
+   std::set< std::tuple< uint32_t, uint32_t, uint32_t > > groups;
+   double                                                 elapsedMs  = 0.0;
+   size_t                                                 batchTotal = 0;
+   const int                                              frames     = ( std::max )( options.frames, 1 );
+   const uint32_t                                         meshes     = static_cast< uint32_t >( ( std::max )( options.meshes, 1 ) );
+   for( int frame = 0; frame < frames; ++frame )
+   {
+      queues.Clear();
+      groups.clear();
+      for( int i = 0; i < options.draws; ++i )
+      {
+         const uint8_t  shader        = static_cast< uint8_t >( rng.NextBelow( 4 ) );
+         const uint32_t vertexArrayId = 1 + rng.NextBelow( meshes );
+         const uint32_t textureId     = rng.NextBelow( 2 );
+         const float    depth         = static_cast< float >( rng.NextBelow( 1 << 15 ) ); // exact in a key's depth bits
+         queues.SubmitOpaque( MakeDraw( shader, vertexArrayId, textureId, static_cast< uint32_t >( i ), depth ) );
+         groups.emplace( shader, vertexArrayId, textureId );
+      }
+
+      const auto start = Clock::now();
+      queues.Sort();
+      elapsedMs += std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+
+      check( FBatchesMatch( queues, static_cast< size_t >( options.draws ), groups.size() ) );
+      batchTotal += queues.GetOpaqueBatches().size();
+   }
+
+   report.batches              = static_cast< double >( batchTotal ) / frames;
+   report.microsecondsPerFrame = elapsedMs * 1000.0 / frames;
+   return report;
+}
+
+} // namespace Tools
@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Tools
+{
+
+struct RenderBatchBenchOptions
+{
+   int      draws { 10000 }; // opaque draws submitted per frame
+   int      meshes { 64 };   // distinct vertex arrays they are spread over
+   uint64_t seed { 1 };
+   int      frames { 200 };
+};
+
+struct RenderBatchBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // frames whose batches lose, duplicate or misfile a draw, plus the fixed cases
+
+   double batches { 0.0 };              // per frame, on average: one instanced call each
+   double microsecondsPerFrame { 0.0 }; // RenderQueues::Sort, which builds the batches
+};
+
+// Fills RenderQueues with draws of random key, mesh and texture, checking that every draw lands exactly once in
+// the batch for its key, mesh and texture and that batches come out in order, and times sorting and batching
+RenderBatchBenchReport BenchRenderBatches( const RenderBatchBenchOptions& options );
+
+} // namespace Tools
@@ -0,0 +1,205 @@
+#include "pch_server.h"
+
+#include "RenderFrameBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/Renderer/NullRenderDevice.h>
+#include <Engine/Renderer/Texture.h>
+#include <Engine/World/Level.h>
+#include <Engine/World/RenderSystem.h>
+
+namespace Tools
+{
+
+using Engine::RenderSystem;
+
+static size_t CountCommands( std::span< const RenderCommand > commands, RenderCommand::Type type )
+{
+   return static_cast< size_t >( std::ranges::count( commands, type, &RenderCommand::type ) );
+}
+
+
+// Meshing uploads go through the copy target, so they are told apart from the per-frame streams
+static uint64_t MeshUploadBytes( std::span< const RenderCommand > commands )
+{
+   uint64_t bytes = 0;
+   for( const RenderCommand& command : commands )
+   {
+      if( command.type == RenderCommand::Type::UploadBuffer && command.target == GL_COPY_WRITE_BUFFER )
+         bytes += command.bytes;
+   }
+   return bytes;
+}
+
+
+RenderFrameBenchReport BenchRenderFrame( const RenderFrameBenchOptions& options )
+{
+   RenderFrameBenchReport report;
+   auto                   check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   NullRenderDevice         device;
+   const ScopedRenderDevice scopedDevice( device );
+   TextureAtlasManager::Get().CompileBlockAtlas();
+
+   const ScratchWorld world( "RenderFrameBench", options.seed );
+   {
+      constexpr float TICK_INTERVAL = 1.0f / 20.0f; // the application's fixed tick rate
+      const uint8_t   radius        = static_cast< uint8_t >( options.radius );
+
+      Level        level( world.GetDir() );
+      RenderSystem renderSystem( level );
+
+      // Light is computed off-thread and chunks are not meshed until they are lit
+      auto fAllLit = [ &level ]()
+      {
+         bool fLit = true;
+         level.GetChunks().ForEach( [ &fLit ]( const Chunk& chunk ) { fLit &= chunk.FLit(); } );
+         return fLit;
+      };
+
+      glm::vec3 eye( 8.0f, 100.0f, 8.0f );
+      level.UpdateStreaming( eye, radius );
+      for( int tick = 0; tick < 1000 && !fAllLit(); ++tick )
+      {
+         level.Update( TICK_INTERVAL );
+         std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+      }
+      report.chunks = level.GetChunks().Size();
+
+      // Stand two blocks above the surface at the origin column
+      int surfaceY = CHUNK_SIZE_Y - 1;
+      while( surfaceY > 0 && level.GetBlock( WorldBlockPos { 8, surfaceY, 8 } ).GetId() == BlockId::Air )
+         --surfaceY;
+      eye.y = static_cast< float >( surfaceY ) + 2.0f;
+
+      // Coarse columns are built a budget at a time, so keep updating until an update meshes nothing
+      device.Reset();
+      for( int update = 0; update < 256; ++update )
+      {
+         const size_t first = device.GetCommands().size();
+         renderSystem.Update( eye, radius );
+         if( MeshUploadBytes( device.GetCommands().subspan( first ) ) == 0 )
+            break;
+      }
+      report.meshBytes = MeshUploadBytes( device.GetCommands() );
+
+      // Drops of four blocks ahead of the camera, close enough to be drawn
+      constexpr std::array< BlockId, 4 >                        dropBlocks = { BlockId::Dirt, BlockId::Stone, BlockId::Log, BlockId::Leaves };
+      std::array< std::shared_ptr< IMesh >, dropBlocks.size() > dropMeshes;
+      for( size_t i = 0; i < dropBlocks.size(); ++i )
+         dropMeshes[ i ] = std::make_shared< BlockItemMesh >( dropBlocks[ i ] );
+
+      Entity::Registry registry;
+      TickRng          rng( options.seed );
+      for( int i = 0; i < options.drops; ++i )
+      {
+         const float     distance = 4.0f + static_cast< float >( rng.NextBelow( 36 ) );
+         const glm::vec3 offset( distance, -0.2f * distance, ( static_cast< float >( rng.NextBelow( 41 ) ) / 100.0f - 0.2f ) * distance );
+
+         Entity::Entity drop = registry.Create();
+         registry.Add< CTransform >( drop, eye + offset );
+         registry.Add< CItemDrop >( drop, CItemDrop { .blockId = dropBlocks[ static_cast< size_t >( i ) % dropBlocks.size() ] } );
+         registry.Add< CPhysics >( drop ).SetBoundingBox( 0.125f );
+         registry.Add< CMesh >( drop, dropMeshes[ static_cast< size_t >( i ) % dropMeshes.size() ] );
+      }
+
+      // Looking along +x and a little down, with the block underfoot highlighted
+      const Time::FixedTimeStep time( 20 );
+      const glm::ivec4          viewport   = device.GetViewport();
+      const glm::mat4           view       = glm::lookAt( eye, eye + glm::vec3( 1.0f, -0.2f, 0.0f ), glm::vec3( 0.0f, 1.0f, 0.0f ) );
+      const glm::mat4           projection = glm::perspective( glm::radians( 70.0f ), static_cast< float >( viewport.z ) / viewport.w, 0.1f, 1000.0f );
+
+      const RenderSystem::FrameContext ctx { .registry          = registry,
+                                             .time              = time,
+                                             .view              = view,
+                                             .projection        = projection,
+                                             .viewProjection    = projection * view,
+                                             .viewPos           = eye,
+                                             .optHighlightBlock = glm::ivec3( 8, surfaceY, 8 ) };
+
+      // The first frame creates programs and uploads the skybox; the rest should all ask for the same work
+      device.Reset();
+      renderSystem.Run( ctx );
+      report.textureBytes = device.GetCounters().textureBytes;
+
+      const size_t liveBuffers      = device.GetLiveBuffers();
+      const size_t liveVertexArrays = device.GetLiveVertexArrays();
+      const int    frames           = ( std::max )( options.frames, 1 );
+      double       totalMs          = 0.0;
+      for( int frame = 0; frame < frames; ++frame )
+      {
+         device.Reset();
+         const auto start = std::chrono::steady_clock::now();
+         renderSystem.Run( ctx );
+         totalMs += std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+
+         const RenderCounters&                  counters = device.GetCounters();
+         const std::span< const RenderCommand > commands = device.GetCommands();
+         if( frame == 0 )
+         {
+            report.drawCalls   = counters.drawCalls;
+            report.instances   = counters.instances;
+            report.elements    = counters.elements;
+            report.binds       = counters.programBinds + counters.vertexArrayBinds + counters.bufferBinds + counters.textureBinds;
+            report.uniforms    = counters.uniforms;
+            report.bufferBytes = counters.bufferBytes;
+            for( const RenderCommand& command : commands )
+            {
+               if( command.type != RenderCommand::Type::MultiDrawIndirect )
+                  continue;
+
+               report.terrainDraws += command.draws;
+               report.terrainElements += command.elements;
+            }
+
+            // Terrain in one call; drops in one instanced call per block, covering every drop
+            size_t dropInstances = 0;
+            for( const RenderCommand& command : commands )
+               dropInstances += command.type == RenderCommand::Type::DrawInstanced ? command.instances : 0;
+
+            check( CountCommands( commands, RenderCommand::Type::MultiDrawIndirect ) == 1 && report.terrainDraws > 0 );
+            check( CountCommands( commands, RenderCommand::Type::DrawInstanced ) == ( std::min )( static_cast< size_t >( options.drops ), dropBlocks.size() ) );
+            check( dropInstances == static_cast< size_t >( options.drops ) );
+         }
+
+         // Nothing moved, so every frame asks for the same work, uploads no textures and creates nothing
+         check( counters.drawCalls == report.drawCalls && counters.elements == report.elements && counters.uniforms == report.uniforms &&
+                counters.bufferBytes == report.bufferBytes );
+         check( counters.textureBytes == 0 );
+         check( device.GetLiveBuffers() == liveBuffers && device.GetLiveVertexArrays() == liveVertexArrays );
+      }
+      report.microsecondsPerFrame = totalMs * 1000.0 / frames;
+
+      // Digging out the block underfoot rebuilds its section into the arena, ready to be patched. Filling it back
+      // in only rewrites the faces around it. Terrain stays one call.
+      auto edit = [ & ]( BlockState state )
+      {
+         level.SetBlocks( std::array { Level::BlockWrite { WorldBlockPos { 8, surfaceY, 8 }, state } } );
+         device.Reset();
+         const auto start = std::chrono::steady_clock::now();
+         renderSystem.Update( eye, radius );
+         return std::chrono::duration< double, std::micro >( std::chrono::steady_clock::now() - start ).count();
+      };
+
+      const BlockState underfoot  = level.GetBlock( WorldBlockPos { 8, surfaceY, 8 } );
+      report.rebuildMicroseconds = edit( BlockState( BlockId::Air ) );
+      report.rebuildBytes        = MeshUploadBytes( device.GetCommands() );
+      report.patchMicroseconds   = edit( underfoot );
+      report.patchBytes          = MeshUploadBytes( device.GetCommands() );
+      check( report.rebuildBytes > 0 );
+      check( report.patchBytes > 0 && report.patchBytes < report.rebuildBytes / 16 );
+
+      device.Reset();
+      renderSystem.Run( ctx );
+      check( CountCommands( device.GetCommands(), RenderCommand::Type::MultiDrawIndirect ) == 1 );
+   }
+
+   return report;
+}
+
+} // namespace Tools
@@ -0,0 +1,48 @@
+#pragma once
+
+namespace Tools
+{
+
+struct RenderFrameBenchOptions
+{
+   int      radius { 6 }; // view radius in chunks around the origin
+   uint64_t seed { 1 };
+   int      drops { 256 }; // item drops in front of the camera, spread over four blocks
+   int      frames { 200 };
+};
+
+struct RenderFrameBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // frames that differ, leak, upload textures or draw more calls than expected
+
+   size_t   chunks { 0 };       // loaded and lit before the first frame
+   uint64_t meshBytes { 0 };    // uploaded while meshing the view
+   uint64_t textureBytes { 0 }; // uploaded by the first frame: atlas and skybox
+
+   // Per frame, every frame after the first being identical
+   size_t   drawCalls { 0 };
+   size_t   terrainDraws { 0 };    // commands in the one indirect call, one per run of face groups facing the camera
+   uint64_t terrainElements { 0 }; // indices those commands read
+   size_t   instances { 0 };
+   uint64_t elements { 0 }; // vertices and indices read
+   size_t   binds { 0 };    // program, vertex array, buffer and texture
+   size_t   uniforms { 0 };
+   uint64_t bufferBytes { 0 };
+
+   double microsecondsPerFrame { 0.0 }; // RenderSystem::Run against the null device
+
+   // Edit to mesh: RenderSystem::Update after digging a block, which rebuilds its section, then after filling it
+   // back in, which patches the faces around it
+   double   rebuildMicroseconds { 0.0 };
+   double   patchMicroseconds { 0.0 };
+   uint64_t rebuildBytes { 0 }; // mesh uploads for each
+   uint64_t patchBytes { 0 };
+};
+
+// Streams and meshes generated terrain, spawns item drops, then runs RenderSystem frames against NullRenderDevice,
+// checking what each frame asks of the GPU and timing the CPU side. Expects to run from the directory the game
+// runs from, since shaders and textures load from assets/.
+RenderFrameBenchReport BenchRenderFrame( const RenderFrameBenchOptions& options );
+
+} // namespace Tools
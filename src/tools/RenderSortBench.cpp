@@ -0,0 +1,133 @@
+#include "pch_server.h"
+
+#include "RenderSortBench.h"
+
+#include <Engine/World/Level.h>
+#include <Engine/World/RenderQueues.h>
+
+namespace Tools
+{
+
+using Engine::RenderKey;
+using Engine::RenderQueues;
+
+// Shader, vertex array and texture binds; materials here are vertex arrays, so they add nothing
+static size_t CountBinds( std::span< const RenderQueues::IndexedDraw > draws )
+{
+   const RenderQueues::StateChanges changes = RenderQueues::CountStateChanges( draws );
+   return changes.shaders + changes.vertexArrays + changes.textures;
+}
+
+
+// Radix order is stable, so it must match a stable comparison sort exactly; the submission index rides in the model
+static bool FMatchesStableSort( std::span< const RenderQueues::IndexedDraw > sorted, std::vector< RenderQueues::IndexedDraw > expected )
+{
+   std::stable_sort( expected.begin(), expected.end(), []( const auto& a, const auto& b ) { return a.key < b.key; } );
+   return std::ranges::equal( sorted, expected, []( const auto& a, const auto& b ) { return a.model[ 3 ].w == b.model[ 3 ].w; } );
+}
+
+
+// Depth is kept in model[ 2 ].x: within a state it rises for opaque draws and falls for transparent ones
+static bool FDepthOrdered( std::span< const RenderQueues::IndexedDraw > sorted, bool fTransparent )
+{
+   for( size_t i = 1; i < sorted.size(); ++i )
+   {
+      const auto& prev = sorted[ i - 1 ];
+      const auto& next = sorted[ i ];
+      if( next.key.FTransparent() != fTransparent )
+         return false;
+      if( fTransparent ? prev.model[ 2 ].x < next.model[ 2 ].x : prev.key.GetState() == next.key.GetState() && prev.model[ 2 ].x > next.model[ 2 ].x )
+         return false;
+   }
+   return true;
+}
+
+
+RenderSortBenchReport BenchRenderSort( const RenderSortBenchOptions& options )
+{
+   RenderSortBenchReport report;
+   auto                  check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   // Fixed cases: key fields read back, and depth ranks below state for opaque draws but above it for transparent ones
+   {
+      const RenderKey key = RenderKey::Opaque( 3, 7, 0x123456, 10.0f );
+      check( !key.FTransparent() && key.GetLayer() == 3 && key.GetShader() == 7 && key.GetMaterial() == 0x123456 );
+      check( RenderKey::Opaque( 0, 1, 5, 1000.0f ) < RenderKey::Opaque( 0, 2, 5, 1.0f ) &&
+             RenderKey::Opaque( 0, 1, 5, 1.0f ) < RenderKey::Opaque( 0, 1, 5, 2.0f ) &&
+             RenderKey::Opaque( 0, 1, 5, 1.0f ).GetState() == RenderKey::Opaque( 0, 1, 5, 2.0f ).GetState() );
+      check( RenderKey::Transparent( 0, 2, 5, 2.0f ) < RenderKey::Transparent( 0, 1, 5, 1.0f ) &&
+             RenderKey::Opaque( 127, 255, 0xFFFFFF, 1e30f ) < RenderKey::Transparent( 0, 0, 0, 0.0f ) );
+   }
+
+   using Clock = std::chrono::steady_clock;
+   TickRng                                  rng( options.seed );
+   RenderQueues                             queues;
+   std::vector< RenderQueues::IndexedDraw > opaque, transparent;
+   double                                   radixMs = 0.0, comparisonMs = 0.0;
+   size_t                                   submittedBinds = 0, sortedBinds = 0, batches = 0;
+   const int                                frames         = ( std::max )( options.frames, 1 );
+   const uint32_t                           meshes         = static_cast< uint32_t >( ( std::max )( options.meshes, 1 ) );
+   for( int frame = 0; frame < frames; ++frame )
+   {
+      queues.Clear();
+      opaque.clear();
+      transparent.clear();
+      for( int i = 0; i < options.draws; ++i )
+      {
+         const bool     fTransparent  = rng.NextBelow( 8 ) == 0;
+         const uint8_t  shader        = static_cast< uint8_t >( rng.NextBelow( 4 ) );
+         const uint32_t vertexArrayId = 1 + rng.NextBelow( meshes );
+         const float    depth         = static_cast< float >( rng.NextBelow( 1 << 15 ) ); // exact in a key's depth bits
+
+         glm::mat4 model( 1.0f );
+         model[ 2 ] = glm::vec4( depth );
+         model[ 3 ] = glm::vec4( 0.0f, 0.0f, 0.0f, static_cast< float >( i ) );
+
+         const RenderQueues::IndexedDraw draw { .key           = fTransparent ? RenderKey::Transparent( 0, shader, vertexArrayId, depth )
+                                                                              : RenderKey::Opaque( 0, shader, vertexArrayId, depth ),
+                                                .vertexArrayId = vertexArrayId,
+                                                .textureId     = 0,
+                                                .indexCount    = 36,
+                                                .model         = model };
+         ( fTransparent ? transparent : opaque ).push_back( draw );
+         if( fTransparent )
+            queues.SubmitOverlay( draw );
+         else
+            queues.SubmitOpaque( draw );
+      }
+
+      auto start = Clock::now();
+      queues.Sort();
+      radixMs += std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+
+      check( FMatchesStableSort( queues.GetOpaqueIndexed(), opaque ) && FMatchesStableSort( queues.GetOverlayIndexed(), transparent ) );
+      check( FDepthOrdered( queues.GetOpaqueIndexed(), false ) && FDepthOrdered( queues.GetOverlayIndexed(), true ) );
+
+      const size_t submitted = CountBinds( opaque );
+      const size_t sorted    = CountBinds( queues.GetOpaqueIndexed() );
+      check( sorted <= submitted );
+      submittedBinds += submitted;
+      sortedBinds += sorted;
+      batches += queues.GetOpaqueBatches().size();
+
+      // What Sort used to do: a comparison sort moving whole draws, matrices and all
+      auto byKey = []( const RenderQueues::IndexedDraw& a, const RenderQueues::IndexedDraw& b ) { return a.key < b.key; };
+      start      = Clock::now();
+      std::sort( opaque.begin(), opaque.end(), byKey );
+      std::sort( transparent.begin(), transparent.end(), byKey );
+      comparisonMs += std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+   }
+
+   report.radixMicroseconds      = radixMs * 1000.0 / frames;
+   report.comparisonMicroseconds = comparisonMs * 1000.0 / frames;
+   report.submittedBinds         = static_cast< double >( submittedBinds ) / frames;
+   report.sortedBinds            = static_cast< double >( sortedBinds ) / frames;
+   report.batches                = static_cast< double >( batches ) / frames;
+   return report;
+}
+
+} // namespace Tools
@@ -0,0 +1,32 @@
+#pragma once
+
+namespace Tools
+{
+
+struct RenderSortBenchOptions
+{
+   int      draws { 100000 }; // submissions per frame, one in eight of them transparent
+   int      meshes { 256 };   // distinct vertex arrays, each its own material
+   uint64_t seed { 1 };
+   int      frames { 20 };
+};
+
+struct RenderSortBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // frames where the radix order differs from a stable sort, depth runs the wrong way, or binds go up
+
+   double radixMicroseconds { 0.0 };      // per frame: RenderQueues::Sort, batches included
+   double comparisonMicroseconds { 0.0 }; // per frame: std::sort of the same draws by key
+
+   // Per frame, on average: binds walking the draws as submitted and as sorted
+   double submittedBinds { 0.0 };
+   double sortedBinds { 0.0 };
+   double batches { 0.0 };
+};
+
+// Submits draws of random shader, mesh and depth, checks RenderQueues' radix sort against std::stable_sort on the
+// key and the depth order within each state, counts the state changes sorting saves, and times both sorts
+RenderSortBenchReport BenchRenderSort( const RenderSortBenchOptions& options );
+
+} // namespace Tools
@@ -0,0 +1,185 @@
+#include "pch_server.h"
+
+#include "ResidencyBench.h"
+
+#include "BenchFixture.h"
+
+#include <Engine/World/Level.h>
+
+namespace Tools
+{
+
+namespace
+{
+
+constexpr float    TICK_INTERVAL   = 1.0f / 20.0f; // the application's fixed tick rate
+constexpr uint32_t LONG_TICK_DELAY = 1'000'000;    // ticks; never falls due while the bench runs
+
+using SnapshotMap = std::unordered_map< ChunkPos, ChunkSnapshot, ChunkPosHash >;
+
+
+ChunkSnapshot Unpacked( ChunkSnapshot snapshot )
+{
+   snapshot.UnpackSections();
+   return snapshot;
+}
+
+
+size_t LongTicks( const ChunkSnapshot& snapshot )
+{
+   return static_cast< size_t >( std::ranges::count_if( snapshot.ticks, []( const ChunkBlockTick& tick ) { return tick.dueTick >= LONG_TICK_DELAY; } ) );
+}
+
+} // namespace
+
+
+ResidencyBenchReport BenchResidency( const ResidencyBenchOptions& options )
+{
+   ResidencyBenchReport report;
+   auto                 check = [ &report ]( bool fPassed )
+   {
+      ++report.checks;
+      report.failedChecks += fPassed ? 0 : 1;
+   };
+
+   // The edited chunks are the origin chunk and its neighbors. Standing in chunk warmX along +x puts them between
+   // the view and simulation radii; standing in chunk coldX puts them past the simulation radius.
+   const int       radius           = std::clamp( options.radius, 1, 64 );
+   const int       simulationRadius = std::clamp( options.simulationRadius, radius + 3, 255 );
+   const int       warmX            = radius + 2;
+   const int       coldX            = simulationRadius + 2;
+   const size_t    loadedChunks     = static_cast< size_t >( ( 2 * simulationRadius + 1 ) * ( 2 * simulationRadius + 1 ) );
+   const glm::vec3 home( 8.0f, 100.0f, 8.0f );
+
+   std::vector< ChunkPos > edited;
+   for( int cx = -1; cx <= 1; ++cx )
+   {
+      for( int cz = -1; cz <= 1; ++cz )
+         edited.push_back( ChunkPos { cx, cz } );
+   }
+   report.chunks = edited.size();
+
+   const ScratchWorld world( "ResidencyBench", options.seed );
+   SnapshotMap        expected;
+   {
+      Level level( world.GetDir() );
+      level.SetResidencyOptions( Level::ResidencyOptions { .simulationRadius = static_cast< uint8_t >( simulationRadius ) } );
+
+      // One fixed tick with the player in chunk `playerX`. The edited chunks are recorded between the tick and the
+      // streaming update, which is where they go cold, so the last record of each is what it held when it went.
+      auto step = [ & ]( int playerX )
+      {
+         level.Update( TICK_INTERVAL );
+         for( const ChunkPos& cpos : edited )
+         {
+            if( const Chunk* pChunk = level.GetChunks().Peek( cpos ) )
+               expected[ cpos ] = pChunk->Snapshot();
+         }
+         level.UpdateStreaming( home + glm::vec3( static_cast< float >( playerX * CHUNK_SIZE_X ), 0.0f, 0.0f ), static_cast< uint8_t >( radius ) );
+      };
+      auto walk = [ & ]( int playerX, auto fDone )
+      {
+         for( int tick = 0; tick < options.maxTicks && !fDone(); ++tick )
+            step( playerX );
+         return fDone();
+      };
+      auto fEvery = [ & ]( auto fPredicate )
+      {
+         return std::ranges::all_of( edited, [ & ]( const ChunkPos& cpos ) { return fPredicate( level.GetChunks().Peek( cpos ) ); } );
+      };
+
+      // Writes and scheduled ticks at random in the edited chunks. A quarter of the ticks fall due within the
+      // phase that scheduled them; the rest wait long past the end of the bench.
+      std::mt19937_64 rng( options.seed );
+      auto            edit = [ & ]()
+      {
+         constexpr std::array BLOCKS = { BlockId::Air, BlockId::Stone, BlockId::Log, BlockId::Furnace };
+         for( int i = 0; i < options.edits; ++i )
+         {
+            const ChunkPos&     cpos = edited[ rng() % edited.size() ];
+            const WorldBlockPos pos { cpos.x * CHUNK_SIZE_X + static_cast< int >( rng() % CHUNK_SIZE_X ),
+                                      1 + static_cast< int >( rng() % ( CHUNK_SIZE_Y - 2 ) ),
+                                      cpos.z * CHUNK_SIZE_Z + static_cast< int >( rng() % CHUNK_SIZE_Z ) };
+            level.SetBlock( pos, BlockState( BLOCKS[ rng() % BLOCKS.size() ] ) );
+            ++report.edits;
+
+            const bool fSoon = rng() % 4 == 0;
+            if( level.FScheduleTick( pos, BlockId::Stone, fSoon ? 1 + static_cast< uint32_t >( rng() % 20 ) : LONG_TICK_DELAY ) && !fSoon )
+               ++report.scheduledTicks;
+         }
+      };
+
+      for( int round = 0; round < options.rounds; ++round )
+      {
+         // Hot. Everything out to the simulation radius is loaded before the first edit, so no neighbor of an
+         // edited chunk is generated later and grows trees into it behind the record's back.
+         check( walk( 0, [ & ]() { return level.GetChunks().Size() >= loadedChunks; } ) );
+         check( fEvery( []( const Chunk* pChunk ) { return pChunk && pChunk->Tier() == ChunkTier::Hot; } ) );
+         edit();
+         for( int tick = 0; tick < 32; ++tick )
+            step( 0 );
+
+         // Warm: still ticked, so edited again; then left until the heat of the edits decays and the chunks pack
+         auto fWarm = []( const Chunk* pChunk ) { return pChunk && pChunk->Tier() == ChunkTier::Warm; };
+         check( walk( warmX, [ & ]() { return fEvery( fWarm ); } ) );
+         edit();
+         for( int tick = 0; tick < 32; ++tick )
+            step( warmX );
+
+         auto fPacked = [ & ]( const Chunk* pChunk )
+         {
+            return fWarm( pChunk ) && std::ranges::any_of( pChunk->GetSections(), []( const ChunkSection& section ) { return section.FPacked(); } );
+         };
+         check( walk( warmX, [ & ]() { return fEvery( fPacked ); } ) );
+         for( const ChunkPos& cpos : edited )
+         {
+            if( const Chunk* pChunk = level.GetChunks().Peek( cpos ) )
+               report.packedSections += static_cast< size_t >( std::ranges::count_if( pChunk->GetSections(), []( const ChunkSection& section ) { return section.FPacked(); } ) );
+         }
+
+         // Cold: compressed in memory and no longer ticked. Well under the memory budget, so none is evicted.
+         const size_t evictions = level.GetResidencyStats().evictions;
+         check( walk( coldX, [ & ]() { return fEvery( []( const Chunk* pChunk ) { return pChunk == nullptr; } ); } ) );
+         check( level.GetResidencyStats().evictions == evictions );
+
+         // Hot again: restored from the cold copy by the first streaming update, and compared before anything ticks
+         level.UpdateStreaming( home, static_cast< uint8_t >( radius ) );
+
+         size_t ticks = 0;
+         for( const ChunkPos& cpos : edited )
+         {
+            const Chunk* pChunk = level.GetChunks().Peek( cpos );
+            if( !pChunk || pChunk->Tier() != ChunkTier::Hot || !expected.contains( cpos ) )
+            {
+               ++report.mismatchedChunks;
+               continue;
+            }
+
+            const ChunkSnapshot restored = Unpacked( pChunk->Snapshot() );
+            report.mismatchedChunks += FSameChunk( Unpacked( expected.at( cpos ) ), restored ) ? 0 : 1;
+            ticks += LongTicks( restored );
+         }
+         check( ticks == report.scheduledTicks );
+      }
+      check( report.mismatchedChunks == 0 );
+
+      const Level::ResidencyStats& stats = level.GetResidencyStats();
+      report.promotions                  = stats.promotions;
+      report.demotions                   = stats.demotions;
+      report.evictions                   = stats.evictions;
+   } // saved here; the restored chunks hold nothing unsaved if their edits were written when they went cold
+
+   Level level( world.GetDir() );
+   level.UpdateStreaming( home, static_cast< uint8_t >( radius ) );
+   for( const ChunkPos& cpos : edited )
+   {
+      const Chunk* pChunk = level.GetChunks().Peek( cpos );
+      auto         it     = expected.find( cpos );
+      report.mismatchedReloads += pChunk && it != expected.end() && FSameChunk( Unpacked( it->second ), Unpacked( pChunk->Snapshot() ) ) ? 0 : 1;
+   }
+   check( report.mismatchedReloads == 0 );
+
+   return report;
+}
+
+} // namespace Tools
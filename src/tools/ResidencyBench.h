@@ -0,0 +1,38 @@
+#pragma once
+
+namespace Tools
+{
+
+struct ResidencyBenchOptions
+{
+   int      radius { 2 };           // view radius in chunks
+   int      simulationRadius { 5 }; // chunks; at least radius + 3, so the edited chunks have room to be warm
+   uint64_t seed { 1 };
+   int      rounds { 2 };           // hot, warm, cold and hot again, each with fresh edits
+   int      edits { 64 };           // block writes in the edited chunks while they are hot, and again while they are warm
+   int      maxTicks { 2000 };      // for the edited chunks to pack, or go cold, once the player has moved
+};
+
+struct ResidencyBenchReport
+{
+   size_t checks { 0 };
+   size_t failedChecks { 0 }; // chunks that came back different, or never reached a tier
+
+   size_t chunks { 0 };            // edited chunks, around the origin
+   size_t edits { 0 };             // block writes into them
+   size_t scheduledTicks { 0 };    // scheduled in them to fall due long after the bench ends
+   size_t packedSections { 0 };    // held packed by the edited chunks while warm, summed over rounds
+   size_t mismatchedChunks { 0 };  // blocks or scheduled ticks that differ from when the chunk went cold
+   size_t mismatchedReloads { 0 }; // differing once the level was saved and reopened
+   size_t promotions { 0 }, demotions { 0 }, evictions { 0 };
+};
+
+// Edits the chunks around the origin of a throwaway world and schedules ticks in them, then walks the player away
+// so they go warm (still ticked, and packed once quiet), edits them there, and walks on until they go cold. Every
+// edited chunk is recorded between the fixed tick and the streaming update right up to the point it goes cold;
+// walking back restores it to hot, and its blocks and scheduled ticks are compared with that record. Cold chunks
+// count on their edits having been saved when they went cold, so the level is finally reopened from disk and
+// compared once more.
+ResidencyBenchReport BenchResidency( const ResidencyBenchOptions& options );
+
+} // namespace Tools
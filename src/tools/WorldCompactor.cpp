@@ -0,0 +1,106 @@
+#include "pch_server.h"
+
+#include "WorldCompactor.h"
+
+#include <Engine/World/Level.h>
+#include <Engine/World/TerrainGenerator.h>
+
+namespace Tools
+{
+
+CompactReport CompactWorld( const CompactOptions& options )
+{
+   const auto    start = std::chrono::steady_clock::now();
+   CompactReport report;
+   report.threadCount = options.threadCount ? options.threadCount : ( std::max )( 1u, std::thread::hardware_concurrency() );
+
+   if( !options.fDryRun )
+      report.tempFilesRemoved = World::WorldSave::RemoveTempFiles( options.worldDir );
+
+   std::unique_ptr< TerrainGenerator > pGenerator;
+   if( options.fDropGenerated )
+   {
+      if( auto optMeta = World::WorldSave::LoadMeta( options.worldDir ) )
+         pGenerator = std::make_unique< TerrainGenerator >( optMeta->seed );
+      else
+         std::println( std::cerr, "No readable meta in {}; keeping generated chunks", options.worldDir.string() );
+   }
+
+   // Position order, so rewritten files are allocated in the order the world streams them back in.
+   std::vector< World::ChunkPos3 > chunks = World::WorldSave::ListChunks( options.worldDir );
+   std::ranges::sort( chunks, []( const World::ChunkPos3& a, const World::ChunkPos3& b ) { return std::tie( a.x, a.z, a.y ) < std::tie( b.x, b.z, b.y ); } );
+
+   std::atomic< size_t >   next { 0 };
+   std::atomic< uint64_t > chunksAfter { 0 }, bytesBefore { 0 }, bytesAfter { 0 };
+   std::atomic< uint64_t > dropped { 0 }, upgraded { 0 }, rewritten { 0 }, failed { 0 };
+   auto                    worker = [ & ]()
+   {
+      std::vector< std::byte > bytes;
+      for( size_t i = next++; i < chunks.size(); i = next++ )
+      {
+         const World::ChunkPos3& cpos3 = chunks[ i ];
+         if( !World::WorldSave::FLoadChunkBytes( options.worldDir, cpos3, bytes ) )
+         {
+            ++failed;
+            continue;
+         }
+
+         bytesBefore += bytes.size();
+         auto keepAsIs = [ & ]()
+         {
+            ++failed;
+            ++chunksAfter;
+            bytesAfter += bytes.size();
+         };
+
+         const std::optional< ChunkSnapshot > optSnapshot = ChunkSnapshot::Decode( ChunkPos { cpos3.x, cpos3.z }, bytes );
+         if( !optSnapshot )
+         {
+            keepAsIs();
+            continue;
+         }
+
+         if( pGenerator && pGenerator->FMatchesGenerated( *optSnapshot ) )
+         {
+            if( options.fDryRun || World::WorldSave::FDeleteChunkFile( options.worldDir, cpos3 ) )
+               ++dropped;
+            else
+               keepAsIs();
+            continue;
+         }
+
+         const std::vector< std::byte > encoded = optSnapshot->Encode();
+         if( !options.fDryRun && !World::WorldSave::FSaveChunkBytes( options.worldDir, cpos3, encoded ) )
+         {
+            keepAsIs();
+            continue;
+         }
+
+         if( ChunkSnapshot::FormatVersion( bytes ) != ChunkSnapshot::FORMAT_VERSION )
+            ++upgraded;
+
+         ++rewritten;
+         ++chunksAfter;
+         bytesAfter += encoded.size();
+      }
+   };
+
+   {
+      std::vector< std::jthread > workers;
+      for( unsigned i = 0; i < report.threadCount; ++i )
+         workers.emplace_back( worker );
+   } // join
+
+   report.chunksBefore = chunks.size();
+   report.chunksAfter  = chunksAfter;
+   report.bytesBefore  = bytesBefore;
+   report.bytesAfter   = bytesAfter;
+   report.dropped      = dropped;
+   report.upgraded     = upgraded;
+   report.rewritten    = rewritten;
+   report.failed       = failed;
+   report.seconds      = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+   return report;
+}
+
+} // namespace Tools
@@ -0,0 +1,39 @@
+#pragma once
+
+namespace Tools
+{
+
+struct CompactOptions
+{
+   std::filesystem::path worldDir;
+   unsigned              threadCount { 0 };      // 0 = one per hardware thread
+   bool                  fDropGenerated { true }; // delete chunks that the world seed regenerates identically
+   bool                  fDryRun { false };       // report only, touch nothing
+};
+
+struct CompactReport
+{
+   uint64_t chunksBefore { 0 };
+   uint64_t chunksAfter { 0 };
+   uint64_t bytesBefore { 0 };
+   uint64_t bytesAfter { 0 };
+
+   uint64_t dropped { 0 };   // identical to seed generation
+   uint64_t upgraded { 0 };  // re-encoded from an older chunk format
+   uint64_t rewritten { 0 }; // written back in the current format
+   uint64_t failed { 0 };    // unreadable or unwritable, left untouched
+   uint64_t tempFilesRemoved { 0 };
+
+   unsigned threadCount { 0 };
+   double   seconds { 0.0 };
+};
+
+// Offline world compaction. The world must not be open in a client or server while this runs.
+//  - Chunks identical to what the seed generates are deleted; Level regenerates them on load. Chunks whose
+//    features reach into neighbors are kept, since regenerating them would spill into the neighbors again.
+//  - Every other chunk is re-encoded in the current compact format.
+//  - Each kept chunk is rewritten through a fresh file (in position order), which also defragments
+//    storage, and temp files left by interrupted writes are removed.
+CompactReport CompactWorld( const CompactOptions& options );
+
+} // namespace Tools
@@ -0,0 +1,806 @@
+#include "pch_server.h"
+
+#include "ArenaBench.h"
+#include "BackupBench.h"
+#include "CaveCullingBench.h"
+#include "ConcurrentReadBench.h"
+#include "DeferredDeviceBench.h"
+#include "FarFieldBench.h"
+#include "FeatureBench.h"
+#include "FluidBench.h"
+#include "FrustumBench.h"
+#include "LightBench.h"
+#include "LodBench.h"
+#include "MeshPatchBench.h"
+#include "OcclusionBench.h"
+#include "RandomTickBench.h"
+#include "RenderBatchBench.h"
+#include "RenderFrameBench.h"
+#include "RenderSortBench.h"
+#include "ResidencyBench.h"
+#include "WorldCompactor.h"
+
+#include <Engine/World/WorldSave.h>
+
+static void PrintUsage()
+{
+   std::println( "Usage: OpenGL_WorldTool compact <world> [--threads <n>] [--keep-generated] [--dry-run]" );
+   std::println( "  <world>            world name under saves/, or a path to a world directory" );
+   std::println( "  --threads <n>      worker threads (default: all hardware threads)" );
+   std::println( "  --keep-generated   keep chunks identical to seed generation" );
+   std::println( "  --dry-run          report what would change without touching files" );
+   std::println( "The world must not be open in a client or server while the tool runs." );
+   std::println( "" );
+   std::println( "Usage: OpenGL_WorldTool bench-random-ticks [--radius <chunks>] [--ticks <n>] [--no-grass]" );
+   std::println( "  Measures the random tick pass over a throwaway generated world (default radius 16, 1000 ticks)." );
+   std::println( "  --no-grass         leave the surface as generated, so no section holds ticking blocks" );
+   std::println( "" );
+   std::println( "Usage: OpenGL_WorldTool bench-features [--radius <chunks>] [--seed <n>]" );
+   std::println( "  Measures chunk generation with trees over a throwaway world (default radius 16, seed 1)." );
+   std::println( "" );
+   std::println( "Usage: OpenGL_WorldTool stress-chunk-reads [--readers <n>] [--radius <chunks>] [--chunks <n>] [--seed <n>]" );
+   std::println( "  Walks a player across a throwaway world while reader threads read blocks from the chunks it streams" );
+   std::println( "  in and out (default 4 readers, radius 8, 64 chunks). Exits with 2 if any read returned garbage." );
+   std::println( "" );
+   std::println( "Usage: OpenGL_WorldTool stress-backup [--radius <chunks>] [--chunks <n>] [--rate <bytes/s>] [--seed <n>]" );
+   std::println( "  Starts an online backup of a throwaway world while a player walks, edits and saves it, then reads the" );
+   std::println( "  archive back and compares every chunk and the pending feature writes with the world at the snapshot tick" );
+   std::println( "  (default radius 6, 16 chunks, 524288 bytes/s, seed 1). Exits with 2 if any check failed." );
+   std::println( "" );
+   std::println( "Usage: OpenGL_WorldTool bench-far-field [--radius <chunks>] [--seed <n>] [--lod <0-4>] [--rays <n>]" );
+   std::println( "  Summarizes generated columns into the far-field voxel DAG and reports memory per column, build time," );
+   std::println( "  long-distance raycasts and coarse mesh extraction (default radius 32, seed 1, lod 2, 10000 rays)." );
+   std::println( "" );
+   std::println( "Usage: OpenGL_WorldTool bench-cave-culling [--radius <chunks>] [--seed <n>]" );
+   std::println( "  Checks section visibility against hand-built caves, then measures it on generated terrain seen from" );
+   std::println( "  above the surface (default radius 8, seed 1). Exits with 2 if any check failed." );
+   std::println( "" );
+   std::println( "Usage: OpenGL_WorldTool bench-occlusion [--radius <chunks>] [--seed <n>] [--frames <n>]" );
+   std::println( "  Checks the software occlusion culler against a wall, then measures rasterizing occluders and testing" );
+   std::println( "  sections on generated terrain (default radius 8, seed 1, 100 frames). Exits with 2 if any check failed." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool bench-frustum [--radius <chunks>] [--seed <n>] [--frames <n>]" );
+   std::println( "  Culls every section box of a square view against random camera orientations four boxes at a time and" );
+   std::println( "  one at a time (default radius 32, seed 1, 200 frames). Exits with 2 if the two ever disagree." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool bench-arena [--capacity <units>] [--seed <n>] [--operations <n>]" );
+   std::println( "  Checks the chunk mesh arena's range allocator on fixed cases, then churns the arena itself with" );
+   std::println( "  section-sized meshes through the null render device, checking each rebuild (default capacity 1048576" );
+   std::println( "  vertices, seed 1, 200000 operations). Exits with 2 if any check failed." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool bench-render-batches [--draws <n>] [--meshes <n>] [--seed <n>] [--frames <n>]" );
+   std::println( "  Groups random opaque draws into instance batches, checking each draw lands once in the right batch" );
+   std::println( "  (default 10000 draws over 64 meshes, seed 1, 200 frames). Exits with 2 if any check failed." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool bench-render-sort [--draws <n>] [--meshes <n>] [--seed <n>] [--frames <n>]" );
+   std::println( "  Radix-sorts random draws by render key, checking the order and the binds it saves, and times it against" );
+   std::println( "  std::sort (default 100000 draws over 256 meshes, seed 1, 20 frames). Exits with 2 if any check failed." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool bench-render-frame [--radius <chunks>] [--seed <n>] [--drops <n>] [--frames <n>]" );
+   std::println( "  Renders generated terrain and item drops through the null render device, checking the draws, binds and" );
+   std::println( "  bytes each frame records and timing the CPU side (default radius 6, seed 1, 256 drops, 200 frames), then" );
+   std::println( "  times meshing a single-block edit. Run from the game's directory, as it loads assets/. Exits with 2 if any" );
+   std::println( "  check failed." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool bench-deferred-device [--radius <chunks>] [--seed <n>] [--frames <n>]" );
+   std::println( "  Checks that recorded ids handed out again after a delete and uniforms a program lacks play correctly," );
+   std::println( "  then records a frame of generated terrain through the deferred render device, plays it into the null" );
+   std::println( "  device and compares it with the same frame drawn straight into one; times recording and playing" );
+   std::println( "  (default radius 6, seed 1, 100 frames). Run from the game's directory, as it loads assets/. Exits with" );
+   std::println( "  2 if any check failed." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool bench-lod [--near <chunks>] [--far <chunks>] [--seed <n>] [--tolerance <x>]" );
+   std::println( "  Counts the quads and vertices of generated terrain meshed at full detail out to the near radius against" );
+   std::println( "  the far radius meshed with the LOD rings (default near 12, far 32, seed 1, tolerance 1.25). Run from the" );
+   std::println( "  game's directory, as it loads assets/. Exits with 2 if the far view costs more than tolerance times the" );
+   std::println( "  near one, or any check failed." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool bench-mesh-patch [--radius <chunks>] [--seed <n>] [--edits <n>]" );
+   std::println( "  Edits generated terrain meshed through the null render device: surface digs and placements, edits on" );
+   std::println( "  chunk borders, a furnace, holes that outgrow a section's spare slots and edits in more sections than" );
+   std::println( "  keep face maps. After each update the patched meshes are read back and compared with fresh builds" );
+   std::println( "  (default radius 4, seed 1, 64 edits). Run from the game's directory, as it loads assets/. Exits with 2" );
+   std::println( "  if any check failed." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool stress-lighting [--radius <chunks>] [--seed <n>] [--edits <n>] [--explosions <n>] [--batches <n>]" );
+   std::println( "  Edits lit terrain of a throwaway world with digs, placements, furnaces, explosions and batched roofs," );
+   std::println( "  then saves and reopens it and compares the incrementally updated sky and block light of every cell with" );
+   std::println( "  a relight from scratch (default radius 4, seed 1, 256 edits, 16 explosions, 8 batches). Exits with 2 if" );
+   std::println( "  any check failed." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool stress-fluids [--radius <chunks>] [--seed <n>] [--flood <blocks>] [--max-ticks <n>]" );
+   std::println( "  Pours water and lava onto a throwaway world, then drops a square of water sources on it and finally" );
+   std::println( "  removes every source, ticking until the fluids settle each time. Checks each phase settles in time within" );
+   std::println( "  the per-tick update budget and leaves no cell that would still flow, and that the drain leaves no fluid" );
+   std::println( "  (default radius 3, seed 1, flood 64, 20000 ticks). Exits with 2 if any check failed." );
+   std::println();
+   std::println( "Usage: OpenGL_WorldTool stress-residency [--radius <chunks>] [--simulation-radius <chunks>] [--seed <n>] [--rounds <n>] [--edits <n>]" );
+   std::println( "  Edits and schedules ticks in the chunks around the origin of a throwaway world, then walks away until" );
+   std::println( "  they go warm, edits them again, walks on until they go cold and walks back. Compares their blocks and" );
+   std::println( "  ticks with the moment they went cold, and again after reopening the world from disk (default radius 2," );
+   std::println( "  simulation radius 5, seed 1, 2 rounds, 64 edits). Exits with 2 if any check failed." );
+}
+
+static int RunCompact( std::span< char* > args )
+{
+   if( args.empty() )
+   {
+      PrintUsage();
+      return 1;
+   }
+
+   Tools::CompactOptions options { .worldDir = World::WorldSave::RootDir( args[ 0 ] ) };
+   for( size_t i = 1; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--threads" && i + 1 < args.size() )
+         options.threadCount = static_cast< unsigned >( std::strtoul( args[ ++i ], nullptr, 10 ) );
+      else if( arg == "--keep-generated" )
+         options.fDropGenerated = false;
+      else if( arg == "--dry-run" )
+         options.fDryRun = true;
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   if( !std::filesystem::is_directory( options.worldDir ) )
+   {
+      std::println( std::cerr, "World directory {} does not exist", options.worldDir.string() );
+      return 1;
+   }
+
+   const Tools::CompactReport report = Tools::CompactWorld( options );
+
+   constexpr double MiB = 1024.0 * 1024.0;
+   std::println( "{} {} in {:.3f}s using {} threads",
+                 options.fDryRun ? "Dry run of" : "Compacted",
+                 options.worldDir.string(),
+                 report.seconds,
+                 report.threadCount );
+   std::println( "  chunks: {} -> {} ({} identical to generation, {} upgraded, {} rewritten, {} failed)",
+                 report.chunksBefore,
+                 report.chunksAfter,
+                 report.dropped,
+                 report.upgraded,
+                 report.rewritten,
+                 report.failed );
+   std::println( "  size:   {:.2f} MiB -> {:.2f} MiB", report.bytesBefore / MiB, report.bytesAfter / MiB );
+   if( report.tempFilesRemoved )
+      std::println( "  removed {} temp files from interrupted writes", report.tempFilesRemoved );
+
+   return report.failed ? 2 : 0;
+}
+
+static int RunRandomTickBench( std::span< char* > args )
+{
+   Tools::RandomTickBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--ticks" && i + 1 < args.size() )
+         options.ticks = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else if( arg == "--no-grass" )
+         options.fGrass = false;
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::RandomTickBenchReport report = Tools::BenchRandomTicks( options );
+   std::println( "Random ticks at radius {} over {} ticks", options.radius, options.ticks );
+   std::println( "  sections: {} loaded, {} active", report.sections, report.activeSections );
+   std::println( "  blocks ticked: {}", report.blocksTicked );
+   std::println( "  per tick: {:.3f} ms avg, {:.3f} ms max", report.avgMilliseconds, report.maxMilliseconds );
+   return 0;
+}
+
+static int RunFeatureBench( std::span< char* > args )
+{
+   Tools::FeatureBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::FeatureBenchReport report = Tools::BenchFeatures( options );
+   std::println( "Feature generation at radius {} with seed {}", options.radius, options.seed );
+   std::println( "  chunks: {} requested, {} loaded", report.chunksRequested, report.chunksLoaded );
+   std::println( "  blocks: {} logs, {} leaves", report.logs, report.leaves );
+   std::println( "  pending: {} writes for {} chunks outside the radius", report.pendingWrites, report.pendingChunks );
+   std::println( "  time: {:.1f} ms, {:.3f} ms per chunk", report.milliseconds, report.chunksRequested ? report.milliseconds / report.chunksRequested : 0.0 );
+   return 0;
+}
+
+static int RunConcurrentReadBench( std::span< char* > args )
+{
+   Tools::ConcurrentReadBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--readers" && i + 1 < args.size() )
+         options.readers = std::clamp( std::atoi( args[ ++i ] ), 1, 256 );
+      else if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--chunks" && i + 1 < args.size() )
+         options.chunks = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::ConcurrentReadBenchReport report = Tools::BenchConcurrentReads( options );
+   std::println( "Concurrent chunk reads with {} readers at radius {} over {} chunks", options.readers, options.radius, options.chunks );
+   std::println( "  reads: {} ({} in loaded chunks, {} through held handles), {:.1f} M/s",
+                 report.reads,
+                 report.loadedReads,
+                 report.handleReads,
+                 report.milliseconds > 0.0 ? report.reads / report.milliseconds / 1000.0 : 0.0 );
+   std::println( "  main thread: {} block writes, {} chunks demoted", report.edits, report.demotions );
+   std::println( "  invalid reads: {}", report.invalidReads );
+   return report.invalidReads ? 2 : 0;
+}
+
+static int RunBackupBench( std::span< char* > args )
+{
+   Tools::BackupBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--chunks" && i + 1 < args.size() )
+         options.chunks = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else if( arg == "--rate" && i + 1 < args.size() )
+         options.bytesPerSecond = static_cast< size_t >( std::strtoull( args[ ++i ], nullptr, 10 ) );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::BackupBenchReport report = Tools::BenchBackup( options );
+   std::println( "Online backup at radius {} over {} chunks with seed {}", options.radius, options.chunks, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  chunks: {} at the snapshot tick, {} archived ({} missing, {} extra, {} different)",
+                 report.chunks,
+                 report.archivedChunks,
+                 report.missingChunks,
+                 report.extraChunks,
+                 report.mismatchedChunks );
+   std::println( "  pending feature writes: {} at the snapshot tick, {}", report.featureWrites, report.fFeaturesArchived ? "archived" : "not archived as they were" );
+   std::println( "  while running: {} ticks, {} block writes", report.ticks, report.edits );
+   std::println( "  archive: {:.2f} MiB in {:.1f}s", report.archiveBytes / ( 1024.0 * 1024.0 ), report.seconds );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunFarFieldBench( std::span< char* > args )
+{
+   Tools::FarFieldBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--lod" && i + 1 < args.size() )
+         options.lod = std::clamp( std::atoi( args[ ++i ] ), 0, 4 );
+      else if( arg == "--rays" && i + 1 < args.size() )
+         options.rays = ( std::max )( std::atoi( args[ ++i ] ), 0 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::FarFieldBenchReport report = Tools::BenchFarField( options );
+   const double                     columns = report.columns ? static_cast< double >( report.columns ) : 1.0;
+   std::println( "Far field over {} columns at radius {} with seed {}", report.columns, options.radius, options.seed );
+   std::println( "  nodes: {}, {:.1f} KiB per column ({:.1f} KiB unpacked, {:.1f} KiB cold), intern table {:.1f} MiB",
+                 report.nodes,
+                 report.farFieldBytes / columns / 1024.0,
+                 report.detailedBytes / columns / 1024.0,
+                 report.coldBytes / columns / 1024.0,
+                 report.indexBytes / ( 1024.0 * 1024.0 ) );
+   std::println( "  build: {:.1f} ms, {:.3f} ms per column", report.buildMilliseconds, report.buildMilliseconds / columns );
+   std::println( "  raycasts: {} of {} hit, {:.2f} us per ray", report.rayHits, options.rays, options.rays ? report.rayMilliseconds * 1000.0 / options.rays : 0.0 );
+   std::println( "  coarse mesh at lod {}: {} quads, {:.1f} ms", options.lod, report.coarseQuads, report.meshMilliseconds );
+   return 0;
+}
+
+static int RunCaveCullingBench( std::span< char* > args )
+{
+   Tools::CaveCullingBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::CaveCullingBenchReport report = Tools::BenchCaveCulling( options );
+   std::println( "Cave culling at radius {} with seed {}", options.radius, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  sections: {} of {} non-empty sections reached from above the surface ({:.1f}%)",
+                 report.reachedSections,
+                 report.sections,
+                 report.sections ? 100.0 * report.reachedSections / report.sections : 0.0 );
+   std::println( "  time: {:.1f} ms computing visibility, {:.1f} us per walk", report.computeMilliseconds, report.walkMicroseconds );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunOcclusionBench( std::span< char* > args )
+{
+   Tools::OcclusionBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--frames" && i + 1 < args.size() )
+         options.frames = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::OcclusionBenchReport report = Tools::BenchOcclusion( options );
+   std::println( "Occlusion culling at radius {} with seed {}", options.radius, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  sections: {} of {} in front of the camera occluded by {} opaque runs ({:.1f}%)",
+                 report.occluded,
+                 report.tested,
+                 report.occluders,
+                 report.tested ? 100.0 * report.occluded / report.tested : 0.0 );
+   std::println( "  time per frame: {:.1f} us rasterizing, {:.1f} us testing", report.rasterMicroseconds, report.testMicroseconds );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunFrustumBench( std::span< char* > args )
+{
+   Tools::FrustumBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--frames" && i + 1 < args.size() )
+         options.frames = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::FrustumBenchReport report = Tools::BenchFrustum( options );
+   std::println( "Frustum culling at radius {} with seed {}", options.radius, options.seed );
+   std::println( "  checks: {} of {} frames agreed", report.checks - report.failedChecks, report.checks );
+   std::println( "  boxes: {:.0f} of {} in view on average, in {} columns", report.visibleBoxes, report.boxes, report.columns );
+   std::println( "  time per frame: {:.1f} us batched, {:.1f} us one box at a time ({:.1f}x)",
+                 report.batchedMicroseconds,
+                 report.scalarMicroseconds,
+                 report.batchedMicroseconds > 0.0 ? report.scalarMicroseconds / report.batchedMicroseconds : 0.0 );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunArenaBench( std::span< char* > args )
+{
+   Tools::ArenaBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--capacity" && i + 1 < args.size() )
+         options.capacity = static_cast< uint32_t >( std::clamp( std::strtoull( args[ ++i ], nullptr, 10 ), 1ull, 1ull << 30 ) );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--operations" && i + 1 < args.size() )
+         options.operations = ( std::max )( std::atoi( args[ ++i ] ), 0 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::ArenaBenchReport report = Tools::BenchArena( options );
+   std::println( "Chunk mesh arena churn with seed {}", options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  capacity: {} vertices at the end, peak {} in use; {} rebuilds, {} of them growing",
+                 report.finalCapacity,
+                 report.peakUsed,
+                 report.compactions,
+                 report.grows );
+   std::println( "  fragmentation: {:.1f}% on average, {:.1f}% at worst", report.meanFragmentation * 100.0f, report.peakFragmentation * 100.0f );
+   std::println( "  time: {:.0f} ns per allocation or free", report.nanosecondsPerOperation );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunRenderBatchBench( std::span< char* > args )
+{
+   Tools::RenderBatchBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--draws" && i + 1 < args.size() )
+         options.draws = std::clamp( std::atoi( args[ ++i ] ), 0, 1 << 24 );
+      else if( arg == "--meshes" && i + 1 < args.size() )
+         options.meshes = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--frames" && i + 1 < args.size() )
+         options.frames = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::RenderBatchBenchReport report = Tools::BenchRenderBatches( options );
+   std::println( "Instance batching of {} draws over {} meshes with seed {}", options.draws, options.meshes, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  draw calls: {:.1f} batches per frame instead of {}", report.batches, options.draws );
+   std::println( "  time per frame: {:.1f} us sorting and batching", report.microsecondsPerFrame );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunRenderSortBench( std::span< char* > args )
+{
+   Tools::RenderSortBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--draws" && i + 1 < args.size() )
+         options.draws = std::clamp( std::atoi( args[ ++i ] ), 0, 1 << 24 );
+      else if( arg == "--meshes" && i + 1 < args.size() )
+         options.meshes = std::clamp( std::atoi( args[ ++i ] ), 1, 1 << 24 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--frames" && i + 1 < args.size() )
+         options.frames = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::RenderSortBenchReport report = Tools::BenchRenderSort( options );
+   std::println( "Render key sort of {} draws over {} meshes with seed {}", options.draws, options.meshes, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  opaque binds per frame: {:.0f} as submitted, {:.0f} sorted, in {:.0f} batches", report.submittedBinds, report.sortedBinds, report.batches );
+   std::println( "  time per frame: {:.1f} us radix sort, {:.1f} us std::sort ({:.1f}x)",
+                 report.radixMicroseconds,
+                 report.comparisonMicroseconds,
+                 report.radixMicroseconds > 0.0 ? report.comparisonMicroseconds / report.radixMicroseconds : 0.0 );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunRenderFrameBench( std::span< char* > args )
+{
+   Tools::RenderFrameBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--drops" && i + 1 < args.size() )
+         options.drops = std::clamp( std::atoi( args[ ++i ] ), 0, 1 << 20 );
+      else if( arg == "--frames" && i + 1 < args.size() )
+         options.frames = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::RenderFrameBenchReport report = Tools::BenchRenderFrame( options );
+   std::println( "Null-device frames over radius {} with seed {} and {} drops", options.radius, options.seed, options.drops );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  setup: {} chunks, {} bytes of meshes, {} bytes of textures", report.chunks, report.meshBytes, report.textureBytes );
+   std::println( "  per frame: {} draw calls ({} terrain commands in one, reading {} indices), {} instances, {} elements",
+                 report.drawCalls,
+                 report.terrainDraws,
+                 report.terrainElements,
+                 report.instances,
+                 report.elements );
+   std::println( "  per frame: {} binds, {} uniforms, {} buffer bytes", report.binds, report.uniforms, report.bufferBytes );
+   std::println( "  time per frame: {:.1f} us", report.microsecondsPerFrame );
+   std::println( "  single-block edit: rebuild {:.1f} us ({} bytes), patch {:.1f} us ({} bytes)",
+                 report.rebuildMicroseconds,
+                 report.rebuildBytes,
+                 report.patchMicroseconds,
+                 report.patchBytes );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunDeferredDeviceBench( std::span< char* > args )
+{
+   Tools::DeferredDeviceBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--frames" && i + 1 < args.size() )
+         options.frames = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::DeferredDeviceBenchReport report = Tools::BenchDeferredDevice( options );
+   std::println( "Deferred device frames over radius {} with seed {}", options.radius, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  frame: {} commands played, {} differing from the direct frame", report.commands, report.mismatchedCommands );
+   std::println( "  packet: {} commands in {} bytes", report.packetCommands, report.packetBytes );
+   std::println( "  time per frame: record {:.1f} us, play {:.1f} us", report.recordMicroseconds, report.playMicroseconds );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunLodBench( std::span< char* > args )
+{
+   Tools::LodBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--near" && i + 1 < args.size() )
+         options.nearRadius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--far" && i + 1 < args.size() )
+         options.farRadius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--tolerance" && i + 1 < args.size() )
+         options.tolerance = ( std::max )( std::strtof( args[ ++i ], nullptr ), 0.0f );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::LodBenchReport report = Tools::BenchLod( options );
+   std::println( "LOD rings at radius {} against full detail at radius {} with seed {}", options.farRadius, options.nearRadius, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  full detail: {} chunks, {} quads, {} vertices", report.nearChunks, report.nearQuads, report.nearVertices );
+   std::println( "  LOD rings: {} chunks, {} quads, {} vertices, meshed in {:.1f} ms", report.farChunks, report.farQuads, report.farVertices, report.milliseconds );
+   std::println( "  LOD rings: quads by lod {} / {} / {} / {}",
+                 report.farQuadsByLod[ 0 ],
+                 report.farQuadsByLod[ 1 ],
+                 report.farQuadsByLod[ 2 ],
+                 report.farQuadsByLod[ 3 ] );
+   std::println( "  ratio: {:.2f}x quads, {:.2f}x vertices (target {:.2f}x)",
+                 report.nearQuads ? static_cast< double >( report.farQuads ) / report.nearQuads : 0.0,
+                 report.nearVertices ? static_cast< double >( report.farVertices ) / report.nearVertices : 0.0,
+                 options.tolerance );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunMeshPatchBench( std::span< char* > args )
+{
+   Tools::MeshPatchBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--edits" && i + 1 < args.size() )
+         options.edits = ( std::max )( std::atoi( args[ ++i ] ), 0 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::MeshPatchBenchReport report = Tools::BenchMeshPatch( options );
+   std::println( "Mesh patching over radius {} with seed {}", options.radius, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  {} chunks, {} updates after edits, {:.1f} us per update", report.chunks, report.updates, report.microsecondsPerUpdate );
+   std::println( "  sections read back: {}, {} differing from a fresh build", report.verifiedSections, report.mismatchedSections );
+   std::println( "  slot swaps: {}, spare slot overflows: {}, face maps evicted: {}", report.swaps, report.overflows, report.evictions );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunLightBench( std::span< char* > args )
+{
+   Tools::LightBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 2, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--edits" && i + 1 < args.size() )
+         options.edits = ( std::max )( std::atoi( args[ ++i ] ), 0 );
+      else if( arg == "--explosions" && i + 1 < args.size() )
+         options.explosions = ( std::max )( std::atoi( args[ ++i ] ), 0 );
+      else if( arg == "--batches" && i + 1 < args.size() )
+         options.batches = ( std::max )( std::atoi( args[ ++i ] ), 0 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::LightBenchReport report = Tools::BenchLighting( options );
+   std::println( "Incremental lighting over radius {} with seed {}", options.radius, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  {} edits, {} explosions, {} batches, {:.1f} us per block written", options.edits, options.explosions, options.batches, report.microsecondsPerEdit );
+   std::println( "  {} chunks compared, {} cells relit by the edits", report.chunks, report.relitCells );
+   std::println( "  differing from a relight from scratch: {} sky, {} block light; {} blocks changed on reload",
+                 report.mismatchedSky,
+                 report.mismatchedBlock,
+                 report.changedBlocks );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunFluidBench( std::span< char* > args )
+{
+   Tools::FluidBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 2, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--flood" && i + 1 < args.size() )
+         options.flood = ( std::max )( std::atoi( args[ ++i ] ), 0 );
+      else if( arg == "--max-ticks" && i + 1 < args.size() )
+         options.maxTicks = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::FluidBenchReport report = Tools::BenchFluids( options );
+   std::println( "Fluid settling over radius {} with seed {}", options.radius, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  settled after {} ticks (pour), {} (flood of {} sources), {} (drain); 0 is never", report.pourTicks, report.floodTicks, options.flood * options.flood, report.drainTicks );
+   std::println( "  cells updated: at most {} in a tick, {} ticks at the full budget; {} blocks written", report.peakCellsUpdated, report.fullBudgetTicks, report.blocksWritten );
+   std::println( "  fluid cells: {} after the flood, {} still flowing, {} left after the drain", report.fluidCells, report.unsettledCells, report.remainingCells );
+   return report.failedChecks ? 2 : 0;
+}
+
+static int RunResidencyBench( std::span< char* > args )
+{
+   Tools::ResidencyBenchOptions options;
+   for( size_t i = 0; i < args.size(); ++i )
+   {
+      const std::string_view arg = args[ i ];
+      if( arg == "--radius" && i + 1 < args.size() )
+         options.radius = std::clamp( std::atoi( args[ ++i ] ), 1, 64 );
+      else if( arg == "--simulation-radius" && i + 1 < args.size() )
+         options.simulationRadius = std::clamp( std::atoi( args[ ++i ] ), 0, 255 );
+      else if( arg == "--seed" && i + 1 < args.size() )
+         options.seed = std::strtoull( args[ ++i ], nullptr, 10 );
+      else if( arg == "--rounds" && i + 1 < args.size() )
+         options.rounds = ( std::max )( std::atoi( args[ ++i ] ), 1 );
+      else if( arg == "--edits" && i + 1 < args.size() )
+         options.edits = ( std::max )( std::atoi( args[ ++i ] ), 0 );
+      else
+      {
+         PrintUsage();
+         return 1;
+      }
+   }
+
+   const Tools::ResidencyBenchReport report = Tools::BenchResidency( options );
+   std::println( "Residency round trips at radius {} with seed {}", options.radius, options.seed );
+   std::println( "  checks: {} of {} passed", report.checks - report.failedChecks, report.checks );
+   std::println( "  {} chunks edited over {} rounds: {} block writes, {} ticks scheduled past the end, {} sections packed while warm",
+                 report.chunks,
+                 options.rounds,
+                 report.edits,
+                 report.scheduledTicks,
+                 report.packedSections );
+   std::println( "  promotions: {}, demotions: {}, evictions: {}", report.promotions, report.demotions, report.evictions );
+   std::println( "  chunks differing: {} back from cold, {} after reopening", report.mismatchedChunks, report.mismatchedReloads );
+   return report.failedChecks ? 2 : 0;
+}
+
+int main( int argc, char* argv[] )
+{
+   try
+   {
+      const std::span< char* > args( argv + 1, argc > 1 ? argc - 1 : 0 );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "compact" )
+         return RunCompact( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-random-ticks" )
+         return RunRandomTickBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-features" )
+         return RunFeatureBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "stress-chunk-reads" )
+         return RunConcurrentReadBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "stress-backup" )
+         return RunBackupBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-far-field" )
+         return RunFarFieldBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-cave-culling" )
+         return RunCaveCullingBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-occlusion" )
+         return RunOcclusionBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-frustum" )
+         return RunFrustumBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-arena" )
+         return RunArenaBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-render-batches" )
+         return RunRenderBatchBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-render-sort" )
+         return RunRenderSortBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-render-frame" )
+         return RunRenderFrameBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-deferred-device" )
+         return RunDeferredDeviceBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-lod" )
+         return RunLodBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "bench-mesh-patch" )
+         return RunMeshPatchBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "stress-lighting" )
+         return RunLightBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "stress-fluids" )
+         return RunFluidBench( args.subspan( 1 ) );
+      if( !args.empty() && std::string_view( args[ 0 ] ) == "stress-residency" )
+         return RunResidencyBench( args.subspan( 1 ) );
+
+      PrintUsage();
+      return 1;
+   }
+   catch( const std::exception& e )
+   {
+      std::println( std::cerr, "World tool terminated unexpectedly: {}", e.what() );
+      return -1;
+   }
+}